@@ -1,4 +1,5 @@
 
 include(CMakeFindDependencyMacro)
 find_dependency(Eigen3)
+find_dependency(Threads)
 include("${CMAKE_CURRENT_LIST_DIR}/panaceaTargets.cmake")
@@ -0,0 +1,65 @@
+#ifndef PANACEA_BASEDESCRIPTORSUMMARY_H
+#define PANACEA_BASEDESCRIPTORSUMMARY_H
+#pragma once
+
+// Public PANACEA includes
+#include "settings.hpp"
+
+// Standard includes
+#include <vector>
+
+namespace panacea {
+
+/**
+ * Summary of a set of descriptors, e.g. read from the ".summary" sidecar
+ * written next to a descriptor file with settings::DescriptorSidecar::Summary
+ *
+ * The summaries of disjoint sets of descriptors are merged without reading
+ * the descriptors. The statistics merge exactly, the histograms of each
+ * dimension are rebinned onto the combined range.
+ *
+ * std::unique_ptr<BaseDescriptorSummary> summary = panacea.mergeSummaries(
+ *     {"descriptors1.txt.summary", "descriptors2.txt.summary"});
+ * std::vector<double> coeffs =
+ *     summary->getNormalizationCoeffs(settings::KernelNormalization::Variance);
+ **/
+class BaseDescriptorSummary {
+public:
+  virtual int getNumberPoints() const noexcept = 0;
+  virtual int getNumberDimensions() const noexcept = 0;
+
+  virtual double getMin(const int dim) const = 0;
+  virtual double getMax(const int dim) const = 0;
+  virtual double getMean(const int dim) const = 0;
+  virtual double getVariance(const int dim) const = 0;
+
+  /**
+   * Number of points in a bin of the histogram of a dimension, bin spans
+   * [getBinLower(dim, bin), getBinLower(dim, bin) + getBinWidth(dim)).
+   **/
+  virtual int getNumberBins() const noexcept = 0;
+  virtual double getBinCount(const int dim, const int bin) const = 0;
+  virtual double getBinLower(const int dim, const int bin) const = 0;
+  virtual double getBinWidth(const int dim) const = 0;
+
+  /**
+   * Combines the summary of a disjoint set of descriptors with the same
+   * number of dimensions and bins.
+   **/
+  virtual void merge(const BaseDescriptorSummary &summary) = 0;
+
+  /**
+   * Coefficients a normalizer initialized from the summarized descriptors
+   * would divide them by, without reading the descriptors. The flexible
+   * algorithm replaces coefficients of 0.0 with 1.0, the strict one fails.
+   **/
+  virtual std::vector<double>
+  getNormalizationCoeffs(const settings::KernelNormalization norm_method,
+                         const settings::PANACEAAlgorithm algorithm =
+                             settings::PANACEAAlgorithm::Flexible) const = 0;
+
+  virtual ~BaseDescriptorSummary() = 0;
+};
+
+} // namespace panacea
+#endif // PANACEA_BASEDESCRIPTORSUMMARY_H
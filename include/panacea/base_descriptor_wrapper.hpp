@@ -20,6 +20,9 @@ enum class Arrangement;
  * Base Descriptor interface
  */
 class BaseDescriptorWrapper {
+private:
+  settings::LayoutCache layout_cache_ = settings::LayoutCache::None;
+
 public:
   /**
    * Return the dimensions available to the wrapper
@@ -86,6 +89,18 @@ public:
    **/
   virtual void print() const = 0;
 
+  /**
+   * Controls whether entropy terms evaluate descriptors whose dimensions are
+   * arranged along the rows from a point major copy, see
+   * settings::LayoutCache.
+   *
+   * The copy is taken at the start of each compute or compute_grad call and
+   * discarded before it returns, so values modified between calls, through
+   * operator() or the wrapped data directly, are always seen.
+   **/
+  void setLayoutCache(const settings::LayoutCache layout_cache) noexcept;
+  settings::LayoutCache getLayoutCache() const noexcept;
+
   virtual ~BaseDescriptorWrapper() = 0;
 
   static std::vector<std::any> write(const settings::FileType file_type,
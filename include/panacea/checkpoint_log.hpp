@@ -0,0 +1,56 @@
+#ifndef PANACEA_CHECKPOINTLOG_H
+#define PANACEA_CHECKPOINTLOG_H
+#pragma once
+
+// Standard includes
+#include <any>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Restart file that grows by a record per checkpoint
+ *
+ * A kernel distribution that grows through update between checkpoints only
+ * needs the new kernel rows written, each appended record contains those
+ * together with the summary statistics, i.e. the covariance, normalizer,
+ * means and medians, which are small. Reading the log replays the records
+ * in order.
+ *
+ * The first record a log appends is a full record that replaces the file,
+ * compact rewrites the log as a single full record. Both replace the file
+ * atomically.
+ *
+ * std::unique_ptr<io::CheckpointLog> log =
+ *   panacea.createCheckpointLog(settings::FileType::BinaryRestart,
+ *                               "self_ent.log");
+ * log->append(self_ent.get());
+ * self_ent->update(*more_descriptors);
+ * log->append(self_ent.get());
+ *
+ * log->read(self_ent_shell.get());
+ **/
+class CheckpointLog {
+public:
+  /**
+   * Appends a record holding the changes since the previous record.
+   **/
+  virtual void append(std::any obj) = 0;
+
+  /**
+   * Replaces the log with a single record holding the full object.
+   **/
+  virtual void compact(std::any obj) = 0;
+
+  /**
+   * Reads every record of the log into the object.
+   **/
+  virtual void read(std::any obj) = 0;
+
+  virtual ~CheckpointLog() = 0;
+};
+} // namespace io
+
+} // namespace panacea
+#endif // PANACEA_CHECKPOINTLOG_H
@@ -0,0 +1,54 @@
+#ifndef PANACEA_CHECKPOINTWRITER_H
+#define PANACEA_CHECKPOINTWRITER_H
+#pragma once
+
+// Standard includes
+#include <any>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Writes restart files without blocking the caller for the file system
+ *
+ * A snapshot of the objects is taken before write returns, after which the
+ * objects can be updated again. Writing, flushing to disk and renaming the
+ * snapshot onto the file name happen on a background thread, readers of the
+ * file never see a partially written restart.
+ *
+ * std::unique_ptr<io::CheckpointWriter> checkpoint =
+ *   panacea.createCheckpointWriter(settings::FileType::BinaryRestart);
+ *
+ * auto written = checkpoint->write(self_ent.get(), "self_ent.restart");
+ * self_ent->update(*dwrapper);
+ * written.get();
+ **/
+class CheckpointWriter {
+public:
+  /**
+   * Checkpoints are written in the order they were requested. The returned
+   * future rethrows any error raised while writing the file.
+   **/
+  virtual std::shared_future<void> write(std::any obj,
+                                         const std::string &filename) = 0;
+  virtual std::shared_future<void> write(const std::vector<std::any> &objs,
+                                         const std::string &filename) = 0;
+
+  /**
+   * Blocks until every requested checkpoint is on disk.
+   **/
+  virtual void wait() = 0;
+
+  /**
+   * Waits for the pending checkpoints.
+   **/
+  virtual ~CheckpointWriter() = 0;
+};
+} // namespace io
+
+} // namespace panacea
+#endif // PANACEA_CHECKPOINTWRITER_H
@@ -0,0 +1,60 @@
+#ifndef PANACEA_DESCRIPTORSTREAMREADER_H
+#define PANACEA_DESCRIPTORSTREAMREADER_H
+#pragma once
+
+// Standard includes
+#include <functional>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+class EntropyTerm;
+
+namespace io {
+
+/**
+ * Reads a descriptor file a fixed number of points at a time
+ *
+ * Only the points of the current chunk are held in memory, each chunk is
+ * handed to a callback or to the update method of an entropy term, which
+ * should then be set up with an update policy that accumulates the chunks.
+ * The chunks are reused from one to the next, kernels that would otherwise
+ * share the memory of the descriptors are given a copy of them.
+ *
+ * std::unique_ptr<io::DescriptorStreamReader> reader =
+ *   panacea.createDescriptorStreamReader(settings::FileType::TXTDescriptors,
+ *                                        "descriptors.txt", 10000);
+ * reader->update(*self_ent);
+ **/
+class DescriptorStreamReader {
+public:
+  using ChunkCallback = std::function<void(const BaseDescriptorWrapper &)>;
+
+  /**
+   * Number of points and dimensions in the file.
+   **/
+  virtual int rows() const noexcept = 0;
+  virtual int cols() const noexcept = 0;
+  virtual int chunkRows() const noexcept = 0;
+  virtual int rowsRead() const noexcept = 0;
+  virtual bool done() const noexcept = 0;
+
+  /**
+   * Passes every remaining chunk to the callback. With overlap the next
+   * chunk is parsed on a background thread while the callback runs.
+   **/
+  virtual void forEachChunk(const ChunkCallback &callback,
+                            const bool overlap = true) = 0;
+
+  /**
+   * Updates the entropy term with every remaining chunk.
+   **/
+  virtual void update(EntropyTerm &entropy_term,
+                      const bool overlap = true) = 0;
+
+  virtual ~DescriptorStreamReader() = 0;
+};
+} // namespace io
+
+} // namespace panacea
+#endif // PANACEA_DESCRIPTORSTREAMREADER_H
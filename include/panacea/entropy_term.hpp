@@ -86,6 +86,11 @@ public:
    *
    * Throws error if the entropy term has not been fully initialized before
    * calling compute.
+   *
+   * Scratch memory is kept per thread, different entropy terms can be
+   * evaluated on different threads at the same time. The same entropy term
+   * must not be used by two threads at once, compute stores its settings and
+   * descriptors may cache their layout.
    **/
   virtual double compute(const BaseDescriptorWrapper &descriptor_wrapper) = 0;
 
@@ -157,6 +162,20 @@ public:
   compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
                const int desc_ind) = 0;
 
+  /**
+   * Computes the gradiant of the entropy term at the location of the
+   * descriptor given by 'desc_ind' and writes it into grad.
+   *
+   * grad is resized to the number of dimensions, when the same vector is
+   * passed in from one call to the next its memory is reused so repeated
+   * calls do not allocate.
+   *
+   * Throws error if the entropy term has not been fully initialized before
+   * calling compute.
+   **/
+  virtual void compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind, std::vector<double> &grad) = 0;
+
   /**
    * Computes the gradiant of the entropy term at the location of the
    * descriptor given by 'desc_ind'.
@@ -0,0 +1,51 @@
+#ifndef PANACEA_INSTRUMENTATION_H
+#define PANACEA_INSTRUMENTATION_H
+#pragma once
+
+// Standard includes
+#include <cstddef>
+#include <functional>
+#include <iostream>
+
+namespace panacea {
+
+/**
+ * Lightweight instrumentation
+ *
+ * Decisions that PANACEA makes internally for performance reasons are
+ * reported as events. Every event is counted, and if a listener has been
+ * registered it is called with the event and a short description.
+ **/
+namespace instrumentation {
+
+enum class Event {
+  // Descriptors were accessed in their own layout
+  LayoutInPlace,
+  // A point major copy of dimension major descriptors was created
+  LayoutPointMajorBuilt
+};
+
+using Listener = std::function<void(const Event, const char *description)>;
+
+/**
+ * Register a listener, replaces any existing listener. Pass an empty
+ * function to remove it.
+ **/
+void setListener(Listener listener);
+
+void record(const Event event, const char *description);
+
+/**
+ * Number of times the event has been recorded since the last reset
+ **/
+std::size_t count(const Event event) noexcept;
+
+void reset() noexcept;
+
+} // namespace instrumentation
+
+std::ostream &operator<<(std::ostream &os, const instrumentation::Event &);
+
+} // namespace panacea
+
+#endif // PANACEA_INSTRUMENTATION_H
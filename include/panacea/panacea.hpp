@@ -4,12 +4,18 @@
 #pragma once
 
 // Public PANACEA includes
+#include "base_descriptor_summary.hpp"
+#include "checkpoint_log.hpp"
+#include "checkpoint_writer.hpp"
+#include "descriptor_stream_reader.hpp"
 #include "file_io.hpp"
 #include "settings.hpp"
 
 // Standard includes
 #include <any>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace panacea {
 
@@ -29,6 +35,32 @@ public:
   std::unique_ptr<BaseDescriptorWrapper> wrap(std::any, const int rows,
                                               const int cols) const;
 
+  /**
+   * Wraps a binary descriptor file without loading it into memory.
+   *
+   * The file, written with FileType::BinaryDescriptors, is memory mapped and
+   * the operating system pages the descriptors in as they are accessed. This
+   * allows descriptor sets that are larger than the available memory to be
+   * used, e.g. as the reference descriptors of a cross entropy term when the
+   * kernel memory is shared.
+   **/
+  std::unique_ptr<BaseDescriptorWrapper>
+  wrap(const std::string &binary_descriptor_file) const;
+
+  /**
+   * Wraps descriptors in compressed sparse row format, the data is moved
+   * into the wrapper.
+   *
+   * Each row is a descriptor point, the non zero values of row r are
+   * values[row_offsets[r]] to values[row_offsets[r + 1] - 1] and col_indices
+   * holds the dimension of each value in increasing order. Zero entries are
+   * not stored and are skipped when the covariance matrix, normalization
+   * coefficients and uncorrelated Gaussian kernels are evaluated.
+   **/
+  std::unique_ptr<BaseDescriptorWrapper>
+  wrapSparse(const int rows, const int cols, std::vector<int> row_offsets,
+             std::vector<int> col_indices, std::vector<double> values) const;
+
   /**
    * Method will fully initialize an entropy term.
    *
@@ -56,9 +88,69 @@ public:
    **/
   std::unique_ptr<EntropyTerm> create(const PANACEASettings &settings) const;
 
-  std::unique_ptr<EntropyTerm> create(const std::string &file_name) const;
+  /**
+   * Creates an entropy term from a restart file or checkpoint log.
+   *
+   * The type of the file, txt or binary, and the settings of the entropy
+   * term are read from the file. With RestartLoading::Lazy only the settings
+   * and statistics are read here, enough to query the dimensions of the
+   * term, while the kernels are read the first time the term is evaluated,
+   * updated or written. The file must not change until then.
+   **/
+  std::unique_ptr<EntropyTerm>
+  create(const std::string &file_name,
+         const settings::RestartLoading restart_loading =
+             settings::RestartLoading::Eager) const;
 
   std::unique_ptr<io::FileIO> create(const settings::FileType) const;
+
+  /**
+   * Descriptor file whose writes are accompanied by a sidecar, e.g. a
+   * summary that can be merged with the summaries of other descriptor files
+   * without reading the descriptors.
+   **/
+  std::unique_ptr<io::FileIO>
+  create(const settings::FileType, const settings::DescriptorSidecar) const;
+
+  /**
+   * Reads and merges the summary sidecars of many descriptor files, e.g. to
+   * normalize the descriptors of all the files without reading any of them.
+   **/
+  std::unique_ptr<BaseDescriptorSummary>
+  mergeSummaries(const std::vector<std::string> &summary_files) const;
+
+  /**
+   * Creates a writer that writes restart files on a background thread.
+   *
+   * Only TXTRestart and BinaryRestart are supported. Kernels owned by the
+   * entropy terms are held on to rather than serialized before write
+   * returns.
+   **/
+  std::unique_ptr<io::CheckpointWriter>
+  createCheckpointWriter(const settings::FileType) const;
+
+  /**
+   * Creates a log that appends a record per checkpoint to the file, the
+   * records after the first only hold the kernels added since the previous
+   * one.
+   *
+   * Only TXTRestart and BinaryRestart are supported.
+   **/
+  std::unique_ptr<io::CheckpointLog>
+  createCheckpointLog(const settings::FileType,
+                      const std::string &file_name) const;
+
+  /**
+   * Creates a reader that passes the descriptors of a file on a chunk of
+   * chunk_rows points at a time, e.g. to update an entropy term from a file
+   * too large to be loaded at once.
+   *
+   * Only TXTDescriptors with the points along the rows are supported.
+   **/
+  std::unique_ptr<io::DescriptorStreamReader>
+  createDescriptorStreamReader(const settings::FileType,
+                               const std::string &file_name,
+                               const int chunk_rows) const;
 };
 
 }; // namespace panacea
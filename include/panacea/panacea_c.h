@@ -0,0 +1,197 @@
+
+#ifndef PANACEA_C_H
+#define PANACEA_C_H
+
+/*
+ * C interface to PANACEA
+ *
+ * Allows codes that cannot use the C++ interface, e.g. Fortran through
+ * iso_c_binding or Python through ctypes, to call the library directly
+ * instead of exchanging descriptor and restart files.
+ *
+ * Every object is an opaque handle created by a panacea_*_create or
+ * panacea_descriptors_wrap function and released with the matching
+ * panacea_*_destroy function, destroying a null handle does nothing.
+ *
+ * Functions that can fail return PANACEA_SUCCESS or PANACEA_FAILURE, in the
+ * latter case panacea_last_error describes what went wrong. Handles are not
+ * thread safe, the error message is kept per thread.
+ *
+ * Enumerator values are part of the interface and will not change.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct panacea_descriptors panacea_descriptors;
+typedef struct panacea_settings panacea_settings;
+typedef struct panacea_entropy_term panacea_entropy_term;
+
+enum { PANACEA_SUCCESS = 0, PANACEA_FAILURE = 1 };
+
+/*
+ * How the values of a descriptor array are stored in memory.
+ *
+ * PANACEA_POINT_MAJOR - the dimensions of each point are contiguous, a C or
+ * NumPy array [points][dimensions] or a Fortran array (dimensions, points)
+ * PANACEA_DIMENSION_MAJOR - the points of each dimension are contiguous, a C
+ * array [dimensions][points] or a Fortran array (points, dimensions)
+ */
+typedef enum {
+  PANACEA_POINT_MAJOR = 0,
+  PANACEA_DIMENSION_MAJOR = 1
+} panacea_layout;
+
+typedef enum { PANACEA_SELF = 0, PANACEA_CROSS = 1 } panacea_entropy_type;
+
+typedef enum { PANACEA_STRICT = 0, PANACEA_FLEXIBLE = 1 } panacea_algorithm;
+
+typedef enum {
+  PANACEA_GAUSSIAN = 0,
+  PANACEA_GAUSSIAN_LOG = 1,
+  PANACEA_EXPONENTIAL = 2
+} panacea_kernel_primitive;
+
+typedef enum {
+  PANACEA_SINGLE = 0,
+  PANACEA_ONE_TO_ONE = 1,
+  PANACEA_FIXED = 2
+} panacea_kernel_count;
+
+typedef enum {
+  PANACEA_CORRELATED = 0,
+  PANACEA_UNCORRELATED = 1
+} panacea_kernel_correlation;
+
+typedef enum {
+  PANACEA_CENTER_NONE = 0,
+  PANACEA_CENTER_MEAN = 1,
+  PANACEA_CENTER_MEDIAN = 2,
+  PANACEA_CENTER_STREAMING_MEDIAN = 3
+} panacea_kernel_center;
+
+typedef enum {
+  PANACEA_NORMALIZATION_NONE = 0,
+  PANACEA_NORMALIZATION_VARIANCE = 1
+} panacea_kernel_normalization;
+
+typedef enum {
+  PANACEA_TXT_RESTART = 0,
+  PANACEA_BINARY_RESTART = 1
+} panacea_restart_type;
+
+typedef enum {
+  PANACEA_EAGER = 0,
+  PANACEA_LAZY = 1
+} panacea_restart_loading;
+
+/*
+ * Message of the last call on this thread that returned PANACEA_FAILURE,
+ * an empty string if there was none. Valid until the next failing call.
+ */
+const char *panacea_last_error(void);
+
+/*
+ * Wraps number_points * number_dimensions values owned by the caller without
+ * copying them.
+ *
+ * The values must outlive the handle and every entropy term created or
+ * updated from it whose kernels share the descriptors, which is the default
+ * for self entropy terms. The values may be changed in place between calls,
+ * numerical gradients temporarily modify them and restore them afterwards.
+ */
+int panacea_descriptors_wrap(double *data, int number_points,
+                             int number_dimensions, panacea_layout layout,
+                             panacea_descriptors **descriptors);
+void panacea_descriptors_destroy(panacea_descriptors *descriptors);
+
+/*
+ * Writes the descriptors to a binary descriptor file, a 64 byte header
+ * followed by the values, that PANACEA can memory map and numpy.memmap can
+ * open with an offset of 64 bytes.
+ */
+int panacea_descriptors_write(const panacea_descriptors *descriptors,
+                              const char *file_name);
+
+/*
+ * Settings of an entropy term using a kernel distribution, created with
+ * flexible, one to one, uncorrelated Gaussian kernels that are neither
+ * centered nor normalized.
+ */
+int panacea_settings_create(panacea_entropy_type type,
+                            panacea_settings **settings);
+void panacea_settings_destroy(panacea_settings *settings);
+
+int panacea_settings_set_algorithm(panacea_settings *settings,
+                                   panacea_algorithm algorithm);
+int panacea_settings_set_kernel_primitive(panacea_settings *settings,
+                                          panacea_kernel_primitive primitive);
+int panacea_settings_set_kernel_count(panacea_settings *settings,
+                                      panacea_kernel_count count);
+int panacea_settings_set_kernel_correlation(
+    panacea_settings *settings, panacea_kernel_correlation correlation);
+int panacea_settings_set_kernel_center(panacea_settings *settings,
+                                       panacea_kernel_center center);
+int panacea_settings_set_kernel_normalization(
+    panacea_settings *settings, panacea_kernel_normalization normalization);
+int panacea_settings_set_weight(panacea_settings *settings, double weight);
+int panacea_settings_set_numerical_grad(panacea_settings *settings, int on);
+
+/*
+ * Creates and initializes an entropy term from the descriptors.
+ */
+int panacea_entropy_term_create(const panacea_descriptors *descriptors,
+                                const panacea_settings *settings,
+                                panacea_entropy_term **entropy_term);
+
+/*
+ * Creates an entropy term from a restart file or checkpoint log.
+ */
+int panacea_entropy_term_create_from_restart(
+    const char *file_name, panacea_restart_loading loading,
+    panacea_entropy_term **entropy_term);
+
+void panacea_entropy_term_destroy(panacea_entropy_term *entropy_term);
+
+/*
+ * Number of dimensions the entropy term uses, the size of the gradient.
+ */
+int panacea_entropy_term_dimensions(const panacea_entropy_term *entropy_term,
+                                    int *number_dimensions);
+
+int panacea_entropy_term_update(panacea_entropy_term *entropy_term,
+                                const panacea_descriptors *descriptors);
+
+/*
+ * Entropy of all the descriptor points.
+ */
+int panacea_entropy_term_compute(panacea_entropy_term *entropy_term,
+                                 const panacea_descriptors *descriptors,
+                                 double *entropy);
+
+/*
+ * Entropy of a single descriptor point.
+ */
+int panacea_entropy_term_compute_point(panacea_entropy_term *entropy_term,
+                                       const panacea_descriptors *descriptors,
+                                       int point, double *entropy);
+
+/*
+ * Gradient of the entropy with respect to the dimensions of a descriptor
+ * point, written to grad which must hold at least grad_size values.
+ * grad_size must be at least panacea_entropy_term_dimensions.
+ */
+int panacea_entropy_term_compute_grad(panacea_entropy_term *entropy_term,
+                                      const panacea_descriptors *descriptors,
+                                      int point, double *grad, int grad_size);
+
+int panacea_entropy_term_write_restart(
+    const panacea_entropy_term *entropy_term, panacea_restart_type type,
+    const char *file_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PANACEA_C_H */
@@ -3,6 +3,7 @@
 #pragma once
 
 // Standard includes
+#include <iostream>
 #include <optional>
 #include <type_traits>
 
@@ -16,7 +17,13 @@ namespace settings {
 
 enum class DistributionType { Histogram, Kernel };
 
-enum class FileType { TXTRestart, TXTDescriptors, TXTKernelDistribution };
+enum class FileType {
+  TXTRestart,
+  TXTDescriptors,
+  TXTKernelDistribution,
+  BinaryDescriptors,
+  BinaryRestart
+};
 
 class Kernel {};
 const Kernel kernel = Kernel();
@@ -61,11 +68,55 @@ enum class KernelCenterCalculation {
   None,
   Mean,
   Median,
+  StreamingMedian,
 };
 
 enum class RandomizeDimensions { Yes, No };
 
 enum class RandomizeNumberDimensions { Yes, No };
+
+/**
+ * Whether entropy terms evaluate descriptors whose dimensions are along the
+ * rows from a copy of their values with the points along the rows.
+ *
+ * None - the descriptors are always accessed in place
+ * PointMajor - a point major copy is created at the start of each compute
+ * call and discarded before it returns
+ **/
+enum class LayoutCache { None, PointMajor };
+
+/**
+ * How the statistics of a kernel distribution, the mean kernel center, the
+ * covariance matrix and the normalization coefficients, combine the
+ * descriptors of an update with the descriptors already seen.
+ *
+ * Cumulative - every descriptor ever seen carries the same weight
+ * ExponentialDecay - the weight of the descriptors already seen is multiplied
+ * by a forgetting factor before each update
+ * SlidingWindow - only the descriptors of the most recent updates are kept
+ **/
+enum class UpdateMode { Cumulative, ExponentialDecay, SlidingWindow };
+
+/**
+ * When an entropy term created from a restart file reads its kernels.
+ *
+ * Eager - everything is read when the entropy term is created
+ * Lazy - the settings and statistics are read when the entropy term is
+ * created, the kernels are read and the primitives constructed the first
+ * time the entropy term is evaluated or updated
+ **/
+enum class RestartLoading { Eager, Lazy };
+
+/**
+ * What is written next to each descriptor file.
+ *
+ * None - only the descriptor file is written
+ * Summary - a summary of the descriptors, their number, the minimum,
+ * maximum, mean and co-moments of each dimension and a coarse histogram of
+ * each dimension, is written to the descriptor file name + ".summary". The
+ * summaries of many files can be merged without reading the descriptors.
+ **/
+enum class DescriptorSidecar { None, Summary };
 } // namespace settings
 
 std::ostream &operator<<(std::ostream &os, const settings::DistributionType &);
@@ -84,6 +135,10 @@ std::ostream &operator<<(std::ostream &os,
                          const settings::RandomizeDimensions &);
 std::ostream &operator<<(std::ostream &os,
                          const settings::RandomizeNumberDimensions &);
+std::ostream &operator<<(std::ostream &os, const settings::LayoutCache &);
+std::ostream &operator<<(std::ostream &os, const settings::UpdateMode &);
+std::ostream &operator<<(std::ostream &os, const settings::RestartLoading &);
+std::ostream &operator<<(std::ostream &os, const settings::DescriptorSidecar &);
 
 std::istream &operator>>(std::istream &is, settings::DistributionType &);
 std::istream &operator>>(std::istream &is, settings::FileType &);
@@ -98,6 +153,10 @@ std::istream &operator>>(std::istream &is, settings::KernelCenterCalculation &);
 std::istream &operator>>(std::istream &is, settings::RandomizeDimensions &);
 std::istream &operator>>(std::istream &is,
                          settings::RandomizeNumberDimensions &);
+std::istream &operator>>(std::istream &is, settings::LayoutCache &);
+std::istream &operator>>(std::istream &is, settings::UpdateMode &);
+std::istream &operator>>(std::istream &is, settings::RestartLoading &);
+std::istream &operator>>(std::istream &is, settings::DescriptorSidecar &);
 
 class PANACEASettingsBuilder;
 
@@ -120,6 +179,14 @@ public:
     return max_number_dimensions_;
   }
 
+  std::optional<double> getForgettingFactor() const noexcept {
+    return forgetting_factor_;
+  }
+
+  std::optional<int> getUpdateWindow() const noexcept {
+    return update_window_;
+  }
+
   template <class T> std::optional<T> get() const noexcept {
     if constexpr (std::is_same<settings::EntropyType, T>::value) {
       return ent_type_;
@@ -145,6 +212,8 @@ public:
     } else if constexpr (std::is_same<settings::RandomizeNumberDimensions,
                                       T>::value) {
       return randomize_number_dimensions_;
+    } else if constexpr (std::is_same<settings::UpdateMode, T>::value) {
+      return update_mode_;
     }
   }
 
@@ -167,6 +236,9 @@ private:
   std::optional<settings::RandomizeDimensions> randomize_dimensions_;
   std::optional<settings::RandomizeNumberDimensions>
       randomize_number_dimensions_;
+  std::optional<settings::UpdateMode> update_mode_;
+  std::optional<double> forgetting_factor_;
+  std::optional<int> update_window_;
 };
 
 class PANACEASettingsBuilder {
@@ -193,6 +265,18 @@ public:
   PANACEASettingsBuilder &set(const settings::KernelNormalization &);
   PANACEASettingsBuilder &set(const settings::RandomizeDimensions &);
   PANACEASettingsBuilder &set(const settings::RandomizeNumberDimensions &);
+  PANACEASettingsBuilder &set(const settings::UpdateMode &);
+
+  /**
+   * Only used with UpdateMode::ExponentialDecay, must be in the range (0, 1]
+   **/
+  PANACEASettingsBuilder &setForgettingFactorTo(const double &factor);
+
+  /**
+   * Only used with UpdateMode::SlidingWindow, the number of most recent
+   * updates whose descriptors are kept, must be positive
+   **/
+  PANACEASettingsBuilder &setUpdateWindowTo(const int &number_updates);
 
   operator PANACEASettings &&() {
     return std::move(ent_settings_); // notice the move
@@ -89,9 +89,15 @@ class MinMaxDescCache:
                     index = index + 1
                 line_num = line_num + 1
 
-    def createCache(self, all_descriptors):
-        self.__min_vals = all_descriptors.min(axis=0)
-        self.__max_vals = all_descriptors.max(axis=0)
+    def createCache(self, all_descriptors, summary=None):
+        """The min and max values are taken from the merged summary sidecars
+        of the descriptor files when available"""
+        if summary is not None:
+            self.__min_vals = summary.min_vals.copy()
+            self.__max_vals = summary.max_vals.copy()
+        else:
+            self.__min_vals = all_descriptors.min(axis=0)
+            self.__max_vals = all_descriptors.max(axis=0)
         self.__ndim = all_descriptors.shape[1]
         self.__den_val = np.zeros(int((self.__ndim * self.__ndim - self.__ndim) / 2.0))
         self.__bin_widths = np.subtract(
@@ -150,10 +156,14 @@ class MinMaxDescCache:
                     index = index + 1
         self.__writeCache()
 
-    def consolidateCache(self, all_descriptors):
+    def consolidateCache(self, all_descriptors, summary=None):
         """Update the min and max values with a new set"""
-        min_vals_new_batch = all_descriptors.min(axis=0)
-        max_vals_new_batch = all_descriptors.max(axis=0)
+        if summary is not None:
+            min_vals_new_batch = summary.min_vals
+            max_vals_new_batch = summary.max_vals
+        else:
+            min_vals_new_batch = all_descriptors.min(axis=0)
+            max_vals_new_batch = all_descriptors.max(axis=0)
 
         self.__readCache()
 
@@ -215,6 +225,19 @@ class MinMaxDescCache:
         return self.__bin_widths
 
 
+def readSummaries(desc_file_grp, num_files):
+    """Merged summary sidecars, descriptor files written with
+    settings::DescriptorSidecar::Summary, None unless every file has one"""
+    summary = desc_file_grp.readSummaries(0, num_files)
+    if summary is not None:
+        print(
+            "Min and max values read from the summaries of {} points".format(
+                summary.number_points
+            )
+        )
+    return summary
+
+
 def main(**kwargs):
     path = kwargs.pop("path")
     file_name = kwargs.pop("file")
@@ -246,7 +269,7 @@ def main(**kwargs):
         )
         desc_file_grp.read(0, num_files)
         all_descriptors = desc_file_grp.descriptors
-        cache.createCache(all_descriptors)
+        cache.createCache(all_descriptors, readSummaries(desc_file_grp, num_files))
     elif consolidate:
         # descriptor_files = read_all_descriptors.ReadAllDescriptors(num_files)
         desc_file_grp = panacea.descriptor_file_group.DescriptorFileGroup(
@@ -258,7 +281,7 @@ def main(**kwargs):
         all_descriptors = desc_file_grp.descriptors
 
         cache = MinMaxDescCache(path_and_file_name, num_bins)
-        cache.consolidateCache(all_descriptors)
+        cache.consolidateCache(all_descriptors, readSummaries(desc_file_grp, num_files))
 
     read = kwargs.pop("read")
     if read:
@@ -310,7 +333,9 @@ if __name__ == "__main__":
         "Descriptor files extension.\nDescriptor files are named with the following format\n"
         "base + index + extension\nFor example descriptors1.txt\n"
         "base = descriptors\nindex = 1\nextension = .txt\n"
-        "By default the extension is assumed to be .txt"
+        "By default the extension is assumed to be .txt\n"
+        "Binary descriptor files, e.g. descriptors1.bin, are detected from their "
+        "header and read directly into memory"
     )
     parser.add_argument("--desc_ext", "-de", nargs=1, default=[".txt"], help=desc)
 
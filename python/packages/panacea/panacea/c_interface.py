@@ -0,0 +1,337 @@
+#!/usr/bin/python3
+
+import ctypes
+import ctypes.util
+import os
+
+import numpy as np
+
+# Values of the enumerators in panacea_c.h
+SUCCESS = 0
+
+POINT_MAJOR = 0
+DIMENSION_MAJOR = 1
+
+SELF = 0
+CROSS = 1
+
+STRICT = 0
+FLEXIBLE = 1
+
+GAUSSIAN = 0
+GAUSSIAN_LOG = 1
+EXPONENTIAL = 2
+
+SINGLE = 0
+ONE_TO_ONE = 1
+FIXED = 2
+
+CORRELATED = 0
+UNCORRELATED = 1
+
+CENTER_NONE = 0
+CENTER_MEAN = 1
+CENTER_MEDIAN = 2
+CENTER_STREAMING_MEDIAN = 3
+
+NORMALIZATION_NONE = 0
+NORMALIZATION_VARIANCE = 1
+
+TXT_RESTART = 0
+BINARY_RESTART = 1
+
+EAGER = 0
+LAZY = 1
+
+_double_p = ctypes.POINTER(ctypes.c_double)
+_int_p = ctypes.POINTER(ctypes.c_int)
+_handle = ctypes.c_void_p
+_handle_p = ctypes.POINTER(ctypes.c_void_p)
+
+_signatures = {
+    "panacea_last_error": (ctypes.c_char_p, []),
+    "panacea_descriptors_wrap": (
+        ctypes.c_int,
+        [_double_p, ctypes.c_int, ctypes.c_int, ctypes.c_int, _handle_p],
+    ),
+    "panacea_descriptors_destroy": (None, [_handle]),
+    "panacea_descriptors_write": (ctypes.c_int, [_handle, ctypes.c_char_p]),
+    "panacea_settings_create": (ctypes.c_int, [ctypes.c_int, _handle_p]),
+    "panacea_settings_destroy": (None, [_handle]),
+    "panacea_settings_set_algorithm": (ctypes.c_int, [_handle, ctypes.c_int]),
+    "panacea_settings_set_kernel_primitive": (
+        ctypes.c_int,
+        [_handle, ctypes.c_int],
+    ),
+    "panacea_settings_set_kernel_count": (ctypes.c_int, [_handle, ctypes.c_int]),
+    "panacea_settings_set_kernel_correlation": (
+        ctypes.c_int,
+        [_handle, ctypes.c_int],
+    ),
+    "panacea_settings_set_kernel_center": (ctypes.c_int, [_handle, ctypes.c_int]),
+    "panacea_settings_set_kernel_normalization": (
+        ctypes.c_int,
+        [_handle, ctypes.c_int],
+    ),
+    "panacea_settings_set_weight": (ctypes.c_int, [_handle, ctypes.c_double]),
+    "panacea_settings_set_numerical_grad": (ctypes.c_int, [_handle, ctypes.c_int]),
+    "panacea_entropy_term_create": (ctypes.c_int, [_handle, _handle, _handle_p]),
+    "panacea_entropy_term_create_from_restart": (
+        ctypes.c_int,
+        [ctypes.c_char_p, ctypes.c_int, _handle_p],
+    ),
+    "panacea_entropy_term_destroy": (None, [_handle]),
+    "panacea_entropy_term_dimensions": (ctypes.c_int, [_handle, _int_p]),
+    "panacea_entropy_term_update": (ctypes.c_int, [_handle, _handle]),
+    "panacea_entropy_term_compute": (ctypes.c_int, [_handle, _handle, _double_p]),
+    "panacea_entropy_term_compute_point": (
+        ctypes.c_int,
+        [_handle, _handle, ctypes.c_int, _double_p],
+    ),
+    "panacea_entropy_term_compute_grad": (
+        ctypes.c_int,
+        [_handle, _handle, ctypes.c_int, _double_p, ctypes.c_int],
+    ),
+    "panacea_entropy_term_write_restart": (
+        ctypes.c_int,
+        [_handle, ctypes.c_int, ctypes.c_char_p],
+    ),
+}
+
+_library = None
+
+
+def findLibrary():
+    """Path of the PANACEA shared library, the PANACEA_LIBRARY environment
+    variable takes precedence over the library search path."""
+    path = os.environ.get("PANACEA_LIBRARY")
+    if path:
+        return path
+    return ctypes.util.find_library("panacea")
+
+
+def library():
+    """Loads the PANACEA shared library the first time it is needed."""
+    global _library
+    if _library is None:
+        path = findLibrary()
+        if path is None:
+            raise Exception(
+                "Unable to find the PANACEA library, set PANACEA_LIBRARY to its path"
+            )
+        lib = ctypes.CDLL(path)
+        for name, (restype, argtypes) in _signatures.items():
+            function = getattr(lib, name)
+            function.restype = restype
+            function.argtypes = argtypes
+        _library = lib
+    return _library
+
+
+def _check(status):
+    if status != SUCCESS:
+        raise Exception(library().panacea_last_error().decode())
+
+
+class Descriptors:
+    """Wraps a 2d float64 NumPy array of points by dimensions without copying
+    it.
+
+    The array must be C or Fortran contiguous, a reference is kept so the
+    memory stays valid for as long as the descriptors exist. Values changed
+    in the array are seen by the next call.
+    """
+
+    def __init__(self, array):
+        if not isinstance(array, np.ndarray) or array.ndim != 2:
+            raise Exception("Descriptors must be a 2d NumPy array")
+        if array.dtype != np.float64:
+            raise Exception("Descriptors must be of type float64")
+        if array.flags["C_CONTIGUOUS"]:
+            layout = POINT_MAJOR
+        elif array.flags["F_CONTIGUOUS"]:
+            layout = DIMENSION_MAJOR
+        else:
+            raise Exception("Descriptors must be C or Fortran contiguous")
+        self.__array = array
+        self.__handle = ctypes.c_void_p()
+        _check(
+            library().panacea_descriptors_wrap(
+                array.ctypes.data_as(_double_p),
+                array.shape[0],
+                array.shape[1],
+                layout,
+                ctypes.byref(self.__handle),
+            )
+        )
+
+    def __del__(self):
+        if getattr(self, "_Descriptors__handle", None) and _library is not None:
+            _library.panacea_descriptors_destroy(self.__handle)
+
+    @property
+    def array(self):
+        return self.__array
+
+    def write(self, file_name):
+        """Writes a binary descriptor file, see read_descriptors"""
+        _check(library().panacea_descriptors_write(self.__handle, file_name.encode()))
+
+    @property
+    def handle(self):
+        return self.__handle
+
+
+class Settings:
+    """Settings of an entropy term using a kernel distribution, defaults to
+    flexible, one to one, uncorrelated Gaussian kernels."""
+
+    def __init__(self, entropy_type=SELF):
+        self.__handle = ctypes.c_void_p()
+        _check(
+            library().panacea_settings_create(entropy_type, ctypes.byref(self.__handle))
+        )
+
+    def __del__(self):
+        if getattr(self, "_Settings__handle", None) and _library is not None:
+            _library.panacea_settings_destroy(self.__handle)
+
+    @property
+    def handle(self):
+        return self.__handle
+
+    def setAlgorithm(self, algorithm):
+        _check(library().panacea_settings_set_algorithm(self.__handle, algorithm))
+        return self
+
+    def setKernelPrimitive(self, primitive):
+        _check(
+            library().panacea_settings_set_kernel_primitive(self.__handle, primitive)
+        )
+        return self
+
+    def setKernelCount(self, count):
+        _check(library().panacea_settings_set_kernel_count(self.__handle, count))
+        return self
+
+    def setKernelCorrelation(self, correlation):
+        _check(
+            library().panacea_settings_set_kernel_correlation(
+                self.__handle, correlation
+            )
+        )
+        return self
+
+    def setKernelCenter(self, center):
+        _check(library().panacea_settings_set_kernel_center(self.__handle, center))
+        return self
+
+    def setKernelNormalization(self, normalization):
+        _check(
+            library().panacea_settings_set_kernel_normalization(
+                self.__handle, normalization
+            )
+        )
+        return self
+
+    def setWeight(self, weight):
+        _check(library().panacea_settings_set_weight(self.__handle, weight))
+        return self
+
+    def setNumericalGrad(self, on):
+        _check(library().panacea_settings_set_numerical_grad(self.__handle, int(on)))
+        return self
+
+
+class EntropyTerm:
+    """Entropy term created from descriptors and settings or read from a
+    restart file."""
+
+    def __init__(
+        self, descriptors=None, settings=None, restart_file=None, loading=EAGER
+    ):
+        self.__handle = ctypes.c_void_p()
+        # Self entropy kernels may share the descriptors, keep them alive
+        self.__descriptors = descriptors
+        if restart_file is not None:
+            _check(
+                library().panacea_entropy_term_create_from_restart(
+                    restart_file.encode(), loading, ctypes.byref(self.__handle)
+                )
+            )
+        elif descriptors is not None and settings is not None:
+            _check(
+                library().panacea_entropy_term_create(
+                    descriptors.handle, settings.handle, ctypes.byref(self.__handle)
+                )
+            )
+        else:
+            raise Exception(
+                "An entropy term requires descriptors and settings or a restart file"
+            )
+
+    def __del__(self):
+        if getattr(self, "_EntropyTerm__handle", None) and _library is not None:
+            _library.panacea_entropy_term_destroy(self.__handle)
+
+    @property
+    def dimensions(self):
+        dims = ctypes.c_int()
+        _check(
+            library().panacea_entropy_term_dimensions(self.__handle, ctypes.byref(dims))
+        )
+        return dims.value
+
+    def update(self, descriptors):
+        _check(library().panacea_entropy_term_update(self.__handle, descriptors.handle))
+        self.__descriptors = descriptors
+
+    def compute(self, descriptors, point=None):
+        entropy = ctypes.c_double()
+        if point is None:
+            _check(
+                library().panacea_entropy_term_compute(
+                    self.__handle, descriptors.handle, ctypes.byref(entropy)
+                )
+            )
+        else:
+            _check(
+                library().panacea_entropy_term_compute_point(
+                    self.__handle, descriptors.handle, point, ctypes.byref(entropy)
+                )
+            )
+        return entropy.value
+
+    def computeGrad(self, descriptors, point, grad=None):
+        """Gradient at a descriptor point, written into grad if a float64
+        array is provided so repeated calls do not allocate."""
+        dims = descriptors.array.shape[1]
+        if grad is None:
+            grad = np.zeros(dims)
+        elif (
+            grad.dtype != np.float64
+            or not grad.flags["C_CONTIGUOUS"]
+            or grad.size < dims
+        ):
+            raise Exception(
+                "Gradient buffer must be a contiguous float64 array of at least {} values".format(
+                    dims
+                )
+            )
+        _check(
+            library().panacea_entropy_term_compute_grad(
+                self.__handle,
+                descriptors.handle,
+                point,
+                grad.ctypes.data_as(_double_p),
+                grad.size,
+            )
+        )
+        return grad
+
+    def write(self, file_name, restart_type=TXT_RESTART):
+        _check(
+            library().panacea_entropy_term_write_restart(
+                self.__handle, restart_type, file_name.encode()
+            )
+        )
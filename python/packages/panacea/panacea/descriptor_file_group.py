@@ -1,9 +1,13 @@
+import panacea.descriptor_summary
 import panacea.read_descriptors
 import panacea.read_files
 
 import numpy as np
+import os
 
-# Class provides a means of reading multiple descriptor files
+
+# Class provides a means of reading multiple descriptor files, the files can be
+# txt or binary descriptor files
 class DescriptorFileGroup:
     def __init__(self, path_to_files, base, extension):
         self.__file_grp_reader = panacea.read_files.ReadFiles(
@@ -46,6 +50,24 @@ class DescriptorFileGroup:
                 axis=0
             )
 
+    # Merges the summary sidecars of the files in the index range without
+    # reading the descriptors, returns None if any of the files lacks one
+    def readSummaries(self, index_start=0, index_end=None):
+        summary_files = []
+        for file_path in self.__file_grp_reader.full_file_paths:
+            index = panacea.read_files.getIndex(
+                os.path.basename(file_path), self.__file_grp_reader.base
+            )
+            if index < index_start or (index_end is not None and index >= index_end):
+                continue
+            summary_file = panacea.descriptor_summary.summaryFileName(file_path)
+            if not os.path.isfile(summary_file):
+                return None
+            summary_files.append(summary_file)
+        if len(summary_files) == 0:
+            return None
+        return panacea.descriptor_summary.mergeDescriptorSummaries(summary_files)
+
     def __getitem__(self, file_name_or_index):
         return self.__file_grp_reader[file_name_or_index]
 
@@ -64,13 +86,12 @@ class DescriptorFileGroup:
     # All descriptors in a single numpy array
     @property
     def descriptors(self):
-        all_descriptors = np.zeros((self.__total_descriptors, self.__dims))
-        index = 0
-        for file_name in self.__file_grp_reader.files_read:
-            local_descriptors = self.__file_grp_reader[file_name].descriptors
-            rows, cols = local_descriptors.shape
-            for row in range(0, rows):
-                for col in range(0, cols):
-                    all_descriptors[index, col] = local_descriptors[row, col]
-                index = index + 1
-        return all_descriptors
+        if len(self.__file_grp_reader.files_read) == 0:
+            return np.zeros((0, self.__dims))
+        return np.concatenate(
+            [
+                self.__file_grp_reader[file_name].descriptors
+                for file_name in self.__file_grp_reader.files_read
+            ],
+            axis=0,
+        )
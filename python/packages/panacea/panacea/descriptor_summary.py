@@ -0,0 +1,216 @@
+import numpy as np
+
+# Summaries written next to descriptor files by PANACEA with
+# settings::DescriptorSidecar::Summary, see DescriptorSummary in
+# descriptor_summary.hpp. A summary holds the number of points and the mean,
+# min, max and co-moments of every dimension along with a histogram of every
+# dimension, so the summaries of many descriptor files can be merged without
+# reading the descriptors.
+
+
+def summaryFileName(descriptor_file):
+    return descriptor_file + ".summary"
+
+
+def nextLine(fid, file_name):
+    line = fid.readline()
+    if line == "":
+        raise Exception("Unexpected end of descriptor summary {}".format(file_name))
+    return line
+
+
+def findTag(fid, tag, file_name):
+    while True:
+        line = fid.readline()
+        if line == "":
+            raise Exception(
+                "Missing {} tag while reading descriptor summary {}".format(
+                    tag, file_name
+                )
+            )
+        if tag in line:
+            return
+
+
+class DescriptorSummary:
+    def __init__(self):
+        self.__points = 0
+        self.__weight = 0.0
+        self.__mean = np.zeros(0)
+        self.__min_vals = np.zeros(0)
+        self.__max_vals = np.zeros(0)
+        # Only the upper triangle is filled, as in the file
+        self.__co_moments = np.zeros((0, 0))
+        self.__histograms = np.zeros((0, 0))
+
+    def read(self, file_name):
+        with open(file_name, "r") as fid:
+            findTag(fid, "[Descriptor Summary]", file_name)
+            words = nextLine(fid, file_name).split()
+            if len(words) != 4 or words[0] != "Full":
+                raise Exception(
+                    "Descriptor summary {} must hold the full moments".format(file_name)
+                )
+            dims = int(words[1])
+            self.__points = int(words[2])
+            self.__weight = float(words[3])
+            values = []
+            for count in (dims, dims, dims, dims * dims):
+                row = np.array(nextLine(fid, file_name).split(), dtype=float)
+                if len(row) != count:
+                    raise Exception(
+                        "Unable to read the statistics of descriptor "
+                        "summary {}".format(file_name)
+                    )
+                values.append(row)
+            self.__mean, self.__min_vals, self.__max_vals = values[0:3]
+            self.__co_moments = values[3].reshape(dims, dims)
+
+            findTag(fid, "[Histograms]", file_name)
+            bins = int(nextLine(fid, file_name))
+            self.__histograms = np.zeros((dims, bins))
+            for dim in range(dims):
+                row = np.array(nextLine(fid, file_name).split(), dtype=float)
+                if len(row) != bins:
+                    raise Exception(
+                        "Unable to read the histograms of descriptor "
+                        "summary {}".format(file_name)
+                    )
+                self.__histograms[dim] = row
+
+    # Histogram of a dimension spread over the same number of bins spanning
+    # [min_val, max_val], the count of each bin is shared among the new bins
+    # it overlaps in proportion to the overlap
+    def __rebin(self, dim, min_val, max_val):
+        bins = self.number_bins
+        rebinned = np.zeros(bins)
+        old_width = self.bin_widths[dim]
+        new_width = (max_val - min_val) / bins
+
+        def binIndex(value):
+            if new_width <= 0.0:
+                return 0
+            return int(np.clip(int((value - min_val) / new_width), 0, bins - 1))
+
+        for old_bin, count in enumerate(self.__histograms[dim]):
+            if count == 0.0:
+                continue
+            lower = self.__min_vals[dim] + old_bin * old_width
+            if old_width <= 0.0 or new_width <= 0.0:
+                rebinned[binIndex(lower)] += count
+                continue
+            upper = lower + old_width
+            for new_bin in range(binIndex(lower), binIndex(upper) + 1):
+                new_lower = min_val + new_bin * new_width
+                overlap = min(upper, new_lower + new_width) - max(lower, new_lower)
+                if overlap > 0.0:
+                    rebinned[new_bin] += count * overlap / old_width
+        return rebinned
+
+    # Combines the summary of a disjoint set of descriptors, the statistics
+    # merge exactly and the histograms are rebinned onto the combined range
+    def merge(self, summary):
+        if summary.number_points == 0:
+            return
+        if self.__points == 0:
+            self.__points = summary.number_points
+            self.__weight = summary.weight
+            self.__mean = summary.mean.copy()
+            self.__min_vals = summary.min_vals.copy()
+            self.__max_vals = summary.max_vals.copy()
+            self.__co_moments = summary.co_moments.copy()
+            self.__histograms = summary.histograms.copy()
+            return
+        if (
+            summary.dimensions != self.dimensions
+            or summary.number_bins != self.number_bins
+        ):
+            raise Exception(
+                "Cannot merge descriptor summaries with different dimensions "
+                "or numbers of histogram bins."
+            )
+
+        min_vals = np.minimum(self.__min_vals, summary.min_vals)
+        max_vals = np.maximum(self.__max_vals, summary.max_vals)
+        histograms = np.zeros(self.__histograms.shape)
+        for dim in range(self.dimensions):
+            histograms[dim] = self.__rebin(
+                dim, min_vals[dim], max_vals[dim]
+            ) + summary.__rebin(dim, min_vals[dim], max_vals[dim])
+
+        weight = self.__weight + summary.weight
+        factor = self.__weight * summary.weight / weight
+        delta = summary.mean - self.__mean
+        self.__co_moments = self.__co_moments + summary.co_moments
+        self.__co_moments += np.triu(np.outer(delta, delta) * factor)
+        self.__mean = self.__mean + delta * summary.weight / weight
+        self.__min_vals = min_vals
+        self.__max_vals = max_vals
+        self.__histograms = histograms
+        self.__points = self.__points + summary.number_points
+        self.__weight = weight
+
+    @property
+    def number_points(self):
+        return self.__points
+
+    @property
+    def weight(self):
+        return self.__weight
+
+    @property
+    def dimensions(self):
+        return len(self.__mean)
+
+    @property
+    def mean(self):
+        return self.__mean
+
+    @property
+    def min_vals(self):
+        return self.__min_vals
+
+    @property
+    def max_vals(self):
+        return self.__max_vals
+
+    @property
+    def co_moments(self):
+        return self.__co_moments
+
+    # Sample variance of every dimension
+    @property
+    def variance(self):
+        if self.__weight <= 1.0:
+            return np.zeros(self.dimensions)
+        return np.diagonal(self.__co_moments) / (self.__weight - 1.0)
+
+    @property
+    def number_bins(self):
+        return self.__histograms.shape[1]
+
+    # Row per dimension, bin b of dimension d spans
+    # [min_vals[d] + b * bin_widths[d], min_vals[d] + (b + 1) * bin_widths[d])
+    @property
+    def histograms(self):
+        return self.__histograms
+
+    @property
+    def bin_widths(self):
+        if self.number_bins == 0:
+            return np.zeros(self.dimensions)
+        return (self.__max_vals - self.__min_vals) / self.number_bins
+
+
+def readDescriptorSummary(file_name):
+    summary = DescriptorSummary()
+    summary.read(file_name)
+    return summary
+
+
+# Reads and merges the summaries of many descriptor files
+def mergeDescriptorSummaries(summary_files):
+    merged = DescriptorSummary()
+    for summary_file in summary_files:
+        merged.merge(readDescriptorSummary(summary_file))
+    return merged
@@ -4,6 +4,20 @@ import matplotlib.pyplot as plt
 import numpy as np
 import copy
 import re
+import struct
+
+# Binary descriptor files, written by PANACEA with FileType::BinaryDescriptors,
+# begin with a fixed size header followed by the raw little endian values, see
+# BinaryArrayHeader in memory_mapped_array.hpp
+binary_magic = b"PANACEA\0"
+binary_header_size = 64
+binary_version = 1
+
+# Enumerator values stored in the header
+binary_float64 = 0
+binary_column_major = 2
+binary_dimensions_along_rows = 1
+
 
 # Helper functions
 def getRowsAndCols(line):
@@ -35,6 +49,89 @@ def getRowsAndCols(line):
     return rows, cols
 
 
+def isBinaryDescriptorFile(file_name):
+    with open(file_name, "rb") as file1:
+        return file1.read(len(binary_magic)) == binary_magic
+
+
+def readBinaryHeader(file_name):
+    """Returns the shape, numpy order and whether the points are along the
+    rows of the array stored in a binary descriptor file."""
+    with open(file_name, "rb") as file1:
+        header = file1.read(binary_header_size)
+    if len(header) != binary_header_size or header[0:8] != binary_magic:
+        raise Exception("{} is not a binary descriptor file".format(file_name))
+    version, data_type, layout, arrangement, rows, cols = struct.unpack(
+        "<IIIIqq", header[8:40]
+    )
+    if version != binary_version:
+        raise Exception(
+            "Unsupported binary descriptor file version {} in {}".format(
+                version, file_name
+            )
+        )
+    if data_type != binary_float64:
+        raise Exception(
+            "Only 64 bit floating point binary descriptor files are supported"
+        )
+    order = "F" if layout == binary_column_major else "C"
+    points_along_rows = arrangement != binary_dimensions_along_rows
+    return (rows, cols), order, points_along_rows
+
+
+def readBinaryDescriptors(file_name, memory_map=False):
+    """Reads a binary descriptor file into an array with the points along the
+    rows.
+
+    If memory_map is True the values are not read, the array is a read only
+    numpy.memmap of the file that is paged in as it is accessed.
+    """
+    shape, order, points_along_rows = readBinaryHeader(file_name)
+    count = shape[0] * shape[1]
+    if memory_map:
+        if count == 0:
+            descriptors = np.zeros(shape, order=order)
+        else:
+            descriptors = np.memmap(
+                file_name,
+                dtype="<f8",
+                mode="r",
+                offset=binary_header_size,
+                shape=shape,
+                order=order,
+            )
+    else:
+        values = np.fromfile(
+            file_name, dtype="<f8", count=count, offset=binary_header_size
+        )
+        if values.size != count:
+            raise Exception(
+                "Binary descriptor file {} is truncated, expected {} values "
+                "but found {}".format(file_name, count, values.size)
+            )
+        descriptors = values.reshape(shape, order=order)
+    if not points_along_rows:
+        descriptors = descriptors.T
+    return descriptors
+
+
+def writeBinaryDescriptors(file_name, descriptors):
+    """Writes a 2d array with the points along the rows to a binary
+    descriptor file that PANACEA can read or memory map."""
+    descriptors = np.ascontiguousarray(descriptors, dtype="<f8")
+    if descriptors.ndim != 2:
+        raise Exception("Descriptors must be a 2d array")
+    rows, cols = descriptors.shape
+    # Row major layout with the points along the rows
+    header = binary_magic + struct.pack(
+        "<IIIIqq", binary_version, binary_float64, 1, 0, rows, cols
+    )
+    header = header + bytes(binary_header_size - len(header))
+    with open(file_name, "wb") as file1:
+        file1.write(header)
+        descriptors.tofile(file1)
+
+
 class DescriptorFile:
 
     # Initialization
@@ -54,7 +151,12 @@ class DescriptorFile:
     def dimensions(self):
         return self.__descriptors.shape[1]
 
-    def read(self, file_name):
+    # Binary descriptor files are detected from their header, they can
+    # optionally be memory mapped instead of read
+    def read(self, file_name, memory_map=False):
+        if isBinaryDescriptorFile(file_name):
+            self.__descriptors = readBinaryDescriptors(file_name, memory_map)
+            return
         with open(file_name, "r") as file1:
             # Ignore first line
             file1.readline()
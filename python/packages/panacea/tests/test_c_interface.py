@@ -0,0 +1,71 @@
+import os
+
+import numpy as np
+import pytest
+
+import panacea.c_interface as c_interface
+import panacea.read_descriptors
+
+pytestmark = pytest.mark.skipif(
+    c_interface.findLibrary() is None, reason="PANACEA library not found"
+)
+
+
+@pytest.fixture
+def points():
+    return np.array([[0.0, 0.0], [1.0, 0.5], [2.0, 2.0]])
+
+
+def test_layouts_agree(points):
+    settings = c_interface.Settings(c_interface.SELF)
+    row_major = c_interface.Descriptors(points)
+    column_major = c_interface.Descriptors(np.asfortranarray(points))
+    term1 = c_interface.EntropyTerm(row_major, settings)
+    term2 = c_interface.EntropyTerm(column_major, settings)
+    assert term1.dimensions == 2
+    assert term1.compute(row_major) == pytest.approx(term2.compute(column_major))
+    assert term1.compute(row_major, 1) == pytest.approx(term2.compute(column_major, 1))
+    grad1 = term1.computeGrad(row_major, 1)
+    grad2 = np.zeros(2)
+    term2.computeGrad(column_major, 1, grad2)
+    assert grad1 == pytest.approx(grad2)
+
+
+def test_descriptors_are_not_copied(points):
+    settings = c_interface.Settings(c_interface.SELF)
+    descriptors = c_interface.Descriptors(points)
+    term = c_interface.EntropyTerm(descriptors, settings)
+    stacked = term.compute(descriptors)
+    # Spreading the points apart increases the self entropy
+    points[0, 0] = -2.0
+    points[2, 0] = 4.0
+    assert term.compute(descriptors) > stacked
+
+
+def test_errors_are_raised(points):
+    settings = c_interface.Settings(c_interface.SELF)
+    descriptors = c_interface.Descriptors(points)
+    term = c_interface.EntropyTerm(descriptors, settings)
+    with pytest.raises(Exception, match="out of range"):
+        term.compute(descriptors, 3)
+    with pytest.raises(Exception):
+        c_interface.Descriptors(points.astype(np.float32))
+
+
+def test_write_descriptors(points, tmp_path):
+    descriptors = c_interface.Descriptors(np.asfortranarray(points))
+    file_name = str(tmp_path / "descriptors.bin")
+    descriptors.write(file_name)
+    assert (panacea.read_descriptors.readBinaryDescriptors(file_name) == points).all()
+
+
+def test_restart(points, tmp_path):
+    settings = c_interface.Settings(c_interface.SELF)
+    descriptors = c_interface.Descriptors(points)
+    term = c_interface.EntropyTerm(descriptors, settings)
+    restart_file = os.path.join(str(tmp_path), "restart.txt")
+    term.write(restart_file)
+    restarted = c_interface.EntropyTerm(
+        restart_file=restart_file, loading=c_interface.LAZY
+    )
+    assert restarted.compute(descriptors) == pytest.approx(term.compute(descriptors))
@@ -45,3 +45,19 @@ def test_read_files():
     assert all_descriptors[3, 2] == 3
     assert all_descriptors[4, 2] == 3
     assert all_descriptors[5, 2] == -4
+
+
+def test_read_binary_files():
+    txt_reader = panacea.descriptor_file_group.DescriptorFileGroup(
+        os.path.dirname(os.path.abspath(__file__)), "descriptors", ".txt"
+    )
+    txt_reader.read()
+    binary_reader = panacea.descriptor_file_group.DescriptorFileGroup(
+        os.path.dirname(os.path.abspath(__file__)), "descriptors", ".bin"
+    )
+    binary_reader.read()
+
+    assert binary_reader.dimensions == 3
+    assert (binary_reader.minmax[0] == txt_reader.minmax[0]).all()
+    assert (binary_reader.minmax[1] == txt_reader.minmax[1]).all()
+    assert (binary_reader.descriptors == txt_reader.descriptors).all()
@@ -0,0 +1,47 @@
+import panacea.descriptor_file_group
+import panacea.descriptor_summary
+
+import numpy as np
+import os
+import pytest
+
+
+def test_read_summary():
+    # Written by PANACEA next to descriptors3.txt
+    summary = panacea.descriptor_summary.readDescriptorSummary(
+        "tests/descriptors3.txt.summary"
+    )
+    assert summary.number_points == 2
+    assert summary.dimensions == 3
+    assert summary.number_bins == 16
+    assert np.array_equal(summary.min_vals, [1.0, 2.0, -4.0])
+    assert np.array_equal(summary.max_vals, [6.0, 2.0, 3.0])
+    assert summary.variance == pytest.approx([12.5, 0.0, 24.5])
+    assert summary.histograms.sum(axis=1) == pytest.approx([2.0, 2.0, 2.0])
+
+
+def test_merge_summaries():
+    desc_file_grp = panacea.descriptor_file_group.DescriptorFileGroup(
+        os.path.dirname(os.path.abspath(__file__)), "descriptors", ".txt"
+    )
+    desc_file_grp.read()
+    all_descriptors = desc_file_grp.descriptors
+
+    summary = desc_file_grp.readSummaries()
+    assert summary.number_points == 6
+    assert np.array_equal(summary.min_vals, all_descriptors.min(axis=0))
+    assert np.array_equal(summary.max_vals, all_descriptors.max(axis=0))
+    assert summary.mean == pytest.approx(all_descriptors.mean(axis=0))
+    assert summary.variance == pytest.approx(all_descriptors.var(axis=0, ddof=1))
+    assert summary.histograms.sum(axis=1) == pytest.approx([6.0, 6.0, 6.0])
+
+    # The files in the index range only
+    summary = desc_file_grp.readSummaries(1, 3)
+    assert summary.number_points == 4
+    assert summary.max_vals[0] == 5.0
+
+    # Without the sidecars the descriptors have to be read
+    binary_file_grp = panacea.descriptor_file_group.DescriptorFileGroup(
+        os.path.dirname(os.path.abspath(__file__)), "descriptors", ".bin"
+    )
+    assert binary_file_grp.readSummaries() is None
@@ -1,4 +1,6 @@
+import numpy as np
 import pytest
+import struct
 
 import panacea.read_descriptors
 
@@ -19,3 +21,39 @@ def test_descriptors(read_file):
     assert read_file.descriptors[1, 1] == 2.0
     assert read_file.descriptors[0, 2] == 3.0
     assert read_file.descriptors[1, 2] == 3.0
+
+
+def test_binary_descriptors():
+    # Written by PANACEA from descriptors.txt
+    binary_file = panacea.read_descriptors.DescriptorFile()
+    binary_file.read("tests/descriptors.bin")
+    txt_file = panacea.read_descriptors.DescriptorFile()
+    txt_file.read("tests/descriptors.txt")
+    assert (binary_file.descriptors == txt_file.descriptors).all()
+
+    mapped_file = panacea.read_descriptors.DescriptorFile()
+    mapped_file.read("tests/descriptors.bin", memory_map=True)
+    assert (mapped_file.descriptors == txt_file.descriptors).all()
+
+
+def test_binary_descriptors_layouts(tmp_path):
+    points = np.arange(12.0).reshape(4, 3)
+    file_name = str(tmp_path / "descriptors.bin")
+    panacea.read_descriptors.writeBinaryDescriptors(file_name, points)
+    assert (panacea.read_descriptors.readBinaryDescriptors(file_name) == points).all()
+
+    # A column major file with the dimensions along the rows, as written from a
+    # Fortran array (dimensions, points)
+    with open(file_name, "r+b") as file1:
+        header = bytearray(file1.read(64))
+        header[16:24] = struct.pack("<II", 2, 1)
+        header[24:40] = struct.pack("<qq", 3, 4)
+        file1.seek(0)
+        file1.write(header)
+        file1.write(points.T.tobytes(order="F"))
+    for memory_map in [False, True]:
+        descriptors = panacea.read_descriptors.readBinaryDescriptors(
+            file_name, memory_map
+        )
+        assert descriptors.shape == (4, 3)
+        assert (descriptors == points).all()
@@ -14,7 +14,14 @@ namespace panacea {
 
 ReducedInvCovariance
 Inverter::invert(const ReducedCovariance &reduced_cov) const {
-  auto inv_matrix = pseudoInverse(reduced_cov.get(PassKey<Inverter>()));
+  // The reduced covariance is already factorized when it is positive definite
+  // so the inverse is assembled from the factor, the pseudo inverse is only
+  // needed when it is not.
+  const Matrix *cholesky_factor =
+      reduced_cov.getCholeskyFactor(PassKey<Inverter>());
+  auto inv_matrix = cholesky_factor != nullptr
+                        ? choleskyInverse(*cholesky_factor)
+                        : pseudoInverse(reduced_cov.get(PassKey<Inverter>()));
 
   ReducedInvCovariance reduced_inv_cov(
       PassKey<Inverter>(), std::move(inv_matrix),
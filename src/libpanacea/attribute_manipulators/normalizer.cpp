@@ -2,9 +2,15 @@
 // Local private PANACEA includes
 #include "normalizer.hpp"
 
+#include "descriptors/descriptor_statistics.hpp"
+#include "descriptors/descriptor_wrapper.hpp"
+#include "descriptors/streaming_statistics.hpp"
 #include "error.hpp"
+#include "io/restart_read_context.hpp"
+#include "io/txt_numbers.hpp"
 #include "normalization_methods/normalization_method_factory.hpp"
 #include "type_map.hpp"
+#include "update_policy.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io_types.hpp"
@@ -12,7 +18,6 @@
 
 // Standard includes
 #include <cassert>
-#include <iomanip>
 #include <iostream>
 #include <typeindex>
 #include <vector>
@@ -46,8 +51,46 @@ void trim(const std::vector<double> &in, const NormalizerOption &opt,
   }
 }
 
+/**
+ * Variance statistics of the descriptors of an update, reusing statistics
+ * that were passed in as extra arguments.
+ **/
+DescriptorStatistics batchStatistics(const BaseDescriptorWrapper &dwrapper,
+                                     const std::any &extra_args) {
+  if (extra_args.type() == typeid(const DescriptorStatistics *)) {
+    return std::any_cast<const DescriptorStatistics *>(extra_args)->diagonal();
+  }
+  return DescriptorStatistics(dwrapper, Moments::Diagonal);
+}
+
+/**
+ * Descriptors without any points that only carry the number of dimensions,
+ * the normalization methods read everything else from the statistics.
+ **/
+DescriptorWrapper<std::vector<std::vector<double>>>
+emptyDescriptors(const DescriptorStatistics &stats) {
+  return DescriptorWrapper<std::vector<std::vector<double>>>(
+      std::vector<std::vector<double>>(), 0, stats.getNumberDimensions());
+}
+
 } // namespace
 
+/********************************************************
+ * Private methods
+ ********************************************************/
+
+void Normalizer::setCoeffs_(const std::vector<double> &normalization_coeffs) {
+  trim(normalization_coeffs, norm_option_, normalization_coeffs_);
+  cacheInverseCoeffs_();
+}
+
+void Normalizer::cacheInverseCoeffs_() {
+  inv_normalization_coeffs_.resize(normalization_coeffs_.size());
+  for (size_t dim = 0; dim < normalization_coeffs_.size(); ++dim) {
+    inv_normalization_coeffs_[dim] = 1.0 / normalization_coeffs_[dim];
+  }
+}
+
 /********************************************************
  * Public methods
  ********************************************************/
@@ -55,21 +98,33 @@ void trim(const std::vector<double> &in, const NormalizerOption &opt,
 Normalizer::Normalizer(const std::vector<double> &normalization_coeffs,
                        const NormalizerOption opt)
     : norm_option_(opt) {
-  trim(normalization_coeffs, norm_option_, normalization_coeffs_);
+  setCoeffs_(normalization_coeffs);
 }
 
 Normalizer::Normalizer(const BaseDescriptorWrapper &dwrapper,
                        const settings::KernelNormalization &norm_method,
-                       const NormalizerOption opt)
+                       const NormalizerOption opt, std::any extra_args,
+                       const UpdatePolicy &policy)
     : norm_option_(opt) {
 
   NormalizationMethodFactory norm_method_factory;
   norm_method_ = norm_method_factory.create(norm_method);
-  auto extra_settings = settings::None::None;
-  const auto normalization_coeffs = norm_method_(dwrapper, extra_settings);
-  trim(normalization_coeffs, norm_option_, normalization_coeffs_);
+  // Coefficients taken from a covariance matrix follow its own history
+  if (not policy.is(settings::UpdateMode::Cumulative) &&
+      extra_args.type() != typeid(Covariance *)) {
+    history_ =
+        StreamingStatistics(policy, batchStatistics(dwrapper, extra_args));
+    extra_args = &history_->statistics();
+  }
+  const auto normalization_coeffs = norm_method_(dwrapper, extra_args);
+  setCoeffs_(normalization_coeffs);
 }
 
+Normalizer::Normalizer(const DescriptorStatistics &stats,
+                       const settings::KernelNormalization &norm_method,
+                       const NormalizerOption opt, const UpdatePolicy &policy)
+    : Normalizer(emptyDescriptors(stats), norm_method, opt, &stats, policy) {}
+
 Normalizer::Normalizer(const settings::KernelNormalization &norm_method,
                        const NormalizerOption opt)
     : norm_option_(opt) {
@@ -86,13 +141,13 @@ void Normalizer::normalize(Covariance &cov) const {
 
   assert(cov.cols() == normalization_coeffs_.size());
 
-  // Division is expensive so do it once and then use the inverse
-  std::vector<double> inv_coeffs;
-  inv_coeffs.reserve(normalization_coeffs_.size());
-  for (int col = 0; col < cov.cols(); ++col) {
-    assert(normalization_coeffs_.at(col) != 0.0);
-    inv_coeffs.push_back(1.0 / normalization_coeffs_.at(col));
+  // Division is expensive so the cached inverse is used
+  const auto &inv_coeffs = inv_normalization_coeffs_;
+#ifndef NDEBUG
+  for (const double coef : normalization_coeffs_) {
+    assert(coef != 0.0);
   }
+#endif
 
   for (int row = 0; row < cov.rows(); ++row) {
     for (int col = row; col < cov.cols(); ++col) {
@@ -119,16 +174,37 @@ void Normalizer::unnormalize(Covariance &cov) const {
   cov.set(PassKey<Normalizer>(), NormalizationState::Unnormalized);
 }
 
-const std::vector<double> Normalizer::getNormalizationCoeffs() const {
+const std::vector<double> &Normalizer::getNormalizationCoeffs() const
+    noexcept {
   return normalization_coeffs_;
 }
 
+const std::vector<double> &Normalizer::getInverseNormalizationCoeffs() const
+    noexcept {
+  return inv_normalization_coeffs_;
+}
+
+UpdatePolicy Normalizer::getUpdatePolicy() const {
+  if (history_) {
+    return history_->policy();
+  }
+  return UpdatePolicy();
+}
+
 void Normalizer::update(const BaseDescriptorWrapper &dwrapper,
                         std::any extra_args) {
 
   assert(norm_method_ != nullptr);
+  if (history_ && extra_args.type() != typeid(Covariance *)) {
+    history_->update(batchStatistics(dwrapper, extra_args));
+    extra_args = &history_->statistics();
+  }
   const auto normalization_coeffs = norm_method_(dwrapper, extra_args);
-  trim(normalization_coeffs, norm_option_, normalization_coeffs_);
+  setCoeffs_(normalization_coeffs);
+}
+
+void Normalizer::update(const DescriptorStatistics &stats) {
+  update(emptyDescriptors(stats), &stats);
 }
 
 std::vector<std::any> Normalizer::write(const settings::FileType file_type,
@@ -184,6 +260,7 @@ std::vector<std::any> Normalizer::write(const settings::FileType file_type,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     os << "[Normalization]\n";
@@ -191,8 +268,13 @@ std::vector<std::any> Normalizer::write(const settings::FileType file_type,
     os << normalizer.normalization_coeffs_.size() << "\n";
     os << "[Normalization Coefficients]\n";
     for (const auto &coef : normalizer.normalization_coeffs_) {
-      os << std::setfill(' ') << std::setw(14) << std::setprecision(15)
-         << std::right << coef << "\n";
+      io::writeDouble(os, coef, 14);
+      os << "\n";
+    }
+    os << "[Update History]\n";
+    os << (normalizer.history_ ? 1 : 0) << "\n";
+    if (normalizer.history_) {
+      StreamingStatistics::write(*normalizer.history_, os);
     }
   }
   return std::vector<std::any>();
@@ -231,6 +313,7 @@ io::ReadInstantiateVector Normalizer::read(const settings::FileType file_type,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line;
@@ -275,12 +358,30 @@ io::ReadInstantiateVector Normalizer::read(const settings::FileType file_type,
         is >> value;
         normalizer.normalization_coeffs_.at(row) = value;
       }
+      normalizer.cacheInverseCoeffs_();
     } catch (...) {
       std::string error_msg =
           "Error encountered while attempting to read in normalization ";
       error_msg += "coefficients from Normalization section of restart file.\n";
       PANACEA_FAIL(error_msg);
     }
+
+    // Restart files written before update modes were added do not have an
+    // update history
+    int has_history = 0;
+    if (io::readOptionalTag(is, "[Update History]") &&
+        not(is >> has_history)) {
+      std::string error_msg = "Unable to read whether the normalizer has an ";
+      error_msg += "update history from restart file.\n";
+      PANACEA_FAIL(error_msg);
+    }
+    if (has_history) {
+      StreamingStatistics history;
+      StreamingStatistics::read(history, is);
+      normalizer.history_ = std::move(history);
+    } else {
+      normalizer.history_.reset();
+    }
   }
   return io::ReadInstantiateVector();
 }
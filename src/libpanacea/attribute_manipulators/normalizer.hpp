@@ -6,8 +6,10 @@
 // Local private includes
 #include "attributes/covariance.hpp"
 
+#include "descriptors/streaming_statistics.hpp"
 #include "normalization_methods/normalization_method_factory.hpp"
 #include "private_settings.hpp"
+#include "update_policy.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io_types.hpp"
@@ -30,6 +32,7 @@ enum class KernelNormalization;
 enum class NormalizerOption { Flexible, Strict };
 
 class BaseDescriptorWrapper;
+class DescriptorStatistics;
 
 /*
  * The only thing that gets normalized and unnormalized is
@@ -37,11 +40,23 @@ class BaseDescriptorWrapper;
  *
  * It would be unnormalized before the covariance matrix could
  * be updated and normalized afterwards.
+ *
+ * When the coefficients are calculated from the descriptors, rather than from
+ * a covariance matrix, an update policy other than Cumulative keeps a history
+ * of the variance of the descriptors so that each update is combined with the
+ * earlier ones. Without it each update replaces the coefficients.
  **/
 class Normalizer {
   std::vector<double> normalization_coeffs_;
+  // 1 / coefficient, so that the primitives multiply instead of divide when
+  // they are evaluated
+  std::vector<double> inv_normalization_coeffs_;
   NormalizationMethodFactory::NormalizationMethod norm_method_ = nullptr;
   NormalizerOption norm_option_ = NormalizerOption::Strict;
+  std::optional<StreamingStatistics> history_;
+
+  void setCoeffs_(const std::vector<double> &normalization_coeffs);
+  void cacheInverseCoeffs_();
 
 public:
   Normalizer() = default;
@@ -54,15 +69,42 @@ public:
   Normalizer(const settings::KernelNormalization &norm_method,
              const NormalizerOption opt = NormalizerOption::Strict);
 
+  /**
+   * The extra arguments are passed on to the normalization method, e.g.
+   * statistics of the descriptors that have already been gathered.
+   **/
   Normalizer(const BaseDescriptorWrapper &descriptor_wrapper,
              const settings::KernelNormalization &norm_method,
-             const NormalizerOption opt = NormalizerOption::Strict);
+             const NormalizerOption opt = NormalizerOption::Strict,
+             std::any extra_args = settings::None::None,
+             const UpdatePolicy &policy = UpdatePolicy());
 
-  const std::vector<double> getNormalizationCoeffs() const;
+  /**
+   * Coefficients computed from statistics that were gathered, or merged from
+   * descriptor summaries, earlier without reading any descriptors.
+   **/
+  Normalizer(const DescriptorStatistics &stats,
+             const settings::KernelNormalization &norm_method,
+             const NormalizerOption opt = NormalizerOption::Strict,
+             const UpdatePolicy &policy = UpdatePolicy());
+
+  const std::vector<double> &getNormalizationCoeffs() const noexcept;
+
+  /**
+   * Reciprocals of the normalization coefficients, a coefficient of 0.0 has
+   * a reciprocal of infinity.
+   **/
+  const std::vector<double> &getInverseNormalizationCoeffs() const noexcept;
+  UpdatePolicy getUpdatePolicy() const;
 
   void update(const BaseDescriptorWrapper &descriptor_wrapper,
               std::any extra_args = settings::None::None);
 
+  /**
+   * Update with the statistics of a new batch of descriptors.
+   **/
+  void update(const DescriptorStatistics &stats);
+
   template <class T> T get() const noexcept;
 
   void normalize(Covariance &cov) const;
@@ -6,9 +6,11 @@
 #include "attributes/dimensions.hpp"
 #include "error.hpp"
 #include "matrix/matrix.hpp"
+#include "workspace.hpp"
 
 // Standard includes
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <iostream>
 #include <numeric>
@@ -202,19 +204,19 @@ rowEchelonDimensionDependenceDetection_(Matrix &tmp, const double threshold) {
 Dimensions
 findLinearlyIndependentDescDimensions_(const Matrix &cov,
                                        const Dimensions &priority_rows,
-                                       const double threshold) {
-
-  auto tmp = createMatrix(cov.rows(), cov.cols());
+                                       const double threshold, Matrix &tmp) {
 
+  assert(tmp.rows() == cov.rows());
+  assert(tmp.cols() == cov.cols());
   for (int ind1 = 0; ind1 < cov.rows(); ++ind1) {
     for (int ind2 = ind1; ind2 < cov.rows(); ++ind2) {
-      tmp->operator()(ind1, ind2) = cov(ind1, ind2);
-      tmp->operator()(ind2, ind1) = tmp->operator()(ind1, ind2);
+      tmp(ind1, ind2) = cov(ind1, ind2);
+      tmp(ind2, ind1) = tmp(ind1, ind2);
     }
   }
 
   // Next we are going to reorder the covariance matrix
-  std::vector<int> order = reorderSymmetricMatrix_(*tmp.get(), priority_rows);
+  std::vector<int> order = reorderSymmetricMatrix_(tmp, priority_rows);
 
   // E.g.
   // order.at(0) is row of reordered tmp that points back to the original tmp
@@ -225,7 +227,7 @@ findLinearlyIndependentDescDimensions_(const Matrix &cov,
   // swapped, because the diagonal may not be non zero at the dimension of
   // interest this does not constitute an error
   const std::vector<int> relative_independent_rows =
-      rowEchelonDimensionDependenceDetection_(*tmp.get(), threshold);
+      rowEchelonDimensionDependenceDetection_(tmp, threshold);
 
   // relative_independent_rows has not accounted for the changes in rows that
   // occurred during the call to reorderSymmetricMatrix this corrects the row
@@ -275,6 +277,13 @@ createRedCovarRawMatrix_(const Covariance &cov,
 
 ReducedCovariance Reducer::reduce(const Covariance &cov,
                                   Dimensions priority_rows) const {
+  Workspace workspace;
+  return reduce(cov, std::move(priority_rows), workspace);
+}
+
+ReducedCovariance Reducer::reduce(const Covariance &cov,
+                                  Dimensions priority_rows,
+                                  Workspace &workspace) const {
 
   // If priority rows are empty create some assume the current order is fine
   if (priority_rows.size() == 0) {
@@ -284,10 +293,13 @@ ReducedCovariance Reducer::reduce(const Covariance &cov,
   runChecks_(cov, priority_rows);
 
   double threshold = starting_threshold_;
+  // Overwritten on every attempt
+  Matrix &tmp =
+      workspace.matrix(Workspace::Slot::Reduction, cov.rows(), cov.cols());
 
   do {
     Dimensions independent_dims = findLinearlyIndependentDescDimensions_(
-        cov.matrix(PassKey<Reducer>()), priority_rows, threshold);
+        cov.matrix(PassKey<Reducer>()), priority_rows, threshold, tmp);
 
     if (independent_dims.size() == 0) {
       independent_dims = Dimensions(std::vector<int>{priority_rows.at(0)});
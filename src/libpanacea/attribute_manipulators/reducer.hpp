@@ -12,6 +12,8 @@
 
 namespace panacea {
 
+class Workspace;
+
 class Reducer {
 private:
   /*
@@ -42,6 +44,14 @@ public:
    */
   ReducedCovariance reduce(const Covariance &cov,
                            Dimensions preferred_dimensions) const;
+
+  /**
+   * Same as above but the copy of the covariance matrix that is put in row
+   * echelon form is borrowed from the workspace instead of being allocated.
+   **/
+  ReducedCovariance reduce(const Covariance &cov,
+                           Dimensions preferred_dimensions,
+                           Workspace &workspace) const;
 };
 } // namespace panacea
 
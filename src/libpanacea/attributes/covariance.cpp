@@ -6,6 +6,7 @@
 
 #include "covariance/covariance_correlated.hpp"
 #include "covariance/covariance_uncorrelated.hpp"
+#include "descriptors/descriptor_statistics.hpp"
 #include "error.hpp"
 #include "matrix/matrix.hpp"
 #include "type_map.hpp"
@@ -56,6 +57,7 @@ std::vector<std::any> Covariance::write(const settings::FileType file_type,
 
   std::vector<std::any> nested_objs;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     os << "[Covariance]\n";
     os << cov.correlation() << "\n";
@@ -97,6 +99,7 @@ io::ReadInstantiateVector Covariance::read(const settings::FileType file_type,
 
   io::ReadInstantiateVector nested_objs;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     std::string line;
     // Find header tag
@@ -180,6 +183,34 @@ Covariance::create(const BaseDescriptorWrapper &desc_wrap,
   return nullptr;
 }
 
+std::unique_ptr<Covariance>
+Covariance::create(const DescriptorStatistics &stats,
+                   const settings::KernelCorrelation corr,
+                   const settings::KernelAlgorithm opt) {
+
+  if (opt == settings::KernelAlgorithm::Strict) {
+    return Covariance::create(stats, corr, CovarianceOption::Strict);
+  }
+  return Covariance::create(stats, corr, CovarianceOption::Flexible);
+}
+
+std::unique_ptr<Covariance>
+Covariance::create(const DescriptorStatistics &stats,
+                   const settings::KernelCorrelation corr,
+                   const CovarianceOption opt) {
+
+  if (corr == settings::KernelCorrelation::Correlated) {
+    return std::make_unique<CovarianceCorrelated>(stats, opt);
+  } else if (corr == settings::KernelCorrelation::Uncorrelated) {
+    return std::make_unique<CovarianceUncorrelated>(stats, opt);
+  }
+
+  std::string error_msg = "Unrecognized correlation type specified, ";
+  error_msg += "cannot create correlation matrix.";
+  PANACEA_FAIL(error_msg);
+  return nullptr;
+}
+
 std::unique_ptr<Covariance>
 Covariance::create(const settings::KernelCorrelation corr) {
 
@@ -214,4 +245,30 @@ Covariance::create(const settings::KernelCorrelation corr,
   return nullptr;
 }
 
+std::ostream &operator<<(std::ostream &os, const CovarianceOption &cov_opt) {
+  if (cov_opt == CovarianceOption::Strict) {
+    os << "Strict";
+  } else if (cov_opt == CovarianceOption::Flexible) {
+    os << "Flexible";
+  }
+  return os;
+}
+
+std::istream &operator>>(std::istream &is, CovarianceOption &cov_opt) {
+  std::string line;
+  std::getline(is, line);
+  if (line.find("Strict", 0) != std::string::npos) {
+    cov_opt = CovarianceOption::Strict;
+  } else if (line.find("Flexible", 0) != std::string::npos) {
+    cov_opt = CovarianceOption::Flexible;
+  } else {
+    std::string error_msg =
+        "Unrecognized covariance option while reading istream.\n";
+    error_msg += "Accepted covariance option settings are:\n";
+    error_msg += "Strict\nFlexible\n";
+    error_msg += "Line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  return is;
+}
 } // namespace panacea
@@ -7,6 +7,7 @@
 #include "data_settings.hpp"
 #include "matrix/matrix.hpp"
 #include "private_settings.hpp"
+#include "update_policy.hpp"
 #include "vector/vector.hpp"
 
 // Local public PANACEA includes
@@ -30,6 +31,7 @@ enum class CovarianceOption { Flexible, Strict };
 enum class CovarianceBuild { Allocate, NoAllocate };
 
 class BaseDescriptorWrapper;
+class DescriptorStatistics;
 class Normalizer;
 class Reducer;
 
@@ -59,6 +61,18 @@ public:
   /// Designed to update the covariance matrix
   virtual void update(const BaseDescriptorWrapper &desc_wrap) = 0;
 
+  /// Update from statistics that were already gathered from the descriptors
+  virtual void update(const DescriptorStatistics &stats) = 0;
+
+  /**
+   * Sets how later updates are combined with the descriptors already seen.
+   *
+   * The covariance matrix must be unnormalized, its current values count as
+   * the first update.
+   **/
+  virtual void set(const UpdatePolicy &policy) = 0;
+  virtual UpdatePolicy getUpdatePolicy() const = 0;
+
   /// Don't want to allow for the matrix to be arbitrarily changed but do want
   /// to provide access to the actual covariance matrix elements
   virtual double operator()(const int row, const int col) const = 0;
@@ -120,6 +134,19 @@ public:
          const settings::KernelCorrelation corr,
          const settings::KernelAlgorithm opt);
 
+  /**
+   * Statistics must hold the full moments of the descriptors.
+   **/
+  static std::unique_ptr<Covariance>
+  create(const DescriptorStatistics &stats,
+         const settings::KernelCorrelation corr,
+         const CovarianceOption opt = CovarianceOption::Strict);
+
+  static std::unique_ptr<Covariance>
+  create(const DescriptorStatistics &stats,
+         const settings::KernelCorrelation corr,
+         const settings::KernelAlgorithm opt);
+
   static std::unique_ptr<Covariance>
   create(const settings::KernelCorrelation corr);
 
@@ -129,5 +156,7 @@ public:
          const CovarianceOption opt = CovarianceOption::Strict);
 };
 
+std::ostream &operator<<(std::ostream &os, const CovarianceOption &);
+std::istream &operator>>(std::istream &is, CovarianceOption &);
 } // namespace panacea
 #endif // PANACEA_PRIVATE_COVARIANCE_H
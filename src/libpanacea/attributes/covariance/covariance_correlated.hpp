@@ -7,8 +7,10 @@
 #include "attributes/covariance.hpp"
 
 #include "data_settings.hpp"
+#include "descriptors/streaming_statistics.hpp"
 #include "matrix/matrix.hpp"
 #include "private_settings.hpp"
+#include "update_policy.hpp"
 #include "vector/vector.hpp"
 
 // Local public PANACEA includes
@@ -18,6 +20,7 @@
 // Standard includes
 #include <any>
 #include <memory>
+#include <optional>
 
 namespace panacea {
 
@@ -35,6 +38,12 @@ private:
 
   NormalizationState normalized_ = NormalizationState::Unnormalized;
 
+  /// How problematic matrices are handled when rebuilt from the history
+  CovarianceOption option_ = CovarianceOption::Strict;
+
+  /// Only kept if updates are not cumulative
+  std::optional<StreamingStatistics> history_;
+
 public:
   CovarianceCorrelated() = default;
 
@@ -43,6 +52,9 @@ public:
   CovarianceCorrelated(const BaseDescriptorWrapper &desc_wrap,
                        const CovarianceOption opt = CovarianceOption::Strict);
 
+  CovarianceCorrelated(const DescriptorStatistics &stats,
+                       const CovarianceOption opt = CovarianceOption::Strict);
+
   CovarianceCorrelated(std::unique_ptr<Matrix> matrix,
                        std::unique_ptr<Vector> mean, int total_num_pts,
                        const CovarianceOption opt = CovarianceOption::Strict);
@@ -54,6 +66,10 @@ public:
 
   /// Designed to update the covariance matrix
   virtual void update(const BaseDescriptorWrapper &desc_wrap) final;
+  virtual void update(const DescriptorStatistics &stats) final;
+
+  virtual void set(const UpdatePolicy &policy) final;
+  virtual UpdatePolicy getUpdatePolicy() const final;
 
   /// Don't want to allow for the matrix to be arbitrarily changed but do want
   /// to provide access to the actual covariance matrix elements
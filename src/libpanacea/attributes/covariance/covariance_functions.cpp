@@ -3,6 +3,8 @@
 
 // Local private PANACEA includes
 #include "attributes/covariance.hpp"
+#include "covariance_functions.hpp"
+#include "descriptors/descriptor_statistics.hpp"
 #include "error.hpp"
 #include "matrix/matrix.hpp"
 #include "vector/vector.hpp"
@@ -21,83 +23,94 @@
 namespace panacea {
 namespace covariance {
 
-void calculateMean(Vector &mean, const BaseDescriptorWrapper &desc_wrap) {
-  const int num_dims = desc_wrap.getNumberDimensions();
-  const int num_pts = desc_wrap.getNumberPoints();
-  mean.resize(num_dims);
-  for (int dim = 0; dim < num_dims; ++dim) {
-    double sum = 0.0;
-    for (int pt = 0; pt < num_pts; ++pt) {
-      sum += desc_wrap(pt, dim);
-    }
-    mean(dim) = sum / static_cast<double>(num_pts);
-  }
-}
+/************************************************
+ * Public functions
+ ************************************************/
 
-void updateMean(Vector &mean, const BaseDescriptorWrapper &desc_wrap,
-                const int current_num_desc_pts) {
+void mergeCovariance(Matrix &covariance, Vector &mean,
+                     const double current_weight,
+                     const DescriptorStatistics &stats) {
 
-  const int num_dims = desc_wrap.getNumberDimensions();
-  const int num_pts = desc_wrap.getNumberPoints();
+  const int num_dims = stats.getNumberDimensions();
+  assert(covariance.rows() == num_dims);
+  assert(covariance.cols() == num_dims);
   assert(mean.rows() == num_dims);
+  assert(stats.moments() == Moments::Full);
+  if (stats.getNumberPoints() == 0) {
+    return;
+  }
+
+  // Chan et al. pairwise combination of the co-moments of the two sets
+  const double num_pts_a = current_weight;
+  const double num_pts_b = stats.getWeight();
+  const double total_num_pts = num_pts_a + num_pts_b;
+  const double factor = num_pts_a * num_pts_b / total_num_pts;
+  const double current_divisor = current_weight > 0.0 ? num_pts_a - 1.0 : 0.0;
+  const double inv_divisor = 1.0 / (total_num_pts - 1.0);
+
+  // The differences of the means are recomputed where they are needed rather
+  // than stored, the mean is only moved once the co-moments are merged
+  const std::vector<double> &stats_mean = stats.getMean();
   for (int dim = 0; dim < num_dims; ++dim) {
-    double new_sum = 0.0;
-    for (int pt = 0; pt < num_pts; ++pt) {
-      new_sum += desc_wrap(pt, dim);
+    const double delta = stats_mean[dim] - mean(dim);
+    for (int dim2 = dim; dim2 < num_dims; ++dim2) {
+      const double delta2 = stats_mean[dim2] - mean(dim2);
+      const double co_moment = covariance(dim, dim2) * current_divisor +
+                               stats.getCoMoment(dim, dim2) +
+                               delta * delta2 * factor;
+      covariance(dim, dim2) = co_moment * inv_divisor;
+      covariance(dim2, dim) = covariance(dim, dim2);
     }
-    double old_sum = mean(dim) * static_cast<double>(current_num_desc_pts);
-    mean(dim) = (old_sum + new_sum) /
-                static_cast<double>(num_pts + current_num_desc_pts);
+  }
+  for (int dim = 0; dim < num_dims; ++dim) {
+    mean(dim) += (stats_mean[dim] - mean(dim)) * num_pts_b / total_num_pts;
   }
 }
 
-void updateCovariance(Matrix &covariance, const Vector &current_mean,
-                      const Vector &new_mean, const int current_num_pts,
-                      const BaseDescriptorWrapper &desc_wrap) {
-
-  const int num_dims = desc_wrap.getNumberDimensions();
-  const int num_pts = desc_wrap.getNumberPoints();
+void buildCovariance(Matrix &covariance, Vector &mean,
+                     const DescriptorStatistics &stats,
+                     const CovarianceOption opt) {
+  mean.setZero();
+  covariance.setZero();
+  mergeCovariance(covariance, mean, 0.0, stats);
+
+  if (covariance.isZero(1E-9)) {
+    accountForZeroMatrix(opt, covariance);
+  } else if (stats.getWeight() <= 1.0) {
+    if (opt == CovarianceOption::Flexible) {
+      covariance.makeIdentity();
+    } else {
+      std::string error_msg =
+          "You are trying to create covariance matrix with ";
+      error_msg +=
+          "a single point Either get a better starting data set or allow";
+      error_msg += " flexibility in the algorithm.";
+      PANACEA_FAIL(error_msg);
+    }
+  } else {
+    // Set any diagonal elements that are equal to 0.0 equal to 1.0
+    accountForZeroOnDiagonal(opt, covariance);
+  }
+}
 
-  assert(covariance.rows() == num_dims);
-  assert(covariance.cols() == num_dims);
-  assert(current_mean.rows() == num_dims);
-  assert(new_mean.rows() == num_dims);
-  const int total_num_pts = current_num_pts + num_pts;
+DescriptorStatistics covarianceStatistics(const Matrix &covariance,
+                                          const Vector &mean,
+                                          const int num_pts) {
+  const int num_dims = covariance.rows();
+  assert(mean.rows() == num_dims);
+  const double divisor = num_pts > 1 ? static_cast<double>(num_pts - 1) : 0.0;
+  std::vector<double> mean_values(num_dims);
+  std::vector<double> co_moments(static_cast<std::size_t>(num_dims) *
+                                 num_dims);
   for (int dim = 0; dim < num_dims; ++dim) {
-    { // account for diagonal
-      double sum = 0.0;
-      for (int pt = 0; pt < num_pts; ++pt) {
-        sum += desc_wrap(pt, dim) * desc_wrap(pt, dim);
-      }
-      double A_ij =
-          covariance(dim, dim) * (static_cast<double>(current_num_pts) - 1.0) +
-          static_cast<double>(current_num_pts) * current_mean(dim) *
-              current_mean(dim) +
-          sum;
-      double B_ij =
-          static_cast<double>(total_num_pts) * new_mean(dim) * new_mean(dim);
-
-      covariance(dim, dim) = 1.0 / (static_cast<double>(total_num_pts) - 1.0);
-      covariance(dim, dim) *= (A_ij - B_ij);
-    } // end account for diagonal
-    for (int dim2 = dim + 1; dim2 < num_dims;
-         ++dim2) { // account for off diagonal elements
-      double sum = 0.0;
-      for (int pt = 0; pt < num_pts; ++pt) {
-        sum += desc_wrap(pt, dim) * desc_wrap(pt, dim2);
-      }
-      double A_ij =
-          covariance(dim, dim2) * (static_cast<double>(current_num_pts) - 1.0) +
-          static_cast<double>(current_num_pts) * current_mean(dim) *
-              current_mean(dim2) +
-          sum;
-      double B_ij = static_cast<double>(total_num_pts) * -1.0 * new_mean(dim) *
-                    new_mean(dim2);
-      covariance(dim, dim2) = 1.0 / (static_cast<double>(total_num_pts) - 1.0);
-      covariance(dim, dim2) *= (A_ij + B_ij);
-      covariance(dim2, dim) = covariance(dim, dim2);
-    } // account for off diagonal elements
+    mean_values[dim] = mean(dim);
+    for (int dim2 = 0; dim2 < num_dims; ++dim2) {
+      co_moments[static_cast<std::size_t>(dim) * num_dims + dim2] =
+          covariance(dim, dim2) * divisor;
+    }
   }
+  return DescriptorStatistics(num_pts, std::move(mean_values),
+                              std::move(co_moments), Moments::Full);
 }
 
 void checkForSymmetry(Matrix &matrix, const double threshold) {
@@ -20,27 +20,40 @@
 #include <vector>
 
 namespace panacea {
+
+class DescriptorStatistics;
+
 namespace covariance {
 
 /**
- * Provided a bunch of descriptors, cycle through each dimension of the
- * descriptors and calculate the mean.
+ * Adds the descriptors summarized by stats to a covariance matrix and mean.
+ *
+ * The third argument represents the total weight, the number of descriptor
+ * points unless they have been decayed, that was used to calculate the
+ * covariance matrix and mean before they were passed into this function. The
+ * covariance matrix must be unnormalized and stats must hold the full moments.
  **/
-void calculateMean(Vector &mean, const BaseDescriptorWrapper &desc_wrap);
+void mergeCovariance(Matrix &covariance, Vector &mean,
+                     const double current_weight,
+                     const DescriptorStatistics &stats);
 
 /**
- * Update the mean with a new batch of descriptors.
+ * Overwrites the covariance matrix and mean with those of stats.
  *
- * The third argument represents the total number of descriptor points that
- * were used to calculate the first argument (mean) before it was passed into
- * this function.
+ * Problematic matrices, those that are 0 everywhere, built from the weight of
+ * a single point or with 0's on the diagonal, are handled according to opt.
  **/
-void updateMean(Vector &mean, const BaseDescriptorWrapper &desc_wrap,
-                const int current_num_desc_pts);
+void buildCovariance(Matrix &covariance, Vector &mean,
+                     const DescriptorStatistics &stats,
+                     const CovarianceOption opt);
 
-void updateCovariance(Matrix &covariance, const Vector &current_mean,
-                      const Vector &new_mean, const int current_num_pts,
-                      const BaseDescriptorWrapper &desc_wrap);
+/**
+ * Statistics holding the mean and co-moments of an unnormalized covariance
+ * matrix that was built from num_pts points.
+ **/
+DescriptorStatistics covarianceStatistics(const Matrix &covariance,
+                                          const Vector &mean,
+                                          const int num_pts);
 
 /**
  * Check that the covariance matrix is symmetric.
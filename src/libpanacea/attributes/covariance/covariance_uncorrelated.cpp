@@ -4,9 +4,13 @@
 
 #include "attributes/covariance.hpp"
 #include "covariance_functions.hpp"
+#include "descriptors/descriptor_statistics.hpp"
+#include "descriptors/streaming_statistics.hpp"
 #include "error.hpp"
+#include "io/restart_read_context.hpp"
 #include "matrix/matrix.hpp"
 #include "type_map.hpp"
+#include "update_policy.hpp"
 #include "vector/vector.hpp"
 
 // Local public PANACEA includes
@@ -31,45 +35,20 @@ CovarianceUncorrelated::CovarianceUncorrelated(const CovarianceBuild memory) {
 }
 
 CovarianceUncorrelated::CovarianceUncorrelated(
-    const BaseDescriptorWrapper &desc_wrap, const CovarianceOption opt) {
+    const BaseDescriptorWrapper &desc_wrap, const CovarianceOption opt)
+    : CovarianceUncorrelated(DescriptorStatistics(desc_wrap), opt) {}
+
+CovarianceUncorrelated::CovarianceUncorrelated(
+    const DescriptorStatistics &stats, const CovarianceOption opt)
+    : option_(opt) {
   // Resize the covariance matrix based on the number of descriptor dimensions
-  const int num_dims = desc_wrap.getNumberDimensions();
+  const int num_dims = stats.getNumberDimensions();
   matrix_ = createMatrix(num_dims, num_dims);
   mean_ = createVector(num_dims);
+  covariance::buildCovariance(*matrix_.get(), *mean_.get(), stats, opt);
 
-  auto new_mean = createVector(num_dims);
-  mean_->setZero();
-  new_mean->setZero();
-
-  covariance::calculateMean(*new_mean.get(), desc_wrap);
-
-  matrix_->resize(num_dims, num_dims);
-  matrix_->setZero();
-
-  covariance::updateCovariance(*matrix_.get(), *mean_.get(), *new_mean.get(),
-                               total_number_data_pts_, desc_wrap);
-
-  if (isZero()) {
-    covariance::accountForZeroMatrix(opt, *matrix_.get());
-  } else if (desc_wrap.getNumberPoints() == 1) {
-    if (opt == CovarianceOption::Flexible) {
-      matrix_->makeIdentity();
-    } else {
-      std::string error_msg =
-          "You are trying to create covariance matrix with ";
-      error_msg +=
-          "a single point Either get a better starting data set or allow";
-      error_msg += " flexibility in the algorithm.";
-      PANACEA_FAIL(error_msg);
-    }
-  } else {
-    covariance::accountForZeroOnDiagonal(opt, *matrix_.get());
-    // Set any diagonal elements that are equal to 0.0 equal to 1.0
-  }
-
-  mean_ = std::move(new_mean);
   // Record the total number of data points used to create the covariance matrix
-  total_number_data_pts_ = desc_wrap.getNumberPoints();
+  total_number_data_pts_ = stats.getNumberPoints();
 }
 
 CovarianceUncorrelated::CovarianceUncorrelated(std::unique_ptr<Matrix> matrix,
@@ -77,7 +56,7 @@ CovarianceUncorrelated::CovarianceUncorrelated(std::unique_ptr<Matrix> matrix,
                                                int total_num_pts,
                                                const CovarianceOption opt)
     : matrix_(std::move(matrix)), mean_(std::move(mean)),
-      total_number_data_pts_(total_num_pts) {
+      total_number_data_pts_(total_num_pts), option_(opt) {
 
   assert(matrix_->rows() == matrix_->cols() &&
          "Covariance matrix must be square");
@@ -102,19 +81,41 @@ bool CovarianceUncorrelated::isZero(const double threshold) const noexcept {
 }
 
 void CovarianceUncorrelated::update(const BaseDescriptorWrapper &desc_wrap) {
+  update(DescriptorStatistics(desc_wrap));
+}
 
-  auto new_mean = createVector(mean_->rows());
-  for (int row = 0; row < mean_->rows(); ++row) {
-    new_mean->operator()(row) = mean_->operator()(row);
+void CovarianceUncorrelated::update(const DescriptorStatistics &stats) {
+  if (history_) {
+    history_->update(stats);
+    covariance::buildCovariance(*matrix_.get(), *mean_.get(),
+                                history_->statistics(), option_);
+  } else {
+    covariance::mergeCovariance(*matrix_.get(), *mean_.get(),
+                                total_number_data_pts_, stats);
   }
+  total_number_data_pts_ += stats.getNumberPoints();
+}
 
-  covariance::updateMean(*new_mean.get(), desc_wrap, total_number_data_pts_);
-
-  covariance::updateCovariance(*matrix_.get(), *mean_.get(), *new_mean.get(),
-                               total_number_data_pts_, desc_wrap);
+void CovarianceUncorrelated::set(const UpdatePolicy &policy) {
+  if (normalized_ == NormalizationState::Normalized) {
+    std::string error_msg = "The update policy of a covariance matrix can ";
+    error_msg += "only be set while it is unnormalized.";
+    PANACEA_FAIL(error_msg);
+  }
+  if (policy.is(settings::UpdateMode::Cumulative)) {
+    history_.reset();
+    return;
+  }
+  history_ = StreamingStatistics(
+      policy, covariance::covarianceStatistics(*matrix_.get(), *mean_.get(),
+                                               total_number_data_pts_));
+}
 
-  mean_ = std::move(new_mean);
-  total_number_data_pts_ += desc_wrap.getNumberPoints();
+UpdatePolicy CovarianceUncorrelated::getUpdatePolicy() const {
+  if (history_) {
+    return history_->policy();
+  }
+  return UpdatePolicy();
 }
 
 // This is how we make it correlated
@@ -243,11 +244,19 @@ CovarianceUncorrelated::write(const settings::FileType file_type,
 
   std::vector<std::any> nested_objs;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     os << cov_mat.total_number_data_pts_ << "\n\n";
     os << "[Normalization State]\n";
     os << cov_mat.normalized_ << "\n\n";
+    os << "[Update History]\n";
+    os << cov_mat.option_ << "\n";
+    os << (cov_mat.history_ ? 1 : 0) << "\n";
+    if (cov_mat.history_) {
+      StreamingStatistics::write(*cov_mat.history_, os);
+    }
+    os << "\n";
     // Note order of writing out the covariance matrix must be the
     // same as order of reading in
     nested_objs.push_back(cov_mat.matrix_.get());
@@ -304,6 +313,7 @@ CovarianceUncorrelated::read(const settings::FileType file_type,
 
   io::ReadInstantiateVector nested_objs;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
@@ -337,6 +347,25 @@ CovarianceUncorrelated::read(const settings::FileType file_type,
       cov_mat.normalized_ = NormalizationState::Unnormalized;
     }
 
+    // Restart files written before update modes were added do not have an
+    // update history, the updates were cumulative
+    int has_history = 0;
+    if (io::readOptionalTag(is, "[Update History]")) {
+      is >> cov_mat.option_;
+      if (not(is >> has_history)) {
+        std::string error_msg = "Unable to read whether the covariance ";
+        error_msg += "matrix has an update history from restart file.";
+        PANACEA_FAIL(error_msg);
+      }
+    }
+    if (has_history) {
+      StreamingStatistics history;
+      StreamingStatistics::read(history, is);
+      cov_mat.history_ = std::move(history);
+    } else {
+      cov_mat.history_.reset();
+    }
+
     // Check to see if memory has been allocated to the internal vector and
     // matrix
     if (cov_mat.matrix_.get() == nullptr) {
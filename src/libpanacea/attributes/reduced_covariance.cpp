@@ -6,13 +6,43 @@
 
 // Private local PANACEA includes
 #include "reduced_covariance.hpp"
+
+#include "constants.hpp"
 #include "dimensions.hpp"
 
 // Standard includes
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace panacea {
 
+void ReducedCovariance::factorize_() {
+  if (matrix_ == nullptr || matrix_->rows() == 0) {
+    return;
+  }
+  const double number_dimensions = static_cast<double>(matrix_->rows());
+  cholesky_factor_ = choleskyFactor(*matrix_);
+  if (cholesky_factor_) {
+    // det = prod L_ii^2
+    log_determinant_ = 0.0;
+    for (int dim = 0; dim < cholesky_factor_->rows(); ++dim) {
+      log_determinant_ += std::log((*cholesky_factor_)(dim, dim));
+    }
+    log_determinant_ *= 2.0;
+    determinant_ = std::exp(log_determinant_);
+  } else {
+    determinant_ = matrix_->getDeterminant();
+    log_determinant_ = determinant_ > 0.0
+                           ? std::log(determinant_)
+                           : -std::numeric_limits<double>::infinity();
+  }
+  gaussian_log_pre_factor_ =
+      -0.5 * (log_determinant_ +
+              number_dimensions * std::log(2.0 * constants::PI));
+  gaussian_pre_factor_ = std::exp(gaussian_log_pre_factor_);
+}
+
 double ReducedCovariance::operator()(const int row, const int col) const {
   return matrix_->operator()(row, col);
 }
@@ -21,8 +51,23 @@ const Matrix &ReducedCovariance::get(PassKey<Inverter>) const {
   return *matrix_.get();
 }
 
-double ReducedCovariance::getDeterminant() const {
-  return matrix_->getDeterminant();
+const Matrix *ReducedCovariance::getCholeskyFactor(PassKey<Inverter>) const
+    noexcept {
+  return cholesky_factor_.get();
+}
+
+double ReducedCovariance::getDeterminant() const { return determinant_; }
+
+double ReducedCovariance::getLogDeterminant() const noexcept {
+  return log_determinant_;
+}
+
+double ReducedCovariance::getGaussianPreFactor() const noexcept {
+  return gaussian_pre_factor_;
+}
+
+double ReducedCovariance::getGaussianLogPreFactor() const noexcept {
+  return gaussian_log_pre_factor_;
 }
 
 int ReducedCovariance::getNumberDimensions() const {
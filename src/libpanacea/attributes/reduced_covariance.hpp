@@ -27,6 +27,21 @@ private:
 
   NormalizationState normalized_ = NormalizationState::Unnormalized;
 
+  // The matrix does not change after construction, it is factorized once and
+  // the determinant and the Gaussian prefactor that depend on the factor are
+  // shared by every primitive of a group. A changed covariance is reduced
+  // again, which creates a new object with its own factorization.
+  //
+  // The factor is a nullptr if the matrix is not positive definite, in which
+  // case the determinant comes from an LU decomposition.
+  std::unique_ptr<Matrix> cholesky_factor_;
+  double determinant_ = 0.0;
+  double log_determinant_ = 0.0;
+  double gaussian_pre_factor_ = 0.0;
+  double gaussian_log_pre_factor_ = 0.0;
+
+  void factorize_();
+
 public:
   ReducedCovariance(PassKey<Reducer>);
   ReducedCovariance(PassKey<Reducer> key, std::unique_ptr<Matrix> matrix,
@@ -34,10 +49,18 @@ public:
                     const NormalizationState &normalized)
       : matrix_(std::move(matrix)),
         chosen_dimension_indices_(chosen_dimension_indices),
-        normalized_(normalized){};
+        normalized_(normalized) {
+    factorize_();
+  }
 
   const Matrix &get(PassKey<Inverter>) const;
 
+  /**
+   * Lower triangular Cholesky factor of the matrix or a nullptr if the matrix
+   * is not positive definite.
+   **/
+  const Matrix *getCholeskyFactor(PassKey<Inverter>) const noexcept;
+
   ReducedCovariance() = delete;
 
   double operator()(const int row, const int col) const;
@@ -48,6 +71,28 @@ public:
   const NormalizationState &getNormalizationState() const noexcept;
 
   double getDeterminant() const;
+
+  /**
+   * Natural log of the determinant, -infinity if the determinant is not
+   * positive. Unlike the determinant it does not under or overflow when
+   * there are many dimensions.
+   **/
+  double getLogDeterminant() const noexcept;
+
+  /**
+   * Normalization constant of a Gaussian with this covariance
+   *
+   * 1 / ( sqrt(det) * (2 pi)^(n/2) ) with n the number of dimensions.
+   **/
+  double getGaussianPreFactor() const noexcept;
+
+  /**
+   * Natural log of the Gaussian normalization constant, for evaluating
+   * densities in log space.
+   *
+   * -0.5 * ( log(det) + n log(2 pi) )
+   **/
+  double getGaussianLogPreFactor() const noexcept;
   int getNumberDimensions() const;
   const Dimensions &getReducedDimensions() const noexcept;
 };
@@ -7,6 +7,18 @@
 
 namespace panacea {
 
+void ReducedInvCovariance::indexChosenDimensions_() {
+  reduced_index_.clear();
+  int index = 0;
+  for (const int dim : chosen_dimension_indices_) {
+    if (dim >= static_cast<int>(reduced_index_.size())) {
+      reduced_index_.resize(dim + 1, -1);
+    }
+    reduced_index_[dim] = index;
+    ++index;
+  }
+}
+
 double ReducedInvCovariance::operator()(const int row, const int col) const {
   return (*matrix_)(row, col);
 }
@@ -21,6 +33,13 @@ const Dimensions &ReducedInvCovariance::getChosenDimensionIndices() const {
   return chosen_dimension_indices_;
 }
 
+int ReducedInvCovariance::getReducedIndex(const int dim) const noexcept {
+  if (dim < 0 || dim >= static_cast<int>(reduced_index_.size())) {
+    return -1;
+  }
+  return reduced_index_[dim];
+}
+
 void ReducedInvCovariance::print() const {
   std::cout << "Reduced Inverse Covariance Matrix\n";
   matrix_->print();
@@ -26,6 +26,12 @@ private:
 
   NormalizationState normalized_ = NormalizationState::Unnormalized;
 
+  // Position of each descriptor dimension in the reduced matrix, -1 if the
+  // dimension was not chosen
+  std::vector<int> reduced_index_;
+
+  void indexChosenDimensions_();
+
 public:
   ReducedInvCovariance() = delete;
   ReducedInvCovariance(PassKey<Inverter>, std::unique_ptr<Matrix> matrix,
@@ -33,7 +39,9 @@ public:
                        const NormalizationState &normalized)
       : matrix_(std::move(matrix)),
         chosen_dimension_indices_(chosen_dimension_indices),
-        normalized_(normalized){};
+        normalized_(normalized) {
+    indexChosenDimensions_();
+  }
 
   double operator()(const int row, const int col) const;
 
@@ -46,6 +54,12 @@ public:
   int getNumberDimensions() const;
   const Dimensions &getChosenDimensionIndices() const;
 
+  /**
+   * Returns the row and column of the descriptor dimension in the reduced
+   * matrix or -1 if the dimension is not one of the chosen dimensions.
+   **/
+  int getReducedIndex(const int dim) const noexcept;
+
   bool is(const NormalizationState &state) const noexcept;
   const NormalizationState &getNormalizationState() const noexcept;
 };
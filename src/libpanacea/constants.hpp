@@ -11,6 +11,10 @@ const double PI_SQRT = 1.77245385091;
 const double SQRT_2 = 1.41421356237;
 
 const int automate = -1;
+
+// Size of the blocks of kernel centers that are paged in at a time when the
+// kernels are backed by a memory mapped file
+const int kernel_stream_block_bytes = 1 << 20;
 } // namespace constants
 } // namespace panacea
 #endif // PANACEA_PRIVATE_CONSTANTS_H
@@ -0,0 +1,6 @@
+// Public PANACEA includes
+#include "panacea/base_descriptor_summary.hpp"
+
+namespace panacea {
+BaseDescriptorSummary::~BaseDescriptorSummary(){};
+} // namespace panacea
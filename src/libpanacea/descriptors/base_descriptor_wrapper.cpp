@@ -4,18 +4,44 @@
 
 // Local private PANACEA includes
 #include "data_point_template.hpp"
+#include "error.hpp"
+#include "io/txt_numbers.hpp"
+#include "memory_mapped_array.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io_types.hpp"
 
 // Standard includes
 #include <any>
-#include <iomanip>
 #include <iostream>
 #include <vector>
 
 namespace panacea {
 
+/************************************************
+ * File scope functions
+ ************************************************/
+
+// Value stored at the row and column of the wrapped data, independent of the
+// arrangement
+static double rawValue(const BaseDescriptorWrapper &dwrapper, const int row,
+                       const int col) {
+  if (dwrapper.arrangement() ==
+      Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    return dwrapper(row, col);
+  }
+  return dwrapper(col, row);
+}
+
+static double &rawValue(BaseDescriptorWrapper &dwrapper, const int row,
+                        const int col) {
+  if (dwrapper.arrangement() ==
+      Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    return dwrapper(row, col);
+  }
+  return dwrapper(col, row);
+}
+
 std::vector<std::any>
 BaseDescriptorWrapper::write(const settings::FileType file_type,
                              std::ostream &os, std::any dwrapper_instance) {
@@ -52,11 +78,30 @@ BaseDescriptorWrapper::write(const settings::FileType file_type,
     os << dwrapper.rows() << " " << dwrapper.cols() << "\n";
     for (int row = 0; row < dwrapper.rows(); ++row) {
       for (int col = 0; col < dwrapper.cols(); ++col) {
-        os << std::setfill(' ') << std::setw(14) << std::setprecision(8)
-           << std::right << dwrapper(row, col) << " ";
+        io::writeDouble(os, dwrapper(row, col), 14);
+        os << " ";
       }
       os << "\n";
     }
+  } else if (file_type == settings::FileType::BinaryDescriptors) {
+    if (not littleEndianHost()) {
+      PANACEA_FAIL("Binary descriptor files require a little endian host.");
+    }
+    BinaryArrayHeader header;
+    header.layout = MemoryLayout::RowMajor;
+    header.arrangement = dwrapper.arrangement();
+    header.rows = dwrapper.rows();
+    header.cols = dwrapper.cols();
+    header.write(os);
+
+    std::vector<double> row_values(dwrapper.cols());
+    for (int row = 0; row < dwrapper.rows(); ++row) {
+      for (int col = 0; col < dwrapper.cols(); ++col) {
+        row_values[col] = rawValue(dwrapper, row, col);
+      }
+      os.write(reinterpret_cast<const char *>(row_values.data()),
+               row_values.size() * sizeof(double));
+    }
   }
   return std::vector<std::any>();
 }
@@ -148,14 +193,12 @@ BaseDescriptorWrapper::read(const settings::FileType file_type,
 
     try {
 
+      std::vector<double> values;
+      io::readBlock(is, rows, cols, values);
       dwrapper.resize(rows, cols);
       for (int row = 0; row < rows; ++row) {
-        std::getline(is, line);
-        std::istringstream ss_data(line);
         for (int col = 0; col < cols; ++col) {
-          double value;
-          ss_data >> value;
-          dwrapper(row, col) = value;
+          dwrapper(row, col) = values[row * cols + col];
         }
       }
     } catch (...) {
@@ -166,6 +209,43 @@ BaseDescriptorWrapper::read(const settings::FileType file_type,
       PANACEA_FAIL(error_msg);
     }
 
+  } else if (file_type == settings::FileType::BinaryDescriptors) {
+    if (not littleEndianHost()) {
+      PANACEA_FAIL("Binary descriptor files require a little endian host.");
+    }
+    const BinaryArrayHeader header = BinaryArrayHeader::read(is);
+    // Nothing is allocated for values that are not in the file
+    header.checkAvailable(is);
+    const int rows = static_cast<int>(header.rows);
+    const int cols = static_cast<int>(header.cols);
+
+    dwrapper.set(header.arrangement);
+    dwrapper.resize(rows, cols);
+
+    // Values are read one row, or column if column major, at a time
+    const bool row_major = header.layout != MemoryLayout::ColumnMajor;
+    const int outer = row_major ? rows : cols;
+    const int inner = row_major ? cols : rows;
+    std::vector<double> values(inner);
+    for (int index = 0; index < outer; ++index) {
+      is.read(reinterpret_cast<char *>(values.data()),
+              values.size() * sizeof(double));
+      if (is.gcount() !=
+          static_cast<std::streamsize>(values.size() * sizeof(double))) {
+        std::string error_msg =
+            "Binary descriptor file is truncated, expected ";
+        error_msg += std::to_string(rows) + " rows and ";
+        error_msg += std::to_string(cols) + " columns.";
+        PANACEA_FAIL(error_msg);
+      }
+      for (int inner_index = 0; inner_index < inner; ++inner_index) {
+        if (row_major) {
+          rawValue(dwrapper, index, inner_index) = values[inner_index];
+        } else {
+          rawValue(dwrapper, inner_index, index) = values[inner_index];
+        }
+      }
+    }
   } else {
     std::string error_msg =
         "Descriptors cannot be written to the specified file type.";
@@ -174,5 +254,14 @@ BaseDescriptorWrapper::read(const settings::FileType file_type,
   return io::ReadInstantiateVector();
 }
 
+void BaseDescriptorWrapper::setLayoutCache(
+    const settings::LayoutCache layout_cache) noexcept {
+  layout_cache_ = layout_cache;
+}
+
+settings::LayoutCache BaseDescriptorWrapper::getLayoutCache() const noexcept {
+  return layout_cache_;
+}
+
 BaseDescriptorWrapper::~BaseDescriptorWrapper(){};
 } // namespace panacea
@@ -0,0 +1,406 @@
+
+// Local private PANACEA includes
+#include "descriptor_statistics.hpp"
+
+#include "error.hpp"
+#include "sparse_descriptor_wrapper.hpp"
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace panacea {
+
+namespace {
+// Target size of the block of points that is reduced while in cache
+constexpr std::size_t block_bytes = 1 << 15;
+// Below this amount of work the statistics are gathered on the calling thread
+constexpr std::size_t parallel_threshold = 1 << 18;
+} // namespace
+
+/************************************************
+ * Private Methods
+ ************************************************/
+
+std::size_t DescriptorStatistics::index_(const int dim1,
+                                         const int dim2) const noexcept {
+  if (moments_ == Moments::Diagonal) {
+    return dim1;
+  }
+  // Only the upper triangle is accumulated
+  return static_cast<std::size_t>(std::min(dim1, dim2)) * number_dimensions_ +
+         std::max(dim1, dim2);
+}
+
+void DescriptorStatistics::accumulate_(const BaseDescriptorWrapper &dwrapper,
+                                       const int pt_begin, const int pt_end) {
+
+  const int ndim = number_dimensions_;
+  const int block = static_cast<int>(std::max<std::size_t>(
+      1, block_bytes / (std::max(1, ndim) * sizeof(double))));
+  std::vector<double> values(static_cast<std::size_t>(block) * ndim);
+  DescriptorStatistics block_stats(ndim, moments_);
+
+  for (int start = pt_begin; start < pt_end; start += block) {
+    const int num_pts = std::min(block, pt_end - start);
+
+    // The only read of the descriptors, the block is then reused from cache
+    for (int pt = 0; pt < num_pts; ++pt) {
+      double *row = values.data() + static_cast<std::size_t>(pt) * ndim;
+      for (int dim = 0; dim < ndim; ++dim) {
+        row[dim] = dwrapper(start + pt, dim);
+      }
+    }
+
+    block_stats.number_points_ = num_pts;
+    block_stats.weight_ = num_pts;
+    std::copy(values.begin(), values.begin() + ndim, block_stats.min_.begin());
+    std::copy(values.begin(), values.begin() + ndim, block_stats.max_.begin());
+    std::fill(block_stats.mean_.begin(), block_stats.mean_.end(), 0.0);
+    std::fill(block_stats.co_moments_.begin(), block_stats.co_moments_.end(),
+              0.0);
+    for (int pt = 0; pt < num_pts; ++pt) {
+      const double *row = values.data() + static_cast<std::size_t>(pt) * ndim;
+      for (int dim = 0; dim < ndim; ++dim) {
+        block_stats.mean_[dim] += row[dim];
+        block_stats.min_[dim] = std::min(block_stats.min_[dim], row[dim]);
+        block_stats.max_[dim] = std::max(block_stats.max_[dim], row[dim]);
+      }
+    }
+    const double inv_num_pts = 1.0 / static_cast<double>(num_pts);
+    for (auto &mean : block_stats.mean_) {
+      mean *= inv_num_pts;
+    }
+
+    // Deviations from the block mean are formed in place
+    for (int pt = 0; pt < num_pts; ++pt) {
+      double *row = values.data() + static_cast<std::size_t>(pt) * ndim;
+      for (int dim = 0; dim < ndim; ++dim) {
+        row[dim] -= block_stats.mean_[dim];
+      }
+      if (moments_ == Moments::Full) {
+        for (int dim = 0; dim < ndim; ++dim) {
+          double *co_moments = block_stats.co_moments_.data() +
+                               static_cast<std::size_t>(dim) * ndim;
+          const double deviation = row[dim];
+          for (int dim2 = dim; dim2 < ndim; ++dim2) {
+            co_moments[dim2] += deviation * row[dim2];
+          }
+        }
+      } else {
+        for (int dim = 0; dim < ndim; ++dim) {
+          block_stats.co_moments_[dim] += row[dim] * row[dim];
+        }
+      }
+    }
+    merge(block_stats);
+  }
+}
+
+void DescriptorStatistics::accumulateSparse_(const CompressedSparseRows &csr) {
+
+  // Sums and sums of products of the non zero values, the zeros do not
+  // contribute to either
+  const int ndim = number_dimensions_;
+  std::vector<int> non_zeros(ndim, 0);
+  for (int row = 0; row < csr.rows; ++row) {
+    for (int index = csr.row_offsets[row]; index < csr.row_offsets[row + 1];
+         ++index) {
+      const int dim = csr.col_indices[index];
+      const double value = csr.values[index];
+      if (non_zeros[dim] == 0) {
+        min_[dim] = value;
+        max_[dim] = value;
+      } else {
+        min_[dim] = std::min(min_[dim], value);
+        max_[dim] = std::max(max_[dim], value);
+      }
+      ++non_zeros[dim];
+      mean_[dim] += value;
+      if (moments_ == Moments::Full) {
+        double *co_moments =
+            co_moments_.data() + static_cast<std::size_t>(dim) * ndim;
+        for (int index2 = index; index2 < csr.row_offsets[row + 1];
+             ++index2) {
+          co_moments[csr.col_indices[index2]] += value * csr.values[index2];
+        }
+      } else {
+        co_moments_[dim] += value * value;
+      }
+    }
+  }
+
+  number_points_ = csr.rows;
+  weight_ = csr.rows;
+  if (number_points_ == 0) {
+    return;
+  }
+  const double num_pts = static_cast<double>(number_points_);
+  for (int dim = 0; dim < ndim; ++dim) {
+    mean_[dim] /= num_pts;
+    // Implicit zeros take part in the range as well
+    if (non_zeros[dim] < csr.rows) {
+      min_[dim] = std::min(min_[dim], 0.0);
+      max_[dim] = std::max(max_[dim], 0.0);
+    }
+  }
+  // Convert the sums of products into co-moments about the mean
+  for (int dim = 0; dim < ndim; ++dim) {
+    if (moments_ == Moments::Full) {
+      for (int dim2 = dim; dim2 < ndim; ++dim2) {
+        co_moments_[index_(dim, dim2)] -= num_pts * mean_[dim] * mean_[dim2];
+      }
+    } else {
+      co_moments_[dim] -= num_pts * mean_[dim] * mean_[dim];
+    }
+  }
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+DescriptorStatistics::DescriptorStatistics(const int number_dimensions,
+                                           const Moments moments)
+    : number_dimensions_(number_dimensions), moments_(moments),
+      mean_(number_dimensions, 0.0),
+      co_moments_(moments == Moments::Full
+                      ? static_cast<std::size_t>(number_dimensions) *
+                            number_dimensions
+                      : number_dimensions,
+                  0.0),
+      min_(number_dimensions, 0.0), max_(number_dimensions, 0.0) {}
+
+DescriptorStatistics::DescriptorStatistics(
+    const BaseDescriptorWrapper &dwrapper, const Moments moments)
+    : DescriptorStatistics(dwrapper.getNumberDimensions(), moments) {
+
+  if (const CompressedSparseRows *csr = sparseData(dwrapper)) {
+    accumulateSparse_(*csr);
+    return;
+  }
+
+  const int num_pts = dwrapper.getNumberPoints();
+  const std::size_t work =
+      static_cast<std::size_t>(num_pts) * number_dimensions_ *
+      (moments == Moments::Full ? number_dimensions_ : 1);
+  int threads = 1;
+  if (work >= parallel_threshold) {
+    threads =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    threads = std::min(threads, num_pts);
+  }
+  if (threads == 1) {
+    accumulate_(dwrapper, 0, num_pts);
+    return;
+  }
+
+  // Each thread reduces a contiguous range of points, the partial results
+  // are merged in order so the result does not depend on timing
+  auto range_begin = [&](const int thread) {
+    return static_cast<int>(static_cast<long long>(num_pts) * thread /
+                            threads);
+  };
+  std::vector<DescriptorStatistics> partials(
+      threads, DescriptorStatistics(number_dimensions_, moments));
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (int thread = 1; thread < threads; ++thread) {
+    workers.emplace_back([&, thread]() {
+      partials[thread].accumulate_(dwrapper, range_begin(thread),
+                                   range_begin(thread + 1));
+    });
+  }
+  partials[0].accumulate_(dwrapper, 0, range_begin(1));
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (const auto &partial : partials) {
+    merge(partial);
+  }
+}
+
+DescriptorStatistics::DescriptorStatistics(const int number_points,
+                                           std::vector<double> mean,
+                                           std::vector<double> co_moments,
+                                           const Moments moments)
+    : number_points_(number_points), weight_(number_points),
+      number_dimensions_(static_cast<int>(mean.size())), moments_(moments),
+      mean_(std::move(mean)), co_moments_(std::move(co_moments)),
+      min_(number_dimensions_, std::numeric_limits<double>::lowest()),
+      max_(number_dimensions_, std::numeric_limits<double>::max()) {
+  const std::size_t num_co_moments =
+      moments == Moments::Full
+          ? static_cast<std::size_t>(number_dimensions_) * number_dimensions_
+          : number_dimensions_;
+  if (co_moments_.size() != num_co_moments) {
+    std::string error_msg = "Descriptor statistics with ";
+    error_msg += std::to_string(number_dimensions_) + " dimensions require ";
+    error_msg += std::to_string(num_co_moments) + " co-moments, ";
+    error_msg += std::to_string(co_moments_.size()) + " were provided.";
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+void DescriptorStatistics::merge(const DescriptorStatistics &stats) {
+  if (stats.number_dimensions_ != number_dimensions_ ||
+      stats.moments_ != moments_) {
+    std::string error_msg = "Cannot merge descriptor statistics with ";
+    error_msg += "different dimensions or moments.";
+    PANACEA_FAIL(error_msg);
+  }
+  if (stats.number_points_ == 0) {
+    return;
+  }
+  if (number_points_ == 0) {
+    *this = stats;
+    return;
+  }
+
+  const int ndim = number_dimensions_;
+  const double num_pts_a = weight_;
+  const double num_pts_b = stats.weight_;
+  const double num_pts = num_pts_a + num_pts_b;
+  const double factor = num_pts_a * num_pts_b / num_pts;
+
+  std::vector<double> delta(ndim);
+  for (int dim = 0; dim < ndim; ++dim) {
+    delta[dim] = stats.mean_[dim] - mean_[dim];
+  }
+  for (int dim = 0; dim < ndim; ++dim) {
+    if (moments_ == Moments::Full) {
+      const std::size_t offset = static_cast<std::size_t>(dim) * ndim;
+      for (int dim2 = dim; dim2 < ndim; ++dim2) {
+        co_moments_[offset + dim2] += stats.co_moments_[offset + dim2] +
+                                      delta[dim] * delta[dim2] * factor;
+      }
+    } else {
+      co_moments_[dim] += stats.co_moments_[dim] + delta[dim] * delta[dim] *
+                                                       factor;
+    }
+    mean_[dim] += delta[dim] * num_pts_b / num_pts;
+    min_[dim] = std::min(min_[dim], stats.min_[dim]);
+    max_[dim] = std::max(max_[dim], stats.max_[dim]);
+  }
+  number_points_ += stats.number_points_;
+  weight_ += stats.weight_;
+}
+
+void DescriptorStatistics::decay(const double factor) {
+  assert(factor > 0.0 && factor <= 1.0);
+  weight_ *= factor;
+  for (auto &co_moment : co_moments_) {
+    co_moment *= factor;
+  }
+}
+
+DescriptorStatistics DescriptorStatistics::diagonal() const {
+  if (moments_ == Moments::Diagonal) {
+    return *this;
+  }
+  DescriptorStatistics stats(*this);
+  stats.moments_ = Moments::Diagonal;
+  stats.co_moments_.resize(number_dimensions_);
+  for (int dim = 0; dim < number_dimensions_; ++dim) {
+    stats.co_moments_[dim] = co_moments_[index_(dim, dim)];
+  }
+  return stats;
+}
+
+double DescriptorStatistics::getCoMoment(const int dim1,
+                                         const int dim2) const {
+  assert(dim1 >= 0 && dim1 < number_dimensions_);
+  assert(dim2 >= 0 && dim2 < number_dimensions_);
+  if (moments_ == Moments::Diagonal && dim1 != dim2) {
+    std::string error_msg = "Off diagonal co-moments are only available if ";
+    error_msg += "the full moments of the descriptors were gathered.";
+    PANACEA_FAIL(error_msg);
+  }
+  return co_moments_[index_(dim1, dim2)];
+}
+
+double DescriptorStatistics::getVariance(const int dim) const {
+  if (weight_ <= 1.0) {
+    return 0.0;
+  }
+  return getCoMoment(dim, dim) / (weight_ - 1.0);
+}
+
+std::vector<int> DescriptorStatistics::getStackedDimensions() const {
+  std::vector<int> stacked_dims;
+  if (number_points_ == 0) {
+    return stacked_dims;
+  }
+  for (int dim = 0; dim < number_dimensions_; ++dim) {
+    if (min_[dim] == max_[dim]) {
+      stacked_dims.push_back(dim);
+    }
+  }
+  return stacked_dims;
+}
+
+std::istream &DescriptorStatistics::read(DescriptorStatistics &stats,
+                                         std::istream &is) {
+  std::string line = "";
+  is >> std::ws;
+  std::getline(is, line);
+  std::istringstream ss(line);
+  std::string moments = "";
+  if (not(ss >> moments >> stats.number_dimensions_ >> stats.number_points_ >>
+          stats.weight_) ||
+      (moments != "Full" && moments != "Diagonal")) {
+    std::string error_msg = "Unable to read the moments, number of dimensions,";
+    error_msg += " number of points and weight of descriptor statistics.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  stats.moments_ = moments == "Full" ? Moments::Full : Moments::Diagonal;
+
+  const int ndim = stats.number_dimensions_;
+  stats.mean_.resize(ndim);
+  stats.min_.resize(ndim);
+  stats.max_.resize(ndim);
+  stats.co_moments_.resize(stats.moments_ == Moments::Full
+                               ? static_cast<std::size_t>(ndim) * ndim
+                               : ndim);
+  for (auto *values :
+       {&stats.mean_, &stats.min_, &stats.max_, &stats.co_moments_}) {
+    for (auto &value : *values) {
+      if (not(is >> value)) {
+        std::string error_msg = "Unable to read the values of descriptor ";
+        error_msg += "statistics.";
+        PANACEA_FAIL(error_msg);
+      }
+    }
+  }
+  return is;
+}
+
+std::ostream &DescriptorStatistics::write(const DescriptorStatistics &stats,
+                                          std::ostream &os) {
+  // Values are written with enough digits to be read back exactly
+  const auto precision =
+      os.precision(std::numeric_limits<double>::max_digits10);
+  os << (stats.moments_ == Moments::Full ? "Full" : "Diagonal") << " "
+     << stats.number_dimensions_ << " " << stats.number_points_ << " "
+     << stats.weight_ << "\n";
+  for (const auto *values :
+       {&stats.mean_, &stats.min_, &stats.max_, &stats.co_moments_}) {
+    for (const auto &value : *values) {
+      os << value << " ";
+    }
+    os << "\n";
+  }
+  os.precision(precision);
+  return os;
+}
+
+} // namespace panacea
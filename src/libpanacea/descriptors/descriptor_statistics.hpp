@@ -0,0 +1,131 @@
+#ifndef PANACEA_PRIVATE_DESCRIPTORSTATISTICS_H
+#define PANACEA_PRIVATE_DESCRIPTORSTATISTICS_H
+#pragma once
+
+// Standard includes
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+struct CompressedSparseRows;
+
+/**
+ * Which second order moments are accumulated
+ *
+ * Diagonal - only the sum of squared deviations of each dimension, O(d) work
+ *            per point
+ * Full - the sum of products of deviations of every pair of dimensions,
+ *        O(d * d) work per point
+ **/
+enum class Moments { Diagonal, Full };
+
+/**
+ * Statistics of a set of descriptors gathered in a single pass
+ *
+ * The number of points, mean, co-moments (sums of products of deviations
+ * from the mean), minimum and maximum of every dimension are computed in one
+ * sweep over the descriptors. The points are read in small blocks which are
+ * reduced while they are still in cache, large descriptor sets are split into
+ * ranges of points that are reduced on separate threads and then merged.
+ *
+ * The mean kernel, the covariance matrix and the variance normalization all
+ * read their values from here instead of each walking the descriptors.
+ *
+ * Besides the number of points the statistics carry a weight, the two are
+ * equal unless the statistics have been decayed, the mean and co-moments are
+ * combined according to the weights.
+ **/
+class DescriptorStatistics {
+private:
+  int number_points_ = 0;
+  double weight_ = 0.0;
+  int number_dimensions_ = 0;
+  Moments moments_ = Moments::Full;
+  std::vector<double> mean_;
+  // Row major number_dimensions_ x number_dimensions_ if moments_ is Full
+  // otherwise only the diagonal is stored
+  std::vector<double> co_moments_;
+  std::vector<double> min_;
+  std::vector<double> max_;
+
+  std::size_t index_(const int dim1, const int dim2) const noexcept;
+  void accumulate_(const BaseDescriptorWrapper &dwrapper, const int pt_begin,
+                   const int pt_end);
+  void accumulateSparse_(const CompressedSparseRows &csr);
+
+public:
+  DescriptorStatistics() = default;
+
+  /**
+   * Statistics of an empty set of points.
+   **/
+  DescriptorStatistics(const int number_dimensions, const Moments moments);
+
+  explicit DescriptorStatistics(const BaseDescriptorWrapper &dwrapper,
+                                const Moments moments = Moments::Full);
+
+  /**
+   * Statistics of points that are only known through their mean and
+   * co-moments, e.g. a covariance matrix that was built earlier.
+   *
+   * The co-moments are row major number_dimensions x number_dimensions if
+   * the moments are Full and the diagonal otherwise. As the individual values
+   * are not known the minimum and maximum are left unbounded.
+   **/
+  DescriptorStatistics(const int number_points, std::vector<double> mean,
+                       std::vector<double> co_moments, const Moments moments);
+
+  /**
+   * Combines the statistics of two disjoint sets of points.
+   **/
+  void merge(const DescriptorStatistics &stats);
+
+  /**
+   * Multiplies the weight and co-moments by a factor in (0, 1], the mean,
+   * number of points, minimum and maximum are unchanged.
+   **/
+  void decay(const double factor);
+
+  /**
+   * Copy that only holds the diagonal moments.
+   **/
+  DescriptorStatistics diagonal() const;
+
+  int getNumberPoints() const noexcept { return number_points_; }
+  double getWeight() const noexcept { return weight_; }
+  int getNumberDimensions() const noexcept { return number_dimensions_; }
+  Moments moments() const noexcept { return moments_; }
+
+  double getMean(const int dim) const { return mean_.at(dim); }
+  const std::vector<double> &getMean() const noexcept { return mean_; }
+
+  /**
+   * Sum over the points of the products of the deviations from the mean,
+   * off diagonal values are only available if the moments are Full.
+   **/
+  double getCoMoment(const int dim1, const int dim2) const;
+
+  /**
+   * Sample variance of a dimension, co-moment / (weight - 1), 0.0 if the
+   * weight is no more than that of a single point.
+   **/
+  double getVariance(const int dim) const;
+
+  double getMin(const int dim) const { return min_.at(dim); }
+  double getMax(const int dim) const { return max_.at(dim); }
+
+  /**
+   * Dimensions in which every point has the same value.
+   **/
+  std::vector<int> getStackedDimensions() const;
+
+  static std::istream &read(DescriptorStatistics &stats, std::istream &is);
+  static std::ostream &write(const DescriptorStatistics &stats,
+                             std::ostream &os);
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_DESCRIPTORSTATISTICS_H
@@ -0,0 +1,281 @@
+
+// Local private PANACEA includes
+#include "descriptor_summary.hpp"
+
+#include "attribute_manipulators/normalizer.hpp"
+#include "error.hpp"
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+/************************************************
+ * Local functions
+ ************************************************/
+
+namespace {
+
+/**
+ * Bin of the histogram spanning [min, min + number_bins * width) that holds
+ * the value, the maximum is placed in the last bin.
+ **/
+int bin(const double value, const double min, const double width,
+        const int number_bins) {
+  if (width <= 0.0) {
+    return 0;
+  }
+  const int index = static_cast<int>((value - min) / width);
+  return std::clamp(index, 0, number_bins - 1);
+}
+
+} // namespace
+
+/************************************************
+ * Private Methods
+ ************************************************/
+
+/**
+ * Histogram of a dimension spread over number_bins_ bins spanning
+ * [min, max], the counts of each bin are shared among the new bins it
+ * overlaps in proportion to the overlap.
+ **/
+std::vector<double> DescriptorSummary::rebin_(const int dim, const double min,
+                                              const double max) const {
+  std::vector<double> rebinned(number_bins_, 0.0);
+  const double old_width = getBinWidth(dim);
+  const double new_width = (max - min) / number_bins_;
+  const double *counts =
+      histograms_.data() + static_cast<std::size_t>(dim) * number_bins_;
+  for (int old_bin = 0; old_bin < number_bins_; ++old_bin) {
+    if (counts[old_bin] == 0.0) {
+      continue;
+    }
+    const double lower = getBinLower(dim, old_bin);
+    if (old_width <= 0.0 || new_width <= 0.0) {
+      // Every point of a dimension without a range shares the same value
+      rebinned[bin(lower, min, new_width, number_bins_)] += counts[old_bin];
+      continue;
+    }
+    const double upper = lower + old_width;
+    const int first = bin(lower, min, new_width, number_bins_);
+    const int last = bin(upper, min, new_width, number_bins_);
+    for (int new_bin = first; new_bin <= last; ++new_bin) {
+      const double new_lower = min + new_bin * new_width;
+      const double overlap = std::min(upper, new_lower + new_width) -
+                             std::max(lower, new_lower);
+      if (overlap > 0.0) {
+        rebinned[new_bin] += counts[old_bin] * overlap / old_width;
+      }
+    }
+  }
+  return rebinned;
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+DescriptorSummary::DescriptorSummary(const BaseDescriptorWrapper &dwrapper,
+                                     const int number_bins)
+    : statistics_(dwrapper, Moments::Full), number_bins_(number_bins) {
+
+  if (number_bins < 1) {
+    std::string error_msg = "A descriptor summary requires at least one ";
+    error_msg += "histogram bin, " + std::to_string(number_bins);
+    error_msg += " were requested.";
+    PANACEA_FAIL(error_msg);
+  }
+  const int ndim = dwrapper.getNumberDimensions();
+  histograms_.assign(static_cast<std::size_t>(ndim) * number_bins_, 0.0);
+  std::vector<double> widths(ndim);
+  for (int dim = 0; dim < ndim; ++dim) {
+    widths[dim] = getBinWidth(dim);
+  }
+  // The ranges are only known once the statistics are gathered, the
+  // histograms take a second pass
+  for (int pt = 0; pt < dwrapper.getNumberPoints(); ++pt) {
+    for (int dim = 0; dim < ndim; ++dim) {
+      const int index = bin(dwrapper(pt, dim), statistics_.getMin(dim),
+                            widths[dim], number_bins_);
+      histograms_[static_cast<std::size_t>(dim) * number_bins_ + index] += 1.0;
+    }
+  }
+}
+
+void DescriptorSummary::merge(const BaseDescriptorSummary &base_summary) {
+  const auto *other = dynamic_cast<const DescriptorSummary *>(&base_summary);
+  if (other == nullptr) {
+    PANACEA_FAIL("Unsupported descriptor summary type, cannot merge.");
+  }
+  const DescriptorSummary &summary = *other;
+  if (summary.statistics_.getNumberPoints() == 0) {
+    return;
+  }
+  if (statistics_.getNumberPoints() == 0) {
+    *this = summary;
+    return;
+  }
+  const int ndim = statistics_.getNumberDimensions();
+  if (summary.statistics_.getNumberDimensions() != ndim ||
+      summary.number_bins_ != number_bins_) {
+    std::string error_msg = "Cannot merge descriptor summaries with ";
+    error_msg += "different dimensions or numbers of histogram bins.";
+    PANACEA_FAIL(error_msg);
+  }
+
+  std::vector<double> histograms;
+  histograms.reserve(histograms_.size());
+  for (int dim = 0; dim < ndim; ++dim) {
+    const double min =
+        std::min(statistics_.getMin(dim), summary.statistics_.getMin(dim));
+    const double max =
+        std::max(statistics_.getMax(dim), summary.statistics_.getMax(dim));
+    if (not std::isfinite(max - min)) {
+      std::string error_msg = "Cannot merge the histograms of descriptor ";
+      error_msg += "summaries, dimension " + std::to_string(dim);
+      error_msg += " does not have a finite range.";
+      PANACEA_FAIL(error_msg);
+    }
+    const auto counts = rebin_(dim, min, max);
+    const auto other_counts = summary.rebin_(dim, min, max);
+    for (int index = 0; index < number_bins_; ++index) {
+      histograms.push_back(counts[index] + other_counts[index]);
+    }
+  }
+  statistics_.merge(summary.statistics_);
+  histograms_ = std::move(histograms);
+}
+
+double DescriptorSummary::getBinCount(const int dim, const int bin) const {
+  assert(bin >= 0 && bin < number_bins_);
+  return histograms_.at(static_cast<std::size_t>(dim) * number_bins_ + bin);
+}
+
+double DescriptorSummary::getBinLower(const int dim, const int bin) const {
+  return statistics_.getMin(dim) + bin * getBinWidth(dim);
+}
+
+double DescriptorSummary::getBinWidth(const int dim) const {
+  return (statistics_.getMax(dim) - statistics_.getMin(dim)) / number_bins_;
+}
+
+std::vector<double> DescriptorSummary::getNormalizationCoeffs(
+    const settings::KernelNormalization norm_method,
+    const settings::PANACEAAlgorithm algorithm) const {
+  // Flexible option will avoid errors if coefficients are 0.0,
+  // e.g. if variance is 0.0, will set such coefficients to 1.0
+  const NormalizerOption opt = algorithm == settings::PANACEAAlgorithm::Strict
+                                   ? NormalizerOption::Strict
+                                   : NormalizerOption::Flexible;
+  Normalizer normalizer(statistics_, norm_method, opt);
+  return normalizer.getNormalizationCoeffs();
+}
+
+std::istream &DescriptorSummary::read(DescriptorSummary &summary,
+                                      std::istream &is) {
+  std::string line = "";
+  while (line.find("[Descriptor Summary]", 0) == std::string::npos) {
+    if (not std::getline(is, line)) {
+      std::string error_msg = "Missing [Descriptor Summary] tag while ";
+      error_msg += "reading descriptor summary.";
+      PANACEA_FAIL(error_msg);
+    }
+  }
+  DescriptorStatistics::read(summary.statistics_, is);
+  if (summary.statistics_.moments() != Moments::Full) {
+    PANACEA_FAIL("Descriptor summaries must hold the full moments.");
+  }
+  while (line.find("[Histograms]", 0) == std::string::npos) {
+    if (not std::getline(is, line)) {
+      std::string error_msg = "Missing [Histograms] tag while reading ";
+      error_msg += "descriptor summary.";
+      PANACEA_FAIL(error_msg);
+    }
+  }
+  if (not(is >> summary.number_bins_) || summary.number_bins_ < 1) {
+    std::string error_msg = "Unable to read the number of histogram bins of ";
+    error_msg += "descriptor summary.";
+    PANACEA_FAIL(error_msg);
+  }
+  summary.histograms_.resize(
+      static_cast<std::size_t>(summary.statistics_.getNumberDimensions()) *
+      summary.number_bins_);
+  for (auto &count : summary.histograms_) {
+    if (not(is >> count)) {
+      std::string error_msg = "Unable to read the histogram counts of ";
+      error_msg += "descriptor summary.";
+      PANACEA_FAIL(error_msg);
+    }
+  }
+  return is;
+}
+
+std::ostream &DescriptorSummary::write(const DescriptorSummary &summary,
+                                       std::ostream &os) {
+  os << "[Descriptor Summary]\n";
+  DescriptorStatistics::write(summary.statistics_, os);
+  os << "[Histograms]\n";
+  os << summary.number_bins_ << "\n";
+  const auto precision =
+      os.precision(std::numeric_limits<double>::max_digits10);
+  for (int dim = 0; dim < summary.statistics_.getNumberDimensions(); ++dim) {
+    for (int index = 0; index < summary.number_bins_; ++index) {
+      os << summary.getBinCount(dim, index) << " ";
+    }
+    os << "\n";
+  }
+  os.precision(precision);
+  return os;
+}
+
+DescriptorSummary DescriptorSummary::read(const std::string &file_name) {
+  std::ifstream file(file_name);
+  if (not file.is_open()) {
+    std::string error_msg = "Unable to open descriptor summary: ";
+    error_msg += file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  DescriptorSummary summary;
+  read(summary, file);
+  return summary;
+}
+
+void DescriptorSummary::write(const DescriptorSummary &summary,
+                              const std::string &file_name) {
+  std::ofstream file(file_name);
+  if (not file.is_open()) {
+    std::string error_msg = "Unable to write descriptor summary: ";
+    error_msg += file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  write(summary, file);
+}
+
+/************************************************
+ * Free functions
+ ************************************************/
+
+std::string summaryFileName(const std::string &descriptor_file) {
+  return descriptor_file + ".summary";
+}
+
+DescriptorSummary
+mergeSummaries(const std::vector<std::string> &summary_files) {
+  DescriptorSummary merged;
+  for (const auto &summary_file : summary_files) {
+    merged.merge(DescriptorSummary::read(summary_file));
+  }
+  return merged;
+}
+
+} // namespace panacea
@@ -0,0 +1,112 @@
+#ifndef PANACEA_PRIVATE_DESCRIPTORSUMMARY_H
+#define PANACEA_PRIVATE_DESCRIPTORSUMMARY_H
+#pragma once
+
+// Local private PANACEA includes
+#include "descriptor_statistics.hpp"
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_summary.hpp"
+
+// Standard includes
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+
+/**
+ * Summary of a set of descriptors that is small enough to be kept next to
+ * every descriptor file
+ *
+ * The summary holds the full statistics of the descriptors, the number of
+ * points and the minimum, maximum, mean and co-moments (the sum of squared
+ * deviations M2 on the diagonal, cross-moments off it) of every dimension,
+ * along with a coarse histogram of every dimension. The bins of a histogram
+ * evenly divide the range between the minimum and maximum of the dimension.
+ *
+ * Summaries of disjoint sets of descriptors are merged without reading the
+ * descriptors again. The statistics merge exactly, the histograms are
+ * rebinned onto the combined range assuming the points are spread evenly
+ * within each bin. The covariance matrix and normalization coefficients can
+ * then be built, or updated, from statistics().
+ **/
+class DescriptorSummary : public BaseDescriptorSummary {
+private:
+  DescriptorStatistics statistics_;
+  int number_bins_ = 0;
+  // Row major number of dimensions x number_bins_ point counts, counts are
+  // only fractional after rebinning
+  std::vector<double> histograms_;
+
+  std::vector<double> rebin_(const int dim, const double min,
+                             const double max) const;
+
+public:
+  static constexpr int default_number_bins = 16;
+
+  DescriptorSummary() = default;
+
+  explicit DescriptorSummary(const BaseDescriptorWrapper &dwrapper,
+                             const int number_bins = default_number_bins);
+
+  virtual void merge(const BaseDescriptorSummary &summary) override;
+
+  const DescriptorStatistics &statistics() const noexcept {
+    return statistics_;
+  }
+
+  virtual int getNumberPoints() const noexcept override {
+    return statistics_.getNumberPoints();
+  }
+  virtual int getNumberDimensions() const noexcept override {
+    return statistics_.getNumberDimensions();
+  }
+
+  virtual double getMin(const int dim) const override {
+    return statistics_.getMin(dim);
+  }
+  virtual double getMax(const int dim) const override {
+    return statistics_.getMax(dim);
+  }
+  virtual double getMean(const int dim) const override {
+    return statistics_.getMean(dim);
+  }
+  virtual double getVariance(const int dim) const override {
+    return statistics_.getVariance(dim);
+  }
+
+  virtual int getNumberBins() const noexcept override { return number_bins_; }
+  virtual double getBinCount(const int dim, const int bin) const override;
+  virtual double getBinLower(const int dim, const int bin) const override;
+  virtual double getBinWidth(const int dim) const override;
+
+  virtual std::vector<double>
+  getNormalizationCoeffs(const settings::KernelNormalization norm_method,
+                         const settings::PANACEAAlgorithm algorithm =
+                             settings::PANACEAAlgorithm::Flexible)
+      const override;
+
+  static std::istream &read(DescriptorSummary &summary, std::istream &is);
+  static std::ostream &write(const DescriptorSummary &summary,
+                             std::ostream &os);
+
+  static DescriptorSummary read(const std::string &file_name);
+  static void write(const DescriptorSummary &summary,
+                    const std::string &file_name);
+};
+
+/**
+ * Name of the summary written next to a descriptor file.
+ **/
+std::string summaryFileName(const std::string &descriptor_file);
+
+/**
+ * Reads and merges the summaries of many descriptor files.
+ **/
+DescriptorSummary mergeSummaries(const std::vector<std::string> &summary_files);
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_DESCRIPTORSUMMARY_H
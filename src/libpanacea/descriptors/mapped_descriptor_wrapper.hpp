@@ -0,0 +1,86 @@
+#ifndef PANACEA_PRIVATE_MAPPEDDESCRIPTORWRAPPER_H
+#define PANACEA_PRIVATE_MAPPEDDESCRIPTORWRAPPER_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Local private includes
+#include "descriptor_wrapper.hpp"
+#include "memory_mapped_array.hpp"
+
+// Standard includes
+#include <any>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+namespace panacea {
+
+/*
+ * Descriptor wrapper backed by a memory mapped binary descriptor file.
+ *
+ * Unlike the other descriptor wrappers this one owns the mapping, the
+ * descriptors are never fully loaded into memory. The underlying type
+ * reported is MemoryMappedArray * so kernels can be created that share the
+ * mapping.
+ *
+ * The wrapper can also own a view of a contiguous array owned by the caller,
+ * this is how the C interface wraps caller buffers without copying them.
+ */
+class MappedDescriptorWrapper : public BaseDescriptorWrapper {
+private:
+  // Must be declared before the wrapper so it is constructed first
+  std::unique_ptr<MemoryMappedArray> mapped_array_;
+  DescriptorWrapper<MemoryMappedArray *> data_wrapper_;
+
+public:
+  explicit MappedDescriptorWrapper(const std::string &file_name)
+      : MappedDescriptorWrapper(
+            std::make_unique<MemoryMappedArray>(file_name)) {}
+
+  explicit MappedDescriptorWrapper(
+      std::unique_ptr<MemoryMappedArray> mapped_array)
+      : mapped_array_(std::move(mapped_array)),
+        data_wrapper_(mapped_array_.get(), mapped_array_->rows(),
+                      mapped_array_->cols()) {
+    data_wrapper_.set(mapped_array_->arrangement());
+  }
+
+  virtual double &operator()(const int point_ind, const int dim_ind) final {
+    return data_wrapper_(point_ind, dim_ind);
+  }
+  virtual double operator()(const int point_ind,
+                            const int dim_ind) const final {
+    return data_wrapper_(point_ind, dim_ind);
+  }
+
+  virtual int rows() const final { return data_wrapper_.rows(); }
+  virtual int cols() const final { return data_wrapper_.cols(); }
+  virtual void resize(const int rows, const int cols) final {
+    PANACEA_FAIL("Memory mapped descriptors cannot be resized.");
+  }
+  virtual int getNumberDimensions() const final {
+    return data_wrapper_.getNumberDimensions();
+  }
+  virtual int getNumberPoints() const final {
+    return data_wrapper_.getNumberPoints();
+  }
+  virtual const Arrangement &arrangement() const noexcept final {
+    return data_wrapper_.arrangement();
+  }
+  virtual void set(const Arrangement arrangement) final {
+    data_wrapper_.set(arrangement);
+  }
+  virtual const std::any getPointerToRawData() const noexcept final {
+    return data_wrapper_.getPointerToRawData();
+  }
+  virtual std::type_index getTypeIndex() const noexcept final {
+    return data_wrapper_.getTypeIndex();
+  }
+  virtual void print() const final { data_wrapper_.print(); }
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_MAPPEDDESCRIPTORWRAPPER_H
@@ -0,0 +1,43 @@
+// Local private PANACEA includes
+#include "point_major_descriptors.hpp"
+
+#include "data_point_template.hpp"
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+#include "panacea/instrumentation.hpp"
+
+// Standard includes
+#include <utility>
+#include <vector>
+
+namespace panacea {
+
+PointMajorDescriptors::PointMajorDescriptors(
+    const BaseDescriptorWrapper &descriptor_wrapper)
+    : descriptors_(&descriptor_wrapper) {
+  if (descriptor_wrapper.arrangement() ==
+          Arrangement::PointsAlongRowsDimensionsAlongCols ||
+      descriptor_wrapper.getLayoutCache() == settings::LayoutCache::None) {
+    instrumentation::record(instrumentation::Event::LayoutInPlace,
+                            "descriptors accessed in their own layout");
+    return;
+  }
+
+  const int num_pts = descriptor_wrapper.getNumberPoints();
+  const int num_dims = descriptor_wrapper.getNumberDimensions();
+  std::vector<std::vector<double>> data(num_pts, std::vector<double>(num_dims));
+  // Read along the rows of the original data so the copy is a single
+  // contiguous sweep of the source
+  for (int dim = 0; dim < num_dims; ++dim) {
+    for (int pt = 0; pt < num_pts; ++pt) {
+      data[pt][dim] = descriptor_wrapper(pt, dim);
+    }
+  }
+  copy_.emplace(std::move(data), num_pts, num_dims);
+  descriptors_ = &(*copy_);
+  instrumentation::record(instrumentation::Event::LayoutPointMajorBuilt,
+                          "created point major copy of descriptors");
+}
+
+} // namespace panacea
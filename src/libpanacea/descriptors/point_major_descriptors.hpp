@@ -0,0 +1,44 @@
+#ifndef PANACEA_PRIVATE_POINTMAJORDESCRIPTORS_H
+#define PANACEA_PRIVATE_POINTMAJORDESCRIPTORS_H
+#pragma once
+
+// Local private PANACEA includes
+#include "descriptor_wrapper.hpp"
+
+// Standard includes
+#include <optional>
+#include <vector>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+
+/**
+ * Descriptors with the points along the rows for the duration of a single
+ * evaluation
+ *
+ * Evaluating a distribution reads every dimension of a single descriptor
+ * point, when the dimensions are along the rows those reads are strided. If
+ * the layout cache of the wrapper is enabled a point major copy is created on
+ * construction, otherwise the wrapper itself is used. Entropy terms create
+ * one at the start of compute and discard it before returning, so the copy
+ * never outlives the values it was taken from and changes made to the
+ * descriptors between calls are always seen.
+ **/
+class PointMajorDescriptors {
+private:
+  std::optional<DescriptorWrapper<std::vector<std::vector<double>>>> copy_;
+  const BaseDescriptorWrapper *descriptors_;
+
+public:
+  explicit PointMajorDescriptors(
+      const BaseDescriptorWrapper &descriptor_wrapper);
+
+  PointMajorDescriptors(const PointMajorDescriptors &) = delete;
+  PointMajorDescriptors &operator=(const PointMajorDescriptors &) = delete;
+
+  const BaseDescriptorWrapper &get() const noexcept { return *descriptors_; }
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_POINTMAJORDESCRIPTORS_H
@@ -0,0 +1,220 @@
+// Local private PANACEA includes
+#include "sparse_descriptor_wrapper.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <any>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+/************************************************
+ * File scope functions
+ ************************************************/
+
+static void checkStructure(const CompressedSparseRows &data) {
+  if (data.rows < 0 || data.cols < 0) {
+    PANACEA_FAIL("Sparse descriptors cannot have a negative number of rows or "
+                 "columns.");
+  }
+  if (data.row_offsets.size() != static_cast<std::size_t>(data.rows) + 1) {
+    std::string error_msg = "Sparse descriptors require rows + 1 row offsets, ";
+    error_msg += "expected " + std::to_string(data.rows + 1) + " but found ";
+    error_msg += std::to_string(data.row_offsets.size()) + ".";
+    PANACEA_FAIL(error_msg);
+  }
+  if (data.col_indices.size() != data.values.size()) {
+    PANACEA_FAIL("Sparse descriptors must have a column index for every "
+                 "value.");
+  }
+  if (data.row_offsets.front() != 0 ||
+      data.row_offsets.back() != static_cast<int>(data.values.size())) {
+    PANACEA_FAIL("Sparse descriptor row offsets must begin at 0 and end at the "
+                 "number of values.");
+  }
+  for (int row = 0; row < data.rows; ++row) {
+    if (data.row_offsets[row] > data.row_offsets[row + 1]) {
+      std::string error_msg = "Sparse descriptor row offsets are decreasing ";
+      error_msg += "at row " + std::to_string(row) + ".";
+      PANACEA_FAIL(error_msg);
+    }
+    for (int index = data.row_offsets[row]; index < data.row_offsets[row + 1];
+         ++index) {
+      const int col = data.col_indices[index];
+      if (col < 0 || col >= data.cols) {
+        std::string error_msg = "Sparse descriptor column index out of range ";
+        error_msg += "at row " + std::to_string(row) + ": ";
+        error_msg += std::to_string(col);
+        PANACEA_FAIL(error_msg);
+      }
+      if (index > data.row_offsets[row] && data.col_indices[index - 1] >= col) {
+        std::string error_msg = "Sparse descriptor column indices must be ";
+        error_msg += "strictly increasing within a row, see row ";
+        error_msg += std::to_string(row) + ".";
+        PANACEA_FAIL(error_msg);
+      }
+    }
+  }
+}
+
+/************************************************
+ * Private Methods
+ ************************************************/
+
+int SparseDescriptorWrapper::find_(const int point_ind,
+                                   const int dim_ind) const noexcept {
+  const auto begin = data_.col_indices.begin() + data_.row_offsets[point_ind];
+  const auto end = data_.col_indices.begin() + data_.row_offsets[point_ind + 1];
+  const auto it = std::lower_bound(begin, end, dim_ind);
+  return static_cast<int>(it - data_.col_indices.begin());
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+SparseDescriptorWrapper::SparseDescriptorWrapper(const int rows,
+                                                 const int cols) {
+  data_.rows = rows;
+  data_.cols = cols;
+  data_.row_offsets.assign(rows + 1, 0);
+  checkStructure(data_);
+}
+
+SparseDescriptorWrapper::SparseDescriptorWrapper(const int rows,
+                                                 const int cols,
+                                                 std::vector<int> row_offsets,
+                                                 std::vector<int> col_indices,
+                                                 std::vector<double> values) {
+  data_.rows = rows;
+  data_.cols = cols;
+  data_.row_offsets = std::move(row_offsets);
+  data_.col_indices = std::move(col_indices);
+  data_.values = std::move(values);
+  checkStructure(data_);
+}
+
+SparseDescriptorWrapper::SparseDescriptorWrapper(
+    const BaseDescriptorWrapper &dwrapper) {
+  data_.rows = dwrapper.getNumberPoints();
+  data_.cols = dwrapper.getNumberDimensions();
+  data_.row_offsets.clear();
+  data_.row_offsets.reserve(data_.rows + 1);
+  data_.row_offsets.push_back(0);
+  for (int pt = 0; pt < data_.rows; ++pt) {
+    for (int dim = 0; dim < data_.cols; ++dim) {
+      const double value = dwrapper(pt, dim);
+      if (value != 0.0) {
+        data_.col_indices.push_back(dim);
+        data_.values.push_back(value);
+      }
+    }
+    data_.row_offsets.push_back(static_cast<int>(data_.values.size()));
+  }
+}
+
+double &SparseDescriptorWrapper::operator()(const int point_ind,
+                                            const int dim_ind) {
+  assert(point_ind >= 0 && point_ind < data_.rows);
+  assert(dim_ind >= 0 && dim_ind < data_.cols);
+  const int index = find_(point_ind, dim_ind);
+  if (index < data_.row_offsets[point_ind + 1] &&
+      data_.col_indices[index] == dim_ind) {
+    return data_.values[index];
+  }
+  // Value is not stored yet, insert it so it can be written to
+  data_.col_indices.insert(data_.col_indices.begin() + index, dim_ind);
+  data_.values.insert(data_.values.begin() + index, 0.0);
+  for (int row = point_ind + 1; row <= data_.rows; ++row) {
+    ++data_.row_offsets[row];
+  }
+  return data_.values[index];
+}
+
+double SparseDescriptorWrapper::operator()(const int point_ind,
+                                           const int dim_ind) const {
+  return value(point_ind, dim_ind);
+}
+
+double SparseDescriptorWrapper::value(const int point_ind,
+                                      const int dim_ind) const noexcept {
+  assert(point_ind >= 0 && point_ind < data_.rows);
+  assert(dim_ind >= 0 && dim_ind < data_.cols);
+  const int index = find_(point_ind, dim_ind);
+  if (index < data_.row_offsets[point_ind + 1] &&
+      data_.col_indices[index] == dim_ind) {
+    return data_.values[index];
+  }
+  return 0.0;
+}
+
+void SparseDescriptorWrapper::resize(const int rows, const int cols) {
+  assert(rows >= 0);
+  assert(cols >= 0);
+  CompressedSparseRows resized;
+  resized.rows = rows;
+  resized.cols = cols;
+  resized.row_offsets.reserve(rows + 1);
+  for (int row = 0; row < rows; ++row) {
+    if (row < data_.rows) {
+      for (int index = data_.row_offsets[row];
+           index < data_.row_offsets[row + 1]; ++index) {
+        if (data_.col_indices[index] < cols) {
+          resized.col_indices.push_back(data_.col_indices[index]);
+          resized.values.push_back(data_.values[index]);
+        }
+      }
+    }
+    resized.row_offsets.push_back(static_cast<int>(resized.values.size()));
+  }
+  data_ = std::move(resized);
+}
+
+void SparseDescriptorWrapper::set(const Arrangement arrangement) {
+  if (arrangement != Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    std::string error_msg = "Sparse descriptors only support points along the ";
+    error_msg += "rows and dimensions along the columns.";
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+const std::any SparseDescriptorWrapper::getPointerToRawData() const noexcept {
+  // Consistent with the type index, the storage is not modified through it
+  return const_cast<CompressedSparseRows *>(&data_);
+}
+
+std::type_index SparseDescriptorWrapper::getTypeIndex() const noexcept {
+  return std::type_index(typeid(CompressedSparseRows *));
+}
+
+void SparseDescriptorWrapper::print() const {
+  std::cout << "Rows " << rows() << " Columns " << cols() << "\n";
+  std::cout << "Dimensions " << getNumberDimensions();
+  std::cout << " Points " << getNumberPoints() << "\n";
+  std::cout << "Non zeros " << getNumberNonZeros() << "\n";
+  std::cout << "\nData\n";
+  for (int row = 0; row < data_.rows; ++row) {
+    for (int index = data_.row_offsets[row];
+         index < data_.row_offsets[row + 1]; ++index) {
+      std::cout << row << " " << data_.col_indices[index] << " "
+                << data_.values[index] << "\n";
+    }
+  }
+  std::cout << std::endl;
+}
+
+const CompressedSparseRows *
+sparseData(const BaseDescriptorWrapper &dwrapper) noexcept {
+  if (dwrapper.getTypeIndex() !=
+      std::type_index(typeid(CompressedSparseRows *))) {
+    return nullptr;
+  }
+  return std::any_cast<CompressedSparseRows *>(dwrapper.getPointerToRawData());
+}
+
+} // namespace panacea
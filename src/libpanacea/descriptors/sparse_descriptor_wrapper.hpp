@@ -0,0 +1,104 @@
+#ifndef PANACEA_PRIVATE_SPARSEDESCRIPTORWRAPPER_H
+#define PANACEA_PRIVATE_SPARSEDESCRIPTORWRAPPER_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Local private includes
+#include "data_point_template.hpp"
+
+// Standard includes
+#include <any>
+#include <typeindex>
+#include <vector>
+
+namespace panacea {
+
+/**
+ * Descriptors stored in compressed sparse row (CSR) format.
+ *
+ * Each row is a descriptor point and each column a descriptor dimension.
+ * The non zero values of row r are stored in
+ * values[row_offsets[r]] ... values[row_offsets[r + 1] - 1], with the
+ * dimension of each value in the same position of col_indices. Within a
+ * row the column indices are strictly increasing.
+ **/
+struct CompressedSparseRows {
+  int rows = 0;
+  int cols = 0;
+  std::vector<int> row_offsets{0};
+  std::vector<int> col_indices;
+  std::vector<double> values;
+};
+
+/*
+ * Descriptor wrapper for high dimensional descriptors that are mostly zero.
+ *
+ * The wrapper owns its data, only the non zero values are stored. Reading a
+ * value that is not stored returns 0.0, accessing it through the non const
+ * access operator inserts it, so reads should go through value() or a const
+ * reference.
+ *
+ * The points are always along the rows. Code that can take advantage of the
+ * sparsity obtains the underlying storage with sparseData().
+ */
+class SparseDescriptorWrapper : public BaseDescriptorWrapper {
+private:
+  CompressedSparseRows data_;
+  Arrangement arrangement_ = Arrangement::PointsAlongRowsDimensionsAlongCols;
+
+  int find_(const int point_ind, const int dim_ind) const noexcept;
+
+public:
+  SparseDescriptorWrapper(const int rows, const int cols);
+  SparseDescriptorWrapper(const int rows, const int cols,
+                          std::vector<int> row_offsets,
+                          std::vector<int> col_indices,
+                          std::vector<double> values);
+
+  /**
+   * Copies the non zero values of another descriptor wrapper.
+   **/
+  explicit SparseDescriptorWrapper(const BaseDescriptorWrapper &dwrapper);
+
+  virtual double &operator()(const int point_ind, const int dim_ind) final;
+  virtual double operator()(const int point_ind,
+                            const int dim_ind) const final;
+
+  /**
+   * Reads a value without inserting it when it is not stored.
+   **/
+  double value(const int point_ind, const int dim_ind) const noexcept;
+
+  virtual int rows() const final { return data_.rows; }
+  virtual int cols() const final { return data_.cols; }
+
+  /**
+   * Values outside of the new shape are discarded.
+   **/
+  virtual void resize(const int rows, const int cols) final;
+  virtual int getNumberDimensions() const final { return data_.cols; }
+  virtual int getNumberPoints() const final { return data_.rows; }
+  virtual const Arrangement &arrangement() const noexcept final {
+    return arrangement_;
+  }
+  virtual void set(const Arrangement arrangement) final;
+  virtual const std::any getPointerToRawData() const noexcept final;
+  virtual std::type_index getTypeIndex() const noexcept final;
+  virtual void print() const final;
+
+  int getNumberNonZeros() const noexcept {
+    return static_cast<int>(data_.values.size());
+  }
+};
+
+/**
+ * Returns the sparse storage if the descriptor wrapper is sparse and nullptr
+ * otherwise.
+ **/
+const CompressedSparseRows *
+sparseData(const BaseDescriptorWrapper &dwrapper) noexcept;
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_SPARSEDESCRIPTORWRAPPER_H
@@ -0,0 +1,82 @@
+
+// Local private PANACEA includes
+#include "streaming_statistics.hpp"
+
+#include "descriptor_statistics.hpp"
+#include "error.hpp"
+#include "update_policy.hpp"
+
+// Standard includes
+#include <sstream>
+#include <string>
+
+namespace panacea {
+
+StreamingStatistics::StreamingStatistics(const UpdatePolicy &policy,
+                                         const DescriptorStatistics &initial)
+    : policy_(policy), statistics_(initial) {
+  if (policy_.is(settings::UpdateMode::SlidingWindow)) {
+    batches_.push_back(initial);
+  }
+}
+
+void StreamingStatistics::update(const DescriptorStatistics &batch) {
+  if (statistics_.moments() == Moments::Diagonal &&
+      batch.moments() == Moments::Full) {
+    update(batch.diagonal());
+    return;
+  }
+
+  if (policy_.is(settings::UpdateMode::Cumulative)) {
+    statistics_.merge(batch);
+  } else if (policy_.is(settings::UpdateMode::ExponentialDecay)) {
+    statistics_.decay(policy_.forgettingFactor());
+    statistics_.merge(batch);
+  } else if (policy_.is(settings::UpdateMode::SlidingWindow)) {
+    batches_.push_back(batch);
+    while (static_cast<int>(batches_.size()) > policy_.window()) {
+      batches_.pop_front();
+    }
+    statistics_ = DescriptorStatistics(statistics_.getNumberDimensions(),
+                                       statistics_.moments());
+    for (const auto &stats : batches_) {
+      statistics_.merge(stats);
+    }
+  }
+}
+
+std::istream &StreamingStatistics::read(StreamingStatistics &stream,
+                                        std::istream &is) {
+  UpdatePolicy::read(stream.policy_, is);
+  DescriptorStatistics::read(stream.statistics_, is);
+
+  std::string line = "";
+  is >> std::ws;
+  std::getline(is, line);
+  std::istringstream ss(line);
+  std::size_t num_batches = 0;
+  if (not(ss >> num_batches)) {
+    std::string error_msg = "Unable to read the number of batches of ";
+    error_msg += "streaming statistics.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  stream.batches_.resize(num_batches);
+  for (auto &batch : stream.batches_) {
+    DescriptorStatistics::read(batch, is);
+  }
+  return is;
+}
+
+std::ostream &StreamingStatistics::write(const StreamingStatistics &stream,
+                                         std::ostream &os) {
+  UpdatePolicy::write(stream.policy_, os);
+  DescriptorStatistics::write(stream.statistics_, os);
+  os << stream.batches_.size() << "\n";
+  for (const auto &batch : stream.batches_) {
+    DescriptorStatistics::write(batch, os);
+  }
+  return os;
+}
+
+} // namespace panacea
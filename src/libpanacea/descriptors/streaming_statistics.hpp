@@ -0,0 +1,63 @@
+#ifndef PANACEA_PRIVATE_STREAMINGSTATISTICS_H
+#define PANACEA_PRIVATE_STREAMINGSTATISTICS_H
+#pragma once
+
+// Local private PANACEA includes
+#include "descriptor_statistics.hpp"
+#include "update_policy.hpp"
+
+// Standard includes
+#include <deque>
+#include <iostream>
+
+namespace panacea {
+
+/**
+ * Statistics of a stream of descriptor batches combined according to an
+ * update policy
+ *
+ * Cumulative - every batch is merged with the same weight per point
+ * ExponentialDecay - the statistics are decayed by the forgetting factor
+ * before each batch is merged
+ * SlidingWindow - the statistics of the last window batches are kept and the
+ * combined statistics are merged from them again after each batch, the
+ * co-moments are never subtracted so no precision is lost
+ *
+ * Each batch costs O(d * d) on top of gathering its statistics, or
+ * O(window * d * d) for a sliding window.
+ **/
+class StreamingStatistics {
+private:
+  UpdatePolicy policy_;
+  DescriptorStatistics statistics_;
+  // Statistics of the most recent batches, oldest first, only used with a
+  // sliding window
+  std::deque<DescriptorStatistics> batches_;
+
+public:
+  StreamingStatistics() = default;
+
+  /**
+   * The initial statistics count as the first batch.
+   **/
+  StreamingStatistics(const UpdatePolicy &policy,
+                      const DescriptorStatistics &initial);
+
+  /**
+   * Full batches are reduced to their diagonal if only the diagonal
+   * moments are being tracked.
+   **/
+  void update(const DescriptorStatistics &batch);
+
+  const UpdatePolicy &policy() const noexcept { return policy_; }
+  const DescriptorStatistics &statistics() const noexcept {
+    return statistics_;
+  }
+
+  static std::istream &read(StreamingStatistics &stream, std::istream &is);
+  static std::ostream &write(const StreamingStatistics &stream,
+                             std::ostream &os);
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_STREAMINGSTATISTICS_H
@@ -31,9 +31,14 @@ std::unordered_map<settings::DistributionType,
 /***************************************************************
  * Public Methods
  **************************************************************/
-DistributionFactory::DistributionFactory() {
+bool DistributionFactory::registerDistributions_() {
   DistributionFactory::registerDistribution<
       KernelDistribution, settings::DistributionType::Kernel>();
+  return true;
+}
+
+DistributionFactory::DistributionFactory() {
+  [[maybe_unused]] static const bool registered = registerDistributions_();
 }
 
 std::unique_ptr<Distribution>
@@ -40,7 +40,13 @@ private:
                             DistributionCreateShellMethod>
       create_shell_methods_;
 
+  static bool registerDistributions_();
+
 public:
+  /**
+   * The built in distributions are registered by the first instance that is
+   * constructed, constructing further instances is free.
+   **/
   DistributionFactory();
 
   template <class T, settings::DistributionType dist_type>
@@ -46,7 +46,8 @@ std::vector<std::any> Distribution::write(const settings::FileType file_type,
   }();
 
   std::vector<std::any> nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
     os << "[Distribution]\n";
     os << dist.type() << "\n";
     nested_values = dist.getWriteFunction_()(file_type, os, dist);
@@ -73,7 +74,8 @@ io::ReadInstantiateVector Distribution::read(const settings::FileType file_type,
   }();
 
   io::ReadInstantiateVector nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
     std::string line = "";
     while (line.find("[Distribution]", 0) == std::string::npos) {
       if (is.peek() == EOF) {
@@ -47,6 +47,17 @@ public:
                const DistributionSettings &distribution_settings,
                std::any extra_options = settings::None::None) = 0;
 
+  /**
+   * Adds scale times the gradiant to grad instead of returning a new vector,
+   * grad must already hold a value for every dimension of the descriptors.
+   **/
+  virtual void
+  accumulate_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                  const int desc_ind, const int grad_ind,
+                  const DistributionSettings &distribution_settings,
+                  const double scale, std::vector<double> &grad,
+                  std::any extra_options = settings::None::None) = 0;
+
   /**
    * Get the actual dimensions used in the distribution
    **/
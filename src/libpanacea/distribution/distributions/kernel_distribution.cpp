@@ -5,8 +5,11 @@
 // Local private PANACEA includes
 #include "kernel_distribution.hpp"
 
+#include "constants.hpp"
 #include "error.hpp"
+#include "io/txt_numbers.hpp"
 #include "kernels/base_kernel_wrapper.hpp"
+#include "memory_mapped_array.hpp"
 #include "primitives/gaussian_correlated.hpp"
 #include "primitives/gaussian_uncorrelated.hpp"
 #include "primitives/primitive.hpp"
@@ -15,6 +18,7 @@
 #include "private_settings.hpp"
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -29,7 +33,7 @@ KernelDistribution::KernelDistribution(
   PrimitiveFactory prim_factory;
   prim_grp_ = prim_factory.createGroup(descriptor_wrapper, settings);
 
-  pre_factor_ = 1.0 / static_cast<double>(prim_grp_.primitives.size());
+  bind_();
 }
 
 KernelDistribution::KernelDistribution(const PassKey<DistributionFactory> &,
@@ -38,6 +42,18 @@ KernelDistribution::KernelDistribution(const PassKey<DistributionFactory> &,
   PrimitiveFactory prim_factory;
   prim_grp_ = prim_factory.createGroup(settings);
 
+  bind_();
+}
+
+const MemoryMappedArray *KernelDistribution::mappedKernels_() const {
+  if (prim_grp_.kernel_wrapper == nullptr) {
+    return nullptr;
+  }
+  return prim_grp_.kernel_wrapper->mappedRows();
+}
+
+void KernelDistribution::bind_() {
+  plan_ = KernelEvaluationPlan(prim_grp_.getSpecification());
   pre_factor_ = 1.0 / static_cast<double>(prim_grp_.primitives.size());
 }
 
@@ -58,13 +74,34 @@ double KernelDistribution::compute(
     const DistributionSettings &distribution_settings_) {
   assert(distribution_settings_.type() == settings::DistributionType::Kernel);
 
-  auto distribution_settings =
-      dynamic_cast<const KernelDistributionSettings &>(distribution_settings_);
+  // The type is checked above, no need to pay for a dynamic_cast per point
+  const auto &distribution_settings =
+      static_cast<const KernelDistributionSettings &>(distribution_settings_);
 
   double density = 0.0;
-  for (auto &prim_ptr : prim_grp_.primitives) {
-    density += prim_ptr->compute(descriptor_wrapper, desc_ind,
-                                 distribution_settings.eq_settings);
+  const MemoryMappedArray *mapped_kernels = mappedKernels_();
+  if (mapped_kernels == nullptr) {
+    for (auto &prim_ptr : prim_grp_.primitives) {
+      density += prim_ptr->compute(descriptor_wrapper, desc_ind,
+                                   distribution_settings.eq_settings);
+    }
+  } else {
+    // Stream through the kernel centers a block at a time, the next block is
+    // requested from the operating system while the current one is evaluated.
+    // Rows appended past the end of the mapping are already in memory.
+    const int num_prim = static_cast<int>(prim_grp_.primitives.size());
+    const int num_mapped = std::min(num_prim, mapped_kernels->rows());
+    const int block =
+        mapped_kernels->rowsPerBlock(constants::kernel_stream_block_bytes);
+    mapped_kernels->willNeed(0, std::min(block, num_mapped));
+    for (int begin = 0; begin < num_prim; begin += block) {
+      const int end = std::min(begin + block, num_prim);
+      mapped_kernels->willNeed(end, std::min(end + block, num_mapped));
+      for (int prim_ind = begin; prim_ind < end; ++prim_ind) {
+        density += prim_grp_.primitives[prim_ind]->compute(
+            descriptor_wrapper, desc_ind, distribution_settings.eq_settings);
+      }
+    }
   }
 
   double result = pre_factor_ * density;
@@ -77,93 +114,55 @@ double KernelDistribution::compute(
 
 std::vector<double> KernelDistribution::compute_grad(
     const BaseDescriptorWrapper &descriptor_wrapper, const int desc_ind,
-    const int grad_ind, const DistributionSettings &distribution_settings_,
+    const int grad_ind, const DistributionSettings &distribution_settings,
     std::any option) {
 
+  std::vector<double> grad(descriptor_wrapper.getNumberDimensions(), 0.0);
+  accumulate_grad(descriptor_wrapper, desc_ind, grad_ind,
+                  distribution_settings, 1.0, grad, std::move(option));
+  return grad;
+}
+
+void KernelDistribution::accumulate_grad(
+    const BaseDescriptorWrapper &descriptor_wrapper, const int desc_ind,
+    const int grad_ind, const DistributionSettings &distribution_settings_,
+    const double scale, std::vector<double> &grad, std::any option) {
+
   assert(descriptor_wrapper.getNumberDimensions() ==
          prim_grp_.kernel_wrapper->getNumberDimensions());
   assert(distribution_settings_.type() == settings::DistributionType::Kernel);
 
-  settings::GradSetting grad_setting;
+  const auto &distribution_settings =
+      static_cast<const KernelDistributionSettings &>(distribution_settings_);
+
+  // Without an explicit option the gradient is with respect to both the
+  // descriptor and the kernel if they are the same point, otherwise only the
+  // kernel contributes
+  settings::GradSetting grad_setting = settings::GradSetting::WRTKernel;
   if (option.type() != typeid(settings::None)) {
     grad_setting = std::any_cast<settings::GradSetting>(option);
+  } else if (desc_ind == grad_ind) {
+    grad_setting = settings::GradSetting::WRTBoth;
   }
-  auto distribution_settings =
-      dynamic_cast<const KernelDistributionSettings &>(distribution_settings_);
 
-#ifndef NDEBUG
-  std::string error_msg = "Unsupported gradiant method encountered";
-  if (option.type() == typeid(settings::None)) {
-    if (kern_dist_grad.grad_method.count(settings::GradSetting::WRTBoth) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad.grad_method.count(settings::GradSetting::WRTKernel) ==
-        0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad.grad_method[settings::GradSetting::WRTBoth].count(
-            distribution_settings.eq_settings) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad.grad_method[settings::GradSetting::WRTKernel].count(
-            distribution_settings.eq_settings) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad
-            .grad_method[settings::GradSetting::WRTBoth]
-                        [distribution_settings.eq_settings]
-            .count(distribution_settings.dist_settings
-                       .get<settings::KernelCount>()) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad
-            .grad_method[settings::GradSetting::WRTKernel]
-                        [distribution_settings.eq_settings]
-            .count(distribution_settings.dist_settings
-                       .get<settings::KernelCount>()) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-  } else {
-    if (kern_dist_grad.grad_method.count(grad_setting) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad.grad_method[grad_setting].count(
-            distribution_settings.eq_settings) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
-    if (kern_dist_grad
-            .grad_method[grad_setting][distribution_settings.eq_settings]
-            .count(distribution_settings.dist_settings
-                       .get<settings::KernelCount>()) == 0) {
-      PANACEA_FAIL(error_msg);
-    }
+  // A distribution read from a restart file only learns its specification
+  // once the primitive group has been read
+  if (not plan_.bound()) {
+    plan_ = KernelEvaluationPlan(prim_grp_.getSpecification());
   }
-#endif // NDEBUG
-
-  if (option.type() == typeid(settings::None)) {
-    if (desc_ind == grad_ind) {
-
-      return kern_dist_grad.grad_method
-          [settings::GradSetting::WRTBoth][distribution_settings.eq_settings]
-          [distribution_settings.dist_settings.get<settings::KernelCount>()](
-              descriptor_wrapper, desc_ind, grad_ind, prim_grp_,
-              distribution_settings, pre_factor_);
-    } else {
-      // Remaining cases should occur WRTKernel only
-      return kern_dist_grad.grad_method
-          [settings::GradSetting::WRTKernel][distribution_settings.eq_settings]
-          [distribution_settings.dist_settings.get<settings::KernelCount>()](
-              descriptor_wrapper, desc_ind, grad_ind, prim_grp_,
-              distribution_settings, pre_factor_);
-    }
-  } else {
-
-    return kern_dist_grad.grad_method
-        [grad_setting][distribution_settings.eq_settings]
-        [distribution_settings.dist_settings.get<settings::KernelCount>()](
-            descriptor_wrapper, desc_ind, grad_ind, prim_grp_,
-            distribution_settings, pre_factor_);
+  assert(plan_.count() ==
+         distribution_settings.dist_settings.get<settings::KernelCount>());
+
+  const auto grad_method =
+      plan_.gradiant(grad_setting, distribution_settings.eq_settings);
+  if (grad_method == nullptr) {
+    std::string error_msg = "Unsupported gradiant method encountered";
+    PANACEA_FAIL(error_msg);
   }
+  assert(grad.size() ==
+         static_cast<std::size_t>(descriptor_wrapper.getNumberDimensions()));
+  grad_method(descriptor_wrapper, desc_ind, grad_ind, prim_grp_,
+              distribution_settings, scale * pre_factor_, grad);
 }
 
 const Dimensions &KernelDistribution::getDimensions() const noexcept {
@@ -179,13 +178,13 @@ const int KernelDistribution::getMaximumNumberOfDimensions() const noexcept {
 void KernelDistribution::update(
     const BaseDescriptorWrapper &descriptor_wrapper) {
   prim_grp_.update(descriptor_wrapper);
-  pre_factor_ = 1.0 / static_cast<double>(prim_grp_.primitives.size());
+  bind_();
 }
 
 void KernelDistribution::initialize(
     const BaseDescriptorWrapper &descriptor_wrapper) {
   prim_grp_.initialize(descriptor_wrapper);
-  pre_factor_ = 1.0 / static_cast<double>(prim_grp_.primitives.size());
+  bind_();
 }
 
 std::vector<std::any>
@@ -202,9 +201,11 @@ KernelDistribution::write(const settings::FileType file_type, std::ostream &os,
 
   std::vector<std::any> nested_objs;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     os << "[Prefactor]\n";
-    os << kern_dist.pre_factor_ << "\n";
+    io::writeDouble(os, kern_dist.pre_factor_);
+    os << "\n";
     nested_objs.push_back(&(kern_dist.prim_grp_));
   }
   return nested_objs;
@@ -224,6 +225,7 @@ KernelDistribution::read(const settings::FileType file_type, std::istream &is,
 
   io::ReadInstantiateVector nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
@@ -237,6 +239,8 @@ KernelDistribution::read(const settings::FileType file_type, std::istream &is,
       std::getline(is, line);
     }
     is >> kern_dist.pre_factor_;
+    // The primitive group is read after this section
+    kern_dist.plan_ = KernelEvaluationPlan();
     nested_values.emplace_back(&(kern_dist.prim_grp_), std::nullopt);
   }
   return nested_values;
@@ -7,6 +7,7 @@
 
 #include "distribution/distribution_settings/kernel_distribution_settings.hpp"
 #include "kernel_distribution/kernel_distribution_gradiant.hpp"
+#include "kernel_distribution/kernel_evaluation_plan.hpp"
 #include "primitives/primitive_group.hpp"
 
 // Public PANACEA includes
@@ -33,18 +34,32 @@ class BaseDescriptorWrapper;
 class Dimensions;
 class DistributionFactory;
 class DistributionSettings;
+class MemoryMappedArray;
 
 class KernelDistribution : public Distribution {
 
 private:
   PrimitiveGroup prim_grp_;
   KernelDistributionGradiant kern_dist_grad;
+  // Bound whenever the primitive group is created or updated
+  KernelEvaluationPlan plan_;
   // For KDE 1/N value, where N is the number Kernels/primitives
   double pre_factor_;
 
   virtual Distribution::ReadFunction getReadFunction_() final;
   virtual Distribution::WriteFunction getWriteFunction_() const final;
 
+  /**
+   * Returns the memory mapped array holding the kernel centers if the kernel
+   * wrapper reads its rows from one, otherwise nullptr.
+   **/
+  const MemoryMappedArray *mappedKernels_() const;
+
+  /**
+   * Rebinds the evaluation plan and the KDE prefactor to the primitive group.
+   **/
+  void bind_();
+
   double compute_(const BaseDescriptorWrapper &descriptor_wrapper,
                   const int desc_ind,
                   const settings::EquationSetting &equation_settings);
@@ -77,6 +92,13 @@ public:
                const DistributionSettings &distribution_settings,
                std::any grad_setting) final;
 
+  virtual void
+  accumulate_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                  const int desc_ind, const int grad_ind,
+                  const DistributionSettings &distribution_settings,
+                  const double scale, std::vector<double> &grad,
+                  std::any grad_setting) final;
+
   virtual const Dimensions &getDimensions() const noexcept final;
 
   virtual const int getMaximumNumberOfDimensions() const noexcept final;
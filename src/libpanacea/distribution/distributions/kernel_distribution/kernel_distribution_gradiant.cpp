@@ -10,7 +10,6 @@
 #include "private_settings.hpp"
 
 // Standard includes
-#include <functional>
 #include <iostream>
 #include <vector>
 
@@ -23,35 +22,25 @@ namespace {
  * assumes we are taking the gradiant with respect to the decriptor
  * thus each kernel will add a contribution.
  **/
-std::vector<double> gradiant_one_to_one_wrt_desc_only(
+void gradiant_one_to_one_wrt_desc_only(
     const BaseDescriptorWrapper &descriptor_wrapper,
     const int &descriptor_index,
     const int &grad_index, // Not really needed
     const PrimitiveGroup &prim_grp,
     const KernelDistributionSettings &distribution_settings,
-    const double pre_factor) {
+    const double pre_factor, std::vector<double> &grad) {
 
   // We want the gradiant at the location of the sample
   assert(descriptor_index < descriptor_wrapper.getNumberPoints());
   assert(grad_index == descriptor_index &&
          "It doesn't make sense to have the gradiant with respect to a "
          "different index");
-  std::vector<double> grad(descriptor_wrapper.getNumberDimensions(), 0.0);
   for (auto &prim_ptr : prim_grp.primitives) {
-
-    std::vector<double> grad_temp = prim_ptr->compute_grad(
-        descriptor_wrapper, descriptor_index, distribution_settings.eq_settings,
-        settings::GradSetting::WRTDescriptor);
-
-    std::transform(grad.begin(), grad.end(), grad_temp.begin(), grad.begin(),
-                   std::plus<double>());
+    prim_ptr->accumulate_grad(descriptor_wrapper, descriptor_index,
+                              distribution_settings.eq_settings,
+                              settings::GradSetting::WRTDescriptor, pre_factor,
+                              grad);
   }
-
-  std::transform(
-      grad.begin(), grad.end(), grad.begin(),
-      std::bind(std::multiplies<double>(), std::placeholders::_1, pre_factor));
-
-  return grad;
 }
 
 /**
@@ -60,13 +49,13 @@ std::vector<double> gradiant_one_to_one_wrt_desc_only(
  * with a single kernel, thus the gradient will not need to effect
  * any changes to the kernel.
  **/
-std::vector<double> gradiant_single_wrt_desc_only(
+void gradiant_single_wrt_desc_only(
     const BaseDescriptorWrapper &descriptor_wrapper,
     const int &descriptor_index,
     const int &grad_index, // Not really needed
     const PrimitiveGroup &prim_grp,
     const KernelDistributionSettings &distribution_settings,
-    const double pre_factor) {
+    const double pre_factor, std::vector<double> &grad) {
 
   // We want the gradiant at the location of the sample
   assert(descriptor_index < descriptor_wrapper.getNumberPoints());
@@ -74,15 +63,9 @@ std::vector<double> gradiant_single_wrt_desc_only(
          "It doesn't make sense to have the gradiant with respect to a "
          "different index");
 
-  std::vector<double> grad = prim_grp.primitives.at(0)->compute_grad(
+  prim_grp.primitives.at(0)->accumulate_grad(
       descriptor_wrapper, descriptor_index, distribution_settings.eq_settings,
-      settings::GradSetting::WRTDescriptor);
-
-  std::transform(
-      grad.begin(), grad.end(), grad.begin(),
-      std::bind(std::multiplies<double>(), std::placeholders::_1, pre_factor));
-
-  return grad;
+      settings::GradSetting::WRTDescriptor, pre_factor, grad);
 }
 
 /**
@@ -94,55 +77,41 @@ std::vector<double> gradiant_single_wrt_desc_only(
  * Hence there will only be one kernel that is relevant, all the other kernels
  * will not add a contribution.
  **/
-std::vector<double> gradiant_one_to_one_wrt_kern_only(
+void gradiant_one_to_one_wrt_kern_only(
     const BaseDescriptorWrapper &descriptor_wrapper,
     const int &descriptor_index, const int &grad_index,
     const PrimitiveGroup &prim_grp,
     const KernelDistributionSettings &distribution_settings,
-    const double pre_factor) {
+    const double pre_factor, std::vector<double> &grad) {
 
   assert(descriptor_index < descriptor_wrapper.getNumberPoints());
 
-  auto grad = prim_grp.primitives.at(grad_index)
-                  ->compute_grad(descriptor_wrapper, descriptor_index,
-                                 distribution_settings.eq_settings,
-                                 settings::GradSetting::WRTKernel);
-
-  std::transform(
-      grad.begin(), grad.end(), grad.begin(),
-      std::bind(std::multiplies<double>(), std::placeholders::_1, pre_factor));
-  return grad;
+  prim_grp.primitives.at(grad_index)
+      ->accumulate_grad(descriptor_wrapper, descriptor_index,
+                        distribution_settings.eq_settings,
+                        settings::GradSetting::WRTKernel, pre_factor, grad);
 }
 
-std::vector<double> gradiant_one_to_one_wrt_both(
+void gradiant_one_to_one_wrt_both(
     const BaseDescriptorWrapper &descriptor_wrapper,
     const int &descriptor_index, const int &grad_index,
     const PrimitiveGroup &prim_grp,
     const KernelDistributionSettings &distribution_settings,
-    const double pre_factor) {
+    const double pre_factor, std::vector<double> &grad) {
 
   assert(descriptor_index < descriptor_wrapper.getNumberPoints());
   assert(descriptor_index == grad_index);
 
-  std::vector<double> grad(descriptor_wrapper.getNumberDimensions(), 0.0);
   for (auto &prim_ptr : prim_grp.primitives) {
     // Ignore the gradiant of the kernel with the same index because the
     // gradiants will cancel
     if (prim_ptr->getId() != descriptor_index) {
-      std::vector<double> grad_temp =
-          prim_ptr->compute_grad(descriptor_wrapper, descriptor_index,
-                                 distribution_settings.eq_settings,
-                                 settings::GradSetting::WRTDescriptor);
-
-      std::transform(grad.begin(), grad.end(), grad_temp.begin(), grad.begin(),
-                     std::plus<double>());
+      prim_ptr->accumulate_grad(descriptor_wrapper, descriptor_index,
+                                distribution_settings.eq_settings,
+                                settings::GradSetting::WRTDescriptor,
+                                pre_factor, grad);
     }
   }
-
-  std::transform(
-      grad.begin(), grad.end(), grad.begin(),
-      std::bind(std::multiplies<double>(), std::placeholders::_1, pre_factor));
-  return grad;
 }
 
 } // namespace
@@ -158,8 +127,7 @@ std::unordered_map<
                            KernelDistributionGradiant::GradiantMethod>>>
     KernelDistributionGradiant::grad_method;
 
-KernelDistributionGradiant::KernelDistributionGradiant() {
-  // Register gradiant methods
+bool KernelDistributionGradiant::registerGradiantMethods_() {
   grad_method[settings::GradSetting::WRTDescriptor]
              [settings::EquationSetting::None]
              [settings::KernelCount::OneToOne] =
@@ -179,6 +147,11 @@ KernelDistributionGradiant::KernelDistributionGradiant() {
   grad_method[settings::GradSetting::WRTDescriptor]
              [settings::EquationSetting::IgnoreExpAndPrefactor]
              [settings::KernelCount::Single] = gradiant_single_wrt_desc_only;
+  return true;
+}
+
+KernelDistributionGradiant::KernelDistributionGradiant() {
+  [[maybe_unused]] static const bool registered = registerGradiantMethods_();
 }
 
 } // namespace panacea
@@ -17,12 +17,16 @@ class PrimitiveGroup;
 
 class KernelDistributionGradiant {
 public:
-  using GradiantMethod = std::vector<double> (*)(
+  /**
+   * Adds pre_factor times the gradiant to grad, grad holds a value for every
+   * dimension of the descriptors.
+   **/
+  using GradiantMethod = void (*)(
       const BaseDescriptorWrapper &descriptor_wrapper,
       const int &descriptor_index, const int &grad_index,
       const PrimitiveGroup &prim_grp,
       const KernelDistributionSettings &distribution_settings,
-      const double pre_factor);
+      const double pre_factor, std::vector<double> &grad);
 
   static std::unordered_map<
       settings::GradSetting,
@@ -31,7 +35,14 @@ public:
           std::unordered_map<settings::KernelCount, GradiantMethod>>>
       grad_method;
 
+  /**
+   * The gradiant methods are registered by the first instance that is
+   * constructed, after which the map is only read.
+   **/
   KernelDistributionGradiant();
+
+private:
+  static bool registerGradiantMethods_();
 };
 
 } // namespace panacea
@@ -0,0 +1,24 @@
+
+// Local private PANACEA includes
+#include "kernel_evaluation_plan.hpp"
+
+#include "kernels/kernel_specifications.hpp"
+
+namespace panacea {
+
+KernelEvaluationPlan::KernelEvaluationPlan(
+    const KernelSpecification &specification)
+    : bound_(true), count_(specification.get<settings::KernelCount>()) {
+
+  for (const auto &grad_methods : KernelDistributionGradiant::grad_method) {
+    for (const auto &eq_methods : grad_methods.second) {
+      auto method = eq_methods.second.find(count_);
+      if (method != eq_methods.second.end()) {
+        grad_methods_[static_cast<int>(grad_methods.first)]
+                     [static_cast<int>(eq_methods.first)] = method->second;
+      }
+    }
+  }
+}
+
+} // namespace panacea
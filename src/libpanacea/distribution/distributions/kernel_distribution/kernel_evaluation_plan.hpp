@@ -0,0 +1,68 @@
+#ifndef PANACEA_PRIVATE_KERNELEVALUATIONPLAN_H
+#define PANACEA_PRIVATE_KERNELEVALUATIONPLAN_H
+#pragma once
+
+// Local private PANACEA includes
+#include "kernel_distribution_gradiant.hpp"
+
+#include "private_settings.hpp"
+
+// Standard includes
+#include <array>
+
+namespace panacea {
+
+class KernelSpecification;
+
+/**
+ * Gradient routines of a kernel distribution resolved once
+ *
+ * The routine used depends on the gradient setting, the equation setting and
+ * the kernel count. The kernel count is fixed by the specification of the
+ * primitive group, so when the group is created or updated the routines for
+ * that count are copied out of the registered gradient methods into a small
+ * table indexed by the other two settings. Evaluating a point then reads a
+ * function pointer from the table instead of hashing into the nested maps.
+ **/
+class KernelEvaluationPlan {
+private:
+  static constexpr int number_grad_settings = 3;
+  static constexpr int number_equation_settings = 3;
+
+  bool bound_ = false;
+  settings::KernelCount count_ = settings::KernelCount::Single;
+  std::array<std::array<KernelDistributionGradiant::GradiantMethod,
+                        number_equation_settings>,
+             number_grad_settings>
+      grad_methods_{};
+
+public:
+  KernelEvaluationPlan() = default;
+
+  /**
+   * Resolves the gradient routines registered for the kernel count of the
+   * specification.
+   **/
+  explicit KernelEvaluationPlan(const KernelSpecification &specification);
+
+  /**
+   * False for a plan that was default constructed, e.g. while the kernel
+   * distribution is loaded from a restart file.
+   **/
+  bool bound() const noexcept { return bound_; }
+  settings::KernelCount count() const noexcept { return count_; }
+
+  /**
+   * Gradient routine or nullptr if none is registered for the settings.
+   **/
+  KernelDistributionGradiant::GradiantMethod
+  gradiant(const settings::GradSetting grad_setting,
+           const settings::EquationSetting eq_setting) const noexcept {
+    return grad_methods_[static_cast<int>(grad_setting)]
+                        [static_cast<int>(eq_setting)];
+  }
+};
+
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_KERNELEVALUATIONPLAN_H
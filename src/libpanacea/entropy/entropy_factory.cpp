@@ -6,17 +6,24 @@
 #include "entropy_factory.hpp"
 
 #include "distribution/distribution_factory.hpp"
+#include "distribution/distribution_settings/kernel_distribution_settings.hpp"
 #include "entropy_settings/entropy_settings.hpp"
 #include "entropy_terms/cross_entropy.hpp"
+#include "entropy_terms/entropy_decorators/lazy_restart.hpp"
 #include "entropy_terms/entropy_decorators/numerical_grad.hpp"
 #include "entropy_terms/entropy_decorators/weight.hpp"
 #include "entropy_terms/self_entropy.hpp"
 #include "error.hpp"
+#include "io/file_binary_restart.hpp"
+#include "io/file_io_factory.hpp"
+#include "io/restart_read_context.hpp"
 #include "private_settings.hpp"
 
 // Standard includes
 #include <cassert>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -35,6 +42,22 @@ std::unique_ptr<EntropyTerm> decorate(std::unique_ptr<EntropyTerm> ent_term,
   }
   return ent_term;
 }
+
+// The restart file holds the entropy settings but not the distribution
+// settings, those are taken from the kernel specifications of the file
+void readSettings(io::FileIO &file_io, const std::string &file_name,
+                  EntropySettings &settings) {
+  // The first record of a checkpoint log is preceded by its frame
+  io::RestartIFStream is(file_name, true);
+  io::skipRecordFrame(is);
+  const std::streamoff record_begin = is.tellg();
+  file_io.read(&settings, is);
+  is.clear();
+  is.seekg(record_begin);
+  auto kern_dist_settings = std::make_unique<KernelDistributionSettings>();
+  file_io.read(&kern_dist_settings->dist_settings, is);
+  settings.setDistributionSettings(std::move(kern_dist_settings));
+}
 } // unnamed namespace
 
 /**********************************************
@@ -50,13 +73,18 @@ std::unordered_map<settings::EntropyType,
 /**********************************************
  * Public Methods
  **********************************************/
-EntropyFactory::EntropyFactory() {
+bool EntropyFactory::registerEntropyTerms_() {
 
   EntropyFactory::registerEntropyTerm<SelfEntropy,
                                       settings::EntropyType::Self>();
 
   EntropyFactory::registerEntropyTerm<CrossEntropy,
                                       settings::EntropyType::Cross>();
+  return true;
+}
+
+EntropyFactory::EntropyFactory() {
+  [[maybe_unused]] static const bool registered = registerEntropyTerms_();
 }
 
 std::unique_ptr<EntropyTerm>
@@ -91,4 +119,36 @@ EntropyFactory::create(const EntropySettings &settings) const {
   return ent_term;
 }
 
+std::unique_ptr<EntropyTerm>
+EntropyFactory::create(const std::string &file_name,
+                       const settings::RestartLoading restart_loading) const {
+
+  const settings::FileType file_type = [&]() {
+    std::ifstream is(file_name, std::ios::binary);
+    if (not is) {
+      std::string error_msg = "Unable to open restart file: " + file_name;
+      PANACEA_FAIL(error_msg);
+    }
+    io::skipRecordFrame(is);
+    if (io::FileRestartBinary::isRecord(is)) {
+      return settings::FileType::BinaryRestart;
+    }
+    return settings::FileType::TXTRestart;
+  }();
+
+  io::FileIOFactory file_io_factory;
+  std::unique_ptr<io::FileIO> file_io = file_io_factory.create(file_type);
+
+  EntropySettings settings;
+  readSettings(*file_io, file_name, settings);
+  std::unique_ptr<EntropyTerm> ent_term = create(settings);
+
+  if (restart_loading == settings::RestartLoading::Lazy) {
+    return std::make_unique<LazyRestart>(std::move(ent_term),
+                                         std::move(file_io), file_name);
+  }
+  io::readRestartRecords(*file_io, ent_term.get(), file_name, false);
+  return ent_term;
+}
+
 } // namespace panacea
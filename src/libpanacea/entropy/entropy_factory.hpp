@@ -19,6 +19,7 @@ class EntropyTerm;
 
 namespace settings {
 enum class EntropyType;
+enum class RestartLoading;
 }
 
 class EntropyFactory {
@@ -38,7 +39,13 @@ private:
   static std::unordered_map<settings::EntropyType, EntropyCreateShellMethod>
       create_shell_methods_;
 
+  static bool registerEntropyTerms_();
+
 public:
+  /**
+   * The built in entropy terms are registered by the first instance that is
+   * constructed, constructing further instances is free.
+   **/
   EntropyFactory();
 
   template <class T, settings::EntropyType entropy_type>
@@ -62,6 +69,14 @@ public:
          const EntropySettings &settings) const;
 
   std::unique_ptr<EntropyTerm> create(const EntropySettings &settings) const;
+
+  /**
+   * Creates an entropy term from a txt or binary restart file or checkpoint
+   * log, the settings of the term are read from the file.
+   **/
+  std::unique_ptr<EntropyTerm>
+  create(const std::string &file_name,
+         const settings::RestartLoading restart_loading) const;
 };
 } // namespace panacea
 
@@ -2,8 +2,10 @@
 // Local private PANACEA includes
 #include "entropy_settings.hpp"
 #include "distribution/distribution_settings/kernel_distribution_settings.hpp"
+#include "io/txt_numbers.hpp"
 #include "kernels/kernel_specifications.hpp"
 #include "private_settings.hpp"
+#include "update_policy.hpp"
 
 // Standard includes
 #include <cassert>
@@ -16,18 +18,14 @@ namespace panacea {
 
 EntropySettings::EntropySettings(const EntropySettings &entropy_settings) {
 
-  settings::EntropyType type = entropy_settings.type;
-  settings::Memory memory_policy = entropy_settings.memory_policy;
-  std::optional<double> weight = entropy_settings.weight;
-  std::optional<bool> numerical_grad_switch =
-      entropy_settings.numerical_grad_switch;
-  std::optional<double> numerical_grad_inc =
-      entropy_settings.numerical_grad_inc;
+  type = entropy_settings.type;
+  memory_policy = entropy_settings.memory_policy;
+  weight = entropy_settings.weight;
+  numerical_grad_switch = entropy_settings.numerical_grad_switch;
+  numerical_grad_inc = entropy_settings.numerical_grad_inc;
 
-  settings::EquationSetting compute_equation_settings =
-      entropy_settings.compute_equation_settings;
-  settings::EquationSetting grad_equation_settings =
-      entropy_settings.grad_equation_settings;
+  compute_equation_settings = entropy_settings.compute_equation_settings;
+  grad_equation_settings = entropy_settings.grad_equation_settings;
 
   // Here we will create a heap allocation if the types are not the same.
   // If the types are the same then we can assume that the memory has already
@@ -49,18 +47,14 @@ EntropySettings::EntropySettings(const EntropySettings &entropy_settings) {
 EntropySettings &EntropySettings::
 operator=(const EntropySettings &entropy_settings) {
 
-  settings::EntropyType type = entropy_settings.type;
-  settings::Memory memory_policy = entropy_settings.memory_policy;
-  std::optional<double> weight = entropy_settings.weight;
-  std::optional<bool> numerical_grad_switch =
-      entropy_settings.numerical_grad_switch;
-  std::optional<double> numerical_grad_inc =
-      entropy_settings.numerical_grad_inc;
+  type = entropy_settings.type;
+  memory_policy = entropy_settings.memory_policy;
+  weight = entropy_settings.weight;
+  numerical_grad_switch = entropy_settings.numerical_grad_switch;
+  numerical_grad_inc = entropy_settings.numerical_grad_inc;
 
-  settings::EquationSetting compute_equation_settings =
-      entropy_settings.compute_equation_settings;
-  settings::EquationSetting grad_equation_settings =
-      entropy_settings.grad_equation_settings;
+  compute_equation_settings = entropy_settings.compute_equation_settings;
+  grad_equation_settings = entropy_settings.grad_equation_settings;
 
   // Here we will create a heap allocation if the types are not the same.
   // If the types are the same then we can assume that the memory has already
@@ -123,6 +117,13 @@ EntropySettings::EntropySettings(const PANACEASettings &in,
       if (auto val = in.get<RandomizeNumberDimensions>()) {
         kern_dist_settings->dist_settings.set(*val);
       }
+      if (auto val = in.get<UpdateMode>()) {
+        kern_dist_settings->dist_settings.set(UpdatePolicy(
+            *val,
+            in.getForgettingFactor().value_or(
+                UpdatePolicy::default_forgetting_factor),
+            in.getUpdateWindow().value_or(UpdatePolicy::default_window)));
+      }
       if (auto val = in.get<PANACEAAlgorithm>()) {
         if (*val == PANACEAAlgorithm::Flexible) {
           kern_dist_settings->dist_settings.set(KernelAlgorithm::Flexible);
@@ -202,13 +203,15 @@ std::vector<std::any> EntropySettings::write(const settings::FileType file_type,
   }();
 
   std::vector<std::any> nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
 
     os << "[Entropy Settings]\n";
     os << ent_settings.type << "\n";
     os << ent_settings.memory_policy << "\n";
     if (auto weight = ent_settings.weight) {
-      os << *weight << "\n";
+      io::writeDouble(os, *weight);
+      os << "\n";
     } else {
       os << "N/A\n";
     }
@@ -246,7 +249,8 @@ EntropySettings::read(const settings::FileType file_type, std::istream &is,
   }();
 
   io::ReadInstantiateVector nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
     std::string line = "";
     while (line.find("[Entropy Settings]", 0) == std::string::npos) {
       if (is.peek() == EOF) {
@@ -5,6 +5,7 @@
 // Local private PANACEA includes
 #include "cross_entropy.hpp"
 
+#include "descriptors/point_major_descriptors.hpp"
 #include "distribution/distribution_factory.hpp"
 #include "distribution/distribution_settings/distribution_settings.hpp"
 #include "distribution/distributions/distribution.hpp"
@@ -58,13 +59,15 @@ double CrossEntropy::compute(const BaseDescriptorWrapper &descriptor_wrapper) {
     error_msg += " or when creating the entropy term provide the descriptors.";
     PANACEA_FAIL(error_msg);
   }
+  // The settings and layout are the same for every point
+  const DistributionSettings &dist_settings =
+      entropy_settings_.getDistributionSettings(Method::Compute);
+  const PointMajorDescriptors point_major_descriptors(descriptor_wrapper);
+  const BaseDescriptorWrapper &point_major = point_major_descriptors.get();
   double cross_entropy = 0.0;
-  for (int desc_pt = 0; desc_pt < descriptor_wrapper.getNumberPoints();
-       ++desc_pt) {
-    cross_entropy +=
-        -1.0 * log(distribution_->compute(
-                   descriptor_wrapper, desc_pt,
-                   entropy_settings_.getDistributionSettings(Method::Compute)));
+  for (int desc_pt = 0; desc_pt < point_major.getNumberPoints(); ++desc_pt) {
+    cross_entropy += -1.0 * log(distribution_->compute(point_major, desc_pt,
+                                                       dist_settings));
   }
   return cross_entropy;
 }
@@ -117,6 +120,15 @@ std::vector<double> CrossEntropy::compute_grad(
     const BaseDescriptorWrapper &descriptor_wrapper,
     const int desc_ind // Where the gradiant is being calculated at
 ) {
+  std::vector<double> grad;
+  CrossEntropy::compute_grad(descriptor_wrapper, desc_ind, grad);
+  return grad;
+}
+
+void CrossEntropy::compute_grad(
+    const BaseDescriptorWrapper &descriptor_wrapper,
+    const int desc_ind, // Where the gradiant is being calculated at
+    std::vector<double> &grad) {
 
   if (state_ != EntropyTerm::State::Initialized) {
     std::string error_msg =
@@ -126,31 +138,27 @@ std::vector<double> CrossEntropy::compute_grad(
     error_msg += " or when creating the entropy term provide the descriptors.";
     PANACEA_FAIL(error_msg);
   }
-  std::vector<double> inv_distribution;
-  inv_distribution.reserve(descriptor_wrapper.getNumberPoints());
-  for (int desc_ind2 = 0; desc_ind2 < descriptor_wrapper.getNumberPoints();
-       ++desc_ind2) {
-
-    /***
-     * Here is the problem I'm calling compute from within the gradiant method
-     * but have no way of indicating that.
-     */
-    double density = distribution_->compute(
-        descriptor_wrapper, desc_ind2,
-        entropy_settings_.getDistributionSettings(Method::ComputeGradiant));
-    inv_distribution.push_back(-1.0 / density);
-  }
-
-  std::vector<double> grad = distribution_->compute_grad(
-      descriptor_wrapper,
-      desc_ind, // desc_ind
-      desc_ind, // grad_ind
-      entropy_settings_.getDistributionSettings(Method::ComputeGradiant),
-      settings::GradSetting::WRTDescriptor);
-
-  std::transform(grad.begin(), grad.end(), grad.begin(),
-                 std::bind(std::multiplies<double>(), std::placeholders::_1,
-                           inv_distribution.at(desc_ind)));
+  // Only the point the gradiant is taken at is read, so the descriptors are
+  // used in their own layout rather than copied into a point major layout
+  const DistributionSettings &dist_settings =
+      entropy_settings_.getDistributionSettings(Method::ComputeGradiant);
+
+  /***
+   * Here is the problem I'm calling compute from within the gradiant method
+   * but have no way of indicating that.
+   *
+   * Only the density at the point the gradiant is taken at contributes.
+   */
+  const double inv_density =
+      -1.0 /
+      distribution_->compute(descriptor_wrapper, desc_ind, dist_settings);
+
+  grad.assign(descriptor_wrapper.getNumberDimensions(), 0.0);
+  distribution_->accumulate_grad(descriptor_wrapper,
+                                 desc_ind, // desc_ind
+                                 desc_ind, // grad_ind
+                                 dist_settings, inv_density, grad,
+                                 settings::GradSetting::WRTDescriptor);
 
   // Replace nan values with 0.0
   auto f = [](double const val) { return std::isnan(val); };
@@ -159,8 +167,6 @@ std::vector<double> CrossEntropy::compute_grad(
                   std::numeric_limits<double>::max());
   std::replace_if(grad.begin(), grad.end(), is_neg_inf,
                   std::numeric_limits<double>::min());
-
-  return grad;
 }
 
 std::vector<double> CrossEntropy::compute_grad(
@@ -236,6 +242,7 @@ CrossEntropy::write(const settings::FileType file_type, std::ostream &os,
                     const EntropyTerm &entropy_term_instance) {
   std::vector<std::any> nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     if (entropy_term_instance.type() == settings::EntropyType::Cross) {
 
@@ -244,7 +251,8 @@ CrossEntropy::write(const settings::FileType file_type, std::ostream &os,
       nested_values.push_back(&cross_ent.entropy_settings_);
       nested_values.push_back(cross_ent.distribution_.get());
 
-      if (file_type == settings::FileType::TXTRestart) {
+      if (file_type == settings::FileType::TXTRestart ||
+          file_type == settings::FileType::BinaryRestart) {
         if (cross_ent.state() != EntropyTerm::State::Initialized) {
           std::string error_msg =
               "Only entropy terms that have been initialized can";
@@ -269,6 +277,7 @@ CrossEntropy::read(const settings::FileType file_type, std::istream &is,
 
   io::ReadInstantiateVector nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     if (entropy_term_instance.type() == settings::EntropyType::Cross) {
 
@@ -280,7 +289,8 @@ CrossEntropy::read(const settings::FileType file_type, std::istream &is,
       // Set the file type to initialized if reading a restart file
       // This means that only entropy terms that have been initialized should be
       // written to restart files
-      if (file_type == settings::FileType::TXTRestart) {
+      if (file_type == settings::FileType::TXTRestart ||
+          file_type == settings::FileType::BinaryRestart) {
         cross_ent.state_ = EntropyTerm::State::Initialized;
       }
     } else {
@@ -73,6 +73,10 @@ public:
   compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
                const int desc_ind) override;
 
+  virtual void compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind,
+                            std::vector<double> &grad) override;
+
   virtual std::vector<double>
   compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
                const int desc_ind,
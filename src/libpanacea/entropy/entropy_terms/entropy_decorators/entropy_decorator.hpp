@@ -83,6 +83,12 @@ public:
     return entropy_term_->compute_grad(descriptor_wrapper, desc_ind);
   }
 
+  virtual void compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind,
+                            std::vector<double> &grad) override {
+    entropy_term_->compute_grad(descriptor_wrapper, desc_ind, grad);
+  }
+
   virtual std::vector<double>
   compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
                const int desc_ind,
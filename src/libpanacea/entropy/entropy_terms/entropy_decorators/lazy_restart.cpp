@@ -0,0 +1,171 @@
+// Local private PANACEA includes
+#include "lazy_restart.hpp"
+
+#include "entropy/entropy_settings/entropy_settings.hpp"
+#include "error.hpp"
+#include "io/restart_read_context.hpp"
+
+// Standard includes
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// System includes
+#include <sys/stat.h>
+
+namespace panacea {
+
+/***********************************************************
+ * Private Methods
+ ***********************************************************/
+
+bool LazyRestart::FileVersion::operator==(
+    const FileVersion &version) const noexcept {
+  return device == version.device && inode == version.inode &&
+         size == version.size && modified_sec == version.modified_sec &&
+         modified_nsec == version.modified_nsec;
+}
+
+LazyRestart::FileVersion
+LazyRestart::fileVersion_(const std::string &file_name) {
+  struct stat file_stat;
+  if (::stat(file_name.c_str(), &file_stat) != 0) {
+    std::string error_msg = "Unable to find restart file: " + file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  FileVersion version;
+  version.device = static_cast<std::uint64_t>(file_stat.st_dev);
+  version.inode = static_cast<std::uint64_t>(file_stat.st_ino);
+  version.size = static_cast<std::int64_t>(file_stat.st_size);
+  version.modified_sec = static_cast<std::int64_t>(file_stat.st_mtim.tv_sec);
+  version.modified_nsec = static_cast<std::int64_t>(file_stat.st_mtim.tv_nsec);
+  return version;
+}
+
+void LazyRestart::load_() const {
+  if (loaded_) {
+    return;
+  }
+  // Kernels read from another version of the file would not match the
+  // statistics read so far
+  if (not(fileVersion_(file_name_) == file_version_)) {
+    std::string error_msg = "Restart file changed before the kernels of the ";
+    error_msg += "lazily loaded entropy term were read: " + file_name_;
+    PANACEA_FAIL(error_msg);
+  }
+  // Reading the restart file again replaces the statistics read so far and
+  // fills the kernel wrappers that were left empty
+  io::readRestartRecords(*file_io_, entropy_term_.get(), file_name_, false);
+  loaded_ = true;
+}
+
+/***********************************************************
+ * Public Methods
+ ***********************************************************/
+
+LazyRestart::LazyRestart(std::unique_ptr<EntropyTerm> entropy_term,
+                         std::unique_ptr<io::FileIO> file_io,
+                         std::string file_name)
+    : EntropyDecorator(std::move(entropy_term)), file_io_(std::move(file_io)),
+      file_name_(std::move(file_name)),
+      file_version_(fileVersion_(file_name_)) {
+  io::readRestartRecords(*file_io_, entropy_term_.get(), file_name_, true);
+}
+
+std::vector<EntropyTerm::ReadElement>
+LazyRestart::getReadElements(const PassKey<EntropyTerm> &) {
+  // Records read into the entropy term may only hold the kernels added since
+  // the restart file was written
+  load_();
+  return EntropyDecorator::getReadElements(key);
+}
+
+std::vector<EntropyTerm::WriteElement>
+LazyRestart::getWriteElements(const PassKey<EntropyTerm> &) const {
+  load_();
+  return EntropyDecorator::getWriteElements(key);
+}
+
+double LazyRestart::compute(const BaseDescriptorWrapper &descriptor_wrapper) {
+  load_();
+  return entropy_term_->compute(descriptor_wrapper);
+}
+
+double LazyRestart::compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind) {
+  load_();
+  return entropy_term_->compute(descriptor_wrapper, desc_ind);
+}
+
+double LazyRestart::compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const EntropySettings &entropy_settings) {
+  load_();
+  return entropy_term_->compute(descriptor_wrapper, entropy_settings);
+}
+
+double LazyRestart::compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind,
+                            const EntropySettings &entropy_settings) {
+  load_();
+  return entropy_term_->compute(descriptor_wrapper, desc_ind,
+                                entropy_settings);
+}
+
+double LazyRestart::compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const PANACEASettings &panacea_settings) {
+  load_();
+  return entropy_term_->compute(descriptor_wrapper, panacea_settings);
+}
+
+double LazyRestart::compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind,
+                            const PANACEASettings &panacea_settings) {
+  load_();
+  return entropy_term_->compute(descriptor_wrapper, desc_ind,
+                                panacea_settings);
+}
+
+std::vector<double>
+LazyRestart::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                          const int desc_ind) {
+  load_();
+  return entropy_term_->compute_grad(descriptor_wrapper, desc_ind);
+}
+
+void LazyRestart::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                               const int desc_ind, std::vector<double> &grad) {
+  load_();
+  entropy_term_->compute_grad(descriptor_wrapper, desc_ind, grad);
+}
+
+std::vector<double>
+LazyRestart::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                          const int desc_ind,
+                          const EntropySettings &entropy_settings) {
+  load_();
+  return entropy_term_->compute_grad(descriptor_wrapper, desc_ind,
+                                     entropy_settings);
+}
+
+std::vector<double>
+LazyRestart::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                          const int desc_ind,
+                          const PANACEASettings &panacea_settings) {
+  load_();
+  return entropy_term_->compute_grad(descriptor_wrapper, desc_ind,
+                                     panacea_settings);
+}
+
+void LazyRestart::update(const BaseDescriptorWrapper &descriptor_wrapper) {
+  load_();
+  entropy_term_->update(descriptor_wrapper);
+}
+
+void LazyRestart::initialize(const BaseDescriptorWrapper &descriptor_wrapper) {
+  // Initializing replaces the kernels, there is no need to read them first
+  entropy_term_->initialize(descriptor_wrapper);
+  loaded_ = true;
+}
+
+} // namespace panacea
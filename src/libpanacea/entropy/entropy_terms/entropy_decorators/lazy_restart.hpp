@@ -0,0 +1,121 @@
+
+#ifndef PANACEA_PRIVATE_ENTROPYDECORATOR_LAZYRESTART_H
+#define PANACEA_PRIVATE_ENTROPYDECORATOR_LAZYRESTART_H
+#pragma once
+
+// Local private PANACEA includes
+#include "entropy_decorator.hpp"
+
+// Public PANACEA includes
+#include "panacea/file_io.hpp"
+#include "passkey.hpp"
+
+// Standard includes
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+class EntropySettings;
+class EntropyTerm;
+
+/**
+ * Entropy term read from a restart file whose kernels are read on first use
+ *
+ * The settings and statistics of the entropy term are read when it is
+ * created, which is enough to query its dimensions. The kernels are read and
+ * the primitives constructed the first time the entropy term is evaluated,
+ * updated or written, so the restart file must not change until then. The
+ * kernels are not read from a file that was changed or replaced in the
+ * meantime, doing so throws.
+ *
+ * The decorator does not write anything itself, restart files written from
+ * the entropy term are the same as those of the term it wraps.
+ **/
+class LazyRestart : public EntropyDecorator {
+
+private:
+  std::unique_ptr<io::FileIO> file_io_;
+  std::string file_name_;
+  mutable bool loaded_ = false;
+
+  // Identifies the version of the restart file the statistics were read
+  // from, the kernels are only read from that same version
+  struct FileVersion {
+    std::uint64_t device = 0;
+    std::uint64_t inode = 0;
+    std::int64_t size = 0;
+    std::int64_t modified_sec = 0;
+    std::int64_t modified_nsec = 0;
+
+    bool operator==(const FileVersion &version) const noexcept;
+  };
+  FileVersion file_version_;
+
+  static FileVersion fileVersion_(const std::string &file_name);
+
+  void load_() const;
+
+public:
+  /**
+   * Reads the restart file into the entropy term with its kernels deferred.
+   **/
+  LazyRestart(std::unique_ptr<EntropyTerm> entropy_term,
+              std::unique_ptr<io::FileIO> file_io, std::string file_name);
+
+  bool loaded() const noexcept { return loaded_; }
+
+  virtual std::vector<EntropyTerm::ReadElement>
+  getReadElements(const PassKey<EntropyTerm> &) override;
+  virtual std::vector<EntropyTerm::WriteElement>
+  getWriteElements(const PassKey<EntropyTerm> &) const override;
+
+  virtual double
+  compute(const BaseDescriptorWrapper &descriptor_wrapper) override;
+
+  virtual double compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                         const int desc_ind) override;
+
+  virtual double compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                         const EntropySettings &entropy_settings) override;
+
+  virtual double compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                         const int desc_ind,
+                         const EntropySettings &entropy_settings) override;
+
+  virtual double compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                         const PANACEASettings &panacea_settings) override;
+
+  virtual double compute(const BaseDescriptorWrapper &descriptor_wrapper,
+                         const int desc_ind,
+                         const PANACEASettings &panacea_settings) override;
+
+  virtual std::vector<double>
+  compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+               const int desc_ind) override;
+
+  virtual void compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                            const int desc_ind,
+                            std::vector<double> &grad) override;
+
+  virtual std::vector<double>
+  compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+               const int desc_ind,
+               const EntropySettings &entropy_settings) override;
+
+  virtual std::vector<double>
+  compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+               const int desc_ind,
+               const PANACEASettings &panacea_settings) override;
+
+  virtual void update(const BaseDescriptorWrapper &descriptor_wrapper) override;
+
+  virtual void
+  initialize(const BaseDescriptorWrapper &descriptor_wrapper) override;
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_ENTROPYDECORATOR_LAZYRESTART_H
@@ -4,6 +4,7 @@
 
 #include "descriptors/descriptor_wrapper.hpp"
 #include "entropy/entropy_settings/entropy_settings.hpp"
+#include "io/txt_numbers.hpp"
 
 // Standard includes
 #include <cassert>
@@ -27,12 +28,25 @@ NumericalGrad::getWriteElements(const PassKey<EntropyTerm> &) const {
   return write_functions;
 }
 
+std::vector<double> NumericalGrad::compute_grad(
+    const BaseDescriptorWrapper &const_descriptor_wrapper, const int wrt_pt) {
+
+  if (numerical_grad_) {
+    std::vector<double> grad(getMaximumNumberOfDimensions(), 0.0);
+    compute_grad(const_descriptor_wrapper, wrt_pt, grad);
+    return grad;
+  } else {
+    return EntropyDecorator::compute_grad(const_descriptor_wrapper, wrt_pt);
+  }
+}
+
 /**
  * WARNING the following two methods look almost identical but they
  * are not.
  **/
-std::vector<double> NumericalGrad::compute_grad(
-    const BaseDescriptorWrapper &const_descriptor_wrapper, const int wrt_pt) {
+void NumericalGrad::compute_grad(
+    const BaseDescriptorWrapper &const_descriptor_wrapper, const int wrt_pt,
+    std::vector<double> &grad) {
 
   if (numerical_grad_) {
     /**
@@ -51,30 +65,25 @@ std::vector<double> NumericalGrad::compute_grad(
         const_cast<BaseDescriptorWrapper &>(const_descriptor_wrapper);
 
     const int ndim = getMaximumNumberOfDimensions();
-    std::vector<double> grad(ndim, 0.0);
+    grad.assign(ndim, 0.0);
 
     // Cycle through dimensions
     for (const int &dim : getDimensions()) {
       assert(dim < ndim);
-      const double orig_x_val = descriptor_wrapper(wrt_pt, dim);
+      const double orig_x_val = const_descriptor_wrapper(wrt_pt, dim);
       const double diff = orig_x_val * inc_ratio_;
-      // Change in this dimention
-      const std::vector<double> new_x_vals = {orig_x_val - diff,
-                                              orig_x_val + diff};
 
       // Temporarily alter the input value
-      std::vector<double> new_y_vals(2, 0.0);
-      descriptor_wrapper(wrt_pt, dim) = new_x_vals.at(0);
-      new_y_vals.at(0) += EntropyDecorator::compute(descriptor_wrapper);
-      descriptor_wrapper(wrt_pt, dim) = new_x_vals.at(1);
-      new_y_vals.at(1) += EntropyDecorator::compute(descriptor_wrapper);
-      grad.at(dim) = (new_y_vals.at(1) - new_y_vals.at(0)) / (2.0 * diff);
+      descriptor_wrapper(wrt_pt, dim) = orig_x_val - diff;
+      const double lower_y_val = EntropyDecorator::compute(descriptor_wrapper);
+      descriptor_wrapper(wrt_pt, dim) = orig_x_val + diff;
+      const double upper_y_val = EntropyDecorator::compute(descriptor_wrapper);
+      grad[dim] = (upper_y_val - lower_y_val) / (2.0 * diff);
       // Reset to the original value
       descriptor_wrapper(wrt_pt, dim) = orig_x_val;
     }
-    return grad;
   } else {
-    return EntropyDecorator::compute_grad(const_descriptor_wrapper, wrt_pt);
+    EntropyDecorator::compute_grad(const_descriptor_wrapper, wrt_pt, grad);
   }
 }
 
@@ -104,7 +113,7 @@ std::vector<double> NumericalGrad::compute_grad(
     // Cycle through dimensions
     for (const int &dim : getDimensions()) {
       assert(dim < ndim);
-      const double orig_x_val = descriptor_wrapper(wrt_pt, dim);
+      const double orig_x_val = const_descriptor_wrapper(wrt_pt, dim);
       const double diff = orig_x_val * inc_ratio_;
       // Change in this dimention
       const std::vector<double> new_x_vals = {orig_x_val - diff,
@@ -184,14 +193,16 @@ NumericalGrad::write(const settings::FileType file_type, std::ostream &os,
                      const EntropyTerm &entropy_term_instance) {
 
   std::vector<std::any> nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
 
     try {
 
       const NumericalGrad &ent_term =
           dynamic_cast<const NumericalGrad &>(entropy_term_instance);
       os << "[Increment Ratio]\n";
-      os << ent_term.inc_ratio_ << "\n";
+      io::writeDouble(os, ent_term.inc_ratio_);
+      os << "\n";
       os << "[Numerical Grad]\n";
       os << ent_term.numerical_grad_ << "\n";
 
@@ -209,7 +220,8 @@ NumericalGrad::read(const settings::FileType file_type, std::istream &is,
                     EntropyTerm &entropy_term_instance) {
 
   io::ReadInstantiateVector nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
 
     NumericalGrad &ent_term = [&]() -> NumericalGrad & {
       try {
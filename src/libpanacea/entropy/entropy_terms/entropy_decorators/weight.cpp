@@ -3,6 +3,7 @@
 
 #include "entropy/entropy_settings/entropy_settings.hpp"
 #include "error.hpp"
+#include "io/txt_numbers.hpp"
 #include "numerical_grad.hpp"
 
 // Standard includes
@@ -69,6 +70,15 @@ Weight::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
   return vec;
 }
 
+void Weight::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
+                          const int desc_ind, std::vector<double> &grad) {
+
+  EntropyDecorator::compute_grad(descriptor_wrapper, desc_ind, grad);
+  for (double &val : grad) {
+    val *= weight_;
+  }
+}
+
 std::vector<double>
 Weight::compute_grad(const BaseDescriptorWrapper &descriptor_wrapper,
                      const int desc_ind,
@@ -137,13 +147,15 @@ std::vector<std::any> Weight::write(const settings::FileType file_type,
                                     const EntropyTerm &entropy_term_instance) {
 
   std::vector<std::any> nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
     try {
       const Weight &ent_term =
           dynamic_cast<const Weight &>(entropy_term_instance);
 
       os << "[Weight]\n";
-      os << ent_term.weight_ << "\n";
+      io::writeDouble(os, ent_term.weight_);
+      os << "\n";
 
       //      os << std::any_cast<double>(
       //          entropy_term_instance.get(
@@ -162,7 +174,8 @@ io::ReadInstantiateVector Weight::read(const settings::FileType file_type,
                                        EntropyTerm &entropy_term_instance) {
 
   io::ReadInstantiateVector nested_values;
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
 
     try {
       Weight &ent_term = dynamic_cast<Weight &>(entropy_term_instance);
@@ -49,9 +49,11 @@ std::vector<std::any> EntropyTerm::write(const settings::FileType file_type,
 
   std::vector<std::any> nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
-    if (file_type == settings::FileType::TXTRestart) {
+    if (file_type == settings::FileType::TXTRestart ||
+        file_type == settings::FileType::BinaryRestart) {
       if (entropy_term.state() != EntropyTerm::State::Initialized) {
         std::string error_msg =
             "Only entropy terms that have been initialized can";
@@ -95,6 +97,7 @@ io::ReadInstantiateVector EntropyTerm::read(const settings::FileType file_type,
 
   io::ReadInstantiateVector nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
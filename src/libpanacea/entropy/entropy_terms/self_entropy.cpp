@@ -5,6 +5,7 @@
 // Local private PANACEA includes
 #include "self_entropy.hpp"
 
+#include "descriptors/point_major_descriptors.hpp"
 #include "distribution/distribution_factory.hpp"
 #include "distribution/distribution_settings/distribution_settings.hpp"
 #include "distribution/distributions/distribution.hpp"
@@ -61,13 +62,15 @@ double SelfEntropy::compute(const BaseDescriptorWrapper &descriptor_wrapper) {
     error_msg += " or when creating the entropy term provide the descriptors.";
     PANACEA_FAIL(error_msg);
   }
+  // The settings and layout are the same for every point
+  const DistributionSettings &dist_settings =
+      entropy_settings_.getDistributionSettings(Method::Compute);
+  const PointMajorDescriptors point_major_descriptors(descriptor_wrapper);
+  const BaseDescriptorWrapper &point_major = point_major_descriptors.get();
   double self_entropy = 0.0;
-  for (int desc_pt = 0; desc_pt < descriptor_wrapper.getNumberPoints();
-       ++desc_pt) {
-    self_entropy +=
-        -1.0 * log(distribution_->compute(
-                   descriptor_wrapper, desc_pt,
-                   entropy_settings_.getDistributionSettings(Method::Compute)));
+  for (int desc_pt = 0; desc_pt < point_major.getNumberPoints(); ++desc_pt) {
+    self_entropy += -1.0 * log(distribution_->compute(point_major, desc_pt,
+                                                      dist_settings));
   }
   return self_entropy;
 }
@@ -120,6 +123,15 @@ std::vector<double> SelfEntropy::compute_grad(
     const BaseDescriptorWrapper &descriptor_wrapper,
     const int desc_ind // Where the gradiant is being calculated at
 ) {
+  std::vector<double> grad;
+  compute_grad(descriptor_wrapper, desc_ind, grad);
+  return grad;
+}
+
+void SelfEntropy::compute_grad(
+    const BaseDescriptorWrapper &descriptor_wrapper,
+    const int desc_ind, // Where the gradiant is being calculated at
+    std::vector<double> &grad) {
 
   if (state_ != EntropyTerm::State::Initialized) {
     std::string error_msg =
@@ -129,33 +141,25 @@ std::vector<double> SelfEntropy::compute_grad(
     error_msg += " or when creating the entropy term provide the descriptors.";
     PANACEA_FAIL(error_msg);
   }
-  std::vector<double> inv_distribution;
-  inv_distribution.reserve(descriptor_wrapper.getNumberPoints());
-  for (int desc_ind2 = 0; desc_ind2 < descriptor_wrapper.getNumberPoints();
-       ++desc_ind2) {
-    inv_distribution.push_back(
-        -1.0 / distribution_->compute(descriptor_wrapper, desc_ind2,
-                                      entropy_settings_.getDistributionSettings(
-                                          Method::ComputeGradiant)));
-  }
-  // Compute the gradiant with respect to the Descriptors
-  std::vector<double> grad(descriptor_wrapper.getNumberDimensions(), 0.0);
+  // The settings and layout are the same for every point
+  const DistributionSettings &dist_settings =
+      entropy_settings_.getDistributionSettings(Method::ComputeGradiant);
+  const PointMajorDescriptors point_major_descriptors(descriptor_wrapper);
+  const BaseDescriptorWrapper &point_major = point_major_descriptors.get();
+
+  grad.assign(point_major.getNumberDimensions(), 0.0);
 
-  // Compute the gradiant with respect to each of the Kernels
-  for (int desc_ind2 = 0; desc_ind2 < descriptor_wrapper.getNumberPoints();
+  // Compute the gradiant with respect to each of the Kernels, each weighted by
+  // the inverse of the density at its point
+  for (int desc_ind2 = 0; desc_ind2 < point_major.getNumberPoints();
        ++desc_ind2) {
-    std::vector<double> grad_temp = distribution_->compute_grad(
-        descriptor_wrapper,
-        desc_ind2, // desc_ind
-        desc_ind,  // where we are taking gradiant wrt
-        entropy_settings_.getDistributionSettings(Method::ComputeGradiant));
-
-    std::transform(grad_temp.begin(), grad_temp.end(), grad_temp.begin(),
-                   std::bind(std::multiplies<double>(), std::placeholders::_1,
-                             inv_distribution.at(desc_ind2)));
-
-    std::transform(grad.begin(), grad.end(), grad_temp.begin(), grad.begin(),
-                   std::plus<double>());
+    const double inv_density =
+        -1.0 / distribution_->compute(point_major, desc_ind2, dist_settings);
+
+    distribution_->accumulate_grad(point_major,
+                                   desc_ind2, // desc_ind
+                                   desc_ind,  // gradiant wrt
+                                   dist_settings, inv_density, grad);
   }
 
   auto f = [](double const val) { return std::isnan(val); };
@@ -164,8 +168,6 @@ std::vector<double> SelfEntropy::compute_grad(
                   std::numeric_limits<double>::max());
   std::replace_if(grad.begin(), grad.end(), is_neg_inf,
                   std::numeric_limits<double>::min());
-
-  return grad;
 }
 
 std::vector<double> SelfEntropy::compute_grad(
@@ -242,10 +244,12 @@ SelfEntropy::write(const settings::FileType file_type, std::ostream &os,
 
   std::vector<std::any> nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     if (entropy_term_instance.type() == settings::EntropyType::Self) {
 
-      if (file_type == settings::FileType::TXTRestart) {
+      if (file_type == settings::FileType::TXTRestart ||
+          file_type == settings::FileType::BinaryRestart) {
         if (entropy_term_instance.state() != EntropyTerm::State::Initialized) {
           std::string error_msg =
               "Only entropy terms that have been initialized can";
@@ -282,6 +286,7 @@ SelfEntropy::read(const settings::FileType file_type, std::istream &is,
 
   io::ReadInstantiateVector nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     if (entropy_term_instance.type() == settings::EntropyType::Self) {
       try {
@@ -293,7 +298,8 @@ SelfEntropy::read(const settings::FileType file_type, std::istream &is,
         // Set the file type to initialized if reading a restart file
         // This means that only entropy terms that have been initialized should
         // be written to restart files
-        if (file_type == settings::FileType::TXTRestart) {
+        if (file_type == settings::FileType::TXTRestart ||
+            file_type == settings::FileType::BinaryRestart) {
           self_ent.state_ = EntropyTerm::State::Initialized;
         }
       } catch (...) {
@@ -0,0 +1,69 @@
+// Public PANACEA includes
+#include "panacea/instrumentation.hpp"
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace panacea {
+namespace instrumentation {
+
+/************************************************
+ * File scope variables
+ ************************************************/
+
+static constexpr std::size_t number_events = 2;
+
+static std::array<std::atomic<std::size_t>, number_events> event_counts{};
+
+static std::mutex listener_mutex;
+static Listener listener;
+// Avoids taking the lock when no listener is registered
+static std::atomic<bool> listener_set{false};
+
+/************************************************
+ * Public functions
+ ************************************************/
+
+void setListener(Listener new_listener) {
+  std::lock_guard<std::mutex> lock(listener_mutex);
+  listener = std::move(new_listener);
+  listener_set = static_cast<bool>(listener);
+}
+
+void record(const Event event, const char *description) {
+  event_counts[static_cast<std::size_t>(event)].fetch_add(
+      1, std::memory_order_relaxed);
+  if (listener_set.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(listener_mutex);
+    if (listener) {
+      listener(event, description);
+    }
+  }
+}
+
+std::size_t count(const Event event) noexcept {
+  return event_counts[static_cast<std::size_t>(event)].load(
+      std::memory_order_relaxed);
+}
+
+void reset() noexcept {
+  for (auto &event_count : event_counts) {
+    event_count.store(0, std::memory_order_relaxed);
+  }
+}
+
+} // namespace instrumentation
+
+std::ostream &operator<<(std::ostream &os,
+                         const instrumentation::Event &event) {
+  if (event == instrumentation::Event::LayoutInPlace) {
+    os << "LayoutInPlace";
+  } else if (event == instrumentation::Event::LayoutPointMajorBuilt) {
+    os << "LayoutPointMajorBuilt";
+  }
+  return os;
+}
+
+} // namespace panacea
@@ -0,0 +1,81 @@
+
+// Local private PANACEA includes
+#include "async_checkpoint_writer.hpp"
+
+#include "atomic_file.hpp"
+#include "error.hpp"
+#include "file_io_factory.hpp"
+#include "restart_delta.hpp"
+
+// Standard includes
+#include <any>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/***********************************************************
+ * Public Methods
+ ***********************************************************/
+
+AsyncCheckpointWriter::AsyncCheckpointWriter(
+    const settings::FileType file_type) {
+  if (file_type != settings::FileType::TXTRestart &&
+      file_type != settings::FileType::BinaryRestart) {
+    std::string error_msg = "Checkpoints can only be written to restart ";
+    error_msg += "file types.";
+    PANACEA_FAIL(error_msg);
+  }
+  FileIOFactory file_io_factory;
+  file_io_ = file_io_factory.create(file_type);
+}
+
+std::shared_future<void>
+AsyncCheckpointWriter::write(std::any obj, const std::string &filename) {
+  return write(std::vector<std::any>{std::move(obj)}, filename);
+}
+
+std::shared_future<void>
+AsyncCheckpointWriter::write(const std::vector<std::any> &objs,
+                             const std::string &filename) {
+  // The snapshot is taken on the calling thread, afterwards the objects are
+  // free to change. Kernels stored copy-on-write are only held on to, they
+  // are serialized along with the file system work in the background.
+  auto snapshot = std::make_shared<RestartOStream>();
+  snapshot->setSnapshot(true);
+  for (const auto &obj : objs) {
+    file_io_->write(obj, *snapshot);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_future<void> previous = last_;
+  last_ = std::async(std::launch::async, [previous, snapshot, filename]() {
+            if (previous.valid()) {
+              previous.wait();
+            }
+            writeFileAtomically(filename, snapshot->render());
+          }).share();
+  return last_;
+}
+
+void AsyncCheckpointWriter::wait() {
+  std::shared_future<void> last;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    last = last_;
+  }
+  if (last.valid()) {
+    last.wait();
+  }
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() { wait(); }
+
+} // namespace io
+} // namespace panacea
@@ -0,0 +1,62 @@
+#ifndef PANACEA_PRIVATE_ASYNC_CHECKPOINT_WRITER_H
+#define PANACEA_PRIVATE_ASYNC_CHECKPOINT_WRITER_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/checkpoint_writer.hpp"
+#include "panacea/file_io.hpp"
+
+// Local private PANACEA includes
+#include "private_settings.hpp"
+
+// Standard includes
+#include <any>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Checkpoint writer that snapshots objects without serializing their kernels
+ *
+ * The small statistics, e.g. the covariance, normalizer and settings, are
+ * serialized into memory before write returns. Kernels stored copy-on-write
+ * are only held on to, the kernels detach from the held storage if they are
+ * changed, and are serialized on the background thread. Kernels that point
+ * at the memory of the caller's descriptors are serialized before write
+ * returns.
+ *
+ * The snapshot is written to file_name + ".partial", flushed to disk and
+ * then renamed onto file_name.
+ **/
+class AsyncCheckpointWriter : public CheckpointWriter {
+private:
+  std::unique_ptr<FileIO> file_io_;
+  std::mutex mutex_;
+  // The most recently requested checkpoint, each checkpoint waits for the
+  // previous one so that they reach the disk in order
+  std::shared_future<void> last_;
+
+public:
+  explicit AsyncCheckpointWriter(const settings::FileType file_type);
+
+  virtual std::shared_future<void>
+  write(std::any obj, const std::string &filename) override;
+  virtual std::shared_future<void>
+  write(const std::vector<std::any> &objs,
+        const std::string &filename) override;
+
+  virtual void wait() override;
+
+  virtual ~AsyncCheckpointWriter();
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_ASYNC_CHECKPOINT_WRITER_H
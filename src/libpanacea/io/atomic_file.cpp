@@ -0,0 +1,111 @@
+
+// Local private PANACEA includes
+#include "atomic_file.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <cerrno>
+#include <cstdio>
+#include <string>
+
+// System includes
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace panacea {
+
+namespace io {
+
+/***********************************************************
+ * File scope functions
+ ***********************************************************/
+
+namespace {
+
+void fail(const std::string &message, const std::string &file_name) {
+  std::string error_msg = message + " checkpoint file: " + file_name;
+  PANACEA_FAIL(error_msg);
+}
+
+/**
+ * Writes all of the contents and flushes them to disk, the file is closed
+ * in either case.
+ **/
+void writeAndSync(const int file_descriptor, const std::string &file_name,
+                  const std::string &contents) {
+  const char *data = contents.data();
+  std::size_t remaining = contents.size();
+  while (remaining > 0) {
+    const ssize_t written = ::write(file_descriptor, data, remaining);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ::close(file_descriptor);
+      fail("Unable to write", file_name);
+    }
+    data += written;
+    remaining -= static_cast<std::size_t>(written);
+  }
+
+  if (::fsync(file_descriptor) != 0) {
+    ::close(file_descriptor);
+    fail("Unable to flush", file_name);
+  }
+  if (::close(file_descriptor) != 0) {
+    fail("Unable to close", file_name);
+  }
+}
+
+} // namespace
+
+/***********************************************************
+ * Public functions
+ ***********************************************************/
+
+void writeFileAtomically(const std::string &file_name,
+                         const std::string &contents) {
+  const std::string partial_name = file_name + ".partial";
+  const int file_descriptor =
+      ::open(partial_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (file_descriptor < 0) {
+    fail("Unable to open", partial_name);
+  }
+  writeAndSync(file_descriptor, partial_name, contents);
+
+  if (std::rename(partial_name.c_str(), file_name.c_str()) != 0) {
+    fail("Unable to rename", partial_name);
+  }
+
+  // The rename is only durable once the directory has been flushed as well
+  const auto slash = file_name.find_last_of('/');
+  const std::string directory =
+      slash == std::string::npos ? "." : file_name.substr(0, slash + 1);
+  const int directory_descriptor = ::open(directory.c_str(), O_RDONLY);
+  if (directory_descriptor >= 0) {
+    ::fsync(directory_descriptor);
+    ::close(directory_descriptor);
+  }
+}
+
+void appendToFile(const std::string &file_name, const std::string &contents) {
+  const int file_descriptor =
+      ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (file_descriptor < 0) {
+    fail("Unable to open", file_name);
+  }
+  const off_t size = ::lseek(file_descriptor, 0, SEEK_END);
+  try {
+    writeAndSync(file_descriptor, file_name, contents);
+  } catch (...) {
+    // Drop whatever part of the contents made it to the file
+    if (size >= 0) {
+      ::truncate(file_name.c_str(), size);
+    }
+    throw;
+  }
+}
+
+} // namespace io
+} // namespace panacea
@@ -0,0 +1,30 @@
+#ifndef PANACEA_PRIVATE_ATOMIC_FILE_H
+#define PANACEA_PRIVATE_ATOMIC_FILE_H
+#pragma once
+
+// Standard includes
+#include <string>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Writes the contents to file_name + ".partial", flushes it to disk and
+ * renames it onto the file, so the file either holds its previous or its
+ * new contents.
+ **/
+void writeFileAtomically(const std::string &file_name,
+                         const std::string &contents);
+
+/**
+ * Appends the contents to the file and flushes it to disk, the file is
+ * created if it does not exist. A failed append is truncated away again, as
+ * far as the file system allows.
+ **/
+void appendToFile(const std::string &file_name, const std::string &contents);
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_ATOMIC_FILE_H
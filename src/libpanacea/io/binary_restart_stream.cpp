@@ -0,0 +1,75 @@
+
+// Local private PANACEA includes
+#include "binary_restart_stream.hpp"
+
+#include "error.hpp"
+#include "memory_mapped_array.hpp"
+
+// Standard includes
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/************************************************
+ * BinaryRestartOStream
+ ************************************************/
+
+int BinaryRestartOStream::addArray(const BinaryArrayHeader &header,
+                                   ArrayWriter writer,
+                                   const bool holds_values) {
+  arrays_.push_back(Array{header, std::move(writer), holds_values});
+  // Section 0 is the structure section
+  return static_cast<int>(arrays_.size());
+}
+
+/************************************************
+ * BinaryRestartIStream
+ ************************************************/
+
+const BinaryRestartSection &
+BinaryRestartIStream::array_(const int section) const {
+  if (section < 0 || section >= static_cast<int>(sections_.size()) ||
+      sections_[section].kind != BinaryRestartSection::Kind::Array) {
+    std::string error_msg = "Binary restart file does not contain an array ";
+    error_msg += "section with index " + std::to_string(section) + ".";
+    PANACEA_FAIL(error_msg);
+  }
+  return sections_[section];
+}
+
+BinaryRestartIStream::BinaryRestartIStream(
+    std::string structure, std::vector<BinaryRestartSection> sections,
+    std::istream &source, const std::streamoff record_begin,
+    RestartReadContext context)
+    : std::istringstream(std::move(structure)),
+      RestartReadContext(std::move(context)), sections_(std::move(sections)),
+      source_(source), record_begin_(record_begin) {}
+
+std::shared_ptr<MemoryMappedArray>
+BinaryRestartIStream::map(const int section) const {
+  assert(canMap());
+  const auto &array = array_(section);
+  return std::make_shared<MemoryMappedArray>(
+      fileName(), static_cast<std::size_t>(record_begin_ + array.offset));
+}
+
+std::istream &BinaryRestartIStream::seek(const int section) {
+  const auto &array = array_(section);
+  source_.clear();
+  source_.seekg(record_begin_ + static_cast<std::streamoff>(array.offset));
+  if (not source_) {
+    std::string error_msg = "Unable to seek to section ";
+    error_msg += std::to_string(section) + " of binary restart file.";
+    PANACEA_FAIL(error_msg);
+  }
+  return source_;
+}
+
+} // namespace io
+} // namespace panacea
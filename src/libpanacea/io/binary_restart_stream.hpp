@@ -0,0 +1,117 @@
+#ifndef PANACEA_PRIVATE_BINARY_RESTART_STREAM_H
+#define PANACEA_PRIVATE_BINARY_RESTART_STREAM_H
+#pragma once
+
+// Local private PANACEA includes
+#include "memory_mapped_array.hpp"
+#include "restart_delta.hpp"
+#include "restart_read_context.hpp"
+
+// Standard includes
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Entry of the section table of a binary restart file, the offset is
+ * measured from the start of the restart record.
+ **/
+struct BinaryRestartSection {
+  enum class Kind : std::uint32_t { Structure = 0, Array = 1 };
+
+  Kind kind = Kind::Structure;
+  std::uint64_t offset = 0;
+  std::uint64_t size = 0;
+};
+
+/**
+ * Stream handed to the write methods when writing a binary restart file
+ *
+ * Everything written to the stream ends up in the structure section, which
+ * has the same format as a txt restart file. Large arrays are instead added
+ * as separate sections, the object writes the returned section index in
+ * their place.
+ **/
+class BinaryRestartOStream : public RestartOStream {
+public:
+  /**
+   * Must write exactly rows * cols little endian values in the layout given
+   * by the array header.
+   **/
+  using ArrayWriter = std::function<void(std::ostream &)>;
+
+  struct Array {
+    BinaryArrayHeader header;
+    ArrayWriter writer;
+    // Whether the writer holds on to the values it writes rather than
+    // reading them from the object when called
+    bool holds_values = false;
+  };
+
+private:
+  std::vector<Array> arrays_;
+
+public:
+  /**
+   * The writer is only called once the file is written, so whatever it
+   * refers to must outlive the stream. Writers that hold their values are
+   * deferred further when writing to a snapshot.
+   **/
+  int addArray(const BinaryArrayHeader &header, ArrayWriter writer,
+               const bool holds_values = false);
+
+  const std::vector<Array> &arrays() const noexcept { return arrays_; }
+};
+
+/**
+ * Stream handed to the read methods when reading a binary restart file
+ *
+ * Contains the structure section, the array sections are read from the
+ * source stream or, if the file name of the restart file is known, memory
+ * mapped. The read context of the source stream is carried over.
+ **/
+class BinaryRestartIStream : public std::istringstream,
+                             public RestartReadContext {
+private:
+  std::vector<BinaryRestartSection> sections_;
+  std::istream &source_;
+  std::streamoff record_begin_;
+
+  const BinaryRestartSection &array_(const int section) const;
+
+public:
+  BinaryRestartIStream(std::string structure,
+                       std::vector<BinaryRestartSection> sections,
+                       std::istream &source, const std::streamoff record_begin,
+                       RestartReadContext context);
+
+  /**
+   * Array sections can only be mapped if the file name is known.
+   **/
+  bool canMap() const noexcept { return not fileName().empty(); }
+
+  std::shared_ptr<MemoryMappedArray> map(const int section) const;
+
+  /**
+   * Size in bytes of an array section including its array header.
+   **/
+  std::uint64_t size(const int section) const { return array_(section).size; }
+
+  /**
+   * Positions the source stream at the header of an array section.
+   **/
+  std::istream &seek(const int section);
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_BINARY_RESTART_STREAM_H
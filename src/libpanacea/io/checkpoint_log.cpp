@@ -0,0 +1,8 @@
+// Local public PANACEA includes
+#include "panacea/checkpoint_log.hpp"
+
+namespace panacea {
+namespace io {
+CheckpointLog::~CheckpointLog(){};
+}
+} // namespace panacea
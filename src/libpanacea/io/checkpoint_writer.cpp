@@ -0,0 +1,8 @@
+// Local public PANACEA includes
+#include "panacea/checkpoint_writer.hpp"
+
+namespace panacea {
+namespace io {
+CheckpointWriter::~CheckpointWriter(){};
+}
+} // namespace panacea
@@ -0,0 +1,8 @@
+// Local public PANACEA includes
+#include "panacea/descriptor_stream_reader.hpp"
+
+namespace panacea {
+namespace io {
+DescriptorStreamReader::~DescriptorStreamReader(){};
+}
+} // namespace panacea
@@ -0,0 +1,152 @@
+
+// Local private PANACEA includes
+#include "descriptor_stream_reader_txt.hpp"
+
+#include "attributes/covariance.hpp"
+#include "error.hpp"
+#include "txt_numbers.hpp"
+
+// Public PANACEA includes
+#include "panacea/entropy_term.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/***********************************************************
+ * Private Methods
+ ***********************************************************/
+
+void DescriptorStreamReaderTXT::readHeader_() {
+  std::getline(is_, line_);
+  if (line_.find("Descriptors", 0) == std::string::npos) {
+    std::string error_msg = "Descriptor file header does not contain the ";
+    error_msg += "Descriptors word.\n";
+    error_msg += "line is: " + line_ + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  // Chunks are made of points so each row of the file must be a point
+  std::getline(is_, line_);
+  if (line_.find("Dimensions along rows points along columns", 0) !=
+      std::string::npos) {
+    std::string error_msg = "Descriptor files with the dimensions along the ";
+    error_msg += "rows cannot be read in chunks of points.";
+    PANACEA_FAIL(error_msg);
+  }
+
+  std::getline(is_, line_);
+  std::istringstream ss(line_);
+  if (not(ss >> rows_ >> cols_) || rows_ < 0 || cols_ <= 0) {
+    std::string error_msg = "Unable to read in rows and columns from ";
+    error_msg += "Descriptors file.\n";
+    error_msg += "line is: " + line_ + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  row_values_.resize(cols_);
+}
+
+/***********************************************************
+ * Public Methods
+ ***********************************************************/
+
+DescriptorStreamReaderTXT::DescriptorStreamReaderTXT(std::istream &is,
+                                                     const int chunk_rows)
+    : is_(is), chunk_rows_(chunk_rows) {
+  if (chunk_rows_ <= 0) {
+    PANACEA_FAIL("Descriptor chunks must contain at least one point.");
+  }
+  readHeader_();
+}
+
+DescriptorStreamReaderTXT::DescriptorStreamReaderTXT(
+    const std::string &file_name, const int chunk_rows)
+    : file_(std::make_unique<std::ifstream>(file_name)), is_(*file_),
+      chunk_rows_(chunk_rows) {
+  if (not *file_) {
+    std::string error_msg = "Unable to open descriptor file " + file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  if (chunk_rows_ <= 0) {
+    PANACEA_FAIL("Descriptor chunks must contain at least one point.");
+  }
+  readHeader_();
+}
+
+int DescriptorStreamReaderTXT::read(Chunk &chunk) {
+  const int rows = std::min(chunk_rows_, rows_ - rows_read_);
+  if (rows == 0) {
+    return 0;
+  }
+  chunk.set(Arrangement::PointsAlongRowsDimensionsAlongCols);
+  chunk.resize(rows, cols_);
+  for (int row = 0; row < rows; ++row) {
+    std::getline(is_, line_);
+    if (parseValues(line_.data(), line_.data() + line_.size(),
+                    row_values_.data(), cols_) != cols_) {
+      std::string error_msg =
+          "Error encountered while attempting to read in descriptor ";
+      error_msg += "coefficients of point ";
+      error_msg += std::to_string(rows_read_ + row) + ".\n";
+      error_msg += "line is: " + line_ + "\n";
+      PANACEA_FAIL(error_msg);
+    }
+    for (int col = 0; col < cols_; ++col) {
+      chunk(row, col) = row_values_[col];
+    }
+  }
+  rows_read_ += rows;
+  return rows;
+}
+
+void DescriptorStreamReaderTXT::forEachChunk(const ChunkCallback &callback,
+                                             const bool overlap) {
+  Chunk chunk(std::vector<std::vector<double>>(), 0, 0);
+  if (not overlap) {
+    while (read(chunk) > 0) {
+      callback(chunk);
+    }
+    return;
+  }
+
+  // Two chunks are alternated, one is parsed while the other is used
+  Chunk other_chunk(std::vector<std::vector<double>>(), 0, 0);
+  Chunk *current = &chunk;
+  Chunk *next = &other_chunk;
+  int rows = read(*current);
+  while (rows > 0) {
+    auto next_rows =
+        std::async(std::launch::async, [this, next]() { return read(*next); });
+    callback(*current);
+    rows = next_rows.get();
+    std::swap(current, next);
+  }
+}
+
+void DescriptorStreamReaderTXT::update(EntropyTerm &entropy_term,
+                                       const bool overlap) {
+  forEachChunk(
+      [&](const BaseDescriptorWrapper &chunk) { entropy_term.update(chunk); },
+      overlap);
+}
+
+void DescriptorStreamReaderTXT::update(Covariance &covariance,
+                                       const bool overlap) {
+  forEachChunk(
+      [&](const BaseDescriptorWrapper &chunk) { covariance.update(chunk); },
+      overlap);
+}
+
+} // namespace io
+} // namespace panacea
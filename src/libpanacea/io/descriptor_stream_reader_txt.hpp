@@ -0,0 +1,91 @@
+#ifndef PANACEA_PRIVATE_DESCRIPTOR_STREAM_READER_TXT_H
+#define PANACEA_PRIVATE_DESCRIPTOR_STREAM_READER_TXT_H
+#pragma once
+
+// Local private PANACEA includes
+#include "descriptors/descriptor_wrapper.hpp"
+
+// Public PANACEA includes
+#include "panacea/descriptor_stream_reader.hpp"
+
+// Standard includes
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+class Covariance;
+class EntropyTerm;
+
+namespace io {
+
+/**
+ * Reads a txt descriptor file a fixed number of points at a time
+ *
+ * Unlike FileDescriptorTXT, which loads the whole file into a single
+ * descriptor wrapper, only the points of the current chunk are held in
+ * memory. Each chunk is handed to a callback, typically the update method of
+ * an entropy term or covariance, which should then be set up with an update
+ * policy that accumulates the chunks.
+ *
+ * Only files with the points along the rows can be split into chunks of
+ * points.
+ **/
+class DescriptorStreamReaderTXT : public DescriptorStreamReader {
+public:
+  using Chunk = DescriptorWrapper<std::vector<std::vector<double>>>;
+
+private:
+  std::unique_ptr<std::ifstream> file_;
+  std::istream &is_;
+  int chunk_rows_;
+  int rows_ = 0;
+  int cols_ = 0;
+  int rows_read_ = 0;
+  // Reused between rows so parsing does not allocate per line
+  std::string line_;
+  std::vector<double> row_values_;
+
+  void readHeader_();
+
+public:
+  /**
+   * The header of the descriptor file is read on construction, the stream
+   * must outlive the reader.
+   **/
+  DescriptorStreamReaderTXT(std::istream &is, const int chunk_rows);
+  DescriptorStreamReaderTXT(const std::string &file_name,
+                            const int chunk_rows);
+
+  virtual int rows() const noexcept final { return rows_; }
+  virtual int cols() const noexcept final { return cols_; }
+  virtual int chunkRows() const noexcept final { return chunk_rows_; }
+  virtual int rowsRead() const noexcept final { return rows_read_; }
+  virtual bool done() const noexcept final { return rows_read_ == rows_; }
+
+  /**
+   * Fills the chunk with the next points in the file, the chunk is resized
+   * to the number of points read, 0 is returned once every point was read.
+   **/
+  int read(Chunk &chunk);
+
+  /**
+   * With overlap the callback must not touch the stream, the next chunk is
+   * parsed from it while the callback runs.
+   **/
+  virtual void forEachChunk(const ChunkCallback &callback,
+                            const bool overlap = true) final;
+
+  virtual void update(EntropyTerm &entropy_term,
+                      const bool overlap = true) final;
+  void update(Covariance &covariance, const bool overlap = true);
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_DESCRIPTOR_STREAM_READER_TXT_H
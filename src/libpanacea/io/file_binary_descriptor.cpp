@@ -0,0 +1,138 @@
+
+// Local private PANACEA includes
+#include "file_binary_descriptor.hpp"
+
+#include "descriptors/descriptor_summary.hpp"
+#include "error.hpp"
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+#include "panacea/file_io_types.hpp"
+
+// Standard includes
+#include <fstream>
+#include <iostream>
+
+namespace panacea {
+
+namespace io {
+/***************************************************************
+ * Declaring private static Member function maps
+ **************************************************************/
+
+std::unordered_map<std::type_index, FileDescriptorBinary::WriteMethod>
+    FileDescriptorBinary::write_methods_;
+
+std::unordered_map<std::type_index, FileDescriptorBinary::ReadMethod>
+    FileDescriptorBinary::read_methods_;
+
+bool FileDescriptorBinary::registerMethods_() {
+  // Alaways registers as a pointer
+  registerWriteMethod<BaseDescriptorWrapper>();
+  registerReadMethod<BaseDescriptorWrapper>();
+  return true;
+}
+
+FileDescriptorBinary::FileDescriptorBinary(
+    const settings::DescriptorSidecar sidecar)
+    : sidecar_(sidecar) {
+  [[maybe_unused]] static const bool registered = registerMethods_();
+}
+
+/***************************************************************************
+ * Private Methods
+ ***************************************************************************/
+
+void FileDescriptorBinary::write_(std::vector<std::any> &objs,
+                                  std::ostream &os) {
+
+  for (auto &obj : objs) {
+    if (write_methods_.count(obj.type()) == 0) {
+      std::string error_msg =
+          "Unable to write object to binary descriptor file, write ";
+      error_msg += "method is missing.";
+      PANACEA_FAIL(error_msg);
+    }
+    auto data = write_methods_.at(obj.type())(type(), os, obj);
+    write_(data, os);
+  }
+}
+
+void FileDescriptorBinary::read_(std::any parent, ReadInstantiateVector &objs,
+                              std::istream &is) {
+
+  for (auto &obj : objs) {
+    if (read_methods_.count(obj.instance.type()) == 0) {
+      std::string error_msg =
+          "Unable to read object from binary descriptor file, read ";
+      error_msg += "method is missing.";
+      PANACEA_FAIL(error_msg);
+    }
+    auto data = read_methods_.at(obj.instance.type())(type(), is, obj.instance);
+    read_(obj, data, is);
+    if (auto method = obj.method) {
+      (*method)(parent);
+    }
+  }
+}
+
+/***************************************************************************
+ * Public Methods
+ ***************************************************************************/
+
+void FileDescriptorBinary::write(std::any obj, const std::string &filename) {
+
+  std::fstream fs;
+  fs.open(filename, std::fstream::out | std::fstream::binary);
+  write(obj, fs);
+  fs.close();
+  if (sidecar_ == settings::DescriptorSidecar::Summary) {
+    // Only descriptor wrappers are registered, the write above has already
+    // failed for anything else
+    DescriptorSummary::write(
+        DescriptorSummary(*std::any_cast<BaseDescriptorWrapper *>(obj)),
+        summaryFileName(filename));
+  }
+}
+
+void FileDescriptorBinary::write(std::any obj, std::ostream &os) {
+
+  // Check if object type is registered
+  if (write_methods_.count(obj.type())) {
+    auto data = write_methods_.at(obj.type())(type(), os, obj);
+    write_(data, os);
+  } else {
+    std::string error_msg = "Unable to write object it does not contain ";
+    error_msg += "a registered write method.";
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+void FileDescriptorBinary::read(std::any obj, std::istream &is) {
+
+  // Check if object type is registered
+  if (read_methods_.count(obj.type())) {
+    auto data = read_methods_.at(obj.type())(type(), is, obj);
+    read_(obj, data, is);
+  } else {
+    std::string error_msg = "Unable to read object it does not contain ";
+    error_msg += "a registered read method.";
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+void FileDescriptorBinary::read(std::any obj, const std::string &filename) {
+
+  std::fstream fs;
+  fs.open(filename, std::fstream::in | std::fstream::binary);
+  if (not fs.is_open()) {
+    std::string error_msg = "Unable to open binary descriptor file: ";
+    error_msg += filename;
+    PANACEA_FAIL(error_msg);
+  }
+  read(obj, fs);
+  fs.close();
+}
+
+} // namespace io
+} // namespace panacea
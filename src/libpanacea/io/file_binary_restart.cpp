@@ -0,0 +1,423 @@
+
+// Local private PANACEA includes
+#include "file_binary_restart.hpp"
+
+#include "atomic_file.hpp"
+#include "attribute_manipulators/normalizer.hpp"
+#include "attributes/covariance.hpp"
+#include "binary_restart_stream.hpp"
+#include "distribution/distributions/distribution.hpp"
+#include "entropy/entropy_settings/entropy_settings.hpp"
+#include "error.hpp"
+#include "kernels/base_kernel_wrapper.hpp"
+#include "kernels/kernel_specifications.hpp"
+#include "matrix/matrix.hpp"
+#include "memory_mapped_array.hpp"
+#include "primitives/primitive_group.hpp"
+#include "restart_delta.hpp"
+#include "type_map.hpp"
+#include "vector/vector.hpp"
+
+// Public PANACEA includes
+#include "panacea/entropy_term.hpp"
+#include "panacea/file_io_types.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/***************************************************************
+ * File scope functions
+ **************************************************************/
+
+static const char magic[8] = {'P', 'A', 'N', 'A', 'C', 'E', 'A', 'R'};
+
+static std::uint64_t alignUp(const std::uint64_t offset) {
+  const std::uint64_t alignment = FileRestartBinary::alignment;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+static void writePadding(std::ostream &os, std::uint64_t &position,
+                         const std::uint64_t offset) {
+  static const std::array<char, FileRestartBinary::alignment> zeros{};
+  assert(offset >= position);
+  while (position < offset) {
+    const auto bytes = std::min<std::uint64_t>(zeros.size(), offset - position);
+    os.write(zeros.data(), static_cast<std::streamsize>(bytes));
+    position += bytes;
+  }
+}
+
+// Lays out the sections and writes them to the stream in order so that the
+// stream never has to seek
+static void writeRecord(const std::string &text,
+                        const std::vector<BinaryRestartOStream::Array> &arrays,
+                        std::ostream &os) {
+  std::vector<BinaryRestartSection> sections;
+  sections.reserve(arrays.size() + 1);
+  std::uint64_t offset =
+      alignUp(FileRestartBinary::header_size +
+              (arrays.size() + 1) * FileRestartBinary::section_entry_size);
+  sections.push_back(BinaryRestartSection{
+      BinaryRestartSection::Kind::Structure, offset, text.size()});
+  offset = alignUp(offset + text.size());
+  for (const auto &array : arrays) {
+    const std::uint64_t size =
+        BinaryArrayHeader::header_size +
+        static_cast<std::uint64_t>(array.header.rows * array.header.cols) *
+            sizeof(double);
+    sections.push_back(
+        BinaryRestartSection{BinaryRestartSection::Kind::Array, offset, size});
+    offset = alignUp(offset + size);
+  }
+  const std::uint64_t record_size = offset;
+
+  std::array<char, FileRestartBinary::header_size> header{};
+  std::memcpy(header.data(), magic, sizeof(magic));
+  putLittleEndian<std::uint32_t>(header.data() + 8, FileRestartBinary::version);
+  putLittleEndian<std::uint32_t>(header.data() + 12,
+                                 FileRestartBinary::alignment);
+  putLittleEndian<std::uint64_t>(header.data() + 16, sections.size());
+  putLittleEndian<std::uint64_t>(header.data() + 24,
+                                 FileRestartBinary::header_size);
+  putLittleEndian<std::uint64_t>(header.data() + 32, record_size);
+  os.write(header.data(), header.size());
+  std::uint64_t position = header.size();
+
+  for (const auto &section : sections) {
+    std::array<char, FileRestartBinary::section_entry_size> entry{};
+    putLittleEndian<std::uint32_t>(entry.data(),
+                                   static_cast<std::uint32_t>(section.kind));
+    putLittleEndian<std::uint64_t>(entry.data() + 8, section.offset);
+    putLittleEndian<std::uint64_t>(entry.data() + 16, section.size);
+    os.write(entry.data(), entry.size());
+    position += entry.size();
+  }
+
+  writePadding(os, position, sections.front().offset);
+  os.write(text.data(), static_cast<std::streamsize>(text.size()));
+  position += text.size();
+
+  auto snapshot = dynamic_cast<RestartOStream *>(&os);
+  for (std::size_t index = 0; index < arrays.size(); ++index) {
+    writePadding(os, position, sections[index + 1].offset);
+    arrays[index].header.write(os);
+    if (snapshot && snapshot->snapshot() && arrays[index].holds_values) {
+      snapshot->defer(arrays[index].writer);
+    } else {
+      arrays[index].writer(os);
+    }
+    position += sections[index + 1].size;
+  }
+  writePadding(os, position, record_size);
+
+  if (not os) {
+    PANACEA_FAIL("Unable to write binary restart file.");
+  }
+}
+
+/***************************************************************
+ * Declaring private static Member function maps
+ **************************************************************/
+
+std::unordered_map<std::type_index, FileRestartBinary::WriteMethod>
+    FileRestartBinary::write_methods_;
+
+std::unordered_map<std::type_index, FileRestartBinary::ReadMethod>
+    FileRestartBinary::read_methods_;
+
+std::unordered_map<std::type_index, FileRestartBinary::PostReadInitialization>
+    FileRestartBinary::post_read_initialization_;
+
+bool FileRestartBinary::registerMethods_() {
+  // Always registers as a pointer and reference
+  registerWriteMethod<Covariance>();
+  registerWriteMethod<Matrix>();
+  registerWriteMethod<Vector>();
+  registerWriteMethod<BaseKernelWrapper>();
+  registerWriteMethod<KernelSpecification>();
+  registerWriteMethod<Normalizer>();
+  registerWriteMethod<PrimitiveGroup>();
+  registerWriteMethod<Distribution>();
+  registerWriteMethod<EntropySettings>();
+  registerWriteMethod<EntropyTerm>();
+
+  registerReadMethod<Covariance>();
+  registerReadMethod<Matrix>();
+  registerReadMethod<Vector>();
+  registerReadMethod<BaseKernelWrapper>();
+  registerReadMethod<KernelSpecification>();
+  registerReadMethod<Normalizer>();
+  registerReadMethod<PrimitiveGroup>();
+  registerReadMethod<Distribution>();
+  registerReadMethod<EntropySettings>();
+  registerReadMethod<EntropyTerm>();
+  return true;
+}
+
+FileRestartBinary::FileRestartBinary() {
+  [[maybe_unused]] static const bool registered = registerMethods_();
+}
+
+/***************************************************************
+ * Private Methods
+ **************************************************************/
+
+void FileRestartBinary::write_(std::vector<std::any> &objs, std::ostream &os,
+                               const std::string &parent_path,
+                               SectionIndex &index) {
+
+  for (std::size_t obj_ind = 0; obj_ind < objs.size(); ++obj_ind) {
+    auto &obj = objs[obj_ind];
+    if (write_methods_.count(std::type_index(obj.type())) == 0) {
+      std::string error_msg = "Unable to write object to restart file, write ";
+      error_msg += "method is missing.";
+      if (type_map.count(std::type_index(obj.type()))) {
+        error_msg += "\nType identified as: ";
+        error_msg += type_map.at(std::type_index(obj.type())) + "\n";
+      }
+      PANACEA_FAIL(error_msg);
+    }
+    const std::string path = SectionIndex::path(parent_path, obj_ind);
+    index.add(path, os.tellp());
+    auto data = write_methods_.at(std::type_index(obj.type()))(type(), os, obj);
+    write_(data, os, path, index);
+  }
+}
+
+void FileRestartBinary::read_(std::any parent, io::ReadInstantiateVector &objs,
+                              std::istream &is, const std::string &parent_path,
+                              const SectionIndex &index) {
+
+  for (std::size_t obj_ind = 0; obj_ind < objs.size(); ++obj_ind) {
+    auto &obj = objs[obj_ind];
+
+    if (read_methods_.count(std::type_index(obj.instance.type())) == 0) {
+      std::string error_msg =
+          "Unable to read object from restart binary file, read ";
+      error_msg += "method is missing.";
+      if (type_map.count(std::type_index(obj.instance.type()))) {
+        error_msg += "\nType identified as: ";
+        error_msg += type_map.at(std::type_index(obj.instance.type())) + "\n";
+      }
+      PANACEA_FAIL(error_msg);
+    }
+    const std::string path = SectionIndex::path(parent_path, obj_ind);
+    index.seek(is, path);
+    auto data = read_methods_.at(std::type_index(obj.instance.type()))(
+        type(), is, obj.instance);
+    read_(obj.instance, data, is, path, index);
+
+    if (auto method = obj.method) {
+      (*method)(parent);
+    }
+
+    if (post_read_initialization_.count(std::type_index(obj.instance.type()))) {
+      post_read_initialization_.at(obj.instance.type())(type(), obj.instance);
+    }
+  }
+}
+
+void FileRestartBinary::readRecord_(std::any obj, std::istream &is,
+                                    const RestartReadContext &context) {
+
+  if (not littleEndianHost()) {
+    PANACEA_FAIL("Binary restart files require a little endian host.");
+  }
+
+  const std::streamoff record_begin = is.tellg();
+  if (record_begin < 0) {
+    PANACEA_FAIL("Binary restart files can only be read from seekable "
+                 "streams.");
+  }
+
+  std::array<char, header_size> header{};
+  is.read(header.data(), header.size());
+  if (is.gcount() != static_cast<std::streamsize>(header.size()) ||
+      std::memcmp(header.data(), magic, sizeof(magic)) != 0) {
+    PANACEA_FAIL("Stream does not contain a binary restart record.");
+  }
+  const auto file_version = getLittleEndian<std::uint32_t>(header.data() + 8);
+  if (file_version != version) {
+    std::string error_msg = "Unsupported binary restart file version: ";
+    error_msg += std::to_string(file_version);
+    PANACEA_FAIL(error_msg);
+  }
+  const auto num_sections = getLittleEndian<std::uint64_t>(header.data() + 16);
+  const auto table_offset = getLittleEndian<std::uint64_t>(header.data() + 24);
+  const auto record_size = getLittleEndian<std::uint64_t>(header.data() + 32);
+
+  // The header is checked against the size of the stream before anything is
+  // allocated or read from the offsets it holds
+  is.seekg(0, std::ios::end);
+  const std::streamoff stream_end = is.tellg();
+  const auto available = static_cast<std::uint64_t>(
+      std::max<std::streamoff>(stream_end - record_begin, 0));
+  if (record_size < header_size || record_size > available ||
+      table_offset < header_size || table_offset > record_size ||
+      num_sections > (record_size - table_offset) / section_entry_size) {
+    std::string error_msg = "Binary restart record header is inconsistent ";
+    error_msg += "with the " + std::to_string(available);
+    error_msg += " bytes available, the record is truncated or corrupt.";
+    PANACEA_FAIL(error_msg);
+  }
+
+  std::vector<BinaryRestartSection> sections(num_sections);
+  is.seekg(record_begin + static_cast<std::streamoff>(table_offset));
+  for (auto &section : sections) {
+    std::array<char, section_entry_size> entry{};
+    is.read(entry.data(), entry.size());
+    if (is.gcount() != static_cast<std::streamsize>(entry.size())) {
+      PANACEA_FAIL("Binary restart file section table is truncated.");
+    }
+    section.kind = static_cast<BinaryRestartSection::Kind>(
+        getLittleEndian<std::uint32_t>(entry.data()));
+    section.offset = getLittleEndian<std::uint64_t>(entry.data() + 8);
+    section.size = getLittleEndian<std::uint64_t>(entry.data() + 16);
+    if (section.offset > record_size ||
+        section.size > record_size - section.offset) {
+      std::string error_msg = "Binary restart file section extends past the ";
+      error_msg += "end of its record.";
+      PANACEA_FAIL(error_msg);
+    }
+  }
+  if (sections.empty() ||
+      sections.front().kind != BinaryRestartSection::Kind::Structure) {
+    PANACEA_FAIL("Binary restart file is missing its structure section.");
+  }
+
+  std::string text(sections.front().size, '\0');
+  is.seekg(record_begin + static_cast<std::streamoff>(sections.front().offset));
+  is.read(&text[0], static_cast<std::streamsize>(text.size()));
+  if (is.gcount() != static_cast<std::streamsize>(text.size())) {
+    PANACEA_FAIL("Binary restart file structure section is truncated.");
+  }
+
+  BinaryRestartIStream structure(std::move(text), std::move(sections), is,
+                                 record_begin, context);
+  const SectionIndex index = SectionIndex::read(structure);
+
+  // Check if object type is registered
+  if (read_methods_.count(std::type_index(obj.type()))) {
+    index.seek(structure, SectionIndex::root);
+    auto data =
+        read_methods_.at(std::type_index(obj.type()))(type(), structure, obj);
+    read_(obj, data, structure, SectionIndex::root, index);
+  } else {
+    std::string error_msg = "Unable to read object it does not contain ";
+    error_msg += "a registered read method.";
+    if (type_map.count(std::type_index(obj.type()))) {
+      error_msg += "\nType identified as: ";
+      error_msg += type_map.at(std::type_index(obj.type())) + "\n";
+    }
+    PANACEA_FAIL(error_msg);
+  }
+
+  if (post_read_initialization_.count(std::type_index(obj.type()))) {
+    post_read_initialization_.at(std::type_index(obj.type()))(type(), obj);
+  }
+
+  // Leave the stream at the end of the record so the next one can be read
+  is.clear();
+  is.seekg(record_begin + static_cast<std::streamoff>(record_size));
+}
+
+/***************************************************************
+ * Public Methods
+ **************************************************************/
+
+bool FileRestartBinary::isRecord(std::istream &is) {
+  const std::streampos position = is.tellg();
+  std::array<char, sizeof(magic)> start{};
+  is.read(start.data(), start.size());
+  const bool record =
+      is.gcount() == static_cast<std::streamsize>(start.size()) &&
+      std::memcmp(start.data(), magic, sizeof(magic)) == 0;
+  is.clear();
+  is.seekg(position);
+  return record;
+}
+
+void FileRestartBinary::write(std::any obj, std::ostream &os) {
+
+  if (not littleEndianHost()) {
+    PANACEA_FAIL("Binary restart files require a little endian host.");
+  }
+
+  // Check if object type is registered
+  if (write_methods_.count(std::type_index(obj.type()))) {
+    BinaryRestartOStream structure;
+    if (auto restart_os = dynamic_cast<RestartOStream *>(&os)) {
+      structure.set(restart_os->delta());
+      structure.setSnapshot(restart_os->snapshot());
+    }
+    SectionIndex index;
+    index.add(SectionIndex::root, 0);
+    auto data =
+        write_methods_.at(std::type_index(obj.type()))(type(), structure, obj);
+    write_(data, structure, SectionIndex::root, index);
+
+    // The index surrounds the objects in the structure section, the arrays
+    // are written to their own sections
+    std::ostringstream text;
+    SectionIndex::writeHeader(text);
+    text << structure.str();
+    index.writeFooter(text, 0);
+    writeRecord(text.str(), structure.arrays(), os);
+  } else {
+    std::string error_msg = "Unable to write object it does not contain ";
+    error_msg += "a registered write method.";
+    if (type_map.count(std::type_index(obj.type()))) {
+      error_msg += "\nType identified as: ";
+      error_msg += type_map.at(std::type_index(obj.type())) + "\n";
+    }
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+void FileRestartBinary::write(std::any obj, const std::string &filename) {
+
+  // Kernels read from the file may still be mapped from it, truncating the
+  // file in place would pull the pages from under them. The record is
+  // written to a new file that replaces the old one, the mappings keep the
+  // old contents.
+  std::ostringstream record(std::ios::out | std::ios::binary);
+  write(obj, record);
+  writeFileAtomically(filename, record.str());
+}
+
+void FileRestartBinary::read(std::any obj, std::istream &is) {
+  // Streams opened by the restart reader know the name of their file
+  if (auto context = RestartReadContext::of(is)) {
+    readRecord_(obj, is, *context);
+  } else {
+    readRecord_(obj, is, RestartReadContext());
+  }
+}
+
+void FileRestartBinary::read(std::any obj, const std::string &filename) {
+
+  std::fstream fs;
+  fs.open(filename, std::fstream::in | std::fstream::binary);
+  if (not fs.is_open()) {
+    std::string error_msg = "Unable to open binary restart file: ";
+    error_msg += filename;
+    PANACEA_FAIL(error_msg);
+  }
+  readRecord_(obj, fs, RestartReadContext(filename, false));
+  fs.close();
+}
+
+} // namespace io
+} // namespace panacea
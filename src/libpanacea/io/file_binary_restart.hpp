@@ -0,0 +1,185 @@
+
+#ifndef PANACEA_PRIVATE_FILEBINARY_RESTART_H
+#define PANACEA_PRIVATE_FILEBINARY_RESTART_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/file_io.hpp"
+#include "panacea/file_io_types.hpp"
+
+// Local private PANACEA includes
+#include "io_common.hpp"
+#include "restart_read_context.hpp"
+#include "section_index.hpp"
+
+// Standard includes
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Writes restart files in binary format
+ *
+ * The text format is kept for the structure of the restart file while the
+ * kernel centers, the bulk of the data, are stored as raw arrays that are
+ * memory mapped when the file is read by name. Each call to write produces
+ * a single restart record, all offsets are measured from the start of the
+ * record and every section starts at a multiple of alignment bytes.
+ *
+ * Record header, all fields little endian
+ *
+ * Bytes  0 - 7   magic "PANACEAR"
+ * Bytes  8 - 11  format version (uint32)
+ * Bytes 12 - 15  alignment of the sections (uint32)
+ * Bytes 16 - 23  number of sections (uint64)
+ * Bytes 24 - 31  offset of the section table (uint64)
+ * Bytes 32 - 39  size of the record including padding (uint64)
+ * Bytes 40 - 63  reserved, zero
+ *
+ * Each entry of the section table is section_entry_size bytes
+ *
+ * Bytes  0 - 3   kind (uint32), see BinaryRestartSection::Kind
+ * Bytes  4 - 7   reserved, zero
+ * Bytes  8 - 15  offset of the section (uint64)
+ * Bytes 16 - 23  size of the section (uint64)
+ * Bytes 24 - 31  reserved, zero
+ *
+ * Section 0 holds the structure in the txt restart format, including its
+ * SectionIndex, with each array replaced by the index of its section. The
+ * array sections are a BinaryArrayHeader followed by the values.
+ **/
+class FileRestartBinary : public FileIO {
+
+public:
+  static constexpr std::size_t header_size = 64;
+  static constexpr std::size_t section_entry_size = 32;
+  static constexpr std::uint32_t version = 1;
+  static constexpr std::uint32_t alignment = 4096;
+
+private:
+  using WriteMethod = std::vector<std::any> (*)(const settings::FileType,
+                                                std::ostream &, std::any);
+
+  using ReadMethod = io::ReadInstantiateVector (*)(const settings::FileType,
+                                                   std::istream &, std::any);
+
+  using PostReadInitialization = void (*)(const settings::FileType, std::any);
+
+  static std::unordered_map<std::type_index, WriteMethod> write_methods_;
+  static std::unordered_map<std::type_index, ReadMethod> read_methods_;
+  static std::unordered_map<std::type_index, PostReadInitialization>
+      post_read_initialization_;
+
+  void write_(std::vector<std::any> &objs, std::ostream &os,
+              const std::string &parent_path, SectionIndex &index);
+
+  void read_(std::any parent, ReadInstantiateVector &objs, std::istream &is,
+             const std::string &parent_path, const SectionIndex &index);
+
+  void readRecord_(std::any obj, std::istream &is,
+                   const RestartReadContext &context);
+
+  static bool registerMethods_();
+
+public:
+  /**
+   * The read and write methods are registered by the first instance that is
+   * constructed, constructing further instances is free.
+   **/
+  FileRestartBinary();
+  settings::FileType type() const noexcept final {
+    return settings::FileType::BinaryRestart;
+  }
+
+  /**
+   * Will always register methods to the pointer and reference type index
+   * for write method will also register const pointer and const reference
+   **/
+  template <class T> static bool registerWriteMethod() {
+    bool at_least_one_new_registration = false;
+    if (write_methods_.count(std::type_index(typeid(const T *))) == 0) {
+      at_least_one_new_registration = true;
+      write_methods_[std::type_index(typeid(const T *))] = T::write;
+    }
+    if (write_methods_.count(std::type_index(typeid(const T &))) == 0) {
+      at_least_one_new_registration = true;
+      write_methods_[std::type_index(typeid(const T &))] = T::write;
+    }
+    if (write_methods_.count(std::type_index(typeid(T *))) == 0) {
+      at_least_one_new_registration = true;
+      write_methods_[std::type_index(typeid(T *))] = T::write;
+    }
+    if (write_methods_.count(std::type_index(typeid(T &))) == 0) {
+      at_least_one_new_registration = true;
+      write_methods_[std::type_index(typeid(T &))] = T::write;
+    }
+    return at_least_one_new_registration;
+  }
+
+  /**
+   * Will register a static read method from the provided class
+   *
+   * Will also register a static postReadInitialization method if
+   * one is detected with the correct function signature.
+   **/
+  template <class T> static bool registerReadMethod() {
+    bool at_least_one_new_registration = false;
+    if (read_methods_.count(std::type_index(typeid(T *))) == 0) {
+      at_least_one_new_registration = true;
+      read_methods_[std::type_index(typeid(T *))] = T::read;
+    }
+    if (read_methods_.count(std::type_index(typeid(T &))) == 0) {
+      at_least_one_new_registration = true;
+      read_methods_[std::type_index(typeid(T &))] = T::read;
+    }
+    if (read_methods_.count(std::type_index(typeid(std::unique_ptr<T> *))) ==
+        0) {
+      at_least_one_new_registration = true;
+      read_methods_[std::type_index(typeid(std::unique_ptr<T> *))] = T::read;
+    }
+
+    if constexpr (has_post_read_initialization_method<
+                      T, void(const settings::FileType, std::any)>::value) {
+
+      if (post_read_initialization_.count(std::type_index(typeid(T *))) == 0) {
+        at_least_one_new_registration = true;
+        post_read_initialization_[std::type_index(typeid(T *))] =
+            T::postReadInitialization;
+      }
+      if (post_read_initialization_.count(std::type_index(typeid(T &))) == 0) {
+        at_least_one_new_registration = true;
+        post_read_initialization_[std::type_index(typeid(T &))] =
+            T::postReadInitialization;
+      }
+    }
+
+    return at_least_one_new_registration;
+  }
+
+  /**
+   * True if the stream is positioned at a binary restart record, the stream
+   * is left where it was.
+   **/
+  static bool isRecord(std::istream &is);
+
+  virtual void read(std::any obj, std::istream &is) final;
+  virtual void write(std::any obj, std::ostream &os) final;
+  virtual void read(std::any obj, const std::string &filename) final;
+  virtual void write(std::any obj, const std::string &filename) final;
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_FILEBINARY_RESTART_H
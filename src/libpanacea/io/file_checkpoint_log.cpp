@@ -0,0 +1,88 @@
+
+// Local private PANACEA includes
+#include "file_checkpoint_log.hpp"
+
+#include "atomic_file.hpp"
+#include "error.hpp"
+#include "file_io_factory.hpp"
+#include "restart_delta.hpp"
+#include "restart_read_context.hpp"
+
+// Standard includes
+#include <any>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace panacea {
+
+namespace io {
+
+/***********************************************************
+ * Private Methods
+ ***********************************************************/
+
+std::string FileCheckpointLog::record_(std::any obj) {
+  RestartOStream record(&delta_);
+  try {
+    file_io_->write(obj, record);
+  } catch (...) {
+    delta_.discard();
+    throw;
+  }
+  return frameRecord(record.str());
+}
+
+/***********************************************************
+ * Public Methods
+ ***********************************************************/
+
+FileCheckpointLog::FileCheckpointLog(const settings::FileType file_type,
+                                     std::string file_name)
+    : file_name_(std::move(file_name)) {
+  if (file_type != settings::FileType::TXTRestart &&
+      file_type != settings::FileType::BinaryRestart) {
+    std::string error_msg = "Checkpoint logs can only be written to restart ";
+    error_msg += "file types.";
+    PANACEA_FAIL(error_msg);
+  }
+  FileIOFactory file_io_factory;
+  file_io_ = file_io_factory.create(file_type);
+}
+
+void FileCheckpointLog::append(std::any obj) {
+  if (not started_) {
+    compact(std::move(obj));
+    return;
+  }
+  const std::string record = record_(std::move(obj));
+  try {
+    appendToFile(file_name_, record);
+  } catch (...) {
+    delta_.discard();
+    throw;
+  }
+  delta_.commit();
+}
+
+void FileCheckpointLog::compact(std::any obj) {
+  // Nothing is stored yet as far as the full record is concerned
+  delta_.clear();
+  started_ = false;
+  const std::string record = record_(std::move(obj));
+  try {
+    writeFileAtomically(file_name_, record);
+  } catch (...) {
+    delta_.discard();
+    throw;
+  }
+  delta_.commit();
+  started_ = true;
+}
+
+void FileCheckpointLog::read(std::any obj) {
+  readRestartRecords(*file_io_, std::move(obj), file_name_, false);
+}
+
+} // namespace io
+} // namespace panacea
@@ -0,0 +1,57 @@
+#ifndef PANACEA_PRIVATE_FILE_CHECKPOINT_LOG_H
+#define PANACEA_PRIVATE_FILE_CHECKPOINT_LOG_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/checkpoint_log.hpp"
+#include "panacea/file_io.hpp"
+
+// Local private PANACEA includes
+#include "private_settings.hpp"
+#include "restart_delta.hpp"
+
+// Standard includes
+#include <any>
+#include <memory>
+#include <string>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Checkpoint log made of consecutive restart records
+ *
+ * Every record is an ordinary TXTRestart or BinaryRestart record framed by
+ * its size and checksum, see frameRecord. In the records after the first
+ * the kernel data of kernels with append only storage starts with an
+ * "Append first_row" line and holds only the rows from first_row on, all
+ * other sections are written in full.
+ *
+ * Records are flushed to disk before append returns, a record that was
+ * interrupted while being appended is left at the end of the file and is
+ * skipped when the log is read.
+ **/
+class FileCheckpointLog : public CheckpointLog {
+private:
+  std::unique_ptr<FileIO> file_io_;
+  std::string file_name_;
+  // Rows of the kernels stored by the records written so far, empty until
+  // this log has written its first record
+  RestartDelta delta_;
+  bool started_ = false;
+
+  std::string record_(std::any obj);
+
+public:
+  FileCheckpointLog(const settings::FileType file_type, std::string file_name);
+
+  virtual void append(std::any obj) override;
+  virtual void compact(std::any obj) override;
+  virtual void read(std::any obj) override;
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_FILE_CHECKPOINT_LOG_H
@@ -3,6 +3,8 @@
 #include "file_io_factory.hpp"
 
 #include "error.hpp"
+#include "file_binary_restart.hpp"
+#include "file_binary_descriptor.hpp"
 #include "file_txt_descriptor.hpp"
 #include "file_txt_kerneldistribution.hpp"
 #include "file_txt_restart.hpp"
@@ -18,10 +20,30 @@ FileIOFactory::create(const settings::FileType &type) const {
     return std::make_unique<FileDescriptorTXT>();
   } else if (type == settings::FileType::TXTKernelDistribution) {
     return std::make_unique<FileKernelDistributionTXT>();
+  } else if (type == settings::FileType::BinaryDescriptors) {
+    return std::make_unique<FileDescriptorBinary>();
+  } else if (type == settings::FileType::BinaryRestart) {
+    return std::make_unique<FileRestartBinary>();
   } else {
     PANACEA_FAIL("File type not registered with factory.");
   }
   return nullptr;
 }
+
+std::unique_ptr<FileIO>
+FileIOFactory::create(const settings::FileType &type,
+                      const settings::DescriptorSidecar &sidecar) const {
+  if (sidecar == settings::DescriptorSidecar::None) {
+    return create(type);
+  } else if (type == settings::FileType::TXTDescriptors) {
+    return std::make_unique<FileDescriptorTXT>(sidecar);
+  } else if (type == settings::FileType::BinaryDescriptors) {
+    return std::make_unique<FileDescriptorBinary>(sidecar);
+  }
+  std::string error_msg = "Only descriptor files can be written with a ";
+  error_msg += "sidecar.";
+  PANACEA_FAIL(error_msg);
+  return nullptr;
+}
 } // namespace io
 } // namespace panacea
@@ -17,6 +17,13 @@ class FileIO;
 class FileIOFactory {
 public:
   std::unique_ptr<FileIO> create(const settings::FileType &type) const;
+
+  /**
+   * Only descriptor files can be written with a sidecar.
+   **/
+  std::unique_ptr<FileIO>
+  create(const settings::FileType &type,
+         const settings::DescriptorSidecar &sidecar) const;
 };
 
 } // namespace io
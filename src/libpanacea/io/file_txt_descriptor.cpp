@@ -2,6 +2,7 @@
 // Local private PANACEA includes
 #include "file_txt_descriptor.hpp"
 
+#include "descriptors/descriptor_summary.hpp"
 #include "error.hpp"
 
 // Public PANACEA includes
@@ -25,10 +26,16 @@ std::unordered_map<std::type_index, FileDescriptorTXT::WriteMethod>
 std::unordered_map<std::type_index, FileDescriptorTXT::ReadMethod>
     FileDescriptorTXT::read_methods_;
 
-FileDescriptorTXT::FileDescriptorTXT() {
+bool FileDescriptorTXT::registerMethods_() {
   // Alaways registers as a pointer
   registerWriteMethod<BaseDescriptorWrapper>();
   registerReadMethod<BaseDescriptorWrapper>();
+  return true;
+}
+
+FileDescriptorTXT::FileDescriptorTXT(const settings::DescriptorSidecar sidecar)
+    : sidecar_(sidecar) {
+  [[maybe_unused]] static const bool registered = registerMethods_();
 }
 
 /***************************************************************************
@@ -44,7 +51,7 @@ void FileDescriptorTXT::write_(std::vector<std::any> &objs, std::ostream &os) {
       error_msg += "method is missing.";
       PANACEA_FAIL(error_msg);
     }
-    auto data = write_methods_[obj.type()](type(), os, obj);
+    auto data = write_methods_.at(obj.type())(type(), os, obj);
     write_(data, os);
   }
 }
@@ -59,7 +66,7 @@ void FileDescriptorTXT::read_(std::any parent, ReadInstantiateVector &objs,
       error_msg += "method is missing.";
       PANACEA_FAIL(error_msg);
     }
-    auto data = read_methods_[obj.instance.type()](type(), is, obj.instance);
+    auto data = read_methods_.at(obj.instance.type())(type(), is, obj.instance);
     read_(obj, data, is);
     if (auto method = obj.method) {
       (*method)(parent);
@@ -77,13 +84,20 @@ void FileDescriptorTXT::write(std::any obj, const std::string &filename) {
   fs.open(filename, std::fstream::out);
   write(obj, fs);
   fs.close();
+  if (sidecar_ == settings::DescriptorSidecar::Summary) {
+    // Only descriptor wrappers are registered, the write above has already
+    // failed for anything else
+    DescriptorSummary::write(
+        DescriptorSummary(*std::any_cast<BaseDescriptorWrapper *>(obj)),
+        summaryFileName(filename));
+  }
 }
 
 void FileDescriptorTXT::write(std::any obj, std::ostream &os) {
 
   // Check if object type is registered
   if (write_methods_.count(obj.type())) {
-    auto data = write_methods_[obj.type()](type(), os, obj);
+    auto data = write_methods_.at(obj.type())(type(), os, obj);
     write_(data, os);
   } else {
     std::string error_msg = "Unable to write object it does not contain ";
@@ -96,7 +110,7 @@ void FileDescriptorTXT::read(std::any obj, std::istream &is) {
 
   // Check if object type is registered
   if (read_methods_.count(obj.type())) {
-    auto data = read_methods_[obj.type()](type(), is, obj);
+    auto data = read_methods_.at(obj.type())(type(), is, obj);
     read_(obj, data, is);
   } else {
     std::string error_msg = "Unable to read object it does not contain ";
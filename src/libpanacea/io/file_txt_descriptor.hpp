@@ -6,6 +6,7 @@
 // Public PANACEA includes
 #include "panacea/file_io.hpp"
 #include "panacea/file_io_types.hpp"
+#include "panacea/settings.hpp"
 
 // Standard includes
 #include <any>
@@ -34,8 +35,19 @@ private:
   void write_(std::vector<std::any> &objs, std::ostream &os);
   void read_(std::any parent, ReadInstantiateVector &objs, std::istream &is);
 
+  static bool registerMethods_();
+
+  settings::DescriptorSidecar sidecar_ = settings::DescriptorSidecar::None;
+
 public:
-  FileDescriptorTXT();
+  /**
+   * The read and write methods are registered by the first instance that is
+   * constructed, constructing further instances is free.
+   *
+   * Writing descriptors to a file also writes the sidecar next to it.
+   **/
+  explicit FileDescriptorTXT(const settings::DescriptorSidecar sidecar =
+                             settings::DescriptorSidecar::None);
   settings::FileType type() const noexcept final {
     return settings::FileType::TXTDescriptors;
   }
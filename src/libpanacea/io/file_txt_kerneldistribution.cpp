@@ -38,7 +38,7 @@ std::unordered_map<std::type_index,
                    FileKernelDistributionTXT::PostReadInitialization>
     FileKernelDistributionTXT::post_read_initialization_;
 
-FileKernelDistributionTXT::FileKernelDistributionTXT() {
+bool FileKernelDistributionTXT::registerMethods_() {
   // Alaways registers as a pointer
   registerWriteMethod<Covariance>();
   registerWriteMethod<Matrix>();
@@ -59,6 +59,11 @@ FileKernelDistributionTXT::FileKernelDistributionTXT() {
   registerReadMethod<PrimitiveGroup>();
   registerReadMethod<Distribution>();
   registerReadMethod<EntropyTerm>();
+  return true;
+}
+
+FileKernelDistributionTXT::FileKernelDistributionTXT() {
+  [[maybe_unused]] static const bool registered = registerMethods_();
 }
 
 void FileKernelDistributionTXT::write_(std::vector<std::any> &objs,
@@ -70,7 +75,7 @@ void FileKernelDistributionTXT::write_(std::vector<std::any> &objs,
       error_msg += "method is missing.";
       PANACEA_FAIL(error_msg);
     }
-    auto data = write_methods_[obj.type()](type(), os, obj);
+    auto data = write_methods_.at(obj.type())(type(), os, obj);
     write_(data, os);
   }
 }
@@ -87,7 +92,7 @@ void FileKernelDistributionTXT::read_(std::any parent,
       error_msg += "method is missing.";
       PANACEA_FAIL(error_msg);
     }
-    auto data = read_methods_[obj.instance.type()](type(), is, obj.instance);
+    auto data = read_methods_.at(obj.instance.type())(type(), is, obj.instance);
     read_(obj.instance, data, is);
 
     // Below we have the options to call two different functions
@@ -102,7 +107,7 @@ void FileKernelDistributionTXT::read_(std::any parent,
 
     // Second option
     if (post_read_initialization_.count(obj.instance.type())) {
-      post_read_initialization_[obj.instance.type()](type(), obj.instance);
+      post_read_initialization_.at(obj.instance.type())(type(), obj.instance);
     }
   }
 }
@@ -111,7 +116,7 @@ void FileKernelDistributionTXT::write(std::any obj, std::ostream &os) {
 
   // Check if object type is registered
   if (write_methods_.count(obj.type())) {
-    auto data = write_methods_[obj.type()](type(), os, obj);
+    auto data = write_methods_.at(obj.type())(type(), os, obj);
     write_(data, os);
   } else {
     std::string error_msg = "Unable to write object it does not contain ";
@@ -134,7 +139,7 @@ void FileKernelDistributionTXT::read(std::any obj, std::istream &is) {
 
   // Check if object type is registered
   if (read_methods_.count(obj.type())) {
-    auto data = read_methods_[obj.type()](type(), is, obj);
+    auto data = read_methods_.at(obj.type())(type(), is, obj);
     read_(obj, data, is);
   } else {
     std::string error_msg = "Unable to read object it does not contain ";
@@ -143,7 +148,7 @@ void FileKernelDistributionTXT::read(std::any obj, std::istream &is) {
   }
 
   if (post_read_initialization_.count(obj.type())) {
-    post_read_initialization_[obj.type()](type(), obj);
+    post_read_initialization_.at(obj.type())(type(), obj);
   }
 }
 
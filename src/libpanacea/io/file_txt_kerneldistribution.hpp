@@ -57,7 +57,13 @@ private:
 
   void read_(std::any parent, ReadInstantiateVector &objs, std::istream &is);
 
+  static bool registerMethods_();
+
 public:
+  /**
+   * The read and write methods are registered by the first instance that is
+   * constructed, constructing further instances is free.
+   **/
   FileKernelDistributionTXT();
   settings::FileType type() const noexcept final {
     return settings::FileType::TXTKernelDistribution;
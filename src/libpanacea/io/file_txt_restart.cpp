@@ -11,6 +11,7 @@
 #include "kernels/kernel_specifications.hpp"
 #include "matrix/matrix.hpp"
 #include "primitives/primitive_group.hpp"
+#include "restart_delta.hpp"
 #include "type_map.hpp"
 #include "vector/vector.hpp"
 
@@ -21,6 +22,9 @@
 // Standard includes
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
 
 namespace panacea {
 
@@ -38,7 +42,7 @@ std::unordered_map<std::type_index, FileRestartTXT::ReadMethod>
 std::unordered_map<std::type_index, FileRestartTXT::PostReadInitialization>
     FileRestartTXT::post_read_initialization_;
 
-FileRestartTXT::FileRestartTXT() {
+bool FileRestartTXT::registerMethods_() {
   // Alaways registers as a pointer and reference
   registerWriteMethod<Covariance>();
   registerWriteMethod<Matrix>();
@@ -61,11 +65,19 @@ FileRestartTXT::FileRestartTXT() {
   registerReadMethod<Distribution>();
   registerReadMethod<EntropySettings>();
   registerReadMethod<EntropyTerm>();
+  return true;
 }
 
-void FileRestartTXT::write_(std::vector<std::any> &objs, std::ostream &os) {
+FileRestartTXT::FileRestartTXT() {
+  [[maybe_unused]] static const bool registered = registerMethods_();
+}
 
-  for (auto &obj : objs) {
+void FileRestartTXT::write_(std::vector<std::any> &objs, std::ostream &os,
+                            const std::string &parent_path,
+                            SectionIndex &index) {
+
+  for (std::size_t obj_ind = 0; obj_ind < objs.size(); ++obj_ind) {
+    auto &obj = objs[obj_ind];
     if (write_methods_.count(std::type_index(obj.type())) == 0) {
       std::string error_msg = "Unable to write object to restart file, write ";
       error_msg += "method is missing.";
@@ -75,15 +87,19 @@ void FileRestartTXT::write_(std::vector<std::any> &objs, std::ostream &os) {
       }
       PANACEA_FAIL(error_msg);
     }
-    auto data = write_methods_[std::type_index(obj.type())](type(), os, obj);
-    write_(data, os);
+    const std::string path = SectionIndex::path(parent_path, obj_ind);
+    index.add(path, os.tellp());
+    auto data = write_methods_.at(std::type_index(obj.type()))(type(), os, obj);
+    write_(data, os, path, index);
   }
 }
 
 void FileRestartTXT::read_(std::any parent, io::ReadInstantiateVector &objs,
-                           std::istream &is) {
+                           std::istream &is, const std::string &parent_path,
+                           const SectionIndex &index) {
 
-  for (auto &obj : objs) {
+  for (std::size_t obj_ind = 0; obj_ind < objs.size(); ++obj_ind) {
+    auto &obj = objs[obj_ind];
 
     if (read_methods_.count(std::type_index(obj.instance.type())) == 0) {
       std::string error_msg =
@@ -95,9 +111,12 @@ void FileRestartTXT::read_(std::any parent, io::ReadInstantiateVector &objs,
       }
       PANACEA_FAIL(error_msg);
     }
-    auto data = read_methods_[std::type_index(obj.instance.type())](
+    // Jump straight to the section of the object if the file is indexed
+    const std::string path = SectionIndex::path(parent_path, obj_ind);
+    index.seek(is, path);
+    auto data = read_methods_.at(std::type_index(obj.instance.type()))(
         type(), is, obj.instance);
-    read_(obj.instance, data, is);
+    read_(obj.instance, data, is, path, index);
 
     // Below we have the options to call two different functions
     // The first option allows further initialization of a object parent
@@ -111,7 +130,7 @@ void FileRestartTXT::read_(std::any parent, io::ReadInstantiateVector &objs,
 
     // Second option
     if (post_read_initialization_.count(std::type_index(obj.instance.type()))) {
-      post_read_initialization_[obj.instance.type()](type(), obj.instance);
+      post_read_initialization_.at(obj.instance.type())(type(), obj.instance);
     }
   }
 }
@@ -120,8 +139,44 @@ void FileRestartTXT::write(std::any obj, std::ostream &os) {
 
   // Check if object type is registered
   if (write_methods_.count(std::type_index(obj.type()))) {
-    auto data = write_methods_[std::type_index(obj.type())](type(), os, obj);
-    write_(data, os);
+    const std::streamoff header_begin = os.tellp();
+    if (header_begin < 0) {
+      // The header of the index cannot be filled in on streams that cannot
+      // move back, the objects are written without an index
+      SectionIndex index;
+      auto data =
+          write_methods_.at(std::type_index(obj.type()))(type(), os, obj);
+      write_(data, os, SectionIndex::root, index);
+      return;
+    }
+
+    SectionIndex::writeHeader(os);
+    const std::streamoff body_begin = os.tellp();
+    SectionIndex index;
+    index.add(SectionIndex::root, body_begin);
+    auto data =
+        write_methods_.at(std::type_index(obj.type()))(type(), os, obj);
+    write_(data, os, SectionIndex::root, index);
+
+    auto restart_os = dynamic_cast<RestartOStream *>(&os);
+    if (restart_os && restart_os->snapshot()) {
+      // Kernels of a snapshot are only written when it is rendered, so are
+      // the offsets, which depend on them
+      restart_os->defer([restart_os, index, header_begin,
+                         body_begin](std::ostream &out) mutable {
+        const std::streamoff rendered_begin =
+            restart_os->rendered(body_begin);
+        index.move([&](const std::streamoff position) {
+          return restart_os->rendered(position) - rendered_begin;
+        });
+        index.writeFooter(out, restart_os->rendered(header_begin));
+      });
+      return;
+    }
+    index.move([&](const std::streamoff position) {
+      return position - body_begin;
+    });
+    index.writeFooter(os, header_begin);
   } else {
     std::string error_msg = "Unable to write object it does not contain ";
     error_msg += "a registered write method.";
@@ -144,10 +199,14 @@ void FileRestartTXT::write(std::any obj, const std::string &filename) {
 
 void FileRestartTXT::read(std::any obj, std::istream &is) {
 
+  // Files written before the index was added are read sequentially
+  const SectionIndex index = SectionIndex::read(is);
+
   // Check if object type is registered
   if (read_methods_.count(std::type_index(obj.type()))) {
-    auto data = read_methods_[std::type_index(obj.type())](type(), is, obj);
-    read_(obj, data, is);
+    index.seek(is, SectionIndex::root);
+    auto data = read_methods_.at(std::type_index(obj.type()))(type(), is, obj);
+    read_(obj, data, is, SectionIndex::root, index);
   } else {
     std::string error_msg = "Unable to read object it does not contain ";
     error_msg += "a registered read method.";
@@ -159,8 +218,11 @@ void FileRestartTXT::read(std::any obj, std::istream &is) {
   }
 
   if (post_read_initialization_.count(std::type_index(obj.type()))) {
-    post_read_initialization_[std::type_index(obj.type())](type(), obj);
+    post_read_initialization_.at(std::type_index(obj.type()))(type(), obj);
   }
+
+  // Leave the stream after the objects so the next one can be read
+  index.seekEnd(is);
 }
 
 void FileRestartTXT::read(std::any obj, const std::string &filename) {
@@ -9,6 +9,7 @@
 
 // Local private PANACEA includes
 #include "io_common.hpp"
+#include "section_index.hpp"
 
 // Standard includes
 #include <any>
@@ -36,6 +37,10 @@ namespace io {
  * The spaces between the headers are not important but the order they appear in
  *is. The data must appear on the line directly under each header.
  *
+ * The objects are streamed between the header and the offsets of a
+ * SectionIndex, readers seek to the offset of their object. Files without an
+ * index are still read sequentially.
+ *
  **/
 class FileRestartTXT : public FileIO {
 
@@ -53,11 +58,19 @@ private:
   static std::unordered_map<std::type_index, PostReadInitialization>
       post_read_initialization_;
 
-  void write_(std::vector<std::any> &objs, std::ostream &os);
+  void write_(std::vector<std::any> &objs, std::ostream &os,
+              const std::string &parent_path, SectionIndex &index);
+
+  void read_(std::any parent, ReadInstantiateVector &objs, std::istream &is,
+             const std::string &parent_path, const SectionIndex &index);
 
-  void read_(std::any parent, ReadInstantiateVector &objs, std::istream &is);
+  static bool registerMethods_();
 
 public:
+  /**
+   * The read and write methods are registered by the first instance that is
+   * constructed, constructing further instances is free.
+   **/
   FileRestartTXT();
   settings::FileType type() const noexcept final {
     return settings::FileType::TXTRestart;
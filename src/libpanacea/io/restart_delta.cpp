@@ -0,0 +1,90 @@
+
+// Local private PANACEA includes
+#include "restart_delta.hpp"
+
+// Standard includes
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace panacea {
+
+namespace io {
+
+int RestartDelta::storedRows(const void *kernels,
+                             const std::shared_ptr<const void> &storage,
+                             const int rows, const int cols) const {
+  if (storage == nullptr) {
+    return 0;
+  }
+  auto stored = stored_.find(kernels);
+  if (stored == stored_.end()) {
+    return 0;
+  }
+  // Storage that was replaced may have changed any of the rows
+  const auto &previous = stored->second;
+  const auto previous_storage = previous.storage.lock();
+  if (previous_storage != storage || previous.cols != cols ||
+      previous.rows > rows) {
+    return 0;
+  }
+  return previous.rows;
+}
+
+void RestartDelta::record(const void *kernels,
+                          std::shared_ptr<const void> storage, const int rows,
+                          const int cols) {
+  pending_[kernels] = Kernels{std::move(storage), rows, cols};
+}
+
+void RestartDelta::commit() {
+  for (auto &pending : pending_) {
+    stored_[pending.first] = std::move(pending.second);
+  }
+  pending_.clear();
+}
+
+void RestartDelta::clear() noexcept {
+  stored_.clear();
+  pending_.clear();
+}
+
+void RestartOStream::defer(Writer writer) {
+  deferred_.push_back(Deferred{tellp(), std::move(writer), 0});
+}
+
+std::string RestartOStream::render() {
+  const std::string contents = str();
+  std::ostringstream rendered(std::ios::out | std::ios::binary);
+  std::streamoff position = 0;
+  std::streamoff inserted = 0;
+  for (auto &deferred : deferred_) {
+    rendered.write(contents.data() + position, deferred.position - position);
+    position = deferred.position;
+    const std::streamoff before = rendered.tellp();
+    deferred.writer(rendered);
+    inserted += static_cast<std::streamoff>(rendered.tellp()) - before;
+    deferred.inserted = inserted;
+  }
+  rendered.write(contents.data() + position,
+                 static_cast<std::streamoff>(contents.size()) - position);
+  return rendered.str();
+}
+
+std::streamoff
+RestartOStream::rendered(const std::streamoff position) const noexcept {
+  // Whatever a writer deferred at a position wrote comes before it
+  std::streamoff inserted = 0;
+  for (const auto &deferred : deferred_) {
+    if (deferred.position > position) {
+      break;
+    }
+    inserted = deferred.inserted;
+  }
+  return position + inserted;
+}
+
+} // namespace io
+} // namespace panacea
@@ -0,0 +1,113 @@
+#ifndef PANACEA_PRIVATE_RESTART_DELTA_H
+#define PANACEA_PRIVATE_RESTART_DELTA_H
+#pragma once
+
+// Standard includes
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Kernel rows that are already stored in a checkpoint log
+ *
+ * Only kernels backed by append only storage are tracked, as long as the
+ * kernels still use the same storage the rows stored earlier are unchanged
+ * and a record only needs to contain the rows added since. Rows recorded
+ * while writing a record only count as stored once the record is committed.
+ **/
+class RestartDelta {
+private:
+  struct Kernels {
+    std::weak_ptr<const void> storage;
+    int rows = 0;
+    int cols = 0;
+  };
+
+  std::unordered_map<const void *, Kernels> stored_;
+  std::unordered_map<const void *, Kernels> pending_;
+
+public:
+  /**
+   * Number of leading rows of the kernels that are already stored, 0 if
+   * every row has to be written.
+   **/
+  int storedRows(const void *kernels,
+                 const std::shared_ptr<const void> &storage, const int rows,
+                 const int cols) const;
+
+  void record(const void *kernels, std::shared_ptr<const void> storage,
+              const int rows, const int cols);
+
+  void commit();
+  void discard() noexcept { pending_.clear(); }
+  void clear() noexcept;
+};
+
+/**
+ * Stream that objects are written to when writing a restart record
+ *
+ * If it carries a RestartDelta the record is a delta record, kernels only
+ * write the rows that are not yet stored.
+ *
+ * A snapshot stream is filled on the thread that takes a checkpoint and
+ * rendered on the thread that writes it. Objects that can hold on to their
+ * data without copying it, i.e. kernels stored copy-on-write, defer writing
+ * it until the stream is rendered, everything else is written right away.
+ **/
+class RestartOStream : public std::ostringstream {
+public:
+  using Writer = std::function<void(std::ostream &)>;
+
+private:
+  struct Deferred {
+    std::streamoff position = 0;
+    Writer writer;
+    // Bytes written by this and the preceding writers once rendered
+    std::streamoff inserted = 0;
+  };
+
+  RestartDelta *delta_ = nullptr;
+  bool snapshot_ = false;
+  std::vector<Deferred> deferred_;
+
+public:
+  RestartOStream() = default;
+  explicit RestartOStream(RestartDelta *delta) : delta_(delta) {}
+
+  RestartDelta *delta() const noexcept { return delta_; }
+  void set(RestartDelta *delta) noexcept { delta_ = delta; }
+
+  bool snapshot() const noexcept { return snapshot_; }
+  void setSnapshot(const bool snapshot) noexcept { snapshot_ = snapshot; }
+
+  /**
+   * Runs the writer at the current position when the stream is rendered.
+   **/
+  void defer(Writer writer);
+  bool deferred() const noexcept { return not deferred_.empty(); }
+
+  /**
+   * Contents of the stream with the output of the deferred writers inserted
+   * where they were deferred.
+   **/
+  std::string render();
+
+  /**
+   * Position in the rendered contents of a position in the stream, only
+   * valid after render.
+   **/
+  std::streamoff rendered(const std::streamoff position) const noexcept;
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_RESTART_DELTA_H
@@ -0,0 +1,193 @@
+
+// Local private PANACEA includes
+#include "restart_read_context.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace panacea {
+
+namespace io {
+
+/***********************************************************
+ * File scope functions
+ ***********************************************************/
+
+static const std::string record_tag = "[Checkpoint Record]";
+
+static std::uint64_t updateChecksum(std::uint64_t checksum, const char *data,
+                                    const std::size_t size) noexcept {
+  for (std::size_t index = 0; index < size; ++index) {
+    checksum ^= static_cast<unsigned char>(data[index]);
+    checksum *= 0x100000001b3ULL;
+  }
+  return checksum;
+}
+
+static constexpr std::uint64_t checksum_basis = 0xcbf29ce484222325ULL;
+
+enum class Frame { None, Complete, Incomplete };
+
+/**
+ * Reads the frame of a checkpoint log record and checks the record against
+ * it, the stream is left at the start of the record. Streams that are not at
+ * a frame, i.e. plain restart files, are left where they were.
+ **/
+static Frame readFrame(std::istream &is, std::uint64_t &size) {
+  const std::streamoff frame_begin = is.tellg();
+  std::string line = "";
+  std::getline(is, line);
+  if (line.compare(0, record_tag.size(), record_tag) != 0) {
+    // A frame cut short before the end of its tag is trailing
+    if (is.eof() && record_tag.compare(0, line.size(), line) == 0) {
+      return Frame::Incomplete;
+    }
+    is.clear();
+    is.seekg(frame_begin);
+    return Frame::None;
+  }
+  if (is.eof()) {
+    return Frame::Incomplete;
+  }
+  std::uint64_t checksum = 0;
+  std::istringstream ss(line.substr(record_tag.size()));
+  if (not(ss >> size >> std::hex >> checksum)) {
+    std::string error_msg = "Unable to read the size and checksum of a ";
+    error_msg += "checkpoint log record.\nline is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  const std::streamoff record_begin = is.tellg();
+  is.seekg(0, std::ios::end);
+  const std::streamoff end = is.tellg();
+  if (static_cast<std::uint64_t>(end - record_begin) < size) {
+    return Frame::Incomplete;
+  }
+
+  is.seekg(record_begin);
+  std::array<char, 65536> buffer{};
+  std::uint64_t remaining = size;
+  std::uint64_t record_checksum = checksum_basis;
+  while (remaining > 0) {
+    const auto bytes = std::min<std::uint64_t>(buffer.size(), remaining);
+    is.read(buffer.data(), static_cast<std::streamsize>(bytes));
+    record_checksum = updateChecksum(record_checksum, buffer.data(), bytes);
+    remaining -= bytes;
+  }
+  if (record_checksum != checksum) {
+    // Only the last record can have been cut short by an append
+    if (static_cast<std::uint64_t>(end - record_begin) == size) {
+      return Frame::Incomplete;
+    }
+    PANACEA_FAIL("Checkpoint log record does not match its checksum.");
+  }
+  is.seekg(record_begin);
+  return Frame::Complete;
+}
+
+/***********************************************************
+ * Public functions
+ ***********************************************************/
+
+const RestartReadContext *RestartReadContext::of(const std::istream &is) {
+  return dynamic_cast<const RestartReadContext *>(&is);
+}
+
+bool deferKernels(const std::istream &is) {
+  const auto context = RestartReadContext::of(is);
+  return context != nullptr && context->deferKernels();
+}
+
+bool readOptionalTag(std::istream &is, const std::string &tag) {
+  const auto position = is.tellg();
+  if (position == std::istream::pos_type(-1)) {
+    std::string error_msg = "Unable to look for the optional " + tag;
+    error_msg += " section, the restart stream is not seekable.";
+    PANACEA_FAIL(error_msg);
+  }
+  std::string line = "";
+  while (std::getline(is, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    if (line.find(tag, 0) != std::string::npos) {
+      return true;
+    }
+    break;
+  }
+  is.clear();
+  is.seekg(position);
+  return false;
+}
+
+RestartIFStream::RestartIFStream(const std::string &file_name,
+                                 const bool defer_kernels)
+    : std::ifstream(file_name, std::ios::binary),
+      RestartReadContext(file_name, defer_kernels) {}
+
+std::string frameRecord(const std::string &record) {
+  std::ostringstream frame;
+  // The checksum has a fixed width so records of the same size take up the
+  // same space in the log
+  frame << record_tag << " " << record.size() << " " << std::hex
+        << std::setw(16) << std::setfill('0')
+        << updateChecksum(checksum_basis, record.data(), record.size())
+        << "\n";
+  frame << record;
+  return frame.str();
+}
+
+bool skipRecordFrame(std::istream &is) {
+  const std::streamoff frame_begin = is.tellg();
+  std::string line = "";
+  if (std::getline(is, line) &&
+      line.compare(0, record_tag.size(), record_tag) == 0) {
+    return true;
+  }
+  is.clear();
+  is.seekg(frame_begin);
+  return false;
+}
+
+int readRestartRecords(FileIO &file_io, std::any obj,
+                       const std::string &file_name,
+                       const bool defer_kernels) {
+  RestartIFStream is(file_name, defer_kernels);
+  if (not is) {
+    std::string error_msg = "Unable to open restart file: " + file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  int records = 0;
+  while (is.peek() != EOF) {
+    std::uint64_t size = 0;
+    const Frame frame = readFrame(is, size);
+    if (frame == Frame::Incomplete) {
+      break;
+    }
+    const std::streamoff record_begin = is.tellg();
+    file_io.read(obj, is);
+    if (frame == Frame::Complete) {
+      is.clear();
+      is.seekg(record_begin + static_cast<std::streamoff>(size));
+    }
+    ++records;
+  }
+  if (records == 0) {
+    std::string error_msg = "Restart file is empty: " + file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  return records;
+}
+
+} // namespace io
+} // namespace panacea
@@ -0,0 +1,97 @@
+#ifndef PANACEA_PRIVATE_RESTART_READ_CONTEXT_H
+#define PANACEA_PRIVATE_RESTART_READ_CONTEXT_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/file_io.hpp"
+
+// Standard includes
+#include <any>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Carried by the streams restart files are read from
+ *
+ * The file name allows the kernels of a binary restart file to be memory
+ * mapped even though the file is read from a stream. When the kernels are
+ * deferred only the shape of the kernels is read, their values are skipped
+ * and the primitive groups do not construct their primitives, the settings
+ * and statistics of every object are read as usual.
+ **/
+class RestartReadContext {
+private:
+  std::string file_name_ = "";
+  bool defer_kernels_ = false;
+
+public:
+  RestartReadContext() = default;
+  RestartReadContext(std::string file_name, const bool defer_kernels)
+      : file_name_(std::move(file_name)), defer_kernels_(defer_kernels) {}
+
+  const std::string &fileName() const noexcept { return file_name_; }
+  bool deferKernels() const noexcept { return defer_kernels_; }
+
+  virtual ~RestartReadContext() = default;
+
+  /**
+   * The context of the stream, nullptr if the stream does not carry one.
+   **/
+  static const RestartReadContext *of(const std::istream &is);
+};
+
+/**
+ * True if the stream carries a context that defers the kernels.
+ **/
+bool deferKernels(const std::istream &is);
+
+/**
+ * Reads the tag of a section that older restart files do not have
+ *
+ * Returns true and consumes the tag if it is on the next non empty line,
+ * otherwise the stream is returned to where it was and false is returned.
+ **/
+bool readOptionalTag(std::istream &is, const std::string &tag);
+
+class RestartIFStream : public std::ifstream, public RestartReadContext {
+public:
+  RestartIFStream(const std::string &file_name, const bool defer_kernels);
+};
+
+/**
+ * Frames a record of a checkpoint log
+ *
+ * [Checkpoint Record] size checksum
+ *
+ * is followed by the size bytes of the record, the checksum is the 64 bit
+ * FNV-1a hash of those bytes written as 16 hexadecimal digits. An append
+ * that was cut short leaves a trailing record that is shorter than its size
+ * or does not match its checksum, such a record is not read.
+ **/
+std::string frameRecord(const std::string &record);
+
+/**
+ * Moves the stream past the frame of a checkpoint log record, returns false
+ * and leaves the stream where it was if it is not positioned at one.
+ **/
+bool skipRecordFrame(std::istream &is);
+
+/**
+ * Reads every record of a restart file into obj and returns the number of
+ * records read. A restart file holds a single record, a checkpoint log one
+ * framed record per checkpoint. Reading stops in front of an incomplete
+ * trailing record, a damaged record followed by others fails.
+ **/
+int readRestartRecords(FileIO &file_io, std::any obj,
+                       const std::string &file_name,
+                       const bool defer_kernels);
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_RESTART_READ_CONTEXT_H
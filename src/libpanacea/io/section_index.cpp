@@ -0,0 +1,182 @@
+
+// Local private PANACEA includes
+#include "section_index.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace panacea {
+
+namespace io {
+
+/************************************************
+ * File scope variables
+ ************************************************/
+
+static constexpr const char *header_tag = "[Section Index] ";
+// Digits the size of the objects is padded to
+static constexpr std::size_t size_width = 20;
+
+/************************************************
+ * File scope functions
+ ************************************************/
+
+// Header line of a fixed width, so it can be filled in once the size of the
+// objects is known
+static std::string headerLine(const std::streamoff body_size) {
+  const std::string size = std::to_string(body_size);
+  std::string line = header_tag;
+  line += std::string(size_width - size.size(), ' ') + size + "\n";
+  assert(static_cast<std::streamoff>(line.size()) ==
+         SectionIndex::header_width);
+  return line;
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+std::string SectionIndex::path(const std::string &parent,
+                               const std::size_t index) {
+  return parent + "/" + std::to_string(index);
+}
+
+void SectionIndex::add(const std::string &path, const std::streamoff offset) {
+  if (offsets_.count(path) == 0) {
+    paths_.push_back(path);
+  }
+  offsets_[path] = offset;
+}
+
+bool SectionIndex::contains(const std::string &path) const {
+  return offsets_.count(path) > 0;
+}
+
+void SectionIndex::writeHeader(std::ostream &os) {
+  os << headerLine(0);
+}
+
+void SectionIndex::writeFooter(std::ostream &os,
+                               const std::streamoff header_begin) const {
+  const std::streamoff body_size =
+      static_cast<std::streamoff>(os.tellp()) - header_begin - header_width;
+  os << "[Section Offsets]\n";
+  os << paths_.size() << "\n";
+  for (const auto &path : paths_) {
+    os << path << " " << offsets_.at(path) << "\n";
+  }
+  os << "[End Section Index]\n";
+
+  const std::streamoff end = os.tellp();
+  os.seekp(header_begin);
+  os << headerLine(body_size);
+  os.seekp(end);
+  if (not os) {
+    PANACEA_FAIL("Unable to fill in the header of the section index.");
+  }
+}
+
+void SectionIndex::move(
+    const std::function<std::streamoff(std::streamoff)> &to) {
+  for (auto &offset : offsets_) {
+    offset.second = to(offset.second);
+  }
+}
+
+SectionIndex SectionIndex::read(std::istream &is) {
+  SectionIndex index;
+  const std::streamoff begin = is.tellg();
+  if (begin < 0) {
+    return index;
+  }
+
+  std::string line = "";
+  if (not std::getline(is, line) || line.find(header_tag, 0) != 0) {
+    // Files written without an index are read sequentially
+    is.clear();
+    is.seekg(begin);
+    return index;
+  }
+
+  std::istringstream ss(line.substr(std::string(header_tag).size()));
+  std::streamoff body_size = 0;
+  if (not(ss >> body_size) || body_size < 0) {
+    std::string error_msg = "Unable to read the size of the objects from ";
+    error_msg += "the section index header.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  index.body_begin_ = is.tellg();
+
+  // The offsets follow the objects
+  is.seekg(index.body_begin_ + body_size);
+  std::getline(is, line);
+  if (line.find("[Section Offsets]", 0) == std::string::npos) {
+    std::string error_msg = "Section index is missing the [Section Offsets] ";
+    error_msg += "tag after the objects.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  std::getline(is, line);
+  std::istringstream ss_sections(line);
+  std::size_t num_sections = 0;
+  if (not(ss_sections >> num_sections)) {
+    std::string error_msg = "Unable to read the number of sections of the ";
+    error_msg += "section index.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  index.paths_.reserve(num_sections);
+  for (std::size_t section = 0; section < num_sections; ++section) {
+    std::getline(is, line);
+    std::istringstream ss_section(line);
+    std::string path = "";
+    std::streamoff offset = 0;
+    if (not(ss_section >> path >> offset)) {
+      std::string error_msg = "Unable to read section from section index.\n";
+      error_msg += "line is: " + line + "\n";
+      PANACEA_FAIL(error_msg);
+    }
+    index.add(path, offset);
+  }
+
+  std::getline(is, line);
+  if (line.find("[End Section Index]", 0) == std::string::npos) {
+    std::string error_msg = "Section index is not terminated by the ";
+    error_msg += "[End Section Index] tag.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  index.end_ = is.tellg();
+  is.seekg(index.body_begin_);
+  return index;
+}
+
+bool SectionIndex::seek(std::istream &is, const std::string &path) const {
+  auto offset = offsets_.find(path);
+  if (offset == offsets_.end()) {
+    return false;
+  }
+  is.clear();
+  is.seekg(body_begin_ + offset->second);
+  return true;
+}
+
+void SectionIndex::seekEnd(std::istream &is) const {
+  if (empty()) {
+    return;
+  }
+  is.clear();
+  is.seekg(end_);
+}
+
+} // namespace io
+} // namespace panacea
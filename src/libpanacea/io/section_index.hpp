@@ -0,0 +1,104 @@
+#ifndef PANACEA_PRIVATE_SECTION_INDEX_H
+#define PANACEA_PRIVATE_SECTION_INDEX_H
+#pragma once
+
+// Standard includes
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Byte offsets of the objects stored in a restart file
+ *
+ * Each object is identified by its path in the tree of nested objects, "0"
+ * is the object that was written and "0/1/3" the fourth object nested in
+ * the second object nested in it. A reader can seek directly to its section
+ * instead of scanning line by line for its tag.
+ *
+ * The objects are streamed straight to the file between a fixed width header
+ * and the index. Once they are written the index is appended and the size of
+ * the objects is filled in to the header, so writers need a stream they can
+ * move back in.
+ *
+ * [Section Index] body_size
+ * objects
+ * [Section Offsets]
+ * number_of_sections
+ * path offset
+ * ...
+ * [End Section Index]
+ *
+ * body_size is padded to header_width characters. Offsets are measured from
+ * the first byte after the header.
+ **/
+class SectionIndex {
+private:
+  std::vector<std::string> paths_;
+  std::unordered_map<std::string, std::streamoff> offsets_;
+  std::streamoff body_begin_ = 0;
+  std::streamoff end_ = 0;
+
+public:
+  // Path of the object that was written
+  static constexpr const char *root = "0";
+
+  // Characters of the header line, including the newline
+  static constexpr std::streamoff header_width = 37;
+
+  static std::string path(const std::string &parent, const std::size_t index);
+
+  void add(const std::string &path, const std::streamoff offset);
+
+  bool empty() const noexcept { return paths_.empty(); }
+  std::size_t size() const noexcept { return paths_.size(); }
+  bool contains(const std::string &path) const;
+
+  /**
+   * Writes the header with a placeholder for the size of the objects, the
+   * objects are written right after it.
+   **/
+  static void writeHeader(std::ostream &os);
+
+  /**
+   * Writes the index after the objects and fills in the size of the objects
+   * in the header written at header_begin, the stream is left after the
+   * index.
+   **/
+  void writeFooter(std::ostream &os, const std::streamoff header_begin) const;
+
+  /**
+   * Moves every offset, e.g. from positions in the stream to offsets from
+   * the first object or once more bytes were inserted into the objects.
+   **/
+  void move(const std::function<std::streamoff(std::streamoff)> &to);
+
+  /**
+   * Reads the index if the stream is positioned at the header of one and
+   * leaves the stream at the first object, otherwise the stream is left
+   * where it was and the returned index is empty.
+   **/
+  static SectionIndex read(std::istream &is);
+
+  /**
+   * Moves the stream to the start of an object, returns false and leaves the
+   * stream unchanged if the object is not in the index.
+   **/
+  bool seek(std::istream &is, const std::string &path) const;
+
+  /**
+   * Moves the stream past the index so the next record can be read.
+   **/
+  void seekEnd(std::istream &is) const;
+};
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_SECTION_INDEX_H
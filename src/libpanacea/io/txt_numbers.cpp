@@ -0,0 +1,147 @@
+
+// Local private PANACEA includes
+#include "txt_numbers.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/***********************************************************
+ * File scope variables
+ ***********************************************************/
+
+namespace {
+// Number of values below which a block is parsed on the calling thread
+constexpr std::size_t parallel_threshold = 1 << 16;
+
+inline bool isSpace(const char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+} // namespace
+
+/***********************************************************
+ * Public functions
+ ***********************************************************/
+
+void writeDouble(std::ostream &os, const double value, const int width) {
+  std::array<char, 32> buffer;
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  const auto length = static_cast<int>(result.ptr - buffer.data());
+  for (int pad = length; pad < width; ++pad) {
+    os.put(' ');
+  }
+  os.write(buffer.data(), length);
+}
+
+const char *parseDouble(const char *first, const char *last,
+                        double &value) noexcept {
+  while (first != last && isSpace(*first)) {
+    ++first;
+  }
+  // Unlike the stream operators from_chars does not accept a plus sign
+  if (first != last && *first == '+') {
+    ++first;
+  }
+  const auto result = std::from_chars(first, last, value);
+  if (result.ec != std::errc()) {
+    return nullptr;
+  }
+  return result.ptr;
+}
+
+int parseValues(const char *first, const char *last, double *values,
+                const int count) noexcept {
+  for (int index = 0; index < count; ++index) {
+    first = parseDouble(first, last, values[index]);
+    if (first == nullptr) {
+      return index;
+    }
+  }
+  return count;
+}
+
+void readBlock(std::istream &is, const int rows, const int cols,
+               std::vector<double> &values) {
+  values.resize(static_cast<std::size_t>(rows) * cols);
+
+  // Lines are gathered serially, only the parsing is split between threads
+  std::string text;
+  std::vector<std::size_t> line_begin(rows + 1, 0);
+  std::string line;
+  for (int row = 0; row < rows; ++row) {
+    if (not std::getline(is, line)) {
+      std::string error_msg = "Block of values ended after ";
+      error_msg += std::to_string(row) + " of " + std::to_string(rows);
+      error_msg += " lines.";
+      PANACEA_FAIL(error_msg);
+    }
+    line_begin[row] = text.size();
+    text += line;
+    text += '\n';
+  }
+  line_begin[rows] = text.size();
+
+  int threads = 1;
+  if (values.size() >= parallel_threshold) {
+    threads =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    threads = std::min(threads, rows);
+  }
+
+  auto range_begin = [&](const int thread) {
+    return static_cast<int>(static_cast<long long>(rows) * thread / threads);
+  };
+  // Errors cannot be raised from the workers, the first bad row of each
+  // range is recorded instead
+  std::vector<int> bad_rows(threads, -1);
+  auto parse_rows = [&](const int thread) {
+    for (int row = range_begin(thread); row < range_begin(thread + 1); ++row) {
+      const char *first = text.data() + line_begin[row];
+      const char *last = text.data() + line_begin[row + 1];
+      double *row_values = values.data() + static_cast<std::size_t>(row) * cols;
+      if (parseValues(first, last, row_values, cols) != cols) {
+        bad_rows[thread] = row;
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (int thread = 1; thread < threads; ++thread) {
+    workers.emplace_back(parse_rows, thread);
+  }
+  parse_rows(0);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (const int bad_row : bad_rows) {
+    if (bad_row >= 0) {
+      std::string error_msg = "Unable to read " + std::to_string(cols);
+      error_msg += " values from line " + std::to_string(bad_row);
+      error_msg += " of block.\nline is: ";
+      error_msg += text.substr(line_begin[bad_row],
+                               line_begin[bad_row + 1] - line_begin[bad_row]);
+      PANACEA_FAIL(error_msg);
+    }
+  }
+}
+
+} // namespace io
+} // namespace panacea
@@ -0,0 +1,53 @@
+#ifndef PANACEA_PRIVATE_TXT_NUMBERS_H
+#define PANACEA_PRIVATE_TXT_NUMBERS_H
+#pragma once
+
+// Standard includes
+#include <iostream>
+#include <vector>
+
+namespace panacea {
+
+namespace io {
+
+/**
+ * Parsing and formatting of the numbers stored in txt files
+ *
+ * Built on std::from_chars and std::to_chars, these are locale independent
+ * and avoid the per value overhead of the stream operators. Values are
+ * written in their shortest form that reads back to exactly the same double,
+ * and anything written by the stream operators can be read back.
+ **/
+
+/**
+ * Writes the value right aligned in a field of at least width characters.
+ **/
+void writeDouble(std::ostream &os, const double value, const int width = 0);
+
+/**
+ * Parses a single value from the characters in [first, last), leading
+ * whitespace and a leading '+' are skipped. Returns a pointer past the
+ * value or nullptr if no value could be parsed.
+ **/
+const char *parseDouble(const char *first, const char *last,
+                        double &value) noexcept;
+
+/**
+ * Parses up to count whitespace separated values, returns how many were
+ * parsed.
+ **/
+int parseValues(const char *first, const char *last, double *values,
+                const int count) noexcept;
+
+/**
+ * Reads a block of rows lines each holding cols values, values are stored
+ * row major. Large blocks are split at line boundaries and parsed on
+ * several threads.
+ **/
+void readBlock(std::istream &is, const int rows, const int cols,
+               std::vector<double> &values);
+
+} // namespace io
+} // namespace panacea
+
+#endif // PANACEA_PRIVATE_TXT_NUMBERS_H
@@ -4,6 +4,12 @@
 
 #include "data_point_template.hpp"
 #include "error.hpp"
+#include "io/binary_restart_stream.hpp"
+#include "io/restart_delta.hpp"
+#include "io/restart_read_context.hpp"
+#include "io/txt_numbers.hpp"
+#include "kernel_store.hpp"
+#include "memory_mapped_array.hpp"
 #include "private_settings.hpp"
 #include "type_map.hpp"
 
@@ -13,14 +19,150 @@
 // Standard includes
 #include <any>
 #include <cassert>
-#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
 
 namespace panacea {
 
+/************************************************
+ * File scope functions
+ ************************************************/
+
+// Storage of kernels stored copy-on-write, holding on to it keeps the rows
+// unchanged as the kernels detach from it before changing them. Null if the
+// kernels can only be read through the kernel wrapper.
+static std::shared_ptr<const KernelStore>
+heldStorage(const BaseKernelWrapper &kwrapper) {
+  if (kwrapper.getTypeIndex() != std::type_index(typeid(KernelStore))) {
+    return nullptr;
+  }
+  return std::static_pointer_cast<const KernelStore>(
+      kwrapper.appendOnlyStorage());
+}
+
+// Kernels are either the kernel wrapper or the storage held on to
+template <class Kernels>
+static void writeRowsTXT(std::ostream &os, const Kernels &kernels,
+                         const int first_row, const int rows,
+                         const int cols) {
+  for (int row = first_row; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      io::writeDouble(os, kernels.at(row, col), 14);
+      os << " ";
+    }
+    os << "\n";
+  }
+}
+
+template <class Kernels>
+static void writeRowsBinary(std::ostream &os, const Kernels &kernels,
+                            const int first_row, const int rows,
+                            const int cols) {
+  std::vector<double> values(cols);
+  for (int row = first_row; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      values[col] = kernels.at(row, col);
+    }
+    os.write(reinterpret_cast<const char *>(values.data()),
+             values.size() * sizeof(double));
+  }
+}
+
+// Delta records of a checkpoint log only contain the rows added since the
+// previous record, the rows before first_row are already in the kernel
+static int readFirstRow(const BaseKernelWrapper &kwrapper, std::istream &is,
+                        const int rows, const int cols) {
+  if (is.peek() != 'A') {
+    return 0;
+  }
+  std::string line = "";
+  std::getline(is, line);
+  std::istringstream ss(line);
+  std::string word = "";
+  int first_row = 0;
+  if (not(ss >> word >> first_row) || word != "Append") {
+    std::string error_msg = "Unable to read the first appended row of the ";
+    error_msg += "kernel data from restart file.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  if (first_row < 0 || first_row > rows || first_row > kwrapper.rows() ||
+      cols != kwrapper.cols()) {
+    std::string error_msg = "Kernel rows can only be appended to the kernel ";
+    error_msg += "read from the previous records of a checkpoint log.";
+    PANACEA_FAIL(error_msg);
+  }
+  return first_row;
+}
+
+// The kernel data of a binary restart file is a raw array in its own section,
+// it is memory mapped if the kernel wrapper is able to use it in place
+static void readArraySection(BaseKernelWrapper &kwrapper, std::istream &is,
+                             const int rows, const int cols,
+                             const int first_row) {
+
+  std::string line = "";
+  std::getline(is, line);
+  std::istringstream ss(line);
+  std::string word = "";
+  int section = -1;
+  if (not(ss >> word >> section) || word != "Section") {
+    std::string error_msg = "Unable to read the section of the kernel data ";
+    error_msg += "from binary restart file.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  auto sections = dynamic_cast<io::BinaryRestartIStream *>(&is);
+  if (sections == nullptr) {
+    PANACEA_FAIL("Binary restart kernels must be read from a binary restart "
+                 "file.");
+  }
+
+  if (first_row == 0 && sections->canMap()) {
+    auto mapped = sections->map(section);
+    if (mapped->rows() != rows || mapped->cols() != cols) {
+      PANACEA_FAIL("Kernel data section does not match the kernel shape.");
+    }
+    if (kwrapper.adopt(std::move(mapped))) {
+      return;
+    }
+  }
+
+  std::istream &data = sections->seek(section);
+  const BinaryArrayHeader header = BinaryArrayHeader::read(data);
+  if (header.rows != rows - first_row || header.cols != cols ||
+      header.layout != MemoryLayout::RowMajor) {
+    PANACEA_FAIL("Kernel data section does not match the kernel shape.");
+  }
+  if (BinaryArrayHeader::header_size + header.dataBytes() >
+      sections->size(section)) {
+    PANACEA_FAIL("Kernel data section of binary restart file is truncated.");
+  }
+  kwrapper.resize(rows, cols);
+  std::vector<double> values(cols);
+  for (int row = first_row; row < rows; ++row) {
+    data.read(reinterpret_cast<char *>(values.data()),
+              values.size() * sizeof(double));
+    if (data.gcount() !=
+        static_cast<std::streamsize>(values.size() * sizeof(double))) {
+      PANACEA_FAIL("Kernel data section of binary restart file is truncated.");
+    }
+    for (int col = 0; col < cols; ++col) {
+      kwrapper.at(row, col) = values[col];
+    }
+  }
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
 std::vector<std::any>
 BaseKernelWrapper::write(const settings::FileType file_type, std::ostream &os,
                          std::any kwrapper_instance) {
@@ -53,6 +195,7 @@ BaseKernelWrapper::write(const settings::FileType file_type, std::ostream &os,
 
   std::vector<std::any> nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     os << "[Kernel]\n";
@@ -64,12 +207,64 @@ BaseKernelWrapper::write(const settings::FileType file_type, std::ostream &os,
     os << "[Data]\n";
     os << kwrapper.arrangement() << "\n";
     os << kwrapper.rows() << " " << kwrapper.cols() << "\n";
-    for (int row = 0; row < kwrapper.rows(); ++row) {
-      for (int col = 0; col < kwrapper.cols(); ++col) {
-        os << std::setfill(' ') << std::setw(14) << std::setprecision(8)
-           << std::right << kwrapper.at(row, col) << " ";
+
+    // Delta records only contain the rows that are not stored yet
+    int first_row = 0;
+    auto restart_os = dynamic_cast<io::RestartOStream *>(&os);
+    if (restart_os) {
+      if (auto delta = restart_os->delta()) {
+        auto storage = kwrapper.appendOnlyStorage();
+        first_row = delta->storedRows(&kwrapper, storage, kwrapper.rows(),
+                                      kwrapper.cols());
+        delta->record(&kwrapper, std::move(storage), kwrapper.rows(),
+                      kwrapper.cols());
       }
-      os << "\n";
+    }
+    if (first_row > 0) {
+      os << "Append " << first_row << "\n";
+    }
+
+    // Snapshots of a checkpoint hold on to kernels stored copy-on-write and
+    // write them later, the kernels are free to change in the meantime
+    const int rows = kwrapper.rows();
+    const int cols = kwrapper.cols();
+    std::shared_ptr<const KernelStore> storage = nullptr;
+    if (restart_os && restart_os->snapshot()) {
+      storage = heldStorage(kwrapper);
+    }
+
+    if (file_type == settings::FileType::BinaryRestart) {
+      auto sections = dynamic_cast<io::BinaryRestartOStream *>(&os);
+      if (sections == nullptr) {
+        PANACEA_FAIL("Binary restart kernels must be written to a binary "
+                     "restart file.");
+      }
+      BinaryArrayHeader header;
+      header.layout = MemoryLayout::RowMajor;
+      header.arrangement = kwrapper.arrangement();
+      header.rows = rows - first_row;
+      header.cols = cols;
+      int section = 0;
+      if (storage) {
+        section = sections->addArray(
+            header,
+            [storage, first_row, rows, cols](std::ostream &data) {
+              writeRowsBinary(data, *storage, first_row, rows, cols);
+            },
+            true);
+      } else {
+        section = sections->addArray(
+            header, [&kwrapper, first_row, rows, cols](std::ostream &data) {
+              writeRowsBinary(data, kwrapper, first_row, rows, cols);
+            });
+      }
+      os << "Section " << section << "\n";
+    } else if (storage) {
+      restart_os->defer([storage, first_row, rows, cols](std::ostream &data) {
+        writeRowsTXT(data, *storage, first_row, rows, cols);
+      });
+    } else {
+      writeRowsTXT(os, kwrapper, first_row, rows, cols);
     }
   }
   return nested_values;
@@ -107,21 +302,25 @@ BaseKernelWrapper::read(const settings::FileType file_type, std::istream &is,
 
   io::ReadInstantiateVector nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     // Before doing any reading ensure that the underlying descriptor data type
     // is actually compatible, right now the Kernel must be of type
-    // std::vector<std::vector<double>> or std::vector<double> as in the data
-    // must be owned by the kernel wrapper and not simply a pointer to it
+    // std::vector<std::vector<double>>, KernelStore or std::vector<double> as
+    // in the data must be owned by the kernel wrapper and not simply a pointer
+    // to it
     if (kwrapper.getTypeIndex() !=
             std::type_index(typeid(std::vector<std::vector<double>>)) &&
+        kwrapper.getTypeIndex() != std::type_index(typeid(KernelStore)) &&
         kwrapper.getTypeIndex() !=
             std::type_index(typeid(std::vector<double>))) {
       std::string error_msg =
           "Reading kernel data in requires that the kernel ";
       error_msg += "wrapper actually own the data so the underlying type must "
                    "be of type";
-      error_msg += " std::vector<std:vector<double>>, or std::vector<double>, ";
+      error_msg += " std::vector<std:vector<double>>, KernelStore, or ";
+      error_msg += "std::vector<double>, ";
       error_msg += "it cannot be a pointer.";
     }
 
@@ -237,15 +436,25 @@ BaseKernelWrapper::read(const settings::FileType file_type, std::istream &is,
       PANACEA_FAIL(error_msg);
     }
 
+    // Only the shape is read while the kernels are deferred, the readers of
+    // the following objects skip past the kernel values
+    if (io::deferKernels(is)) {
+      return nested_values;
+    }
+
+    const int first_row = readFirstRow(kwrapper, is, rows, cols);
+    if (file_type == settings::FileType::BinaryRestart) {
+      readArraySection(kwrapper, is, rows, cols, first_row);
+      return nested_values;
+    }
+
     try {
+      std::vector<double> values;
+      io::readBlock(is, rows - first_row, cols, values);
       kwrapper.resize(rows, cols);
-      for (int row = 0; row < rows; ++row) {
-        std::getline(is, line);
-        std::istringstream ss_data(line);
+      for (int row = first_row; row < rows; ++row) {
         for (int col = 0; col < cols; ++col) {
-          double value;
-          ss_data >> value;
-          kwrapper.at(row, col) = value;
+          kwrapper.at(row, col) = values[(row - first_row) * cols + col];
         }
       }
     } catch (...) {
@@ -260,5 +469,18 @@ BaseKernelWrapper::read(const settings::FileType file_type, std::istream &is,
   return nested_values;
 }
 
+const MemoryMappedArray *BaseKernelWrapper::mappedRows() const noexcept {
+  const auto raw_data = getPointerToRawData();
+  if (raw_data.type() != typeid(MemoryMappedArray *)) {
+    return nullptr;
+  }
+  const MemoryMappedArray *mapped =
+      std::any_cast<MemoryMappedArray *>(raw_data);
+  if (mapped->layout() != MemoryLayout::RowMajor) {
+    return nullptr;
+  }
+  return mapped;
+}
+
 BaseKernelWrapper::~BaseKernelWrapper(){};
 } // namespace panacea
@@ -9,12 +9,18 @@
 // Standard includes
 #include <any>
 #include <cstddef>
+#include <iostream>
+#include <memory>
 #include <typeindex>
+#include <vector>
 
 namespace panacea {
 
 enum class Arrangement;
 class BaseDescriptorWrapper;
+class DescriptorStatistics;
+class MemoryMappedArray;
+class UpdatePolicy;
 
 namespace settings {
 enum class FileType;
@@ -81,6 +87,52 @@ public:
    **/
   virtual void update(const BaseDescriptorWrapper &) = 0;
 
+  /**
+   * Update the kernel wrapper when statistics of the descriptors have already
+   * been gathered, by default the statistics are ignored.
+   **/
+  virtual void update(const BaseDescriptorWrapper &dwrapper,
+                      const DescriptorStatistics &) {
+    update(dwrapper);
+  }
+
+  /**
+   * Sets how later updates are combined with the descriptors already seen,
+   * kernels whose centers are not accumulated over updates ignore it.
+   **/
+  virtual void set(const UpdatePolicy &) {}
+
+  /**
+   * Uses the rows of a memory mapped array as the kernel data without
+   * copying them. Returns false, leaving the kernel unchanged, if the kernel
+   * cannot be backed by a mapped array.
+   **/
+  virtual bool adopt(std::shared_ptr<MemoryMappedArray>) { return false; }
+
+  /**
+   * Storage of the kernel data if rows already stored in it are never
+   * changed, rows can only be appended. Delta restart records then only
+   * need to contain the rows added since the previous record. Null if the
+   * kernel data can change in place.
+   **/
+  virtual std::shared_ptr<const void> appendOnlyStorage() const noexcept {
+    return nullptr;
+  }
+
+  /**
+   * Whether the kernels point at the memory of the descriptors they were
+   * created from rather than holding a copy, such kernels can only be
+   * updated with descriptors of the same underlying type.
+   **/
+  virtual bool sharesDescriptors() const noexcept { return false; }
+
+  /**
+   * Row major memory mapped array the leading kernel rows are read from,
+   * evaluation then pages the rows in a block at a time ahead of use. Null
+   * if none of the rows are mapped.
+   **/
+  virtual const MemoryMappedArray *mappedRows() const noexcept;
+
   virtual const std::any getPointerToRawData() const noexcept = 0;
   virtual std::type_index getTypeIndex() const noexcept = 0;
   virtual void print() const = 0;
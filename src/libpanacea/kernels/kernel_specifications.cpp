@@ -4,6 +4,7 @@
 
 #include "error.hpp"
 #include "private_settings.hpp"
+#include "update_policy.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io_types.hpp"
@@ -44,6 +45,7 @@ KernelSpecification::write(const settings::FileType file_type, std::ostream &os,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
     os << "[Kernel Specifications]\n";
     os << kern_spec.kern_correlation_ << "\n";
@@ -56,6 +58,7 @@ KernelSpecification::write(const settings::FileType file_type, std::ostream &os,
     os << kern_spec.randomize_dims_ << "\n";
     os << kern_spec.randomize_num_dims_ << "\n";
     os << kern_spec.max_number_dimensions_ << "\n";
+    UpdatePolicy::write(kern_spec.update_policy_, os);
     os << "\n";
   }
   return std::vector<std::any>{};
@@ -83,6 +86,7 @@ KernelSpecification::read(const settings::FileType file_type, std::istream &is,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
@@ -105,6 +109,7 @@ KernelSpecification::read(const settings::FileType file_type, std::istream &is,
     is >> kern_spec.randomize_dims_;
     is >> kern_spec.randomize_num_dims_;
     is >> kern_spec.max_number_dimensions_;
+    UpdatePolicy::read(kern_spec.update_policy_, is);
   }
   return io::ReadInstantiateVector();
 }
@@ -131,6 +136,8 @@ bool operator==(const KernelSpecification &spec1,
     return false;
   if (spec2.max_number_dimensions_ != spec1.max_number_dimensions_)
     return false;
+  if (spec2.update_policy_ != spec1.update_policy_)
+    return false;
   return true;
 }
 
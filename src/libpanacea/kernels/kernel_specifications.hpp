@@ -7,6 +7,7 @@
 
 #include "constants.hpp"
 #include "error.hpp"
+#include "update_policy.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io_types.hpp"
@@ -60,6 +61,7 @@ class KernelSpecification {
   settings::RandomizeNumberDimensions randomize_num_dims_ =
       defaults::randomize_num_dims_default;
   int max_number_dimensions_ = constants::automate;
+  UpdatePolicy update_policy_;
 
 public:
   KernelSpecification() = default;
@@ -122,6 +124,8 @@ public:
     } else if constexpr (std::is_same<
                              T, settings::RandomizeNumberDimensions>::value) {
       return randomize_num_dims_;
+    } else if constexpr (std::is_same<T, UpdatePolicy>::value) {
+      return update_policy_;
     } else if constexpr (std::is_same<T, std::string>::value) {
       std::stringstream string_spec("Kernel ");
       string_spec << settings::toString(kern_correlation_);
@@ -134,6 +138,7 @@ public:
       string_spec << ", " << settings::toString(randomize_dims_);
       string_spec << ", " << settings::toString(randomize_num_dims_);
       string_spec << ", " << max_number_dimensions_;
+      string_spec << ", " << settings::toString(update_policy_.mode());
       return string_spec.str();
     }
   }
@@ -243,6 +248,10 @@ public:
     randomize_num_dims_ = rand_num_dims;
   }
 
+  inline void set(const UpdatePolicy &update_policy) noexcept {
+    update_policy_ = update_policy;
+  }
+
   static std::vector<std::any> write(const settings::FileType file_type,
                                      std::ostream &,
                                      std::any kern_spec_instance);
@@ -0,0 +1,181 @@
+
+// Local private PANACEA includes
+#include "kernel_store.hpp"
+
+#include "error.hpp"
+#include "memory_mapped_array.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace panacea {
+
+/************************************************
+ * Private Methods
+ ************************************************/
+
+void KernelStore::setChunkShape_() {
+  // Largest power of two number of rows that fits in a chunk, at least one
+  const std::size_t row_bytes =
+      std::max<std::size_t>(1, static_cast<std::size_t>(cols_)) *
+      sizeof(double);
+  chunk_shift_ = 0;
+  while ((row_bytes << (chunk_shift_ + 1)) <= chunk_bytes_) {
+    ++chunk_shift_;
+  }
+  chunk_mask_ = (1 << chunk_shift_) - 1;
+}
+
+std::size_t KernelStore::chunkSize_() const noexcept {
+  return static_cast<std::size_t>(rowsPerChunk()) * cols_;
+}
+
+std::size_t KernelStore::storedValues_(const std::size_t chunk) const
+    noexcept {
+  const std::size_t first_row = chunk << chunk_shift_;
+  const std::size_t chunk_rows = std::min<std::size_t>(
+      rowsPerChunk(), static_cast<std::size_t>(rows_) - first_row);
+  return chunk_rows * cols_;
+}
+
+double *KernelStore::addChunk_() {
+  // Value initialization zeros the new chunk
+  owned_chunks_.push_back(std::make_unique<double[]>(chunkSize_()));
+  chunks_.push_back(owned_chunks_.back().get());
+  return chunks_.back();
+}
+
+void KernelStore::ownChunk_(const std::size_t chunk) {
+  assert(owned_chunks_[chunk] == nullptr);
+  auto values = std::make_unique<double[]>(chunkSize_());
+  std::copy(chunks_[chunk], chunks_[chunk] + storedValues_(chunk),
+            values.get());
+  chunks_[chunk] = values.get();
+  owned_chunks_[chunk] = std::move(values);
+}
+
+void KernelStore::releaseMapping_() noexcept {
+  if (std::all_of(owned_chunks_.begin(), owned_chunks_.end(),
+                  [](const std::unique_ptr<double[]> &chunk) {
+                    return chunk != nullptr;
+                  })) {
+    mapped_.reset();
+  }
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+KernelStore::KernelStore(const int cols) : cols_(cols) {
+  assert(cols >= 0);
+  setChunkShape_();
+}
+
+KernelStore::KernelStore(const std::vector<std::vector<double>> &data,
+                         const int rows, const int cols)
+    : KernelStore(cols) {
+  assert(rows >= 0);
+  for (int row = 0; row < rows; ++row) {
+    double *values = appendRow();
+    if (row < static_cast<int>(data.size())) {
+      const int num_values =
+          std::min(cols, static_cast<int>(data[row].size()));
+      std::copy(data[row].begin(), data[row].begin() + num_values, values);
+    }
+  }
+}
+
+KernelStore::KernelStore(std::shared_ptr<MemoryMappedArray> mapped)
+    : KernelStore(mapped->cols()) {
+  if (mapped->layout() != MemoryLayout::RowMajor) {
+    PANACEA_FAIL("Kernel centers can only be mapped from row major arrays.");
+  }
+  rows_ = mapped->rows();
+  const std::size_t num_chunks = (rows_ + chunk_mask_) >> chunk_shift_;
+  chunks_.reserve(num_chunks);
+  owned_chunks_.resize(num_chunks);
+  for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    chunks_.push_back(mapped->data() + chunk * chunkSize_());
+  }
+  mapped_ = std::move(mapped);
+}
+
+KernelStore::KernelStore(const KernelStore &store)
+    : rows_(store.rows_), cols_(store.cols_), chunk_shift_(store.chunk_shift_),
+      chunk_mask_(store.chunk_mask_) {
+  // The copy owns all of its values even if the original is mapped
+  chunks_.reserve(store.chunks_.size());
+  owned_chunks_.reserve(store.chunks_.size());
+  for (std::size_t chunk = 0; chunk < store.chunks_.size(); ++chunk) {
+    std::copy(store.chunks_[chunk],
+              store.chunks_[chunk] + store.storedValues_(chunk), addChunk_());
+  }
+}
+
+KernelStore &KernelStore::operator=(const KernelStore &store) {
+  if (this != &store) {
+    KernelStore copy(store);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+int KernelStore::capacity() const noexcept {
+  return static_cast<int>(chunks_.size()) * rowsPerChunk();
+}
+
+double *KernelStore::appendRow() {
+  const int row = rows_;
+  const std::size_t chunk = row >> chunk_shift_;
+  if (row == capacity()) {
+    addChunk_();
+  } else if (owned_chunks_[chunk] == nullptr && row >= mapped_->rows()) {
+    // The last mapped chunk ends with the mapping, its rows are copied so
+    // that the new row does not fall outside of it
+    ownChunk_(chunk);
+    releaseMapping_();
+  }
+  ++rows_;
+  return chunks_[chunk] + static_cast<std::size_t>(row & chunk_mask_) * cols_;
+}
+
+void KernelStore::resize(const int rows, const int cols) {
+  assert(rows >= 0);
+  assert(cols >= 0);
+  if (cols == cols_) {
+    if (rows < rows_) {
+      // Clear the discarded rows so that growing again starts from zeros
+      for (int row = rows; row < rows_; ++row) {
+        double *values = chunks_[row >> chunk_shift_] +
+                         static_cast<std::size_t>(row & chunk_mask_) * cols_;
+        std::fill(values, values + cols_, 0.0);
+      }
+      rows_ = rows;
+      chunks_.resize((rows_ + chunk_mask_) >> chunk_shift_);
+      owned_chunks_.resize(chunks_.size());
+      releaseMapping_();
+    }
+    while (rows_ < rows) {
+      appendRow();
+    }
+    return;
+  }
+
+  // The number of rows in a chunk depends on the number of columns
+  KernelStore resized(cols);
+  const int shared_cols = std::min(cols, cols_);
+  for (int row = 0; row < rows; ++row) {
+    double *values = resized.appendRow();
+    if (row < rows_) {
+      const double *old_values = this->row(row);
+      std::copy(old_values, old_values + shared_cols, values);
+    }
+  }
+  *this = std::move(resized);
+}
+
+} // namespace panacea
@@ -0,0 +1,133 @@
+#ifndef PANACEA_PRIVATE_KERNELSTORE_H
+#define PANACEA_PRIVATE_KERNELSTORE_H
+#pragma once
+
+// Standard includes
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace panacea {
+
+class MemoryMappedArray;
+
+/**
+ * Append optimized storage of kernel centers
+ *
+ * Rows are stored contiguously in fixed size chunks, each chunk holds a
+ * power of two number of rows. Appending a row never moves the rows that are
+ * already stored, when the last chunk is full a new one is allocated. Adding
+ * k rows of d columns is thus O(k * d) independent of how many rows are
+ * already stored.
+ *
+ * The rows can also be backed by a row major memory mapped array, in which
+ * case each chunk points into the mapping instead of owning its values. A
+ * mapped chunk is only copied into memory if rows are appended past the end
+ * of the mapping.
+ **/
+class KernelStore {
+private:
+  // Target size of a single chunk
+  static constexpr std::size_t chunk_bytes_ = 1 << 16;
+
+  int rows_ = 0;
+  int cols_ = 0;
+  int chunk_shift_ = 0;
+  int chunk_mask_ = 0;
+  // First value of every chunk, either owned or inside the mapped array
+  std::vector<double *> chunks_;
+  // Null for the chunks that point into the mapped array
+  std::vector<std::unique_ptr<double[]>> owned_chunks_;
+  std::shared_ptr<MemoryMappedArray> mapped_;
+
+  void setChunkShape_();
+  std::size_t chunkSize_() const noexcept;
+  std::size_t storedValues_(const std::size_t chunk) const noexcept;
+  double *addChunk_();
+  void ownChunk_(const std::size_t chunk);
+  // Drops the mapped array once no chunk points into it
+  void releaseMapping_() noexcept;
+
+public:
+  KernelStore() = default;
+  explicit KernelStore(const int cols);
+  KernelStore(const std::vector<std::vector<double>> &data, const int rows,
+              const int cols);
+
+  /**
+   * Rows are read from the mapped array without being copied, the array
+   * must be row major.
+   **/
+  explicit KernelStore(std::shared_ptr<MemoryMappedArray> mapped);
+  KernelStore(const KernelStore &store);
+  KernelStore(KernelStore &&store) = default;
+  KernelStore &operator=(const KernelStore &store);
+  KernelStore &operator=(KernelStore &&store) = default;
+
+  int rows() const noexcept { return rows_; }
+  int cols() const noexcept { return cols_; }
+
+  /**
+   * Number of rows that can be stored before another chunk is allocated.
+   **/
+  int capacity() const noexcept;
+
+  /**
+   * Number of rows stored in each chunk.
+   **/
+  int rowsPerChunk() const noexcept { return chunk_mask_ + 1; }
+
+  /**
+   * Whether any of the rows are read from a memory mapped array.
+   **/
+  bool mapped() const noexcept { return mapped_ != nullptr; }
+
+  /**
+   * Array the leading rows are read from, null if no rows are mapped.
+   **/
+  const MemoryMappedArray *mappedArray() const noexcept {
+    return mapped_.get();
+  }
+
+  double &at(const int row, const int col);
+  double at(const int row, const int col) const;
+
+  /**
+   * Pointer to the cols() contiguous values of a row.
+   **/
+  const double *row(const int row) const;
+
+  /**
+   * Adds a row of zeros and returns a pointer to it so it can be filled.
+   **/
+  double *appendRow();
+
+  /**
+   * Values outside of the new shape are discarded, new values are 0.0.
+   **/
+  void resize(const int rows, const int cols);
+};
+
+inline double &KernelStore::at(const int row, const int col) {
+  assert(row >= 0 && row < rows_);
+  assert(col >= 0 && col < cols_);
+  return chunks_[row >> chunk_shift_]
+                [static_cast<std::size_t>(row & chunk_mask_) * cols_ + col];
+}
+
+inline double KernelStore::at(const int row, const int col) const {
+  assert(row >= 0 && row < rows_);
+  assert(col >= 0 && col < cols_);
+  return chunks_[row >> chunk_shift_]
+                [static_cast<std::size_t>(row & chunk_mask_) * cols_ + col];
+}
+
+inline const double *KernelStore::row(const int row) const {
+  assert(row >= 0 && row < rows_);
+  return chunks_[row >> chunk_shift_] +
+         static_cast<std::size_t>(row & chunk_mask_) * cols_;
+}
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_KERNELSTORE_H
@@ -89,6 +89,9 @@ public:
   virtual void set(const Arrangement arrangement) final;
 
   virtual void update(const BaseDescriptorWrapper &) final;
+  virtual bool sharesDescriptors() const noexcept final {
+    return std::is_pointer<T>::value;
+  }
   virtual const std::any getPointerToRawData() const noexcept final;
   virtual std::type_index getTypeIndex() const noexcept final;
   virtual void print() const final;
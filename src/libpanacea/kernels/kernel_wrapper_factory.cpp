@@ -2,12 +2,16 @@
 #include "kernel_wrapper_factory.hpp"
 
 #include "base_kernel_wrapper.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
 #include "error.hpp"
 #include "kernel_specifications.hpp"
 #include "mean.hpp"
 #include "mean_kernel_wrapper.hpp"
 #include "median.hpp"
 #include "median_kernel_wrapper.hpp"
+#include "memory_mapped_array.hpp"
+#include "shared_kernel_wrapper.hpp"
+#include "streaming_median_kernel_wrapper.hpp"
 #include "primitives/gaussian_uncorrelated.hpp"
 #include "private_settings.hpp"
 #include "type_map.hpp"
@@ -31,12 +35,13 @@ std::unordered_map<
                            KernelWrapperFactory::KernelCreateMethod>>>
     KernelWrapperFactory::create_methods_;
 
-KernelWrapperFactory::KernelWrapperFactory() {
+bool KernelWrapperFactory::registerKernels_() {
 
+  // Owned kernels are stored copy-on-write so that primitive groups created
+  // from the same descriptors share a single copy of the kernel centers
   registerKernel<settings::KernelCenterCalculation::None,
                  std::vector<std::vector<double>> *,
-                 std::vector<std::vector<double>>,
-                 KernelWrapper<std::vector<std::vector<double>>>>();
+                 std::vector<std::vector<double>>, SharedKernelWrapper>();
 
   registerKernel<settings::KernelCenterCalculation::None,
                  std::vector<std::vector<double>> *,
@@ -45,26 +50,47 @@ KernelWrapperFactory::KernelWrapperFactory() {
 
   registerKernel<settings::KernelCenterCalculation::None,
                  std::vector<std::vector<double>>,
-                 std::vector<std::vector<double>>,
-                 KernelWrapper<std::vector<std::vector<double>>>>();
+                 std::vector<std::vector<double>>, SharedKernelWrapper>();
 
   registerKernel<settings::KernelCenterCalculation::None, double ***,
-                 std::vector<std::vector<double>>,
-                 KernelWrapper<std::vector<std::vector<double>>>>();
+                 std::vector<std::vector<double>>, SharedKernelWrapper>();
 
   registerKernel<settings::KernelCenterCalculation::None, double ***,
                  double ***, KernelWrapper<double ***>>();
 
+  // Memory mapped descriptors can either be shared, in which case the kernel
+  // centers are paged in on demand, or copied into owned storage
+  registerKernel<settings::KernelCenterCalculation::None, MemoryMappedArray *,
+                 MemoryMappedArray *, KernelWrapper<MemoryMappedArray *>>();
+
+  registerKernel<settings::KernelCenterCalculation::None, MemoryMappedArray *,
+                 std::vector<std::vector<double>>, SharedKernelWrapper>();
+
+  // Sparse descriptors can only be copied into owned storage
+  registerKernel<settings::KernelCenterCalculation::None,
+                 CompressedSparseRows *, std::vector<std::vector<double>>,
+                 SharedKernelWrapper>();
+
   registerKernel<settings::KernelCenterCalculation::Mean, std::vector<double>,
                  std::vector<double>, MeanKernelWrapper>();
 
   registerKernel<settings::KernelCenterCalculation::Median, std::vector<double>,
                  std::vector<double>, MedianKernelWrapper>();
+
+  registerKernel<settings::KernelCenterCalculation::StreamingMedian,
+                 std::vector<double>, std::vector<double>,
+                 StreamingMedianKernelWrapper>();
+  return true;
+}
+
+KernelWrapperFactory::KernelWrapperFactory() {
+  [[maybe_unused]] static const bool registered = registerKernels_();
 }
 
 std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
     const BaseDescriptorWrapper &desc_wrapper,
-    const KernelSpecification &kern_specification) const {
+    const KernelSpecification &kern_specification,
+    const DescriptorStatistics *stats) const {
 
   // Ensure valid method exists
   if (create_methods_.count(
@@ -78,8 +104,8 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
 
   if (kern_specification.is(settings::KernelCount::OneToOne)) {
 
-    if (create_methods_[kern_specification
-                            .get<settings::KernelCenterCalculation>()]
+    if (create_methods_
+            .at(kern_specification.get<settings::KernelCenterCalculation>())
             .count(desc_wrapper.getTypeIndex()) == 0) {
       std::string error_msg =
           "Kernel creation method is missing for the specified internal type.";
@@ -111,15 +137,18 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
       auto kern_data_type_index = desc_data_type_index;
       if (desc_data_type_index !=
               std::type_index(typeid(std::vector<std::vector<double>> *)) &&
-          desc_data_type_index != std::type_index(typeid(double ***))) {
+          desc_data_type_index != std::type_index(typeid(double ***)) &&
+          desc_data_type_index !=
+              std::type_index(typeid(MemoryMappedArray *))) {
         PANACEA_FAIL("Unsupported types detected, cannot create kernels.");
       }
 
-      return create_methods_[kern_specification
-                                 .get<settings::KernelCenterCalculation>()]
-                            [desc_data_type_index][kern_data_type_index](
-                                PassKey<KernelWrapperFactory>(), &desc_wrapper,
-                                desc_wrapper.rows(), desc_wrapper.cols());
+      return create_methods_
+          .at(kern_specification.get<settings::KernelCenterCalculation>())
+          .at(desc_data_type_index)
+          .at(kern_data_type_index)(PassKey<KernelWrapperFactory>(),
+                                    &desc_wrapper, desc_wrapper.rows(),
+                                    desc_wrapper.cols());
     } else { // If owned
 
       auto kern_data_type_index =
@@ -129,7 +158,11 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
               std::type_index(typeid(std::vector<std::vector<double>> *)) &&
           desc_data_type_index !=
               std::type_index(typeid(std::vector<std::vector<double>>)) &&
-          desc_data_type_index != std::type_index(typeid(double ***))) {
+          desc_data_type_index != std::type_index(typeid(double ***)) &&
+          desc_data_type_index !=
+              std::type_index(typeid(MemoryMappedArray *)) &&
+          desc_data_type_index !=
+              std::type_index(typeid(CompressedSparseRows *))) {
         std::string error_msg =
             "Unsupported types detected, cannot create kernels:\n";
         error_msg += "OneToOne\nOwn\n\n";
@@ -137,6 +170,8 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
         error_msg += "vector<vector<double>>* to vector<vector<double>>\n";
         error_msg += "vector<vector<double>>  to vector<vector<double>>\n";
         error_msg += "double ***              to vector<vector<double>>\n";
+        error_msg += "MemoryMappedArray *     to vector<vector<double>>\n";
+        error_msg += "CompressedSparseRows *  to vector<vector<double>>\n";
         if (type_map.count(desc_data_type_index)) {
           error_msg += "\n";
           error_msg += "The type passed in is identified as " +
@@ -145,31 +180,41 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
         PANACEA_FAIL(error_msg);
       }
 
-      return create_methods_[kern_specification
-                                 .get<settings::KernelCenterCalculation>()]
-                            [desc_data_type_index][kern_data_type_index](
-                                PassKey<KernelWrapperFactory>(), &desc_wrapper,
-                                desc_wrapper.rows(), desc_wrapper.cols());
+      return create_methods_
+          .at(kern_specification.get<settings::KernelCenterCalculation>())
+          .at(desc_data_type_index)
+          .at(kern_data_type_index)(PassKey<KernelWrapperFactory>(),
+                                    &desc_wrapper, desc_wrapper.rows(),
+                                    desc_wrapper.cols());
     }
   } else if (kern_specification.is(settings::KernelCount::Single)) {
     if (kern_specification.is(settings::KernelMemory::Own)) {
 
       if (not kern_specification.is(settings::KernelCenterCalculation::Mean) &&
           not kern_specification.is(
-              settings::KernelCenterCalculation::Median)) {
-        std::string error_msg = "Kernel Center Calculation must be Mean or "
-                                "Median when Count is Single: ";
+              settings::KernelCenterCalculation::Median) &&
+          not kern_specification.is(
+              settings::KernelCenterCalculation::StreamingMedian)) {
+        std::string error_msg = "Kernel Center Calculation must be Mean, "
+                                "Median or StreamingMedian when Count is "
+                                "Single: ";
         error_msg += settings::toString(
             kern_specification.get<settings::KernelCenterCalculation>());
         PANACEA_FAIL(error_msg);
       }
 
-      return create_methods_[kern_specification
-                                 .get<settings::KernelCenterCalculation>()]
-                            [std::type_index(typeid(std::vector<double>))]
-                            [std::type_index(typeid(std::vector<double>))](
-                                PassKey<KernelWrapperFactory>(), &desc_wrapper,
-                                1, desc_wrapper.getNumberDimensions());
+      const auto create_method =
+          create_methods_
+              .at(kern_specification.get<settings::KernelCenterCalculation>())
+              .at(std::type_index(typeid(std::vector<double>)))
+              .at(std::type_index(typeid(std::vector<double>)));
+      if (stats != nullptr &&
+          kern_specification.is(settings::KernelCenterCalculation::Mean)) {
+        return create_method(PassKey<KernelWrapperFactory>(), stats, 1,
+                             desc_wrapper.getNumberDimensions());
+      }
+      return create_method(PassKey<KernelWrapperFactory>(), &desc_wrapper, 1,
+                           desc_wrapper.getNumberDimensions());
     }
   }
   std::string error_msg = "The combination of kernel specifications is not";
@@ -205,10 +250,10 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
           std::type_index(typeid(std::vector<std::vector<double>>));
       // Initialize with an empty vector of vectors
       std::vector<std::vector<double>> data;
-      return create_methods_[kern_specification
-                                 .get<settings::KernelCenterCalculation>()]
-                            [data_type_index][data_type_index](
-                                PassKey<KernelWrapperFactory>(), data, 0, 0);
+      return create_methods_
+          .at(kern_specification.get<settings::KernelCenterCalculation>())
+          .at(data_type_index)
+          .at(data_type_index)(PassKey<KernelWrapperFactory>(), data, 0, 0);
     }
   } else if (kern_specification.is(settings::KernelCount::Single)) {
     if (kern_specification.is(settings::KernelMemory::Own) or
@@ -216,19 +261,22 @@ std::unique_ptr<BaseKernelWrapper> KernelWrapperFactory::create(
 
       if (not kern_specification.is(settings::KernelCenterCalculation::Mean) &&
           not kern_specification.is(
-              settings::KernelCenterCalculation::Median)) {
-        std::string error_msg = "Kernel Center Calculation must be Mean or "
-                                "Median when Count is Single: ";
+              settings::KernelCenterCalculation::Median) &&
+          not kern_specification.is(
+              settings::KernelCenterCalculation::StreamingMedian)) {
+        std::string error_msg = "Kernel Center Calculation must be Mean, "
+                                "Median or StreamingMedian when Count is "
+                                "Single: ";
         error_msg += settings::toString(
             kern_specification.get<settings::KernelCenterCalculation>());
         PANACEA_FAIL(error_msg);
       }
       std::vector<double> data;
-      return create_methods_[kern_specification
-                                 .get<settings::KernelCenterCalculation>()]
-                            [std::type_index(typeid(std::vector<double>))]
-                            [std::type_index(typeid(std::vector<double>))](
-                                PassKey<KernelWrapperFactory>(), data, 0, 0);
+      return create_methods_
+          .at(kern_specification.get<settings::KernelCenterCalculation>())
+          .at(std::type_index(typeid(std::vector<double>)))
+          .at(std::type_index(typeid(std::vector<double>)))(
+              PassKey<KernelWrapperFactory>(), data, 0, 0);
     }
   }
   std::string error_msg = "The combination of kernel specifications is not";
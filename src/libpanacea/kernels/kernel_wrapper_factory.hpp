@@ -19,6 +19,7 @@ namespace panacea {
 
 class BaseDescriptorWrapper;
 class BaseKernelWrapper;
+class DescriptorStatistics;
 class KernelSpecification;
 
 class KernelWrapperFactory {
@@ -36,16 +37,26 @@ private:
                                             KernelCreateMethod>>>
       create_methods_;
 
+  static bool registerKernels_();
+
 public:
+  /**
+   * The built in kernels are registered by the first factory that is
+   * constructed, constructing further factories is free.
+   **/
   KernelWrapperFactory();
 
   /**
    * Will create a kernel wrapper who's fields are populated based on what is
    * in the descriptor wrapper.
+   *
+   * If statistics of the descriptors are provided, kernels centered on the
+   * mean are created from them instead of reading the descriptors again.
    **/
   std::unique_ptr<BaseKernelWrapper>
   create(const BaseDescriptorWrapper &desc_wrapper,
-         const KernelSpecification &kern_specification) const;
+         const KernelSpecification &kern_specification,
+         const DescriptorStatistics *stats = nullptr) const;
 
   /**
    * Will create a shell of a kernel wrapper that is essentially empty. This is
@@ -56,6 +67,10 @@ public:
   std::unique_ptr<BaseKernelWrapper>
   create(const KernelSpecification &kern_specification) const;
 
+  /**
+   * Registration is not synchronized, additional kernels must be registered
+   * before factories are used from more than one thread.
+   **/
   template <settings::KernelCenterCalculation kernel_center, class T, class U,
             class S>
   static bool registerKernel() {
@@ -5,10 +5,16 @@
 // Local private PANACEA includes
 #include "mean_kernel_wrapper.hpp"
 
+#include "descriptors/descriptor_statistics.hpp"
+#include "descriptors/streaming_statistics.hpp"
+#include "error.hpp"
+#include "io/restart_read_context.hpp"
 #include "mean.hpp"
+#include "update_policy.hpp"
 
 // Standard incldues
 #include <any>
+#include <cassert>
 #include <vector>
 
 namespace panacea {
@@ -46,6 +52,11 @@ MeanKernelWrapper::MeanKernelWrapper(const std::vector<double> &mean_vec) {
         DataPointTemplate<std::vector<double>>(mean_vec, 1, mean_vec.size());
   }
 }
+MeanKernelWrapper::MeanKernelWrapper(const DescriptorStatistics &stats) {
+  number_pts_mean_ = stats.getNumberPoints();
+  data_wrapper_ = DataPointTemplate<std::vector<double>>(
+      stats.getMean(), 1, stats.getNumberDimensions());
+}
 /************************************************
  * Public Methods
  ************************************************/
@@ -81,6 +92,10 @@ void MeanKernelWrapper::set(const Arrangement arrangement) {
 
 void MeanKernelWrapper::update(const BaseDescriptorWrapper &dwrapper) {
   assert(dwrapper.getNumberDimensions() == data_wrapper_.getNumberDimensions());
+  if (history_) {
+    update(dwrapper, DescriptorStatistics(dwrapper, Moments::Diagonal));
+    return;
+  }
 
   Mean mean;
   std::vector<double> new_center =
@@ -99,6 +114,57 @@ void MeanKernelWrapper::update(const BaseDescriptorWrapper &dwrapper) {
   number_pts_mean_ += dwrapper.getNumberPoints();
 }
 
+void MeanKernelWrapper::update(const BaseDescriptorWrapper &dwrapper,
+                               const DescriptorStatistics &stats) {
+  assert(stats.getNumberDimensions() == data_wrapper_.getNumberDimensions());
+
+  if (history_) {
+    history_->update(stats);
+    const DescriptorStatistics &history_stats = history_->statistics();
+    for (int dim = 0; dim < data_wrapper_.getNumberDimensions(); ++dim) {
+      data_wrapper_(0, dim) = history_stats.getMean(dim);
+    }
+    number_pts_mean_ = history_stats.getNumberPoints();
+    return;
+  }
+
+  const double new_num_pts = static_cast<double>(stats.getNumberPoints());
+  const double inv_total_num_pts =
+      1.0 / static_cast<double>(number_pts_mean_ + new_num_pts);
+  for (int dim = 0; dim < data_wrapper_.getNumberDimensions(); ++dim) {
+    data_wrapper_(0, dim) =
+        (data_wrapper_(0, dim) * static_cast<double>(number_pts_mean_) +
+         stats.getMean(dim) * new_num_pts) *
+        inv_total_num_pts;
+  }
+  number_pts_mean_ += stats.getNumberPoints();
+}
+
+void MeanKernelWrapper::set(const UpdatePolicy &policy) {
+  if (policy.is(settings::UpdateMode::Cumulative)) {
+    history_.reset();
+    return;
+  }
+  // Only the mean is needed so the current center counts as the first update
+  const int num_dims = data_wrapper_.getNumberDimensions();
+  std::vector<double> center(num_dims);
+  for (int dim = 0; dim < num_dims; ++dim) {
+    center[dim] = data_wrapper_(0, dim);
+  }
+  history_ = StreamingStatistics(
+      policy,
+      DescriptorStatistics(number_pts_mean_, std::move(center),
+                           std::vector<double>(num_dims, 0.0),
+                           Moments::Diagonal));
+}
+
+UpdatePolicy MeanKernelWrapper::getUpdatePolicy() const {
+  if (history_) {
+    return history_->policy();
+  }
+  return UpdatePolicy();
+}
+
 const std::any MeanKernelWrapper::getPointerToRawData() const noexcept {
   return data_wrapper_.getPointerToRawData();
 }
@@ -143,6 +209,22 @@ std::istream &MeanKernelWrapper::read(BaseKernelWrapper &kwrapper_instance,
     error_msg += "line is: " + line;
     PANACEA_FAIL(error_msg);
   }
+
+  // Restart files written before update modes were added do not have an
+  // update history
+  int has_history = 0;
+  if (io::readOptionalTag(is, "[Update History]") && not(is >> has_history)) {
+    std::string error_msg = "Unable to read whether the mean kernel has an ";
+    error_msg += "update history from restart file.";
+    PANACEA_FAIL(error_msg);
+  }
+  if (has_history) {
+    StreamingStatistics history;
+    StreamingStatistics::read(history, is);
+    kwrapper_mean.history_ = std::move(history);
+  } else {
+    kwrapper_mean.history_.reset();
+  }
   return is;
 }
 
@@ -153,6 +235,11 @@ MeanKernelWrapper::write(const BaseKernelWrapper &kwrapper_instance,
       dynamic_cast<const MeanKernelWrapper &>(kwrapper_instance);
   os << "[Total Number Points]\n";
   os << kwrapper_mean.number_pts_mean_ << "\n";
+  os << "[Update History]\n";
+  os << (kwrapper_mean.history_ ? 1 : 0) << "\n";
+  if (kwrapper_mean.history_) {
+    StreamingStatistics::write(*kwrapper_mean.history_, os);
+  }
   return os;
 }
 } // namespace panacea
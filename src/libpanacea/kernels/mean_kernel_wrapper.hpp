@@ -7,6 +7,7 @@
 #include "base_kernel_wrapper.hpp"
 
 #include "data_point_template.hpp"
+#include "descriptors/streaming_statistics.hpp"
 
 // Local public PANACEA includes
 #include "panacea/passkey.hpp"
@@ -15,12 +16,14 @@
 #include <any>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <typeindex>
 #include <vector>
 
 namespace panacea {
 
 class BaseDescriptorWrapper;
+class DescriptorStatistics;
 class KernelWrapperFactory;
 
 namespace test {
@@ -32,12 +35,15 @@ class MeanKernelWrapper : public BaseKernelWrapper {
 private:
   DataPointTemplate<std::vector<double>> data_wrapper_;
   int number_pts_mean_; // Number of points used to calculate the mean
+  // Only kept if updates are not cumulative
+  std::optional<StreamingStatistics> history_;
 
   virtual BaseKernelWrapper::ReadFunction getReadFunction_() final;
   virtual BaseKernelWrapper::WriteFunction getWriteFunction_() const final;
 
   explicit MeanKernelWrapper(const BaseDescriptorWrapper &desc_wrapper);
   explicit MeanKernelWrapper(const std::vector<double> &);
+  explicit MeanKernelWrapper(const DescriptorStatistics &stats);
 
 public:
   explicit MeanKernelWrapper(const PassKey<test::Test> &){};
@@ -61,6 +67,18 @@ public:
                     const std::vector<double> &data)
       : MeanKernelWrapper(data){};
 
+  /**
+   * Uses the mean and number of points of statistics that were already
+   * gathered from the descriptors
+   **/
+  MeanKernelWrapper(const PassKey<KernelWrapperFactory> &,
+                    const DescriptorStatistics &stats)
+      : MeanKernelWrapper(stats){};
+
+  MeanKernelWrapper(const PassKey<test::Test> &,
+                    const DescriptorStatistics &stats)
+      : MeanKernelWrapper(stats){};
+
   virtual const settings::KernelCenterCalculation center() const noexcept final;
   virtual const settings::KernelCount count() const noexcept final;
   virtual double &at(const int row, const int col) final;
@@ -73,6 +91,10 @@ public:
   virtual const Arrangement &arrangement() const noexcept final;
   virtual void set(const Arrangement arrangement) final;
   virtual void update(const BaseDescriptorWrapper &) final;
+  virtual void update(const BaseDescriptorWrapper &,
+                      const DescriptorStatistics &stats) final;
+  virtual void set(const UpdatePolicy &policy) final;
+  UpdatePolicy getUpdatePolicy() const;
   virtual const std::any getPointerToRawData() const noexcept final;
   virtual std::type_index getTypeIndex() const noexcept final;
   virtual void print() const final;
@@ -112,6 +134,11 @@ MeanKernelWrapper::create(const PassKey<KernelWrapperFactory> &key,
     return std::make_unique<MeanKernelWrapper>(
         key, std::any_cast<const BaseDescriptorWrapper &>(data));
 
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(const DescriptorStatistics *))) {
+    return std::make_unique<MeanKernelWrapper>(
+        key, *std::any_cast<const DescriptorStatistics *>(data));
+
   } else if (std::type_index(data.type()) ==
              std::type_index(typeid(std::vector<double>))) {
     return std::make_unique<MeanKernelWrapper>(
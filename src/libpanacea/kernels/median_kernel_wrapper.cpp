@@ -6,12 +6,12 @@
 #include "median_kernel_wrapper.hpp"
 
 #include "data_point_template.hpp"
+#include "io/txt_numbers.hpp"
 #include "median.hpp"
 
 // Standard incldues
 #include <algorithm>
 #include <cstdlib>
-#include <iomanip>
 #include <vector>
 
 namespace panacea {
@@ -289,17 +289,12 @@ std::istream &MedianKernelWrapper::read(BaseKernelWrapper &kwrapper_instance,
   }
 
   try {
+    std::vector<double> values;
+    io::readBlock(is, rows, cols, values);
     kwrapper_median.points_near_median_.clear();
     for (int row = 0; row < rows; ++row) {
-      std::getline(is, line);
-      std::istringstream ss_data(line);
-      std::deque<double> data_row;
-      for (int col = 0; col < cols; ++col) {
-        double value;
-        ss_data >> value;
-        data_row.push_back(value);
-      }
-      kwrapper_median.points_near_median_.push_back(data_row);
+      kwrapper_median.points_near_median_.emplace_back(
+          values.begin() + row * cols, values.begin() + (row + 1) * cols);
     }
   } catch (...) {
     std::string error_msg =
@@ -329,9 +324,9 @@ MedianKernelWrapper::write(const BaseKernelWrapper &kwrapper_instance,
   os << rows << " " << cols << "\n";
   for (int row = 0; row < rows; ++row) {
     for (int col = 0; col < cols; ++col) {
-      os << std::setfill(' ') << std::setw(14) << std::setprecision(8)
-         << std::right << kwrapper_median.points_near_median_.at(row).at(col)
-         << " ";
+      io::writeDouble(os, kwrapper_median.points_near_median_.at(row).at(col),
+                      14);
+      os << " ";
     }
     os << "\n";
   }
@@ -0,0 +1,366 @@
+
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Local private PANACEA includes
+#include "shared_kernel_wrapper.hpp"
+
+#include "error.hpp"
+#include "memory_mapped_array.hpp"
+#include "private_settings.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <any>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace panacea {
+
+/************************************************
+ * Declaring private static members
+ ************************************************/
+
+std::vector<std::weak_ptr<SharedKernelWrapper::Storage>>
+    SharedKernelWrapper::storage_pool_;
+
+std::mutex SharedKernelWrapper::storage_pool_mutex_;
+
+/************************************************
+ * File scope functions
+ ************************************************/
+
+// The kernel stores the descriptors with the same row and column layout as
+// the descriptor wrapper
+static double rawValue(const BaseDescriptorWrapper &dwrapper, const int row,
+                       const int col) {
+  if (dwrapper.arrangement() ==
+      Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    return dwrapper(row, col);
+  }
+  return dwrapper(col, row);
+}
+
+static bool sameRow(const SharedKernelWrapper::Storage &data,
+                    const BaseDescriptorWrapper &dwrapper, const int row) {
+  const double *values = data.row(row);
+  for (int col = 0; col < dwrapper.cols(); ++col) {
+    if (values[col] != rawValue(dwrapper, row, col))
+      return false;
+  }
+  return true;
+}
+
+static bool sameValues(const SharedKernelWrapper::Storage &data,
+                       const BaseDescriptorWrapper &dwrapper) {
+  if (data.rows() != dwrapper.rows() || data.cols() != dwrapper.cols())
+    return false;
+  for (int row = 0; row < dwrapper.rows(); ++row) {
+    if (not sameRow(data, dwrapper, row))
+      return false;
+  }
+  return true;
+}
+
+static void appendRow(SharedKernelWrapper::Storage &data,
+                      const BaseDescriptorWrapper &dwrapper, const int row) {
+  double *values = data.appendRow();
+  for (int col = 0; col < dwrapper.cols(); ++col) {
+    values[col] = rawValue(dwrapper, row, col);
+  }
+}
+
+/************************************************
+ * Private Methods
+ ************************************************/
+
+std::shared_ptr<SharedKernelWrapper::Storage>
+SharedKernelWrapper::acquireStorage_(const BaseDescriptorWrapper &dwrapper) {
+
+  std::lock_guard<std::mutex> lock(storage_pool_mutex_);
+
+  // Drop blocks that are no longer referenced by any kernel wrapper
+  storage_pool_.erase(
+      std::remove_if(storage_pool_.begin(), storage_pool_.end(),
+                     [](const std::weak_ptr<Storage> &storage) {
+                       return storage.expired();
+                     }),
+      storage_pool_.end());
+
+  if (auto storage = findStorage_(dwrapper)) {
+    return storage;
+  }
+
+  auto storage = std::make_shared<Storage>(dwrapper.cols());
+  for (int row = 0; row < dwrapper.rows(); ++row) {
+    appendRow(*storage, dwrapper, row);
+  }
+  storage_pool_.push_back(storage);
+  return storage;
+}
+
+std::shared_ptr<SharedKernelWrapper::Storage>
+SharedKernelWrapper::findStorage_(const BaseDescriptorWrapper &dwrapper) {
+  // Comparing the values is a single read pass, which is cheaper than the
+  // allocation and copy it avoids.
+  for (auto &weak_storage : storage_pool_) {
+    if (auto storage = weak_storage.lock()) {
+      if (sameValues(*storage, dwrapper)) {
+        return storage;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void SharedKernelWrapper::detach_() {
+  // The copy owns its values even if the storage is mapped
+  data_ = std::make_shared<Storage>(*data_);
+  exclusive_ = true;
+}
+
+bool SharedKernelWrapper::canAppend_(
+    const BaseDescriptorWrapper &dwrapper) const noexcept {
+  // Only points stored along the rows can be appended
+  return rows_ > 0 && dwrapper.rows() > rows_ && dwrapper.cols() == cols_ &&
+         arrangement_ == Arrangement::PointsAlongRowsDimensionsAlongCols &&
+         dwrapper.arrangement() == arrangement_;
+}
+
+bool SharedKernelWrapper::append_(const BaseDescriptorWrapper &dwrapper) {
+
+  std::lock_guard<std::mutex> lock(storage_pool_mutex_);
+
+  // The descriptors replace the kernels, they can only be appended if the
+  // points already stored are unchanged. Comparing them is a read pass which
+  // is cheaper than copying them into new storage.
+  for (int row = 0; row < rows_; ++row) {
+    if (not sameRow(*data_, dwrapper, row)) {
+      return false;
+    }
+  }
+
+  // Another wrapper that shared the storage may already have appended the
+  // same points to a copy of it
+  if (auto storage = findStorage_(dwrapper)) {
+    data_ = std::move(storage);
+    exclusive_ = false;
+    return true;
+  }
+
+  if (data_.use_count() > 1) {
+    // Other wrappers may be reading the storage, appending could move the
+    // chunks they read from. Detach keeping the rows of this wrapper.
+    auto storage = std::make_shared<Storage>(cols_);
+    for (int row = 0; row < rows_; ++row) {
+      const double *values = data_->row(row);
+      std::copy(values, values + cols_, storage->appendRow());
+    }
+    data_ = std::move(storage);
+    storage_pool_.push_back(data_);
+  } else if (exclusive_.exchange(false)) {
+    // From here on rows are only appended, other wrappers may share it
+    storage_pool_.push_back(data_);
+  }
+  if (data_->rows() > rows_) {
+    data_->resize(rows_, cols_);
+  }
+  exclusive_ = false;
+  for (int row = rows_; row < dwrapper.rows(); ++row) {
+    appendRow(*data_, dwrapper, row);
+  }
+  return true;
+}
+
+void SharedKernelWrapper::setShape_(const int rows, const int cols) {
+  rows_ = rows;
+  cols_ = cols;
+  set(arrangement_);
+}
+
+BaseKernelWrapper::ReadFunction SharedKernelWrapper::getReadFunction_() {
+  return SharedKernelWrapper::read;
+}
+
+BaseKernelWrapper::WriteFunction
+SharedKernelWrapper::getWriteFunction_() const {
+  return SharedKernelWrapper::write;
+}
+
+SharedKernelWrapper::SharedKernelWrapper(const BaseDescriptorWrapper &dwrapper)
+    : data_(acquireStorage_(dwrapper)) {
+  setShape_(dwrapper.rows(), dwrapper.cols());
+}
+
+SharedKernelWrapper::SharedKernelWrapper(
+    const std::vector<std::vector<double>> &data, const int rows,
+    const int cols)
+    : data_(std::make_shared<Storage>(data, rows, cols)), exclusive_(true) {
+  setShape_(rows, cols);
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+void SharedKernelWrapper::resize(const int rows, const int cols) {
+  assert(rows >= 0);
+  assert(cols >= 0);
+  // Detach, any other wrapper sharing the storage keeps the old values
+  auto storage = std::make_shared<Storage>(cols);
+  const int shared_cols = std::min(cols, cols_);
+  for (int row = 0; row < rows; ++row) {
+    double *values = storage->appendRow();
+    if (row < rows_) {
+      const double *old_values = data_->row(row);
+      std::copy(old_values, old_values + shared_cols, values);
+    }
+  }
+  data_ = std::move(storage);
+  exclusive_ = true;
+  setShape_(rows, cols);
+}
+
+int SharedKernelWrapper::rows() const { return rows_; }
+
+int SharedKernelWrapper::cols() const { return cols_; }
+
+int SharedKernelWrapper::getNumberDimensions() const {
+  return number_dimensions_;
+}
+
+int SharedKernelWrapper::getNumberPoints() const { return number_points_; }
+
+const Arrangement &SharedKernelWrapper::arrangement() const noexcept {
+  return arrangement_;
+}
+
+void SharedKernelWrapper::set(const Arrangement arrangement) {
+  arrangement_ = arrangement;
+  if (arrangement_ == Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    number_points_ = rows_;
+    number_dimensions_ = cols_;
+  } else {
+    number_dimensions_ = rows_;
+    number_points_ = cols_;
+  }
+}
+
+void SharedKernelWrapper::update(const BaseDescriptorWrapper &dwrapper) {
+  if (not(canAppend_(dwrapper) && append_(dwrapper))) {
+    data_ = acquireStorage_(dwrapper);
+    exclusive_ = false;
+  }
+  setShape_(dwrapper.rows(), dwrapper.cols());
+}
+
+bool SharedKernelWrapper::adopt(std::shared_ptr<MemoryMappedArray> mapped) {
+  if (mapped->layout() != MemoryLayout::RowMajor) {
+    return false;
+  }
+  const int rows = mapped->rows();
+  const int cols = mapped->cols();
+  data_ = std::make_shared<Storage>(std::move(mapped));
+  exclusive_ = false;
+  setShape_(rows, cols);
+  return true;
+}
+
+const MemoryMappedArray *SharedKernelWrapper::mappedRows() const noexcept {
+  return data_->mappedArray();
+}
+
+const std::any SharedKernelWrapper::getPointerToRawData() const noexcept {
+  return const_cast<const Storage *>(data_.get());
+}
+
+std::type_index SharedKernelWrapper::getTypeIndex() const noexcept {
+  return std::type_index(typeid(Storage));
+}
+
+void SharedKernelWrapper::print() const {
+  std::cout << "Rows " << rows() << " Columns " << cols() << "\n";
+  std::cout << "Dimensions " << getNumberDimensions();
+  std::cout << " Points " << getNumberPoints() << "\n";
+  std::cout << "Storage shared by " << storageUseCount() << " kernels\n";
+  std::cout << "\nData\n";
+  for (int row = 0; row < rows(); ++row) {
+    for (int col = 0; col < cols(); ++col) {
+      std::cout << at(row, col) << "\n";
+    }
+    std::cout << std::endl;
+  }
+}
+
+long SharedKernelWrapper::storageUseCount() const noexcept {
+  return data_.use_count();
+}
+
+bool SharedKernelWrapper::sharesStorageWith(
+    const SharedKernelWrapper &other) const noexcept {
+  return data_ == other.data_;
+}
+
+const settings::KernelCenterCalculation SharedKernelWrapper::center() const
+    noexcept {
+  return settings::KernelCenterCalculation::None;
+}
+
+const settings::KernelCount SharedKernelWrapper::count() const noexcept {
+  return settings::KernelCount::OneToOne;
+}
+
+std::unique_ptr<BaseKernelWrapper>
+SharedKernelWrapper::create(const PassKey<KernelWrapperFactory> &key,
+                            std::any data, const int rows, const int cols) {
+
+  if (std::type_index(data.type()) ==
+      std::type_index(typeid(const BaseDescriptorWrapper *))) {
+    return std::make_unique<SharedKernelWrapper>(
+        key, *std::any_cast<const BaseDescriptorWrapper *>(data));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(BaseDescriptorWrapper *))) {
+    return std::make_unique<SharedKernelWrapper>(
+        key, const_cast<const BaseDescriptorWrapper &>(
+                 *std::any_cast<BaseDescriptorWrapper *>(data)));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(std::vector<std::vector<double>>))) {
+    return std::make_unique<SharedKernelWrapper>(
+        key, std::any_cast<std::vector<std::vector<double>>>(data), rows,
+        cols);
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(std::vector<std::vector<double>> *))) {
+    return std::make_unique<SharedKernelWrapper>(
+        key, *std::any_cast<std::vector<std::vector<double>> *>(data), rows,
+        cols);
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(
+                 typeid(const std::vector<std::vector<double>> *))) {
+    return std::make_unique<SharedKernelWrapper>(
+        key, *std::any_cast<const std::vector<std::vector<double>> *>(data),
+        rows, cols);
+  }
+
+  std::string error_msg = "Unsupported data type encountered while ";
+  error_msg += "attempting to create a shared kernel wrapper.";
+  PANACEA_FAIL(error_msg);
+  return nullptr;
+}
+
+std::istream &SharedKernelWrapper::read(BaseKernelWrapper &,
+                                        std::istream &is) {
+  return is;
+}
+
+std::ostream &SharedKernelWrapper::write(const BaseKernelWrapper &,
+                                         std::ostream &os) {
+  return os;
+}
+
+} // namespace panacea
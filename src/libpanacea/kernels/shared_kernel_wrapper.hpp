@@ -0,0 +1,204 @@
+#ifndef PANACEA_PRIVATE_SHAREDKERNELWRAPPER_H
+#define PANACEA_PRIVATE_SHAREDKERNELWRAPPER_H
+#pragma once
+
+// Local private PANACEA includes
+#include "base_kernel_wrapper.hpp"
+
+#include "data_point_template.hpp"
+#include "kernel_store.hpp"
+
+// Local public PANACEA includes
+#include "panacea/passkey.hpp"
+
+// Standard includes
+#include <any>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+class KernelWrapperFactory;
+
+namespace test {
+class Test;
+}
+
+/**
+ * Kernel wrapper that owns its kernel centers through reference counted,
+ * copy-on-write storage.
+ *
+ * When several primitive groups (e.g. the self and cross entropy terms) are
+ * built from the same descriptors with owned kernel memory they will all
+ * point at the same block of kernel centers instead of each holding a
+ * private copy. Storage that other wrappers, or a checkpoint being written,
+ * may be reading is never changed, a wrapper detaches from it whenever it
+ * would change it, i.e. on a call to update or resize or on writing through
+ * the non-const at method. The remaining wrappers continue to see the
+ * original kernels.
+ *
+ * The kernels are a snapshot of the descriptors, when update is called with
+ * descriptors that extend the ones the kernels were built from, i.e. the
+ * existing points followed by new ones, the wrapper that is the only owner
+ * of its storage copies just the new points and appends them. A wrapper that
+ * shares its storage first looks for storage that another wrapper already
+ * extended with the same points, otherwise it copies the existing rows
+ * before appending.
+ **/
+class SharedKernelWrapper : public BaseKernelWrapper {
+public:
+  using Storage = KernelStore;
+
+private:
+  std::shared_ptr<Storage> data_;
+  // Whether the storage may be changed in place, it is then neither pooled
+  // nor has it been handed out as append only storage. Cleared by the const
+  // appendOnlyStorage, which may be called from several threads.
+  mutable std::atomic<bool> exclusive_{false};
+  Arrangement arrangement_ = Arrangement::PointsAlongRowsDimensionsAlongCols;
+  int rows_ = 0;
+  int cols_ = 0;
+  int number_dimensions_ = 0;
+  int number_points_ = 0;
+
+  /**
+   * Weak references to every block of kernel storage that was created from a
+   * descriptor wrapper, used to find blocks that can be shared.
+   **/
+  static std::vector<std::weak_ptr<Storage>> storage_pool_;
+  static std::mutex storage_pool_mutex_;
+
+  /**
+   * Will return a block of storage containing the same values as the
+   * descriptor wrapper, reusing an existing block if one is found.
+   **/
+  static std::shared_ptr<Storage>
+  acquireStorage_(const BaseDescriptorWrapper &dwrapper);
+
+  /**
+   * Storage in the pool that holds the same values as the descriptor
+   * wrapper, null if there is none. The pool mutex must be held.
+   **/
+  static std::shared_ptr<Storage>
+  findStorage_(const BaseDescriptorWrapper &dwrapper);
+
+  /**
+   * Replaces shared or append only storage with a private copy that can be
+   * written in place.
+   **/
+  void detach_();
+
+  void setShape_(const int rows, const int cols);
+
+  /**
+   * Whether the descriptors have the shape of the kernels with more points.
+   **/
+  bool canAppend_(const BaseDescriptorWrapper &dwrapper) const noexcept;
+
+  /**
+   * Appends the points of the descriptors that are not yet kernels, returns
+   * false without changing the kernels if the existing points differ.
+   **/
+  bool append_(const BaseDescriptorWrapper &dwrapper);
+
+  virtual BaseKernelWrapper::ReadFunction getReadFunction_() final;
+  virtual BaseKernelWrapper::WriteFunction getWriteFunction_() const final;
+
+  explicit SharedKernelWrapper(const BaseDescriptorWrapper &dwrapper);
+  SharedKernelWrapper(const std::vector<std::vector<double>> &data,
+                      const int rows, const int cols);
+
+public:
+  SharedKernelWrapper(const PassKey<KernelWrapperFactory> &,
+                      const BaseDescriptorWrapper &dwrapper)
+      : SharedKernelWrapper(dwrapper){};
+
+  SharedKernelWrapper(const PassKey<test::Test> &,
+                      const BaseDescriptorWrapper &dwrapper)
+      : SharedKernelWrapper(dwrapper){};
+
+  SharedKernelWrapper(const PassKey<KernelWrapperFactory> &,
+                      const std::vector<std::vector<double>> &data,
+                      const int rows, const int cols)
+      : SharedKernelWrapper(data, rows, cols){};
+
+  SharedKernelWrapper(const PassKey<test::Test> &,
+                      const std::vector<std::vector<double>> &data,
+                      const int rows, const int cols)
+      : SharedKernelWrapper(data, rows, cols){};
+
+  virtual const settings::KernelCenterCalculation center() const noexcept final;
+  virtual const settings::KernelCount count() const noexcept final;
+  virtual double &at(const int row, const int col) final;
+  virtual double at(const int row, const int col) const final;
+  virtual void resize(const int rows, const int cols) final;
+  virtual int rows() const final;
+  virtual int cols() const final;
+  virtual int getNumberDimensions() const final;
+  virtual int getNumberPoints() const final;
+  virtual const Arrangement &arrangement() const noexcept final;
+  virtual void set(const Arrangement arrangement) final;
+  /**
+   * The kernels are replaced by the descriptors, if the descriptors only add
+   * points to the existing kernels the new points are appended.
+   **/
+  virtual void update(const BaseDescriptorWrapper &) final;
+  /**
+   * The mapped kernels are not added to the pool of shared storage, wrappers
+   * that map the same array share the pages through the operating system.
+   **/
+  virtual bool adopt(std::shared_ptr<MemoryMappedArray> mapped) final;
+  /**
+   * Rows are only ever appended to the storage, it is replaced whenever
+   * the rows of the kernels change. Once handed out the storage is no longer
+   * written in place, writing through at detaches from it.
+   **/
+  virtual std::shared_ptr<const void> appendOnlyStorage() const
+      noexcept final {
+    exclusive_.store(false, std::memory_order_relaxed);
+    return data_;
+  }
+  /**
+   * Adopted arrays stay mapped until rows are written in place.
+   **/
+  virtual const MemoryMappedArray *mappedRows() const noexcept final;
+  virtual const std::any getPointerToRawData() const noexcept final;
+  virtual std::type_index getTypeIndex() const noexcept final;
+  virtual void print() const final;
+
+  /**
+   * Number of kernel wrappers currently referencing the same storage.
+   **/
+  long storageUseCount() const noexcept;
+  bool sharesStorageWith(const SharedKernelWrapper &other) const noexcept;
+
+  static std::unique_ptr<BaseKernelWrapper>
+  create(const PassKey<KernelWrapperFactory> &, std::any data, const int rows,
+         const int cols);
+
+  static std::istream &read(BaseKernelWrapper &, std::istream &);
+  static std::ostream &write(const BaseKernelWrapper &, std::ostream &);
+};
+
+inline double &SharedKernelWrapper::at(const int row, const int col) {
+  assert(row >= 0 && row < rows_);
+  assert(col >= 0 && col < cols_);
+  if (not exclusive_.load(std::memory_order_relaxed) ||
+      data_.use_count() > 1) {
+    detach_();
+  }
+  return data_->at(row, col);
+}
+
+inline double SharedKernelWrapper::at(const int row, const int col) const {
+  assert(row >= 0 && row < rows_);
+  assert(col >= 0 && col < cols_);
+  return data_->at(row, col);
+}
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_SHAREDKERNELWRAPPER_H
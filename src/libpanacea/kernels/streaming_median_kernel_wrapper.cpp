@@ -0,0 +1,223 @@
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Local private PANACEA includes
+#include "streaming_median_kernel_wrapper.hpp"
+
+#include "data_point_template.hpp"
+#include "error.hpp"
+#include "quantile_sketch.hpp"
+
+// Standard includes
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+/*******************************************
+ * Private methods
+ *******************************************/
+
+BaseKernelWrapper::ReadFunction
+StreamingMedianKernelWrapper::getReadFunction_() {
+  return StreamingMedianKernelWrapper::read;
+}
+
+BaseKernelWrapper::WriteFunction
+StreamingMedianKernelWrapper::getWriteFunction_() const {
+  return StreamingMedianKernelWrapper::write;
+}
+
+void StreamingMedianKernelWrapper::updateCenter_() {
+  std::vector<double> center_(sketches_.size());
+  for (size_t dim = 0; dim < sketches_.size(); ++dim) {
+    center_.at(dim) = sketches_.at(dim).quantile(0.5);
+  }
+  data_wrapper_ =
+      DataPointTemplate<std::vector<double>>(center_, 1, center_.size());
+}
+
+StreamingMedianKernelWrapper::StreamingMedianKernelWrapper(
+    const BaseDescriptorWrapper &dwrapper, const double rank_error)
+    : rank_error_(rank_error) {
+  update(dwrapper);
+}
+
+StreamingMedianKernelWrapper::StreamingMedianKernelWrapper(
+    const std::vector<double> &median_vec, const double rank_error)
+    : rank_error_(rank_error),
+      sketches_(median_vec.size(), QuantileSketch(rank_error)) {
+
+  if (median_vec.size() == 0) {
+    data_wrapper_ = DataPointTemplate<std::vector<double>>(median_vec, 0, 0);
+    number_pts_median_ = 0;
+  } else {
+    for (size_t dim = 0; dim < median_vec.size(); ++dim) {
+      sketches_.at(dim).insert(median_vec.at(dim));
+    }
+    data_wrapper_ = DataPointTemplate<std::vector<double>>(median_vec, 1,
+                                                           median_vec.size());
+    number_pts_median_ = 1;
+  }
+}
+
+/*******************************************
+ * Public methods
+ *******************************************/
+
+void StreamingMedianKernelWrapper::update(
+    const BaseDescriptorWrapper &dwrapper) {
+
+  const int num_pts = dwrapper.getNumberPoints();
+  const int ndim = dwrapper.getNumberDimensions();
+  if (num_pts == 0) {
+    return;
+  }
+  if (sketches_.size() == 0) {
+    sketches_.assign(ndim, QuantileSketch(rank_error_));
+  }
+  assert(ndim == static_cast<int>(sketches_.size()));
+
+  // Each dimension is merged into its sketch as a single sorted batch
+  std::vector<double> values(num_pts);
+  for (int dim = 0; dim < ndim; ++dim) {
+    for (int pt = 0; pt < num_pts; ++pt) {
+      values[pt] = dwrapper(pt, dim);
+    }
+    sketches_.at(dim).insert(values);
+  }
+  number_pts_median_ += num_pts;
+  updateCenter_();
+}
+
+double &StreamingMedianKernelWrapper::at(const int row, const int col) {
+  return data_wrapper_.at(row, col);
+}
+
+double StreamingMedianKernelWrapper::at(const int row, const int col) const {
+  return data_wrapper_.at(row, col);
+}
+
+void StreamingMedianKernelWrapper::resize(const int rows, const int cols) {
+  data_wrapper_.resize(rows, cols);
+}
+
+int StreamingMedianKernelWrapper::rows() const { return data_wrapper_.rows(); }
+
+int StreamingMedianKernelWrapper::cols() const { return data_wrapper_.cols(); }
+
+int StreamingMedianKernelWrapper::getNumberDimensions() const {
+  return data_wrapper_.getNumberDimensions();
+}
+
+int StreamingMedianKernelWrapper::getNumberPoints() const {
+  return number_pts_median_;
+}
+
+const Arrangement &StreamingMedianKernelWrapper::arrangement() const noexcept {
+  return data_wrapper_.arrangement();
+}
+
+void StreamingMedianKernelWrapper::set(const Arrangement arrangement) {
+  data_wrapper_.set(arrangement);
+}
+
+const std::any
+StreamingMedianKernelWrapper::getPointerToRawData() const noexcept {
+  return data_wrapper_.getPointerToRawData();
+}
+
+void StreamingMedianKernelWrapper::print() const { data_wrapper_.print(); }
+
+std::type_index StreamingMedianKernelWrapper::getTypeIndex() const noexcept {
+  return std::type_index(typeid(std::vector<double>));
+}
+
+const settings::KernelCenterCalculation
+StreamingMedianKernelWrapper::center() const noexcept {
+  return settings::KernelCenterCalculation::StreamingMedian;
+}
+
+const settings::KernelCount
+StreamingMedianKernelWrapper::count() const noexcept {
+  return settings::KernelCount::Single;
+}
+
+/********************************************
+ * Static methods
+ ********************************************/
+
+std::istream &
+StreamingMedianKernelWrapper::read(BaseKernelWrapper &kwrapper_instance,
+                                   std::istream &is) {
+
+  StreamingMedianKernelWrapper &kwrapper_median =
+      dynamic_cast<StreamingMedianKernelWrapper &>(kwrapper_instance);
+  std::string line = "";
+  while (line.find("[Total Number Points]", 0) == std::string::npos) {
+    if (is.peek() == EOF) {
+      std::string error_msg =
+          "Did not find [Total Number Points] header while trying ";
+      error_msg += "to read in streaming median kernel wrapper from restart ";
+      error_msg += "file.";
+      PANACEA_FAIL(error_msg);
+    }
+    std::getline(is, line);
+  }
+
+  std::getline(is, line);
+  std::istringstream ss_pts(line);
+  if (not(ss_pts >> kwrapper_median.number_pts_median_)) {
+    std::string error_msg = "Unable to assign total number of points to ";
+    error_msg += "streaming median kernel type from file.\n";
+    error_msg += "line is: " + line;
+    PANACEA_FAIL(error_msg);
+  }
+
+  while (line.find("[Quantile Sketches]", 0) == std::string::npos) {
+    if (is.peek() == EOF) {
+      std::string error_msg = "Did not find [Quantile Sketches]";
+      error_msg += " header while trying to read in streaming median kernel ";
+      error_msg += "wrapper from restart file.";
+      PANACEA_FAIL(error_msg);
+    }
+    std::getline(is, line);
+  }
+
+  std::getline(is, line);
+  std::istringstream ss_dims(line);
+  int ndim = 0;
+  if (not(ss_dims >> ndim) || ndim < 0) {
+    std::string error_msg = "Unable to read in the number of quantile ";
+    error_msg += "sketches from streaming median kernel section of restart ";
+    error_msg += "file.\nline is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  kwrapper_median.sketches_.assign(ndim, QuantileSketch());
+  for (auto &sketch : kwrapper_median.sketches_) {
+    QuantileSketch::read(sketch, is);
+  }
+  if (ndim > 0) {
+    kwrapper_median.rank_error_ = kwrapper_median.sketches_.front().rankError();
+  }
+  return is;
+}
+
+std::ostream &
+StreamingMedianKernelWrapper::write(const BaseKernelWrapper &kwrapper_instance,
+                                    std::ostream &os) {
+  const StreamingMedianKernelWrapper &kwrapper_median =
+      dynamic_cast<const StreamingMedianKernelWrapper &>(kwrapper_instance);
+  os << "[Total Number Points]\n";
+  os << kwrapper_median.number_pts_median_ << "\n";
+  os << "[Quantile Sketches]\n";
+  os << kwrapper_median.sketches_.size() << "\n";
+  for (const auto &sketch : kwrapper_median.sketches_) {
+    QuantileSketch::write(sketch, os);
+  }
+  return os;
+}
+} // namespace panacea
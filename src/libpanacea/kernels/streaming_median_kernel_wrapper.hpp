@@ -0,0 +1,161 @@
+#ifndef PANACEA_PRIVATE_STREAMINGMEDIANKERNELWRAPPER_H
+#define PANACEA_PRIVATE_STREAMINGMEDIANKERNELWRAPPER_H
+#pragma once
+
+// Local private PANACEA includes
+#include "base_kernel_wrapper.hpp"
+
+#include "data_point_template.hpp"
+#include "quantile_sketch.hpp"
+
+// Local public PANACEA includes
+#include "panacea/passkey.hpp"
+
+// Standard includes
+#include <any>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+namespace panacea {
+
+class BaseDescriptorWrapper;
+class KernelWrapperFactory;
+
+namespace test {
+class Test;
+}
+
+/**
+ * Single kernel centered on an approximate median
+ *
+ * Unlike the MedianKernelWrapper no points are stored, each dimension is
+ * summarized by a quantile sketch of fixed size. The median of each dimension
+ * is guaranteed to have a rank within rank_error * n of the exact median,
+ * where n is the total number of points seen.
+ **/
+class StreamingMedianKernelWrapper : public BaseKernelWrapper {
+
+private:
+  DataPointTemplate<std::vector<double>> data_wrapper_;
+
+  double rank_error_ = QuantileSketch::default_rank_error;
+  std::vector<QuantileSketch> sketches_; // One per dimension
+  int number_pts_median_ = 0; // Number of points used to calculate the median
+
+  virtual BaseKernelWrapper::ReadFunction getReadFunction_() final;
+  virtual BaseKernelWrapper::WriteFunction getWriteFunction_() const final;
+
+  void updateCenter_();
+
+  /**
+   * Private constructors
+   **/
+  StreamingMedianKernelWrapper(const BaseDescriptorWrapper &desc_wrapper,
+                               const double rank_error);
+  StreamingMedianKernelWrapper(const std::vector<double> &,
+                               const double rank_error);
+
+public:
+  explicit StreamingMedianKernelWrapper(const PassKey<test::Test> &){};
+
+  StreamingMedianKernelWrapper(
+      const PassKey<KernelWrapperFactory> &,
+      const BaseDescriptorWrapper &desc_wrapper)
+      : StreamingMedianKernelWrapper(desc_wrapper,
+                                     QuantileSketch::default_rank_error){};
+
+  StreamingMedianKernelWrapper(
+      const PassKey<test::Test> &, const BaseDescriptorWrapper &desc_wrapper,
+      const double rank_error = QuantileSketch::default_rank_error)
+      : StreamingMedianKernelWrapper(desc_wrapper, rank_error){};
+
+  /**
+   * If a vector is supplied it is assumed to be the median
+   **/
+  StreamingMedianKernelWrapper(const PassKey<KernelWrapperFactory> &,
+                               const std::vector<double> &data)
+      : StreamingMedianKernelWrapper(data,
+                                     QuantileSketch::default_rank_error){};
+
+  StreamingMedianKernelWrapper(
+      const PassKey<test::Test> &, const std::vector<double> &data,
+      const double rank_error = QuantileSketch::default_rank_error)
+      : StreamingMedianKernelWrapper(data, rank_error){};
+
+  double rankError() const noexcept { return rank_error_; }
+  const std::vector<QuantileSketch> &sketches() const noexcept {
+    return sketches_;
+  }
+
+  virtual const settings::KernelCenterCalculation center() const noexcept final;
+  virtual const settings::KernelCount count() const noexcept final;
+  virtual double &at(const int row, const int col) final;
+  virtual double at(const int row, const int col) const final;
+  virtual void resize(const int rows, const int cols) final;
+  virtual int rows() const final;
+  virtual int cols() const final;
+  virtual int getNumberDimensions() const final;
+  virtual int getNumberPoints() const final;
+  virtual const Arrangement &arrangement() const noexcept final;
+  virtual void set(const Arrangement arrangement) final;
+  virtual void update(const BaseDescriptorWrapper &) final;
+  virtual const std::any getPointerToRawData() const noexcept final;
+  virtual std::type_index getTypeIndex() const noexcept final;
+  virtual void print() const final;
+  // Standard any should not be a reference because the underlying type should
+  // be a pointer
+  static std::unique_ptr<BaseKernelWrapper>
+  create(const PassKey<KernelWrapperFactory> &, std::any data, const int rows,
+         const int cols);
+
+  static std::istream &read(BaseKernelWrapper &, std::istream &);
+  static std::ostream &write(const BaseKernelWrapper &, std::ostream &);
+};
+
+inline std::unique_ptr<BaseKernelWrapper>
+StreamingMedianKernelWrapper::create(const PassKey<KernelWrapperFactory> &key,
+                                     std::any data, const int rows,
+                                     const int cols) {
+
+  if (std::type_index(data.type()) ==
+      std::type_index(typeid(const BaseDescriptorWrapper *))) {
+    return std::make_unique<StreamingMedianKernelWrapper>(
+        key, *std::any_cast<const BaseDescriptorWrapper *>(data));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(BaseDescriptorWrapper *))) {
+    return std::make_unique<StreamingMedianKernelWrapper>(
+        key, const_cast<const BaseDescriptorWrapper &>(
+                 *std::any_cast<BaseDescriptorWrapper *>(data)));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(BaseDescriptorWrapper &))) {
+    return std::make_unique<StreamingMedianKernelWrapper>(
+        key, const_cast<const BaseDescriptorWrapper &>(
+                 std::any_cast<BaseDescriptorWrapper &>(data)));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(const BaseDescriptorWrapper &))) {
+    return std::make_unique<StreamingMedianKernelWrapper>(
+        key, std::any_cast<const BaseDescriptorWrapper &>(data));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(std::vector<double>))) {
+    return std::make_unique<StreamingMedianKernelWrapper>(
+        key, std::any_cast<std::vector<double>>(data));
+
+  } else if (std::type_index(data.type()) ==
+             std::type_index(typeid(const std::vector<double>))) {
+    return std::make_unique<StreamingMedianKernelWrapper>(
+        key, std::any_cast<const std::vector<double>>(data));
+
+  } else {
+    std::string error_msg = "Unsupported data type encountered while ";
+    error_msg += "attempting to create Kernel center streaming median";
+    throw std::runtime_error(error_msg);
+  }
+  return nullptr;
+}
+} // namespace panacea
+#endif // PANACEA_PRIVATE_STREAMINGMEDIANKERNELWRAPPER_H
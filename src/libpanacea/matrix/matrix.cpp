@@ -2,6 +2,7 @@
 // Local private PANACEA includes
 #include "matrix.hpp"
 #include "error.hpp"
+#include "io/txt_numbers.hpp"
 #include "matrix_eigen.hpp"
 
 // Local public PANACEA includes
@@ -9,7 +10,6 @@
 
 // Standard includes
 #include <any>
-#include <iomanip>
 #include <iostream>
 #include <typeindex>
 #include <vector>
@@ -52,6 +52,7 @@ std::vector<std::any> Matrix::write(const settings::FileType file_type,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     os << "[Matrix Type]\n";
@@ -60,8 +61,8 @@ std::vector<std::any> Matrix::write(const settings::FileType file_type,
     os << mat.rows() << " " << mat.cols() << "\n";
     for (int row = 0; row < mat.rows(); ++row) {
       for (int col = 0; col < mat.cols(); ++col) {
-        os << std::setfill(' ') << std::setw(14) << std::setprecision(15)
-           << std::right << mat(row, col) << " ";
+        io::writeDouble(os, mat(row, col), 14);
+        os << " ";
       }
       os << "\n";
     }
@@ -89,6 +90,7 @@ io::ReadInstantiateVector Matrix::read(const settings::FileType file_type,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
@@ -160,13 +162,11 @@ io::ReadInstantiateVector Matrix::read(const settings::FileType file_type,
     }
 
     try {
+      std::vector<double> values;
+      io::readBlock(is, rows, cols, values);
       for (int row = 0; row < rows; ++row) {
-        std::getline(is, line);
-        std::istringstream ss_data(line);
         for (int col = 0; col < cols; ++col) {
-          double value;
-          ss_data >> value;
-          mat(row, col) = value;
+          mat(row, col) = values[row * cols + col];
         }
       }
     } catch (...) {
@@ -211,4 +211,29 @@ std::unique_ptr<Matrix> pseudoInverse(const Matrix &mat,
   }
   return new_mat;
 }
+
+std::unique_ptr<Matrix> choleskyFactor(const Matrix &mat,
+                                       const MatrixType type) {
+  auto new_mat = createMatrix(mat.rows(), mat.cols(), type);
+  if (mat.type() == MatrixType::Eigen or mat.type() == MatrixType::Default) {
+    if (not choleskyFactor(*new_mat, dynamic_cast<const MatrixEigen &>(mat))) {
+      return nullptr;
+    }
+  } else {
+    PANACEA_FAIL("Unsupported matrix type for cholesky factorization.");
+  }
+  return new_mat;
+}
+
+std::unique_ptr<Matrix> choleskyInverse(const Matrix &lower,
+                                        const MatrixType type) {
+  auto new_mat = createMatrix(lower.rows(), lower.cols(), type);
+  if (lower.type() == MatrixType::Eigen or
+      lower.type() == MatrixType::Default) {
+    choleskyInverse(*new_mat, dynamic_cast<const MatrixEigen &>(lower));
+  } else {
+    PANACEA_FAIL("Unsupported matrix type for cholesky inverse.");
+  }
+  return new_mat;
+}
 } // namespace panacea
@@ -75,6 +75,16 @@ createMatrix(const int rows, const int cols,
 std::unique_ptr<Matrix>
 pseudoInverse(const Matrix &mat, const MatrixType type = MatrixType::Default);
 
+// Lower triangular Cholesky factor L of a symmetric matrix, mat = L * L^T,
+// returns a nullptr if the matrix is not positive definite
+std::unique_ptr<Matrix>
+choleskyFactor(const Matrix &mat, const MatrixType type = MatrixType::Default);
+
+// Inverse of a matrix from its lower triangular Cholesky factor
+std::unique_ptr<Matrix>
+choleskyInverse(const Matrix &lower,
+                const MatrixType type = MatrixType::Default);
+
 } // namespace panacea
 
 #endif // PANACEA_MATRIX_H
@@ -98,6 +98,24 @@ Eigen::MatrixXd MatrixEigen::pseudoInverse() const {
   return matrix_->completeOrthogonalDecomposition().pseudoInverse();
 }
 
+bool MatrixEigen::choleskyFactor(Eigen::MatrixXd &lower) const {
+  Eigen::LLT<Eigen::MatrixXd> llt(*matrix_);
+  if (llt.info() != Eigen::Success) {
+    return false;
+  }
+  lower = llt.matrixL();
+  return true;
+}
+
+Eigen::MatrixXd MatrixEigen::choleskyInverse() const {
+  // The matrix holds the lower factor L, inv(A) = inv(L)^T * inv(L)
+  const auto lower = matrix_->triangularView<Eigen::Lower>();
+  Eigen::MatrixXd inv_lower =
+      Eigen::MatrixXd::Identity(matrix_->rows(), matrix_->cols());
+  lower.solveInPlace(inv_lower);
+  return inv_lower.transpose() * inv_lower;
+}
+
 void pseudoInverse(Matrix &return_mat, const MatrixEigen &mat) {
   assert(return_mat.rows() == mat.rows());
   assert(return_mat.cols() == mat.cols());
@@ -109,4 +127,32 @@ void pseudoInverse(Matrix &return_mat, const MatrixEigen &mat) {
     }
   }
 }
+
+bool choleskyFactor(Matrix &return_mat, const MatrixEigen &mat) {
+  assert(return_mat.rows() == mat.rows());
+  assert(return_mat.cols() == mat.cols());
+
+  Eigen::MatrixXd lower;
+  if (not mat.choleskyFactor(lower)) {
+    return false;
+  }
+  for (int row = 0; row < lower.rows(); ++row) {
+    for (int col = 0; col < lower.cols(); ++col) {
+      return_mat(row, col) = lower(row, col);
+    }
+  }
+  return true;
+}
+
+void choleskyInverse(Matrix &return_mat, const MatrixEigen &lower) {
+  assert(return_mat.rows() == lower.rows());
+  assert(return_mat.cols() == lower.cols());
+
+  auto temp_mat = lower.choleskyInverse();
+  for (int row = 0; row < temp_mat.rows(); ++row) {
+    for (int col = 0; col < temp_mat.cols(); ++col) {
+      return_mat(row, col) = temp_mat(row, col);
+    }
+  }
+}
 } // namespace panacea
@@ -43,9 +43,13 @@ public:
 
   // Local method should not be part of the interface
   Eigen::MatrixXd pseudoInverse() const;
+  bool choleskyFactor(Eigen::MatrixXd &lower) const;
+  Eigen::MatrixXd choleskyInverse() const;
 };
 
 void pseudoInverse(Matrix &return_mat, const MatrixEigen &mat);
+bool choleskyFactor(Matrix &return_mat, const MatrixEigen &mat);
+void choleskyInverse(Matrix &return_mat, const MatrixEigen &lower);
 
 } // namespace panacea
 
@@ -3,42 +3,174 @@
 #pragma once
 
 // Local private includes
+#include "data_point_template.hpp"
 #include "data_settings.hpp"
 
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
 // Standard includes
 #include <algorithm>
+#include <any>
+#include <cstddef>
 #include <deque>
 #include <iostream>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
 #include <vector>
 
 namespace panacea {
 
 class Median {
 
-  template <class T>
-  std::vector<double> createSortedRow(const T &data2d, const int row) {
+  // Below this number of values the median is found on the calling thread
+  static constexpr std::size_t parallel_threshold_ = 1 << 16;
+  // Number of columns gathered together, a cache line of doubles
+  static constexpr int column_block_ = 8;
+  // Upper bound on the number of values buffered by a single thread
+  static constexpr std::size_t buffer_values_ = 1 << 21;
 
-    std::vector<double> local_column;
-    local_column.reserve(data2d.cols());
-    // Create local copy
-    for (int col = 0; col < data2d.cols(); ++col) {
-      local_column.push_back(data2d(row, col));
+  /**
+   * Median of the values, the values are reordered.
+   *
+   * Uses selection instead of sorting, for an even number of values the
+   * largest value of the lower half is the other central element.
+   **/
+  static double select(std::vector<double> &values) {
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    if (values.size() % 2 == 1) {
+      return *middle;
     }
-    std::sort(local_column.begin(), local_column.end());
-    return local_column;
+    return (*middle + *std::max_element(values.begin(), middle)) * 0.5;
   }
 
+  static int numberThreads(const std::size_t num_values, const int tasks) {
+    if (num_values < parallel_threshold_) {
+      return 1;
+    }
+    const int hardware =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    return std::max(1, std::min(hardware, tasks));
+  }
+
+  /**
+   * Splits the tasks [0, tasks) into contiguous ranges, one per thread, the
+   * calling thread processes the first range.
+   **/
+  template <class Task>
+  static void forEachRange(const int tasks, const int threads,
+                           const Task &task) {
+    auto range_begin = [&](const int thread) {
+      return static_cast<int>(static_cast<long long>(tasks) * thread /
+                              threads);
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int thread = 1; thread < threads; ++thread) {
+      workers.emplace_back(task, range_begin(thread), range_begin(thread + 1));
+    }
+    task(0, range_begin(1));
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  /**
+   * Returns the underlying rows if the values of a row are stored
+   * contiguously, otherwise nullptr.
+   **/
   template <class T>
-  std::vector<double> createSortedColumn(const T &data2d, const int col) {
+  static const std::vector<std::vector<double>> *
+  contiguousRows(const T &data2d) {
+    if constexpr (std::is_base_of<BaseDescriptorWrapper, T>::value) {
+      if (data2d.getTypeIndex() ==
+              std::type_index(typeid(std::vector<std::vector<double>> *)) &&
+          data2d.arrangement() ==
+              Arrangement::PointsAlongRowsDimensionsAlongCols) {
+        return std::any_cast<std::vector<std::vector<double>> *>(
+            data2d.getPointerToRawData());
+      }
+    }
+    return nullptr;
+  }
+
+  template <class T> static int rows(const T &data2d) { return data2d.rows(); }
+  template <class T> static int cols(const T &data2d) { return data2d.cols(); }
 
-    std::vector<double> local_row;
-    local_row.reserve(data2d.rows());
-    // Create local copy
-    for (int row = 0; row < data2d.rows(); ++row) {
-      local_row.push_back(data2d(row, col));
+  /**
+   * Copies the values in columns [col_begin, col_end) of a row.
+   **/
+  template <class T>
+  static void readRow(const T &data2d,
+                      const std::vector<std::vector<double>> *contiguous,
+                      const int row, const int col_begin, const int col_end,
+                      double *values) {
+    if (contiguous) {
+      const auto &data_row = (*contiguous)[row];
+      std::copy(data_row.begin() + col_begin, data_row.begin() + col_end,
+                values);
+      return;
+    }
+    for (int col = col_begin; col < col_end; ++col) {
+      values[col - col_begin] = data2d(row, col);
     }
-    std::sort(local_row.begin(), local_row.end());
-    return local_row;
+  }
+
+  template <const Direction dir, class T>
+  std::vector<double> calculate_(const T &data2d) {
+
+    const int num_rows = rows(data2d);
+    const int num_cols = num_rows > 0 ? cols(data2d) : 0;
+    const auto contiguous = contiguousRows(data2d);
+    const std::size_t num_values =
+        static_cast<std::size_t>(num_rows) * num_cols;
+
+    std::vector<double> median;
+    if (num_values == 0) {
+      return median;
+    }
+
+    if constexpr (dir == Direction::AlongRows) {
+      median.resize(num_rows);
+      auto task = [&](const int row_begin, const int row_end) {
+        std::vector<double> values(num_cols);
+        for (int row = row_begin; row < row_end; ++row) {
+          readRow(data2d, contiguous, row, 0, num_cols, values.data());
+          median[row] = select(values);
+        }
+      };
+      forEachRange(num_rows, numberThreads(num_values, num_rows), task);
+    } else {
+      median.resize(num_cols);
+      // Columns are gathered in blocks so that each row is read in
+      // contiguous runs rather than a single value at a time
+      const int block = static_cast<int>(std::max<std::size_t>(
+          1, std::min<std::size_t>(column_block_, buffer_values_ / num_rows)));
+      const int num_blocks = (num_cols + block - 1) / block;
+      auto task = [&](const int block_begin, const int block_end) {
+        std::vector<double> row_values(block);
+        std::vector<std::vector<double>> columns(
+            block, std::vector<double>(num_rows));
+        for (int block_ind = block_begin; block_ind < block_end; ++block_ind) {
+          const int col_begin = block_ind * block;
+          const int col_end = std::min(num_cols, col_begin + block);
+          for (int row = 0; row < num_rows; ++row) {
+            readRow(data2d, contiguous, row, col_begin, col_end,
+                    row_values.data());
+            for (int col = col_begin; col < col_end; ++col) {
+              columns[col - col_begin][row] = row_values[col - col_begin];
+            }
+          }
+          for (int col = col_begin; col < col_end; ++col) {
+            median[col] = select(columns[col - col_begin]);
+          }
+        }
+      };
+      forEachRange(num_blocks, numberThreads(num_values, num_blocks), task);
+    }
+    return median;
   }
 
 public:
@@ -66,168 +198,40 @@ public:
    *     col1      col2
    *     2.0       5.0
    *
+   * Each median is found by selection in O(n) time, large data sets are
+   * split across threads, so the data must be safe to read concurrently.
    **/
   template <class T, const Direction dir = Direction::AlongRows>
   std::vector<double> calculate(const T &data2d) {
-
-    std::vector<double> median;
-    if constexpr (std::is_pointer<typename std::remove_const<T>::type>::value) {
-      if constexpr (dir == Direction::AlongRows) {
-        median.reserve(data2d->rows());
-        if (data2d->cols() % 2 == 1) {
-          // is odd
-          for (int row = 0; row < data2d->rows(); ++row) {
-            const auto local_row = createSortedRow(*data2d, row);
-            median.push_back(local_row.at(data2d->cols() / 2));
-          }
-        } else {
-          // is even
-          for (int row = 0; row < data2d->rows(); ++row) {
-            const auto local_row = createSortedRow(*data2d, row);
-            const double avg_of_two = (local_row.at(data2d->cols() / 2) +
-                                       local_row.at((data2d->cols() / 2) - 1)) *
-                                      0.5;
-            median.push_back(avg_of_two);
-          }
-        }
-      } else {
-        median.reserve(data2d->cols());
-        if (data2d->rows() % 2 == 1) {
-          // is odd
-          for (int col = 0; col < data2d->cols(); ++col) {
-            const auto local_column = createSortedColumn(*data2d, col);
-            median.push_back(local_column.at(data2d->rows() / 2));
-          }
-        } else {
-          // is even
-          for (int col = 0; col < data2d->cols(); ++col) {
-            const auto local_column = createSortedColumn(*data2d, col);
-            const double avg_of_two =
-                (local_column.at(data2d->rows() / 2) +
-                 local_column.at((data2d->rows() / 2) - 1)) *
-                0.5;
-            median.push_back(avg_of_two);
-          }
-        }
-      }
-    } else if constexpr (std::is_same<typename std::remove_const<T>::type,
-                                      std::vector<std::deque<double>>>::value) {
-
-      if (data2d.size() == 0)
-        return median;
-
-      const int rows = data2d.size();
-      const int cols = data2d.at(0).size();
-      if constexpr (dir == Direction::AlongRows) {
-        median.reserve(rows);
-        if (cols % 2 == 1) {
-          // is odd
-          for (int row = 0; row < rows; ++row) {
-            const auto local_row = createSortedRow(data2d, row);
-            median.push_back(local_row.at(cols / 2));
-          }
-        } else {
-          // is even
-          for (int row = 0; row < rows; ++row) {
-            const auto local_row = createSortedRow(data2d, row);
-            const double avg_of_two =
-                (local_row.at(cols / 2) + local_row.at((cols / 2) - 1)) * 0.5;
-            median.push_back(avg_of_two);
-          }
-        }
-      } else {
-        median.reserve(cols);
-        if (rows % 2 == 1) {
-          // is odd
-          for (int col = 0; col < cols; ++col) {
-            const auto local_column = createSortedColumn(data2d, col);
-            median.push_back(local_column.at(rows / 2));
-          }
-        } else {
-          // is even
-          for (int col = 0; col < cols; ++col) {
-            const auto local_column = createSortedColumn(data2d, col);
-            const double avg_of_two =
-                (local_column.at(rows / 2) + local_column.at(rows / 2) - 1) *
-                0.5;
-            median.push_back(avg_of_two);
-          }
-        }
-      }
-
-    } else { // If not a pointer type
-      if constexpr (dir == Direction::AlongRows) {
-        median.reserve(data2d.rows());
-        if (data2d.cols() % 2 == 1) {
-          // is odd
-          for (int row = 0; row < data2d.rows(); ++row) {
-            const auto local_row = createSortedRow(data2d, row);
-            median.push_back(local_row.at(data2d.cols() / 2));
-          }
-        } else {
-          // is even
-          for (int row = 0; row < data2d.rows(); ++row) {
-            const auto local_row = createSortedRow(data2d, row);
-            const double avg_of_two = (local_row.at(data2d.cols() / 2) +
-                                       local_row.at((data2d.cols() / 2) - 1)) *
-                                      0.5;
-            median.push_back(avg_of_two);
-          }
-        }
-      } else {
-        median.reserve(data2d.cols());
-        if (data2d.rows() % 2 == 1) {
-          // is odd
-          for (int col = 0; col < data2d.cols(); ++col) {
-            const auto local_column = createSortedColumn(data2d, col);
-            median.push_back(local_column.at(data2d.rows() / 2));
-          }
-        } else {
-          // is even
-          for (int col = 0; col < data2d.cols(); ++col) {
-            const auto local_column = createSortedColumn(data2d, col);
-            const double avg_of_two =
-                (local_column.at(data2d.rows() / 2) +
-                 local_column.at((data2d.rows() / 2) - 1)) *
-                0.5;
-            median.push_back(avg_of_two);
-          }
-        }
-      }
+    if constexpr (std::is_pointer<typename std::remove_const<
+                      typename std::remove_reference<T>::type>::type>::value) {
+      return calculate_<dir>(*data2d);
+    } else {
+      return calculate_<dir>(data2d);
     }
-    return median;
   }
 };
 
 template <>
-inline std::vector<double>
-Median::createSortedRow<std::vector<std::deque<double>>>(
-    const std::vector<std::deque<double>> &data2d, const int row) {
-
-  std::vector<double> local_column;
-  local_column.reserve(data2d.at(0).size());
-  // Create local copy
-  for (int col = 0; col < data2d.at(0).size(); ++col) {
-    local_column.push_back(data2d.at(row).at(col));
-  }
-  std::sort(local_column.begin(), local_column.end());
-  return local_column;
+inline int Median::rows<std::vector<std::deque<double>>>(
+    const std::vector<std::deque<double>> &data2d) {
+  return data2d.size();
 }
 
 template <>
-inline std::vector<double>
-Median::createSortedColumn<std::vector<std::deque<double>>>(
-    const std::vector<std::deque<double>> &data2d, const int col) {
-
-  std::vector<double> local_row;
-  local_row.reserve(data2d.size());
-  // Create local copy
-  for (int row = 0; row < data2d.size(); ++row) {
-    local_row.push_back(data2d.at(row).at(col));
-  }
-  std::sort(local_row.begin(), local_row.end());
-  return local_row;
+inline int Median::cols<std::vector<std::deque<double>>>(
+    const std::vector<std::deque<double>> &data2d) {
+  return data2d.at(0).size();
+}
+
+template <>
+inline void Median::readRow<std::vector<std::deque<double>>>(
+    const std::vector<std::deque<double>> &data2d,
+    const std::vector<std::vector<double>> *, const int row,
+    const int col_begin, const int col_end, double *values) {
+  std::copy(data2d[row].begin() + col_begin, data2d[row].begin() + col_end,
+            values);
 }
 } // namespace panacea
 
-#endif // PANACEA_PRIVATE_MEAN_H
+#endif // PANACEA_PRIVATE_MEDIAN_H
@@ -0,0 +1,288 @@
+// Local private PANACEA includes
+#include "memory_mapped_array.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <iostream>
+#include <string>
+
+// System includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace panacea {
+
+/************************************************
+ * File scope functions
+ ************************************************/
+
+static const char magic[8] = {'P', 'A', 'N', 'A', 'C', 'E', 'A', '\0'};
+
+bool littleEndianHost() noexcept {
+  const std::uint16_t value = 1;
+  return *reinterpret_cast<const unsigned char *>(&value) == 1;
+}
+
+/************************************************
+ * BinaryArrayHeader
+ ************************************************/
+
+std::size_t BinaryArrayHeader::dataBytes() const noexcept {
+  return static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols) *
+         sizeof(double);
+}
+
+void BinaryArrayHeader::checkAvailable(std::istream &is) const {
+  const auto position = is.tellg();
+  if (position < 0) {
+    return;
+  }
+  is.seekg(0, std::ios::end);
+  const auto end = is.tellg();
+  is.seekg(position);
+  if (end < position ||
+      static_cast<std::size_t>(end - position) < dataBytes()) {
+    std::string error_msg = "Binary array is truncated, expected ";
+    error_msg += std::to_string(dataBytes()) + " bytes of values but found ";
+    error_msg += std::to_string(end < position ? 0 : end - position);
+    error_msg += " bytes.";
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+void BinaryArrayHeader::write(std::ostream &os) const {
+  std::array<char, header_size> buffer{};
+  std::memcpy(buffer.data(), magic, sizeof(magic));
+  putLittleEndian<std::uint32_t>(buffer.data() + 8, version);
+  putLittleEndian<std::uint32_t>(buffer.data() + 12,
+                                 static_cast<std::uint32_t>(data_type));
+  putLittleEndian<std::uint32_t>(buffer.data() + 16,
+                                 static_cast<std::uint32_t>(layout));
+  putLittleEndian<std::uint32_t>(buffer.data() + 20,
+                                 static_cast<std::uint32_t>(arrangement));
+  putLittleEndian<std::int64_t>(buffer.data() + 24, rows);
+  putLittleEndian<std::int64_t>(buffer.data() + 32, cols);
+  os.write(buffer.data(), buffer.size());
+}
+
+BinaryArrayHeader BinaryArrayHeader::read(std::istream &is) {
+  std::array<char, header_size> buffer{};
+  is.read(buffer.data(), buffer.size());
+  if (is.gcount() != static_cast<std::streamsize>(header_size)) {
+    PANACEA_FAIL("Binary array file is too small to contain a header.");
+  }
+  return read(buffer.data(), buffer.size());
+}
+
+BinaryArrayHeader BinaryArrayHeader::read(const char *buffer,
+                                          const std::size_t size) {
+  if (size < header_size) {
+    PANACEA_FAIL("Binary array file is too small to contain a header.");
+  }
+  if (std::memcmp(buffer, magic, sizeof(magic)) != 0) {
+    PANACEA_FAIL("Binary array file does not begin with the PANACEA magic.");
+  }
+  const auto file_version = getLittleEndian<std::uint32_t>(buffer + 8);
+  if (file_version != version) {
+    std::string error_msg = "Unsupported binary array file version: ";
+    error_msg += std::to_string(file_version);
+    PANACEA_FAIL(error_msg);
+  }
+
+  // Enumerators are checked before they are cast
+  BinaryArrayHeader header;
+  const auto data_type = getLittleEndian<std::uint32_t>(buffer + 12);
+  if (data_type != static_cast<std::uint32_t>(BinaryDataType::Float64)) {
+    PANACEA_FAIL("Only 64 bit floating point binary arrays are supported.");
+  }
+  header.data_type = BinaryDataType::Float64;
+
+  const auto layout = getLittleEndian<std::uint32_t>(buffer + 16);
+  if (layout > static_cast<std::uint32_t>(MemoryLayout::ColumnMajor)) {
+    std::string error_msg = "Unknown memory layout in binary array header: ";
+    error_msg += std::to_string(layout);
+    PANACEA_FAIL(error_msg);
+  }
+  header.layout = static_cast<MemoryLayout>(layout);
+  if (header.layout == MemoryLayout::Default) {
+    header.layout = MemoryLayout::RowMajor;
+  }
+
+  const auto arrangement = getLittleEndian<std::uint32_t>(buffer + 20);
+  if (arrangement > static_cast<std::uint32_t>(
+                        Arrangement::DimensionsAlongRowsPointsAlongCols)) {
+    std::string error_msg = "Unknown arrangement in binary array header: ";
+    error_msg += std::to_string(arrangement);
+    PANACEA_FAIL(error_msg);
+  }
+  header.arrangement = static_cast<Arrangement>(arrangement);
+
+  header.rows = getLittleEndian<std::int64_t>(buffer + 24);
+  header.cols = getLittleEndian<std::int64_t>(buffer + 32);
+  if (header.rows < 0 || header.cols < 0) {
+    PANACEA_FAIL("Binary array file header contains negative dimensions.");
+  }
+  constexpr std::int64_t max_dim = std::numeric_limits<int>::max();
+  if (header.rows > max_dim || header.cols > max_dim ||
+      (header.rows > 0 &&
+       static_cast<std::uint64_t>(header.cols) >
+           std::numeric_limits<std::size_t>::max() / sizeof(double) /
+               static_cast<std::uint64_t>(header.rows))) {
+    std::string error_msg = "Binary array file header dimensions are too ";
+    error_msg += "large: " + std::to_string(header.rows) + " x ";
+    error_msg += std::to_string(header.cols);
+    PANACEA_FAIL(error_msg);
+  }
+  return header;
+}
+
+/************************************************
+ * MemoryMappedArray
+ ************************************************/
+
+MemoryMappedArray::MemoryMappedArray(const std::string &file_name)
+    : MemoryMappedArray(file_name, 0) {}
+
+MemoryMappedArray::MemoryMappedArray(const std::string &file_name,
+                                     const std::size_t offset) {
+
+  static_assert(sizeof(double) == 8, "Binary arrays require 64 bit doubles.");
+
+  int file_descriptor = ::open(file_name.c_str(), O_RDONLY);
+  if (file_descriptor < 0) {
+    std::string error_msg = "Unable to open binary array file: ";
+    error_msg += file_name;
+    PANACEA_FAIL(error_msg);
+  }
+
+  struct stat file_stat;
+  if (::fstat(file_descriptor, &file_stat) != 0) {
+    ::close(file_descriptor);
+    std::string error_msg = "Unable to stat binary array file: ";
+    error_msg += file_name;
+    PANACEA_FAIL(error_msg);
+  }
+  const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+
+  // The header is read on its own so that only the array is mapped
+  std::array<char, BinaryArrayHeader::header_size> buffer{};
+  if (file_size < offset + BinaryArrayHeader::header_size ||
+      ::pread(file_descriptor, buffer.data(), buffer.size(),
+              static_cast<off_t>(offset)) !=
+          static_cast<ssize_t>(buffer.size())) {
+    ::close(file_descriptor);
+    std::string error_msg = "Binary array file is too small: ";
+    error_msg += file_name;
+    PANACEA_FAIL(error_msg);
+  }
+
+  try {
+    header_ = BinaryArrayHeader::read(buffer.data(), buffer.size());
+  } catch (...) {
+    ::close(file_descriptor);
+    throw;
+  }
+
+  const std::size_t data_bytes = header_.dataBytes();
+  if (file_size - offset - BinaryArrayHeader::header_size < data_bytes) {
+    ::close(file_descriptor);
+    std::string error_msg = "Binary array file is truncated, expected ";
+    error_msg += std::to_string(offset + BinaryArrayHeader::header_size +
+                                data_bytes);
+    error_msg += " bytes but found " + std::to_string(file_size) + " bytes.";
+    PANACEA_FAIL(error_msg);
+  }
+
+  // mmap fails for a length of zero, there is nothing to map
+  if (data_bytes == 0) {
+    ::close(file_descriptor);
+    return;
+  }
+  const std::size_t required_size =
+      offset + BinaryArrayHeader::header_size + data_bytes;
+
+  // mmap requires a page aligned offset
+  static const std::size_t page_size =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::size_t aligned_offset = (offset / page_size) * page_size;
+  data_offset_ = offset - aligned_offset + BinaryArrayHeader::header_size;
+  mapped_size_ = required_size - aligned_offset;
+
+  // Private mapping, pages are only copied if they are written to
+  mapping_ = ::mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    file_descriptor, static_cast<off_t>(aligned_offset));
+  ::close(file_descriptor);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    std::string error_msg = "Unable to memory map binary array file: ";
+    error_msg += file_name;
+    PANACEA_FAIL(error_msg);
+  }
+
+  data_ =
+      reinterpret_cast<double *>(static_cast<char *>(mapping_) + data_offset_);
+
+  // The common access pattern is a sweep over every kernel center
+  ::madvise(mapping_, mapped_size_, MADV_SEQUENTIAL);
+}
+
+MemoryMappedArray::MemoryMappedArray(double *data, const int rows,
+                                     const int cols, const MemoryLayout layout,
+                                     const Arrangement arrangement)
+    : data_offset_(0), data_(data) {
+  if (rows < 0 || cols < 0) {
+    PANACEA_FAIL("Cannot create an array view with negative dimensions.");
+  }
+  if (data == nullptr && rows * cols > 0) {
+    PANACEA_FAIL("Cannot create an array view of a null pointer.");
+  }
+  header_.layout =
+      layout == MemoryLayout::Default ? MemoryLayout::RowMajor : layout;
+  header_.arrangement = arrangement;
+  header_.rows = rows;
+  header_.cols = cols;
+}
+
+MemoryMappedArray::~MemoryMappedArray() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapped_size_);
+  }
+}
+
+int MemoryMappedArray::rowsPerBlock(const std::size_t block_bytes) const
+    noexcept {
+  const std::size_t row_bytes =
+      std::max<std::size_t>(1, header_.cols) * sizeof(double);
+  return static_cast<int>(std::max<std::size_t>(1, block_bytes / row_bytes));
+}
+
+void MemoryMappedArray::willNeed(const int row_begin, const int row_end) const
+    noexcept {
+  // Nothing to page in if the values are owned by the caller
+  if (mapping_ == nullptr || header_.layout != MemoryLayout::RowMajor ||
+      row_begin >= row_end || header_.cols == 0) {
+    return;
+  }
+  static const std::size_t page_size =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+  const std::size_t begin =
+      data_offset_ + index_(row_begin, 0) * sizeof(double);
+  const std::size_t end =
+      data_offset_ +
+      index_(row_end - 1, header_.cols - 1) * sizeof(double) + sizeof(double);
+  // madvise requires a page aligned address
+  const std::size_t aligned_begin = (begin / page_size) * page_size;
+  ::madvise(static_cast<char *>(mapping_) + aligned_begin,
+            std::min(end, mapped_size_) - aligned_begin, MADV_WILLNEED);
+}
+
+template class DataPointTemplate<MemoryMappedArray *>;
+} // namespace panacea
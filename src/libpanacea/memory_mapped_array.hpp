@@ -0,0 +1,226 @@
+#ifndef PANACEA_PRIVATE_MEMORYMAPPEDARRAY_H
+#define PANACEA_PRIVATE_MEMORYMAPPEDARRAY_H
+#pragma once
+
+// Local private PANACEA includes
+#include "data_point_template.hpp"
+
+// Standard includes
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace panacea {
+
+/**
+ * Whether the host stores values little endian, the binary files are only
+ * written and read on such hosts.
+ **/
+bool littleEndianHost() noexcept;
+
+/**
+ * Store and load an integer as little endian bytes independent of the host.
+ **/
+template <class T> inline void putLittleEndian(char *buffer, T value) {
+  auto unsigned_value = static_cast<std::uint64_t>(value);
+  for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+    buffer[byte] = static_cast<char>((unsigned_value >> (8 * byte)) & 0xFF);
+  }
+}
+
+template <class T> inline T getLittleEndian(const char *buffer) {
+  std::uint64_t unsigned_value = 0;
+  for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+    unsigned_value |=
+        static_cast<std::uint64_t>(static_cast<unsigned char>(buffer[byte]))
+        << (8 * byte);
+  }
+  return static_cast<T>(unsigned_value);
+}
+
+/**
+ * Binary array file format
+ *
+ * The file begins with a fixed size header of header_size bytes followed
+ * directly by the array values. All fields are stored little endian.
+ *
+ * Bytes  0 - 7   magic "PANACEA" followed by a null character
+ * Bytes  8 - 11  format version (uint32)
+ * Bytes 12 - 15  data type of the values (uint32), see BinaryDataType
+ * Bytes 16 - 19  memory layout of the values (uint32), see MemoryLayout
+ * Bytes 20 - 23  arrangement (uint32), see Arrangement
+ * Bytes 24 - 31  rows (int64)
+ * Bytes 32 - 39  cols (int64)
+ * Bytes 40 - 63  reserved, zero
+ *
+ * Because the header has a fixed size the values can be opened directly by
+ * other tools e.g. with numpy.memmap and an offset of header_size.
+ **/
+enum class BinaryDataType : std::uint32_t { Float64 = 0 };
+
+struct BinaryArrayHeader {
+  static constexpr std::size_t header_size = 64;
+  static constexpr std::uint32_t version = 1;
+
+  BinaryDataType data_type = BinaryDataType::Float64;
+  MemoryLayout layout = MemoryLayout::RowMajor;
+  Arrangement arrangement = Arrangement::PointsAlongRowsDimensionsAlongCols;
+  std::int64_t rows = 0;
+  std::int64_t cols = 0;
+
+  /**
+   * Size in bytes of the values that follow the header.
+   **/
+  std::size_t dataBytes() const noexcept;
+
+  /**
+   * Fails if fewer than dataBytes() bytes follow the header, i.e. the
+   * current position, in the stream. Streams that cannot seek are not
+   * checked, reading the values then fails once they run out.
+   **/
+  void checkAvailable(std::istream &is) const;
+
+  void write(std::ostream &os) const;
+
+  /**
+   * The fields are validated, reading fails on unknown enumerators or
+   * dimensions that do not fit in an int or whose values do not fit in
+   * memory.
+   **/
+  static BinaryArrayHeader read(std::istream &is);
+  static BinaryArrayHeader read(const char *buffer, const std::size_t size);
+};
+
+/**
+ * Read only view of a binary array file that is memory mapped.
+ *
+ * The values are not loaded into memory when the file is opened, the
+ * operating system pages them in as they are accessed. The mapping is
+ * private so the values can be modified in memory without changing the
+ * file on disk. An array without any values is not mapped at all.
+ *
+ * The same view can be placed over a contiguous array owned by the caller,
+ * in which case nothing is mapped and the values are neither copied nor
+ * released.
+ **/
+class MemoryMappedArray {
+private:
+  BinaryArrayHeader header_;
+  std::size_t mapped_size_ = 0;
+  // Offset of the first value from the start of the mapping
+  std::size_t data_offset_ = BinaryArrayHeader::header_size;
+  void *mapping_ = nullptr;
+  double *data_ = nullptr;
+
+  inline std::size_t index_(const int row, const int col) const noexcept {
+    if (header_.layout == MemoryLayout::ColumnMajor) {
+      return static_cast<std::size_t>(col) * header_.rows + row;
+    }
+    return static_cast<std::size_t>(row) * header_.cols + col;
+  }
+
+public:
+  explicit MemoryMappedArray(const std::string &file_name);
+
+  /**
+   * Maps an array that is embedded in a larger file, offset is the position
+   * of the array header in the file and need not be page aligned.
+   **/
+  MemoryMappedArray(const std::string &file_name, const std::size_t offset);
+
+  /**
+   * View of rows * cols values owned by the caller stored in layout order,
+   * the values must outlive the view.
+   **/
+  MemoryMappedArray(double *data, const int rows, const int cols,
+                    const MemoryLayout layout, const Arrangement arrangement);
+  ~MemoryMappedArray();
+
+  MemoryMappedArray(const MemoryMappedArray &) = delete;
+  MemoryMappedArray &operator=(const MemoryMappedArray &) = delete;
+
+  inline double &at(const int row, const int col) {
+    assert(row >= 0 && row < header_.rows);
+    assert(col >= 0 && col < header_.cols);
+    return data_[index_(row, col)];
+  }
+
+  inline double at(const int row, const int col) const {
+    assert(row >= 0 && row < header_.rows);
+    assert(col >= 0 && col < header_.cols);
+    return data_[index_(row, col)];
+  }
+
+  /**
+   * Pointer to the first value, the values are contiguous in layout() order.
+   **/
+  double *data() noexcept { return data_; }
+  const double *data() const noexcept { return data_; }
+
+  int rows() const noexcept { return static_cast<int>(header_.rows); }
+  int cols() const noexcept { return static_cast<int>(header_.cols); }
+  MemoryLayout layout() const noexcept { return header_.layout; }
+  Arrangement arrangement() const noexcept { return header_.arrangement; }
+
+  /**
+   * Number of contiguous rows that fit in a block of about block_bytes.
+   *
+   * Used to stream through the rows in page friendly chunks.
+   **/
+  int rowsPerBlock(const std::size_t block_bytes) const noexcept;
+
+  /**
+   * Hint to the operating system that rows [row_begin, row_end) are about to
+   * be read so they can be paged in ahead of time.
+   **/
+  void willNeed(const int row_begin, const int row_end) const noexcept;
+};
+
+/*
+ * Specialization of the data point template in the case that a memory mapped
+ * array is used, the array knows its own memory layout
+ */
+template <>
+inline double &DataPointTemplate<MemoryMappedArray *>::
+operator()(const int point_ind, const int dim_ind) {
+  assert(point_ind >= 0 && point_ind < number_points_);
+  assert(dim_ind >= 0 && dim_ind < number_dimensions_);
+
+  if (arrangement_ == Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    return data_->at(point_ind, dim_ind);
+  }
+  return data_->at(dim_ind, point_ind);
+}
+
+template <>
+inline double DataPointTemplate<MemoryMappedArray *>::
+operator()(const int point_ind, const int dim_ind) const {
+  assert(point_ind >= 0 && point_ind < number_points_);
+  assert(dim_ind >= 0 && dim_ind < number_dimensions_);
+
+  if (arrangement_ == Arrangement::PointsAlongRowsDimensionsAlongCols) {
+    return data_->at(point_ind, dim_ind);
+  }
+  return data_->at(dim_ind, point_ind);
+}
+
+template <>
+inline double &DataPointTemplate<MemoryMappedArray *>::at(const int row,
+                                                          const int col) {
+  assert(row >= 0 && row < rows_);
+  assert(col >= 0 && col < cols_);
+  return data_->at(row, col);
+}
+
+template <>
+inline double DataPointTemplate<MemoryMappedArray *>::at(const int row,
+                                                         const int col) const {
+  assert(row >= 0 && row < rows_);
+  assert(col >= 0 && col < cols_);
+  return data_->at(row, col);
+}
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_MEMORYMAPPEDARRAY_H
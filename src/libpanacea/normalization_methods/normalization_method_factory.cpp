@@ -2,11 +2,9 @@
 #include "normalization_method_factory.hpp"
 
 #include "attributes/covariance.hpp"
+#include "descriptors/descriptor_statistics.hpp"
 #include "error.hpp"
-#include "mean.hpp"
-#include "median.hpp"
 #include "private_settings.hpp"
-#include "variance.hpp"
 
 // Local public PANACEA includes
 #include "panacea/base_descriptor_wrapper.hpp"
@@ -14,6 +12,7 @@
 
 // Standard includes
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <memory>
 #include <vector>
@@ -22,26 +21,6 @@ namespace panacea {
 
 namespace {
 
-static std::vector<int>
-findStackedDimensions(const BaseDescriptorWrapper &desc_wrapper) {
-
-  std::vector<int> stacked_dims;
-  for (int dim = 0; dim < desc_wrapper.getNumberDimensions(); ++dim) {
-    const double init_pt_val = desc_wrapper(0, dim);
-    double diff = 0.0;
-    for (int pt = 1; pt < desc_wrapper.getNumberPoints(); ++pt) {
-      diff += init_pt_val - desc_wrapper(pt, dim);
-    }
-    // if the diff in any of the dimensions is 0.0 it is problematic for
-    // counting the variance in that dimension, because all the points in that
-    // dimension are stacked on top of each other.
-    if (diff == 0.0) {
-      stacked_dims.push_back(dim);
-    }
-  }
-  return stacked_dims;
-}
-
 /**
  * It can be problematic to use data points that are stacked directly on top of
  * one another when using the variance as the normalization coefficients. This
@@ -87,10 +66,48 @@ static bool printDataQualityMessage2() {
   return true;
 }
 
+/**
+ * Square root of the sample variance of each dimension.
+ *
+ * Dimensions in which all the points are stacked on top of each other are
+ * assigned 1.0.
+ **/
+static std::vector<double>
+varianceCoefficients(const DescriptorStatistics &stats) {
+
+  // Check to make sure there is more than one point, if that's the case then
+  // there is no effective way of calculating the variance so we will assume
+  // it is one everywhere
+  if (stats.getNumberPoints() == 1) {
+    assert(printDataQualityMessage2());
+    return std::vector<double>(stats.getNumberDimensions(), 1.0);
+  }
+  const std::vector<int> stacked_dims = stats.getStackedDimensions();
+  if (stacked_dims.size() != 0) {
+    assert(printDataQualityMessage1());
+  }
+  std::vector<double> vec_variance;
+  vec_variance.reserve(stats.getNumberDimensions());
+  for (int dim = 0; dim < stats.getNumberDimensions(); ++dim) {
+    vec_variance.push_back(stats.getVariance(dim));
+  }
+  for (const auto &dim : stacked_dims) {
+    vec_variance.at(dim) = 1.0;
+  }
+  // Really we want to return the sqrt of the variance
+  for (auto &elem : vec_variance) {
+    elem = std::sqrt(elem);
+  }
+  return vec_variance;
+}
+
 /**
  * Note that using this with the covariance matrix assumes the covariance
  * matrix already up to date with the latest set of descriptor dimensions.
  *
+ * If statistics of the descriptors have already been gathered they can be
+ * passed in instead, otherwise the descriptors are read in a single pass.
+ *
  * The actual coefficients returned are not the variance but the sqrt of the
  * variance. The sqrt is required in order to appropriate calculate the
  * off diagonal normalization coefficients of the covariance matrix.
@@ -100,6 +117,7 @@ normalization_method_variance(const BaseDescriptorWrapper &desc_wrapper,
                               std::any extra_args) {
 
   if (extra_args.type() != typeid(settings::None) &&
+      extra_args.type() != typeid(const DescriptorStatistics *) &&
       extra_args.type() != typeid(Covariance *)) {
     std::string error_msg =
         "Unrecognized types encountered as extra arguments to ";
@@ -107,30 +125,18 @@ normalization_method_variance(const BaseDescriptorWrapper &desc_wrapper,
     PANACEA_FAIL(error_msg);
   }
 
-  // Check to make sure there is more than one row in the desc wrapper
-  // if that's the case then there is no effective way of calculating the
-  // variance so we will assume it is one everywhere
   if (extra_args.type() == typeid(settings::None)) {
-    std::vector<int> stacked_dims = findStackedDimensions(desc_wrapper);
-    if (stacked_dims.size() != 0) {
-      assert(printDataQualityMessage1());
-    }
-    if (desc_wrapper.rows() == 1) {
-      assert(printDataQualityMessage2());
-      return std::vector<double>(desc_wrapper.getNumberDimensions(), 1.0);
-    }
-    Variance variance(VarianceType::Sample);
-    auto vec_variance =
-        variance.calculate<const BaseDescriptorWrapper &>(desc_wrapper);
-    for (const auto &dim : stacked_dims) {
-      vec_variance.at(dim) = 1.0;
-    }
-
-    // Really we want to return the sqrt of the variance
-    for (auto &elem : vec_variance) {
-      elem = std::sqrt(elem);
-    }
-    return vec_variance;
+    return varianceCoefficients(
+        DescriptorStatistics(desc_wrapper, Moments::Diagonal));
+  }
+
+  if (extra_args.type() == typeid(const DescriptorStatistics *)) {
+    const DescriptorStatistics *stats =
+        std::any_cast<const DescriptorStatistics *>(extra_args);
+    assert(stats != nullptr);
+    assert(stats->getNumberDimensions() ==
+           desc_wrapper.getNumberDimensions());
+    return varianceCoefficients(*stats);
   }
 
   Covariance *cov = std::any_cast<Covariance *>(extra_args);
@@ -158,11 +164,17 @@ std::unordered_map<settings::KernelNormalization,
                    NormalizationMethodFactory::NormalizationMethod>
     NormalizationMethodFactory::normalization_methods_;
 
-NormalizationMethodFactory::NormalizationMethodFactory() {
+bool NormalizationMethodFactory::registerNormalizationMethods_() {
   registerNormalizationMethod<normalization_method_none,
                               settings::KernelNormalization::None>();
   registerNormalizationMethod<normalization_method_variance,
                               settings::KernelNormalization::Variance>();
+  return true;
+}
+
+NormalizationMethodFactory::NormalizationMethodFactory() {
+  [[maybe_unused]] static const bool registered =
+      registerNormalizationMethods_();
 }
 
 NormalizationMethodFactory::NormalizationMethod
@@ -173,6 +185,6 @@ NormalizationMethodFactory::create(
     std::string error_msg = "Normalization Method is not supported.";
     PANACEA_FAIL(error_msg);
   }
-  return normalization_methods_[norm_method];
+  return normalization_methods_.at(norm_method);
 }
 } // namespace panacea
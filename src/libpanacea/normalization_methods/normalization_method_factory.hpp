@@ -30,7 +30,13 @@ private:
   static std::unordered_map<settings::KernelNormalization, NormalizationMethod>
       normalization_methods_;
 
+  static bool registerNormalizationMethods_();
+
 public:
+  /**
+   * The built in normalization methods are registered by the first instance
+   * that is constructed, constructing further instances is free.
+   **/
   NormalizationMethodFactory();
 
   template <NormalizationMethod norm_method, settings::KernelNormalization opt>
@@ -5,10 +5,16 @@
 #include "panacea/entropy_term.hpp"
 
 // Local private PANACEA includes
+#include "descriptors/descriptor_summary.hpp"
 #include "descriptors/descriptor_wrapper.hpp"
+#include "descriptors/mapped_descriptor_wrapper.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
 #include "entropy/entropy_factory.hpp"
 #include "entropy/entropy_settings/entropy_settings.hpp"
 #include "error.hpp"
+#include "io/async_checkpoint_writer.hpp"
+#include "io/descriptor_stream_reader_txt.hpp"
+#include "io/file_checkpoint_log.hpp"
 #include "io/file_io_factory.hpp"
 
 // Standard includes
@@ -53,6 +59,20 @@ PANACEA::wrap(std::any data, const int rows, const int cols) const {
   return nullptr;
 }
 
+std::unique_ptr<BaseDescriptorWrapper>
+PANACEA::wrap(const std::string &binary_descriptor_file) const {
+  return std::make_unique<MappedDescriptorWrapper>(binary_descriptor_file);
+}
+
+std::unique_ptr<BaseDescriptorWrapper>
+PANACEA::wrapSparse(const int rows, const int cols,
+                    std::vector<int> row_offsets, std::vector<int> col_indices,
+                    std::vector<double> values) const {
+  return std::make_unique<SparseDescriptorWrapper>(
+      rows, cols, std::move(row_offsets), std::move(col_indices),
+      std::move(values));
+}
+
 std::unique_ptr<EntropyTerm>
 PANACEA::create(const BaseDescriptorWrapper &dwrapper,
                 const PANACEASettings &settings) const {
@@ -70,15 +90,54 @@ PANACEA::create(const PANACEASettings &settings) const {
   return entropy_factory.create(entropy_settings);
 }
 
+std::unique_ptr<EntropyTerm>
+PANACEA::create(const std::string &file_name,
+                const settings::RestartLoading restart_loading) const {
+  EntropyFactory entropy_factory;
+  return entropy_factory.create(file_name, restart_loading);
+}
+
 std::unique_ptr<io::FileIO>
 PANACEA::create(const settings::FileType type) const {
   io::FileIOFactory file_factory;
   return file_factory.create(type);
 }
-// 1. Determine file type by looking at extension
-// Each object should have it's own read and write methods that are registered
-// with the file type
-// 2. Search for entropy settings in the file
-// 3. Call creation methods with file handle
+
+std::unique_ptr<io::FileIO>
+PANACEA::create(const settings::FileType type,
+                const settings::DescriptorSidecar sidecar) const {
+  io::FileIOFactory file_factory;
+  return file_factory.create(type, sidecar);
+}
+
+std::unique_ptr<BaseDescriptorSummary>
+PANACEA::mergeSummaries(const std::vector<std::string> &summary_files) const {
+  return std::make_unique<DescriptorSummary>(
+      panacea::mergeSummaries(summary_files));
+}
+
+std::unique_ptr<io::CheckpointWriter>
+PANACEA::createCheckpointWriter(const settings::FileType type) const {
+  return std::make_unique<io::AsyncCheckpointWriter>(type);
+}
+
+std::unique_ptr<io::CheckpointLog>
+PANACEA::createCheckpointLog(const settings::FileType type,
+                             const std::string &file_name) const {
+  return std::make_unique<io::FileCheckpointLog>(type, file_name);
+}
+
+std::unique_ptr<io::DescriptorStreamReader>
+PANACEA::createDescriptorStreamReader(const settings::FileType type,
+                                      const std::string &file_name,
+                                      const int chunk_rows) const {
+  if (type != settings::FileType::TXTDescriptors) {
+    std::string error_msg = "Descriptor files can only be streamed from txt ";
+    error_msg += "descriptor files.";
+    PANACEA_FAIL(error_msg);
+  }
+  return std::make_unique<io::DescriptorStreamReaderTXT>(file_name,
+                                                         chunk_rows);
+}
 
 } // namespace panacea
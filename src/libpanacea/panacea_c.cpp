@@ -0,0 +1,455 @@
+// Public PANACEA includes
+#include "panacea/panacea_c.h"
+
+#include "panacea/base_descriptor_wrapper.hpp"
+#include "panacea/entropy_term.hpp"
+#include "panacea/panacea.hpp"
+#include "panacea/settings.hpp"
+
+// Local private PANACEA includes
+#include "descriptors/mapped_descriptor_wrapper.hpp"
+#include "error.hpp"
+#include "memory_mapped_array.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace panacea;
+
+/*
+ * The handles only hold the C++ objects, the C interface is a thin layer
+ * over the PANACEA class.
+ */
+struct panacea_descriptors {
+  std::unique_ptr<BaseDescriptorWrapper> wrapper;
+};
+
+struct panacea_settings {
+  PANACEASettingsBuilder builder = PANACEASettings::make();
+};
+
+struct panacea_entropy_term {
+  std::unique_ptr<EntropyTerm> term;
+  // Reused from one gradient to the next so the calls do not allocate
+  std::vector<double> grad;
+};
+
+/************************************************
+ * File scope functions
+ ************************************************/
+
+namespace {
+
+thread_local std::string last_error;
+
+/**
+ * Runs the call converting any exception into PANACEA_FAILURE, no exception
+ * may cross the C interface.
+ **/
+template <class Call> int guard(Call &&call) noexcept {
+  try {
+    call();
+    return PANACEA_SUCCESS;
+  } catch (const std::exception &e) {
+    last_error = e.what();
+  } catch (...) {
+    last_error = "Unknown error.";
+  }
+  return PANACEA_FAILURE;
+}
+
+template <class T> T &handle(T *ptr, const char *name) {
+  if (ptr == nullptr) {
+    std::string error_msg = "Null ";
+    error_msg += name;
+    error_msg += " handle passed to the PANACEA C interface.";
+    PANACEA_FAIL(error_msg);
+  }
+  return *ptr;
+}
+
+template <class T> void output(T *ptr, const char *name) {
+  if (ptr == nullptr) {
+    std::string error_msg = "Null ";
+    error_msg += name;
+    error_msg += " output passed to the PANACEA C interface.";
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+/**
+ * C enumerations can hold any int, every value is checked explicitly rather
+ * than cast to the C++ enumeration
+ **/
+void unknownValue(const char *name, const int value) {
+  std::string error_msg = "Unknown ";
+  error_msg += name;
+  error_msg += " passed to the PANACEA C interface: ";
+  error_msg += std::to_string(value);
+  PANACEA_FAIL(error_msg);
+}
+
+settings::EntropyType toEntropyType(const panacea_entropy_type type) {
+  switch (type) {
+  case PANACEA_SELF:
+    return settings::EntropyType::Self;
+  case PANACEA_CROSS:
+    return settings::EntropyType::Cross;
+  default:
+    unknownValue("entropy type", type);
+  }
+  return settings::EntropyType::Self;
+}
+
+settings::PANACEAAlgorithm toAlgorithm(const panacea_algorithm algorithm) {
+  switch (algorithm) {
+  case PANACEA_STRICT:
+    return settings::PANACEAAlgorithm::Strict;
+  case PANACEA_FLEXIBLE:
+    return settings::PANACEAAlgorithm::Flexible;
+  default:
+    unknownValue("algorithm", algorithm);
+  }
+  return settings::PANACEAAlgorithm::Flexible;
+}
+
+settings::KernelPrimitive
+toKernelPrimitive(const panacea_kernel_primitive primitive) {
+  switch (primitive) {
+  case PANACEA_GAUSSIAN:
+    return settings::KernelPrimitive::Gaussian;
+  case PANACEA_GAUSSIAN_LOG:
+    return settings::KernelPrimitive::GaussianLog;
+  case PANACEA_EXPONENTIAL:
+    return settings::KernelPrimitive::Exponential;
+  default:
+    unknownValue("kernel primitive", primitive);
+  }
+  return settings::KernelPrimitive::Gaussian;
+}
+
+settings::KernelCount toKernelCount(const panacea_kernel_count count) {
+  switch (count) {
+  case PANACEA_SINGLE:
+    return settings::KernelCount::Single;
+  case PANACEA_ONE_TO_ONE:
+    return settings::KernelCount::OneToOne;
+  case PANACEA_FIXED:
+    return settings::KernelCount::Fixed;
+  default:
+    unknownValue("kernel count", count);
+  }
+  return settings::KernelCount::OneToOne;
+}
+
+settings::KernelCorrelation
+toKernelCorrelation(const panacea_kernel_correlation correlation) {
+  switch (correlation) {
+  case PANACEA_CORRELATED:
+    return settings::KernelCorrelation::Correlated;
+  case PANACEA_UNCORRELATED:
+    return settings::KernelCorrelation::Uncorrelated;
+  default:
+    unknownValue("kernel correlation", correlation);
+  }
+  return settings::KernelCorrelation::Uncorrelated;
+}
+
+settings::KernelCenterCalculation
+toKernelCenter(const panacea_kernel_center center) {
+  switch (center) {
+  case PANACEA_CENTER_NONE:
+    return settings::KernelCenterCalculation::None;
+  case PANACEA_CENTER_MEAN:
+    return settings::KernelCenterCalculation::Mean;
+  case PANACEA_CENTER_MEDIAN:
+    return settings::KernelCenterCalculation::Median;
+  case PANACEA_CENTER_STREAMING_MEDIAN:
+    return settings::KernelCenterCalculation::StreamingMedian;
+  default:
+    unknownValue("kernel center", center);
+  }
+  return settings::KernelCenterCalculation::None;
+}
+
+settings::KernelNormalization
+toKernelNormalization(const panacea_kernel_normalization normalization) {
+  switch (normalization) {
+  case PANACEA_NORMALIZATION_NONE:
+    return settings::KernelNormalization::None;
+  case PANACEA_NORMALIZATION_VARIANCE:
+    return settings::KernelNormalization::Variance;
+  default:
+    unknownValue("kernel normalization", normalization);
+  }
+  return settings::KernelNormalization::None;
+}
+
+settings::RestartLoading
+toRestartLoading(const panacea_restart_loading loading) {
+  switch (loading) {
+  case PANACEA_EAGER:
+    return settings::RestartLoading::Eager;
+  case PANACEA_LAZY:
+    return settings::RestartLoading::Lazy;
+  default:
+    unknownValue("restart loading", loading);
+  }
+  return settings::RestartLoading::Eager;
+}
+
+settings::FileType toFileType(const panacea_restart_type type) {
+  switch (type) {
+  case PANACEA_TXT_RESTART:
+    return settings::FileType::TXTRestart;
+  case PANACEA_BINARY_RESTART:
+    return settings::FileType::BinaryRestart;
+  default:
+    unknownValue("restart file type", type);
+  }
+  return settings::FileType::TXTRestart;
+}
+
+} // namespace
+
+/************************************************
+ * C interface
+ ************************************************/
+
+extern "C" {
+
+const char *panacea_last_error(void) { return last_error.c_str(); }
+
+int panacea_descriptors_wrap(double *data, int number_points,
+                             int number_dimensions, panacea_layout layout,
+                             panacea_descriptors **descriptors) {
+  return guard([&]() {
+    output(descriptors, "descriptors");
+    if (layout != PANACEA_POINT_MAJOR && layout != PANACEA_DIMENSION_MAJOR) {
+      PANACEA_FAIL("Unknown descriptor layout.");
+    }
+    // The points are always along the rows, the layout decides whether the
+    // dimensions of a point or the points of a dimension are contiguous
+    const MemoryLayout memory_layout = layout == PANACEA_POINT_MAJOR
+                                           ? MemoryLayout::RowMajor
+                                           : MemoryLayout::ColumnMajor;
+    auto view = std::make_unique<MemoryMappedArray>(
+        data, number_points, number_dimensions, memory_layout,
+        Arrangement::PointsAlongRowsDimensionsAlongCols);
+    auto wrapped = std::make_unique<panacea_descriptors>();
+    wrapped->wrapper =
+        std::make_unique<MappedDescriptorWrapper>(std::move(view));
+    *descriptors = wrapped.release();
+  });
+}
+
+void panacea_descriptors_destroy(panacea_descriptors *descriptors) {
+  delete descriptors;
+}
+
+int panacea_descriptors_write(const panacea_descriptors *descriptors,
+                              const char *file_name) {
+  return guard([&]() {
+    handle(file_name, "file name");
+    // The file io is registered for non const wrappers, writing does not
+    // modify them
+    BaseDescriptorWrapper *wrapper =
+        handle(descriptors, "descriptors").wrapper.get();
+    PANACEA panacea_pi;
+    auto descriptor_file =
+        panacea_pi.create(settings::FileType::BinaryDescriptors);
+    descriptor_file->write(wrapper, std::string(file_name));
+  });
+}
+
+int panacea_settings_create(panacea_entropy_type type,
+                            panacea_settings **settings) {
+  return guard([&]() {
+    output(settings, "settings");
+    auto created = std::make_unique<panacea_settings>();
+    created->builder.set(toEntropyType(type))
+        .set(settings::PANACEAAlgorithm::Flexible)
+        .distributionType(settings::kernel)
+        .set(settings::KernelPrimitive::Gaussian)
+        .set(settings::KernelCount::OneToOne)
+        .set(settings::KernelCorrelation::Uncorrelated)
+        .set(settings::KernelCenterCalculation::None)
+        .set(settings::KernelNormalization::None);
+    *settings = created.release();
+  });
+}
+
+void panacea_settings_destroy(panacea_settings *settings) { delete settings; }
+
+int panacea_settings_set_algorithm(panacea_settings *settings,
+                                   panacea_algorithm algorithm) {
+  return guard([&]() {
+    handle(settings, "settings").builder.set(toAlgorithm(algorithm));
+  });
+}
+
+int panacea_settings_set_kernel_primitive(panacea_settings *settings,
+                                          panacea_kernel_primitive primitive) {
+  return guard([&]() {
+    handle(settings, "settings").builder.set(toKernelPrimitive(primitive));
+  });
+}
+
+int panacea_settings_set_kernel_count(panacea_settings *settings,
+                                      panacea_kernel_count count) {
+  return guard([&]() {
+    handle(settings, "settings").builder.set(toKernelCount(count));
+  });
+}
+
+int panacea_settings_set_kernel_correlation(
+    panacea_settings *settings, panacea_kernel_correlation correlation) {
+  return guard([&]() {
+    handle(settings, "settings").builder.set(toKernelCorrelation(correlation));
+  });
+}
+
+int panacea_settings_set_kernel_center(panacea_settings *settings,
+                                       panacea_kernel_center center) {
+  return guard([&]() {
+    handle(settings, "settings").builder.set(toKernelCenter(center));
+  });
+}
+
+int panacea_settings_set_kernel_normalization(
+    panacea_settings *settings, panacea_kernel_normalization normalization) {
+  return guard([&]() {
+    handle(settings, "settings")
+        .builder.set(toKernelNormalization(normalization));
+  });
+}
+
+int panacea_settings_set_weight(panacea_settings *settings, double weight) {
+  return guard([&]() {
+    handle(settings, "settings").builder.weightEntropyTermBy(weight);
+  });
+}
+
+int panacea_settings_set_numerical_grad(panacea_settings *settings, int on) {
+  return guard([&]() {
+    handle(settings, "settings").builder.setNumericalGradTo(on != 0);
+  });
+}
+
+int panacea_entropy_term_create(const panacea_descriptors *descriptors,
+                                const panacea_settings *settings,
+                                panacea_entropy_term **entropy_term) {
+  return guard([&]() {
+    output(entropy_term, "entropy term");
+    const auto &wrapper = *handle(descriptors, "descriptors").wrapper;
+    // The builder hands its settings over, a copy keeps the handle reusable
+    PANACEASettingsBuilder builder = handle(settings, "settings").builder;
+    const PANACEASettings panacea_settings = builder;
+    PANACEA panacea_pi;
+    auto created = std::make_unique<panacea_entropy_term>();
+    created->term = panacea_pi.create(wrapper, panacea_settings);
+    *entropy_term = created.release();
+  });
+}
+
+int panacea_entropy_term_create_from_restart(
+    const char *file_name, panacea_restart_loading loading,
+    panacea_entropy_term **entropy_term) {
+  return guard([&]() {
+    output(entropy_term, "entropy term");
+    handle(file_name, "file name");
+    PANACEA panacea_pi;
+    auto created = std::make_unique<panacea_entropy_term>();
+    created->term = panacea_pi.create(file_name, toRestartLoading(loading));
+    *entropy_term = created.release();
+  });
+}
+
+void panacea_entropy_term_destroy(panacea_entropy_term *entropy_term) {
+  delete entropy_term;
+}
+
+int panacea_entropy_term_dimensions(const panacea_entropy_term *entropy_term,
+                                    int *number_dimensions) {
+  return guard([&]() {
+    output(number_dimensions, "number of dimensions");
+    *number_dimensions = handle(entropy_term, "entropy term")
+                             .term->getMaximumNumberOfDimensions();
+  });
+}
+
+int panacea_entropy_term_update(panacea_entropy_term *entropy_term,
+                                const panacea_descriptors *descriptors) {
+  return guard([&]() {
+    handle(entropy_term, "entropy term")
+        .term->update(*handle(descriptors, "descriptors").wrapper);
+  });
+}
+
+int panacea_entropy_term_compute(panacea_entropy_term *entropy_term,
+                                 const panacea_descriptors *descriptors,
+                                 double *entropy) {
+  return guard([&]() {
+    output(entropy, "entropy");
+    *entropy = handle(entropy_term, "entropy term")
+                   .term->compute(*handle(descriptors, "descriptors").wrapper);
+  });
+}
+
+int panacea_entropy_term_compute_point(panacea_entropy_term *entropy_term,
+                                       const panacea_descriptors *descriptors,
+                                       int point, double *entropy) {
+  return guard([&]() {
+    output(entropy, "entropy");
+    const auto &wrapper = *handle(descriptors, "descriptors").wrapper;
+    if (point < 0 || point >= wrapper.getNumberPoints()) {
+      std::string error_msg = "Descriptor point out of range: ";
+      error_msg += std::to_string(point);
+      PANACEA_FAIL(error_msg);
+    }
+    *entropy =
+        handle(entropy_term, "entropy term").term->compute(wrapper, point);
+  });
+}
+
+int panacea_entropy_term_compute_grad(panacea_entropy_term *entropy_term,
+                                      const panacea_descriptors *descriptors,
+                                      int point, double *grad, int grad_size) {
+  return guard([&]() {
+    output(grad, "gradient");
+    auto &term = handle(entropy_term, "entropy term");
+    const auto &wrapper = *handle(descriptors, "descriptors").wrapper;
+    if (point < 0 || point >= wrapper.getNumberPoints()) {
+      std::string error_msg = "Descriptor point out of range: ";
+      error_msg += std::to_string(point);
+      PANACEA_FAIL(error_msg);
+    }
+    if (grad_size < wrapper.getNumberDimensions()) {
+      std::string error_msg = "Gradient buffer holds ";
+      error_msg += std::to_string(grad_size) + " values but ";
+      error_msg += std::to_string(wrapper.getNumberDimensions());
+      error_msg += " are required.";
+      PANACEA_FAIL(error_msg);
+    }
+    term.term->compute_grad(wrapper, point, term.grad);
+    std::copy(term.grad.begin(), term.grad.end(), grad);
+  });
+}
+
+int panacea_entropy_term_write_restart(
+    const panacea_entropy_term *entropy_term, panacea_restart_type type,
+    const char *file_name) {
+  return guard([&]() {
+    handle(file_name, "file name");
+    auto &term = handle(entropy_term, "entropy term");
+    PANACEA panacea_pi;
+    auto restart_file = panacea_pi.create(toFileType(type));
+    restart_file->write(term.term.get(), std::string(file_name));
+  });
+}
+
+} // extern "C"
@@ -13,6 +13,7 @@
 #include "primitive_attributes.hpp"
 #include "private_settings.hpp"
 #include "vector/vector.hpp"
+#include "workspace.hpp"
 
 // Standard includes
 #include <cmath>
@@ -22,21 +23,17 @@
 
 namespace panacea {
 
-void GaussCorrelated::update(PrimitiveAttributes &&attributes) {
-  assert(attributes.kernel_wrapper != nullptr);
+void GaussCorrelated::update(
+    std::shared_ptr<const PrimitiveAttributes> attributes) {
+  assert(attributes != nullptr);
+  assert(attributes->kernel_wrapper != nullptr);
   attributes_ = std::move(attributes);
-  double determinant = attributes_.reduced_covariance->getDeterminant();
+  double determinant = attributes_->reduced_covariance->getDeterminant();
   if (determinant <= 0.0) {
     std::string error_msg =
         "Determinant is less than 0 value: " + std::to_string(determinant);
     PANACEA_FAIL(error_msg);
   }
-  pre_factor_ =
-      1.0 /
-      (std::pow(determinant, 0.5) *
-       std::pow(constants::PI_SQRT * constants::SQRT_2,
-                static_cast<double>(
-                    attributes_.reduced_covariance->getNumberDimensions())));
 }
 
 const settings::KernelPrimitive GaussCorrelated::type() const noexcept {
@@ -55,112 +52,106 @@ GaussCorrelated::compute(const BaseDescriptorWrapper &descriptor_wrapper,
 
   assert(descriptor_ind > -1);
   assert(descriptor_ind < descriptor_wrapper.getNumberPoints());
-  assert(attributes_.kernel_wrapper != nullptr);
+  assert(attributes_->kernel_wrapper != nullptr);
   assert(kernel_index_ > -1);
-  assert(kernel_index_ < attributes_.kernel_wrapper->rows());
-  assert(attributes_.reduced_inv_covariance != nullptr);
-  assert(attributes_.reduced_inv_covariance->getNumberDimensions() > 0);
+  assert(kernel_index_ < attributes_->kernel_wrapper->rows());
+  assert(attributes_->reduced_inv_covariance != nullptr);
+  assert(attributes_->reduced_inv_covariance->getNumberDimensions() > 0);
   assert(
-      attributes_.reduced_inv_covariance->is(NormalizationState::Normalized));
-  assert(attributes_.normalizer != nullptr && "Normalizer is a nullptr");
+      attributes_->reduced_inv_covariance->is(NormalizationState::Normalized));
+  assert(attributes_->normalizer != nullptr && "Normalizer is a nullptr");
 
   if (prim_settings == settings::EquationSetting::IgnoreExpAndPrefactor) {
     return 1.0;
   }
 
   auto &descs = (descriptor_wrapper);
-  auto &kerns = *(attributes_.kernel_wrapper);
-  const std::vector<double> &norm_coeffs =
-      attributes_.normalizer->getNormalizationCoeffs();
-  auto &red_inv_cov = *(attributes_.reduced_inv_covariance);
+  const auto &kerns = *(attributes_->kernel_wrapper);
+  const std::vector<double> &inv_coeffs =
+      attributes_->normalizer->getInverseNormalizationCoeffs();
+  auto &red_inv_cov = *(attributes_->reduced_inv_covariance);
   const auto &chosen_dims = red_inv_cov.getChosenDimensionIndices();
 
-  std::vector<double> diff;
   const int red_ndim =
-      attributes_.reduced_inv_covariance->getNumberDimensions();
-  diff.reserve(red_ndim);
+      attributes_->reduced_inv_covariance->getNumberDimensions();
+  std::vector<double> &diff =
+      Workspace::local().vector(Workspace::Slot::Difference, red_ndim);
   int index = 0;
   for (const int dim : chosen_dims) {
-    diff.push_back((descs(descriptor_ind, dim) - kerns.at(kernel_index_, dim)) /
-                   norm_coeffs.at(dim));
+    diff[index] = (descs(descriptor_ind, dim) - kerns.at(kernel_index_, dim)) *
+                  inv_coeffs[dim];
+    ++index;
   }
 
-  std::vector<double> MxV;
-  MxV.reserve(red_ndim);
+  double VxMxV = 0.0;
   for (int j = 0; j < red_ndim; ++j) {
-    double val = 0.0;
+    double MxV = 0.0;
     for (int k = 0; k < red_ndim; ++k) {
-      val += red_inv_cov(j, k) * diff.at(k);
+      MxV += red_inv_cov(j, k) * diff[k];
     }
-    MxV.push_back(val);
-  }
-
-  double VxMxV = 0.0;
-  for (int i = 0; i < red_ndim; ++i) {
-    VxMxV += diff.at(i) * MxV.at(i);
+    VxMxV += diff[j] * MxV;
   }
-  double result = pre_factor_ * std::exp(-0.5 * VxMxV);
+  double result = getPreFactor() * std::exp(-0.5 * VxMxV);
   if (result == 0.0) {
     return std::numeric_limits<double>::min();
   }
   return result;
 }
 
-std::vector<double>
-GaussCorrelated::compute_grad(const BaseDescriptorWrapper &descriptors,
-                              const int descriptor_ind,
-                              const settings::EquationSetting &prim_settings,
-                              const settings::GradSetting &grad_setting) const {
+void GaussCorrelated::accumulate_grad(
+    const BaseDescriptorWrapper &descriptors, const int descriptor_ind,
+    const settings::EquationSetting &prim_settings,
+    const settings::GradSetting &grad_setting, const double scale,
+    std::vector<double> &grad) const {
 
   assert(descriptor_ind > -1);
   assert(descriptor_ind < descriptors.getNumberPoints());
-  assert(attributes_.kernel_wrapper != nullptr);
+  assert(attributes_->kernel_wrapper != nullptr);
   assert(kernel_index_ > -1);
-  assert(kernel_index_ < attributes_.kernel_wrapper->rows());
-  assert(attributes_.reduced_inv_covariance != nullptr);
-  assert(attributes_.reduced_inv_covariance->getNumberDimensions() > 0);
+  assert(kernel_index_ < attributes_->kernel_wrapper->rows());
+  assert(attributes_->reduced_inv_covariance != nullptr);
+  assert(attributes_->reduced_inv_covariance->getNumberDimensions() > 0);
   assert(
-      attributes_.reduced_inv_covariance->is(NormalizationState::Normalized));
-  assert(attributes_.normalizer != nullptr && "Normalizer is a nullptr");
+      attributes_->reduced_inv_covariance->is(NormalizationState::Normalized));
+  assert(attributes_->normalizer != nullptr && "Normalizer is a nullptr");
+  assert(grad.size() ==
+         static_cast<std::size_t>(descriptors.getNumberDimensions()));
 
   auto &descs = (descriptors);
-  const auto &norm_coeffs = attributes_.normalizer->getNormalizationCoeffs();
-  auto &kerns = *(attributes_.kernel_wrapper);
-  const int ndim = descs.getNumberDimensions();
-  auto &red_inv_cov = *(attributes_.reduced_inv_covariance);
+  const auto &inv_coeffs =
+      attributes_->normalizer->getInverseNormalizationCoeffs();
+  const auto &kerns = *(attributes_->kernel_wrapper);
+  auto &red_inv_cov = *(attributes_->reduced_inv_covariance);
   const auto &chosen_dims = red_inv_cov.getChosenDimensionIndices();
 
-  const double exp_term = compute(descriptors, descriptor_ind, prim_settings);
+  double factor = scale * compute(descriptors, descriptor_ind, prim_settings);
+  if (grad_setting == settings::GradSetting::WRTDescriptor) {
+    factor *= -1.0;
+  }
 
-  std::vector diff(ndim, 0.0);
+  // Borrowed after calling compute which uses the same slot
+  const int red_ndim = red_inv_cov.getNumberDimensions();
+  std::vector<double> &diff =
+      Workspace::local().vector(Workspace::Slot::Difference, red_ndim);
+  int index = 0;
   for (const int dim : chosen_dims) {
     // ( a_i * (d_x_i - d_mu_i) )
-    diff.at(dim) =
-        ((descs(descriptor_ind, dim) - kerns.at(kernel_index_, dim))) /
-        norm_coeffs.at(dim);
+    diff[index] = (descs(descriptor_ind, dim) - kerns.at(kernel_index_, dim)) *
+                  inv_coeffs[dim];
+    ++index;
   }
 
-  std::vector<double> grad(ndim, 0.0);
-
   int index1 = 0;
   for (const int dim : chosen_dims) {
-    int index2 = 0;
-    for (const int dim2 : chosen_dims) {
-      grad.at(dim) += diff.at(dim2) * red_inv_cov(index1, index2);
-      ++index2;
+    double grad_dim = 0.0;
+    for (int index2 = 0; index2 < red_ndim; ++index2) {
+      grad_dim += diff[index2] * red_inv_cov(index1, index2);
     }
 
     // It is appropriate to have a gradiant of 0.0 e.g. at the peak of a kernel
-    grad.at(dim) *= exp_term * 1.0 / norm_coeffs.at(dim);
+    grad[dim] += grad_dim * factor * inv_coeffs[dim];
     ++index1;
   }
-
-  if (grad_setting == settings::GradSetting::WRTDescriptor) {
-    for (const int &dim : chosen_dims) {
-      grad.at(dim) *= -1.0;
-    }
-  }
-  return grad;
 }
 
 } // namespace panacea
@@ -13,6 +13,7 @@
 #include "primitive_attributes.hpp"
 #include "private_settings.hpp"
 #include "vector/vector.hpp"
+#include "workspace.hpp"
 
 // Standard includes
 #include <cmath>
@@ -22,24 +23,20 @@
 
 namespace panacea {
 
-void GaussLogCorrelated::update(PrimitiveAttributes &&attributes) {
-  assert(attributes.kernel_wrapper != nullptr);
+void GaussLogCorrelated::update(
+    std::shared_ptr<const PrimitiveAttributes> attributes) {
+  assert(attributes != nullptr);
+  assert(attributes->kernel_wrapper != nullptr);
   std::cout << "WARNING Multivariate Log normal distribution/Gaussian Log "
                "primitive has not yet been vetted."
             << std::endl;
   attributes_ = std::move(attributes);
-  double determinant = attributes_.reduced_covariance->getDeterminant();
+  double determinant = attributes_->reduced_covariance->getDeterminant();
   if (determinant <= 0.0) {
     std::string error_msg =
         "Determinant is less than 0 value: " + std::to_string(determinant);
     PANACEA_FAIL(error_msg);
   }
-  pre_factor_ =
-      1.0 /
-      (std::pow(determinant, 0.5) *
-       std::pow(constants::PI_SQRT * constants::SQRT_2,
-                static_cast<double>(
-                    attributes_.reduced_covariance->getNumberDimensions())));
 }
 
 const settings::KernelPrimitive GaussLogCorrelated::type() const noexcept {
@@ -57,68 +54,64 @@ double GaussLogCorrelated::compute(
 
   assert(descriptor_ind > -1);
   assert(descriptor_ind < descriptor_wrapper.getNumberPoints());
-  assert(attributes_.kernel_wrapper != nullptr);
+  assert(attributes_->kernel_wrapper != nullptr);
   assert(kernel_index_ > -1);
-  assert(kernel_index_ < attributes_.kernel_wrapper->rows());
-  assert(attributes_.reduced_inv_covariance != nullptr);
-  assert(attributes_.reduced_inv_covariance->getNumberDimensions() > 0);
+  assert(kernel_index_ < attributes_->kernel_wrapper->rows());
+  assert(attributes_->reduced_inv_covariance != nullptr);
+  assert(attributes_->reduced_inv_covariance->getNumberDimensions() > 0);
   assert(
-      attributes_.reduced_inv_covariance->is(NormalizationState::Normalized));
+      attributes_->reduced_inv_covariance->is(NormalizationState::Normalized));
   std::cout << "WARNING Multivariate Log normal distribution/Gaussian Log "
                "primitive has not yet been vetted."
             << std::endl;
 
   auto &descs = (descriptor_wrapper);
-  auto &kerns = *(attributes_.kernel_wrapper);
+  const auto &kerns = *(attributes_->kernel_wrapper);
   // const auto & norm_coeffs = attributes_.normalizer.getNormalizationCoeffs();
-  auto &red_inv_cov = *(attributes_.reduced_inv_covariance);
+  auto &red_inv_cov = *(attributes_->reduced_inv_covariance);
   const auto &chosen_dims = red_inv_cov.getChosenDimensionIndices();
 
-  std::vector<double> diff;
   const int red_ndim =
-      attributes_.reduced_inv_covariance->getNumberDimensions();
-  diff.reserve(red_ndim);
+      attributes_->reduced_inv_covariance->getNumberDimensions();
+  std::vector<double> &diff =
+      Workspace::local().vector(Workspace::Slot::Difference, red_ndim);
   int index = 0;
   for (const int dim : chosen_dims) {
-    diff.push_back(std::log(descs(descriptor_ind, dim)) -
-                   std::log(kerns.at(kernel_index_, dim)));
+    diff[index] = std::log(descs(descriptor_ind, dim)) -
+                  std::log(kerns.at(kernel_index_, dim));
+    ++index;
   }
 
-  std::vector<double> MxV;
-  MxV.reserve(red_ndim);
+  std::vector<double> &MxV =
+      Workspace::local().vector(Workspace::Slot::Product, red_ndim);
   for (int j = 0; j < red_ndim; ++j) {
     double val = 0.0;
     for (int k = 0; k < red_ndim; ++k) {
       val += red_inv_cov(j, k) * diff.at(k);
     }
-    MxV.push_back(val);
+    MxV[j] = val;
   }
 
   double VxMxV = 0.0;
   for (int i = 0; i < red_ndim; ++i) {
     VxMxV += diff.at(i) * MxV.at(i);
   }
-  double result = pre_factor_ * std::exp(-0.5 * VxMxV);
+  double result = getPreFactor() * std::exp(-0.5 * VxMxV);
   if (result == 0.0) {
     return std::numeric_limits<double>::min();
   }
   return result;
 }
 
-std::vector<double> GaussLogCorrelated::compute_grad(
+void GaussLogCorrelated::accumulate_grad(
     const BaseDescriptorWrapper &descriptors, const int descriptor_ind,
     const settings::EquationSetting &prim_settings,
-    const settings::GradSetting &grad_setting) const {
+    const settings::GradSetting &grad_setting, const double scale,
+    std::vector<double> &grad) const {
 
   throw std::runtime_error(
       "Analytical gradiant method for Multivariate Log normal "
       "distribution/GaussLog has not yet been implemented.");
-
-  auto &descs = (descriptors);
-  const int ndim = descs.getNumberDimensions();
-
-  std::vector<double> grad(ndim, 0.0);
-  return grad;
 }
 
 } // namespace panacea
@@ -9,6 +9,7 @@
 #include "attributes/reduced_covariance.hpp"
 #include "attributes/reduced_inv_covariance.hpp"
 #include "constants.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
 #include "error.hpp"
 #include "kernels/kernel_wrapper.hpp"
 #include "primitive_attributes.hpp"
@@ -22,22 +23,18 @@
 
 namespace panacea {
 
-void GaussUncorrelated::update(PrimitiveAttributes &&attributes) {
-  assert(attributes.normalizer->getNormalizationCoeffs().size() > 0);
-  assert(attributes.kernel_wrapper != nullptr);
+void GaussUncorrelated::update(
+    std::shared_ptr<const PrimitiveAttributes> attributes) {
+  assert(attributes != nullptr);
+  assert(attributes->normalizer->getInverseNormalizationCoeffs().size() > 0);
+  assert(attributes->kernel_wrapper != nullptr);
   attributes_ = std::move(attributes);
-  double determinant = attributes_.reduced_covariance->getDeterminant();
+  double determinant = attributes_->reduced_covariance->getDeterminant();
   if (determinant <= 0.0) {
     std::string error_msg =
         "Determinant is less than 0 value: " + std::to_string(determinant);
     PANACEA_FAIL(error_msg);
   }
-  pre_factor_ =
-      1.0 /
-      (std::pow(determinant, 0.5) *
-       std::pow(constants::PI_SQRT * constants::SQRT_2,
-                static_cast<double>(
-                    attributes_.reduced_covariance->getNumberDimensions())));
 }
 
 const settings::KernelPrimitive GaussUncorrelated::type() const noexcept {
@@ -55,82 +52,110 @@ double GaussUncorrelated::compute(
 
   assert(descriptor_ind > -1);
   assert(descriptor_ind < descriptor_wrapper.getNumberPoints());
-  assert(attributes_.kernel_wrapper != nullptr);
+  assert(attributes_->kernel_wrapper != nullptr);
   assert(kernel_index_ > -1);
-  assert(kernel_index_ < attributes_.kernel_wrapper->rows());
-  assert(attributes_.reduced_inv_covariance != nullptr);
-  assert(attributes_.reduced_inv_covariance->getNumberDimensions() > 0);
-  assert(attributes_.normalizer != nullptr && "Normalizer is a nullptr");
+  assert(kernel_index_ < attributes_->kernel_wrapper->rows());
+  assert(attributes_->reduced_inv_covariance != nullptr);
+  assert(attributes_->reduced_inv_covariance->getNumberDimensions() > 0);
+  assert(attributes_->normalizer != nullptr && "Normalizer is a nullptr");
 
   if (prim_settings == settings::EquationSetting::IgnoreExpAndPrefactor) {
     return 1.0;
   }
-  const std::vector<double> norm_coeffs =
-      attributes_.normalizer->getNormalizationCoeffs();
+  const std::vector<double> &inv_coeffs =
+      attributes_->normalizer->getInverseNormalizationCoeffs();
   const int num_dims =
-      attributes_.reduced_inv_covariance->getNumberDimensions();
-  assert(norm_coeffs.size() >= num_dims);
+      attributes_->reduced_inv_covariance->getNumberDimensions();
+  assert(inv_coeffs.size() >= static_cast<std::size_t>(num_dims));
+  const auto &kerns = *(attributes_->kernel_wrapper);
 
   double exponent = 0.0;
+  const CompressedSparseRows *csr = sparseData(descriptor_wrapper);
+  if (csr != nullptr && static_cast<std::size_t>(kernel_index_) <
+                            attributes_->origin_exponents.size()) {
+    // Start from the exponent of a point at the origin and correct it for
+    // the non zero values, with x the descriptor and k the kernel value
+    // (x - k)^2 = k^2 + x * (x - 2k)
+    const auto &red_inv_cov = *(attributes_->reduced_inv_covariance);
+    exponent = attributes_->origin_exponents[kernel_index_];
+    for (int ind = csr->row_offsets[descriptor_ind];
+         ind < csr->row_offsets[descriptor_ind + 1]; ++ind) {
+      const int dim = csr->col_indices[ind];
+      const int red_index = red_inv_cov.getReducedIndex(dim);
+      if (red_index < 0) {
+        continue;
+      }
+      const double desc_val = csr->values[ind];
+      const double kernel_val = kerns.at(kernel_index_, dim);
+      exponent += desc_val * (desc_val - 2.0 * kernel_val) *
+                  (inv_coeffs[dim] * inv_coeffs[dim]) *
+                  red_inv_cov(red_index, red_index);
+    }
+    exponent *= -0.5;
+    double result = getPreFactor() * std::exp(exponent);
+    if (result == 0.0) {
+      return std::numeric_limits<double>::min();
+    }
+    return result;
+  }
+
   int index = 0;
   for (const int dim :
-       attributes_.reduced_inv_covariance->getChosenDimensionIndices()) {
+       attributes_->reduced_inv_covariance->getChosenDimensionIndices()) {
 
     double diff = (descriptor_wrapper(descriptor_ind, dim) -
-                   attributes_.kernel_wrapper->at(kernel_index_, dim)) /
-                  norm_coeffs.at(dim);
+                   kerns.at(kernel_index_, dim)) *
+                  inv_coeffs[dim];
     exponent += diff * diff *
-                attributes_.reduced_inv_covariance->operator()(index, index);
+                attributes_->reduced_inv_covariance->operator()(index, index);
     ++index;
   }
   exponent *= -0.5;
 
-  double result = pre_factor_ * std::exp(exponent);
+  double result = getPreFactor() * std::exp(exponent);
   if (result == 0.0) {
     return std::numeric_limits<double>::min();
   }
   return result;
 }
 
-std::vector<double> GaussUncorrelated::compute_grad(
+void GaussUncorrelated::accumulate_grad(
     const BaseDescriptorWrapper &descriptors, const int descriptor_ind,
     const settings::EquationSetting &prim_settings,
-    const settings::GradSetting &grad_setting) const {
+    const settings::GradSetting &grad_setting, const double scale,
+    std::vector<double> &grad) const {
 
-  assert(attributes_.kernel_wrapper != nullptr);
-  assert(attributes_.reduced_inv_covariance != nullptr);
+  assert(attributes_->kernel_wrapper != nullptr);
+  assert(attributes_->reduced_inv_covariance != nullptr);
   assert(grad_setting != settings::GradSetting::WRTBoth &&
          "Terms will cancel should avoid calling grad method at all");
-  assert(attributes_.normalizer != nullptr && "Normalizer is a nullptr");
-  const auto &norm_coeffs = attributes_.normalizer->getNormalizationCoeffs();
-  const double exp_term = compute(descriptors, descriptor_ind, prim_settings);
+  assert(attributes_->normalizer != nullptr && "Normalizer is a nullptr");
+  assert(grad.size() ==
+         static_cast<std::size_t>(descriptors.getNumberDimensions()));
+  const auto &inv_coeffs =
+      attributes_->normalizer->getInverseNormalizationCoeffs();
 
-  std::vector<double> grad(descriptors.getNumberDimensions(), 0.0);
+  double factor = scale * compute(descriptors, descriptor_ind, prim_settings);
+  if (grad_setting == settings::GradSetting::WRTDescriptor) {
+    factor *= -1.0;
+  }
 
   const auto &chosen_dims =
-      attributes_.reduced_inv_covariance->getChosenDimensionIndices();
-  // const auto & norm_coeffs = attributes_.normalizer.getNormalizationCoeffs();
+      attributes_->reduced_inv_covariance->getChosenDimensionIndices();
+  const auto &kerns = *(attributes_->kernel_wrapper);
 
   int index = 0;
   for (const int &dim : chosen_dims) {
-    const double diff = (descriptors(descriptor_ind, dim) -
-                         attributes_.kernel_wrapper->at(kernel_index_, dim)) /
-                        (norm_coeffs.at(dim) * norm_coeffs.at(dim));
+    const double diff =
+        (descriptors(descriptor_ind, dim) - kerns.at(kernel_index_, dim)) *
+        (inv_coeffs[dim] * inv_coeffs[dim]);
 
-    grad.at(dim) =
-        diff * attributes_.reduced_inv_covariance->operator()(index, index) *
-        exp_term;
+    grad[dim] +=
+        diff * attributes_->reduced_inv_covariance->operator()(index, index) *
+        factor;
 
     ++index;
   }
-
-  if (grad_setting == settings::GradSetting::WRTDescriptor) {
-    // Multiply the gradient by negative 1
-    for (const int &dim : chosen_dims) {
-      grad.at(dim) *= -1.0;
-    }
-  }
-  return grad;
 }
 
 } // namespace panacea
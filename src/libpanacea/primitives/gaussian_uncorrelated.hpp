@@ -15,6 +15,7 @@
 
 // Standard includes
 #include <cmath>
+#include <limits>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -36,8 +37,7 @@ class Test;
 class GaussUncorrelated : public Primitive {
 private:
   const int kernel_index_ = -1;
-  PrimitiveAttributes attributes_;
-  double pre_factor_ = 0.0;
+  std::shared_ptr<const PrimitiveAttributes> attributes_;
 
 public:
   GaussUncorrelated(const PassKey<PrimitiveFactory> &, const int &kernel_index)
@@ -47,34 +47,37 @@ public:
       : kernel_index_(kernel_index){};
 
   GaussUncorrelated(const PassKey<PrimitiveFactory> &,
-                    PrimitiveAttributes prim_att, const int &kernel_index)
-      : kernel_index_(kernel_index), attributes_(std::move(prim_att)),
-        pre_factor_(
-            1.0 /
-            (std::pow(attributes_.reduced_covariance->getDeterminant(), 0.5) *
-             std::pow(
-                 constants::PI_SQRT * constants::SQRT_2,
-                 static_cast<double>(
-                     attributes_.reduced_covariance->getNumberDimensions())))){
-
-        };
+                    std::shared_ptr<const PrimitiveAttributes> prim_att,
+                    const int &kernel_index)
+      : kernel_index_(kernel_index), attributes_(std::move(prim_att)){};
 
   virtual const settings::KernelPrimitive type() const noexcept final;
   virtual const settings::KernelCorrelation correlation() const noexcept final;
 
   virtual int getId() const noexcept final { return kernel_index_; }
 
-  virtual double getPreFactor() const noexcept final { return pre_factor_; }
+  virtual double getPreFactor() const noexcept final {
+    if (attributes_ == nullptr) {
+      return 0.0;
+    }
+    return attributes_->reduced_covariance->getGaussianPreFactor();
+  }
 
-  // Do not make const reference
-  virtual void update(PrimitiveAttributes &&) final;
+  virtual double getLogPreFactor() const noexcept final {
+    if (attributes_ == nullptr) {
+      return -std::numeric_limits<double>::infinity();
+    }
+    return attributes_->reduced_covariance->getGaussianLogPreFactor();
+  }
+
+  virtual void update(std::shared_ptr<const PrimitiveAttributes>) final;
 
   virtual double
   compute(const BaseDescriptorWrapper &descriptor_wrapper, const int sample_ind,
           const settings::EquationSetting &prim_settings) const final;
 
   /*
-   * Compute the gradient of the primitive
+   * Add the gradient of the primitive to grad
    *
    * provide:
    *
@@ -86,23 +89,28 @@ public:
    *gradient
    * 6. GradSetting - whether the gradient is with respect to the descriptors or
    *kernels or both
+   * 7. scale - factor the gradient is multiplied by before it is added
+   * 8. grad - holds a value for every dimension of the descriptors
    **/
-  virtual std::vector<double>
-  compute_grad(const BaseDescriptorWrapper &descriptors,
-               const int descriptor_ind,
-               const settings::EquationSetting &prim_settings,
-               const settings::GradSetting &grad_setting) const final;
-
-  static std::unique_ptr<Primitive> create(const PassKey<PrimitiveFactory> &key,
-                                           PrimitiveAttributes prim_att,
-                                           const int &kernel_index);
+  virtual void accumulate_grad(const BaseDescriptorWrapper &descriptors,
+                               const int descriptor_ind,
+                               const settings::EquationSetting &prim_settings,
+                               const settings::GradSetting &grad_setting,
+                               const double scale,
+                               std::vector<double> &grad) const final;
+
+  static std::unique_ptr<Primitive>
+  create(const PassKey<PrimitiveFactory> &key,
+         std::shared_ptr<const PrimitiveAttributes> prim_att,
+         const int &kernel_index);
 };
 
 inline std::unique_ptr<Primitive>
 GaussUncorrelated::create(const PassKey<PrimitiveFactory> &key,
-                          PrimitiveAttributes prim_att,
+                          std::shared_ptr<const PrimitiveAttributes> prim_att,
                           const int &kernel_index) {
-  return std::make_unique<GaussUncorrelated>(key, prim_att, kernel_index);
+  return std::make_unique<GaussUncorrelated>(key, std::move(prim_att),
+                                            kernel_index);
 }
 } // namespace panacea
 
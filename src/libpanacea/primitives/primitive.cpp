@@ -2,6 +2,24 @@
 // Local private includes
 #include "primitive.hpp"
 
+// Public PANACEA includes
+#include "panacea/base_descriptor_wrapper.hpp"
+
+// Standard includes
+#include <vector>
+
 namespace panacea {
-Primitive::~Primitive(){};
+
+std::vector<double>
+Primitive::compute_grad(const BaseDescriptorWrapper &descriptors,
+                        const int descriptor_ind,
+                        const settings::EquationSetting &prim_settings,
+                        const settings::GradSetting &grad_setting) const {
+  std::vector<double> grad(descriptors.getNumberDimensions(), 0.0);
+  accumulate_grad(descriptors, descriptor_ind, prim_settings, grad_setting, 1.0,
+                  grad);
+  return grad;
 }
+
+Primitive::~Primitive(){};
+} // namespace panacea
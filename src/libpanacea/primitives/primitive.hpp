@@ -7,6 +7,7 @@
 #include "private_settings.hpp"
 
 // Standard includes
+#include <memory>
 #include <vector>
 
 namespace panacea {
@@ -25,12 +26,16 @@ public:
   virtual double getPreFactor() const noexcept = 0;
 
   /*
-   * Updating a primitive inolves updating the kernel pointer
-   * reset the inverse covariance matrix
-   * reset the prefactor value
+   * Natural log of the prefactor, for evaluating densities in log space
    */
-  // Do not make const reference
-  virtual void update(PrimitiveAttributes &&) = 0;
+  virtual double getLogPreFactor() const noexcept = 0;
+
+  /*
+   * Updating a primitive involves pointing it at the attributes of its group,
+   * the attributes are shared with the other primitives of the group, the
+   * prefactor is read from the reduced covariance matrix
+   */
+  virtual void update(std::shared_ptr<const PrimitiveAttributes>) = 0;
 
   /*
    * Computes the density
@@ -49,11 +54,23 @@ public:
    * because it must either be the descriptor or the kernel otherwise the
    * gradient is 0.0)
    */
-  virtual std::vector<double>
+  std::vector<double>
   compute_grad(const BaseDescriptorWrapper &descriptors,
                const int descriptor_ind,
                const settings::EquationSetting &prim_settings,
-               const settings::GradSetting &grad_setting) const = 0;
+               const settings::GradSetting &grad_setting) const;
+
+  /*
+   * Adds scale times the gradient of the density to grad, grad must already
+   * hold a value for every dimension of the descriptors. Dimensions that are
+   * not used by the primitive are left untouched.
+   */
+  virtual void accumulate_grad(const BaseDescriptorWrapper &descriptors,
+                               const int descriptor_ind,
+                               const settings::EquationSetting &prim_settings,
+                               const settings::GradSetting &grad_setting,
+                               const double scale,
+                               std::vector<double> &grad) const = 0;
 
   virtual ~Primitive() = 0;
 };
@@ -6,6 +6,9 @@
 // Local private includes
 #include "attribute_manipulators/normalizer.hpp"
 
+// Standard includes
+#include <vector>
+
 namespace panacea {
 
 class BaseKernelWrapper;
@@ -24,6 +27,9 @@ public:
   Covariance *covariance = nullptr;
   ReducedCovariance *reduced_covariance = nullptr;
   ReducedInvCovariance *reduced_inv_covariance = nullptr;
+  // Exponent of an uncorrelated Gaussian evaluated at the origin for every
+  // kernel, sparse descriptors correct it for their non zero values only
+  std::vector<double> origin_exponents;
 };
 } // namespace panacea
 
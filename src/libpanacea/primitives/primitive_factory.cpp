@@ -14,6 +14,7 @@
 #include "attributes/reduced_covariance.hpp"
 #include "attributes/reduced_inv_covariance.hpp"
 #include "constants.hpp"
+#include "descriptors/descriptor_statistics.hpp"
 #include "error.hpp"
 #include "gaussian_correlated.hpp"
 #include "gaussian_log_correlated.hpp"
@@ -26,10 +27,13 @@
 #include "primitive_attributes.hpp"
 #include "primitive_group.hpp"
 #include "primitives/primitive.hpp"
+#include "update_policy.hpp"
 
 // Standard includes
 #include <iostream>
 #include <memory>
+#include <string>
+#include <typeindex>
 #include <unordered_map>
 #include <vector>
 
@@ -42,42 +46,38 @@ namespace panacea {
 void PrimitiveFactory::OneToOne(const PassKey<PrimitiveFactory> &,
                                 PrimitiveGroup &prim_grp) {
 
-  prim_grp.primitives.reserve(prim_grp.kernel_wrapper->getNumberPoints());
+  // The primitives share the attributes of the group, refreshing them here
+  // is all that is needed to bring the existing primitives up to date, only
+  // the primitives of kernels that have been added need to be created.
+  auto attributes = prim_grp.refreshPrimitiveAttributes();
 
   const int initial_num_prim = prim_grp.primitives.size();
-  const int diff =
-      prim_grp.kernel_wrapper->getNumberPoints() - initial_num_prim;
-  const int new_num_prim = initial_num_prim + diff;
+  const int num_prim = prim_grp.kernel_wrapper->getNumberPoints();
 
-  if (diff > 0) {
+  if (initial_num_prim != 0) {
+    const double determinant = attributes->reduced_covariance->getDeterminant();
+    if (determinant <= 0.0) {
+      std::string error_msg =
+          "Determinant is less than 0 value: " + std::to_string(determinant);
+      PANACEA_FAIL(error_msg);
+    }
+  }
+
+  if (num_prim > initial_num_prim) {
+    prim_grp.primitives.reserve(num_prim);
+    auto create_method =
+        create_methods_
+            .at(prim_grp.getSpecification().get<settings::KernelPrimitive>())
+            .at(prim_grp.getSpecification().get<settings::KernelCorrelation>());
     // Add the difference
-    for (int kernel_index = initial_num_prim;
-         kernel_index < prim_grp.kernel_wrapper->getNumberPoints();
+    for (int kernel_index = initial_num_prim; kernel_index < num_prim;
          ++kernel_index) {
-
       prim_grp.primitives.push_back(
-          create_methods_
-              [prim_grp.getSpecification().get<settings::KernelPrimitive>()]
-              [prim_grp.getSpecification().get<settings::KernelCorrelation>()](
-                  PassKey<PrimitiveFactory>(),
-                  prim_grp.createPrimitiveAttributes(), kernel_index));
+          create_method(PassKey<PrimitiveFactory>(), attributes, kernel_index));
     }
   } else {
     // Shrink to fit
-    prim_grp.primitives.resize(prim_grp.kernel_wrapper->getNumberPoints());
-  }
-
-  if (initial_num_prim != 0) {
-    int num_prim_to_update = initial_num_prim;
-    if (diff < 0)
-      num_prim_to_update = prim_grp.kernel_wrapper->getNumberPoints();
-    // make sure all the primitive attributes are up to date upto the
-    // initial_num_priming index
-    for (int kernel_index = 0; kernel_index < num_prim_to_update;
-         ++kernel_index) {
-      prim_grp.primitives.at(kernel_index)
-          ->update(prim_grp.createPrimitiveAttributes());
-    }
+    prim_grp.primitives.resize(num_prim);
   }
 }
 
@@ -88,13 +88,13 @@ void PrimitiveFactory::Single(const PassKey<PrimitiveFactory> &,
   if (prim_grp.primitives.size() == 0) {
     prim_grp.primitives.emplace_back(
         create_methods_
-            [prim_grp.getSpecification().get<settings::KernelPrimitive>()]
-            [prim_grp.getSpecification().get<settings::KernelCorrelation>()](
+            .at(prim_grp.getSpecification().get<settings::KernelPrimitive>())
+            .at(prim_grp.getSpecification().get<settings::KernelCorrelation>())(
                 PassKey<PrimitiveFactory>(),
-                prim_grp.createPrimitiveAttributes(), kernel_index));
+                prim_grp.refreshPrimitiveAttributes(), kernel_index));
   } else {
     prim_grp.primitives.at(kernel_index)
-        ->update(prim_grp.createPrimitiveAttributes());
+        ->update(prim_grp.refreshPrimitiveAttributes());
   }
 }
 
@@ -119,18 +119,19 @@ std::unordered_map<settings::KernelCount,
 
 static std::unique_ptr<Normalizer>
 createNormalizer(const BaseDescriptorWrapper &dwrapper,
-                 const KernelSpecification &specification) {
+                 const KernelSpecification &specification,
+                 const DescriptorStatistics &stats) {
 
   if (specification.is(settings::KernelAlgorithm::Strict)) {
     return std::make_unique<Normalizer>(
         dwrapper, specification.get<settings::KernelNormalization>(),
-        NormalizerOption::Strict);
+        NormalizerOption::Strict, &stats);
   }
   // Flexible option will avoid errors if coefficients are 0.0,
   // e.g. if variance is 0.0, will set such coefficients to 1.0
   return std::make_unique<Normalizer>(
       dwrapper, specification.get<settings::KernelNormalization>(),
-      NormalizerOption::Flexible);
+      NormalizerOption::Flexible, &stats);
 }
 
 static std::unique_ptr<Normalizer>
@@ -148,20 +149,63 @@ createNormalizer(const KernelSpecification &specification) {
       NormalizerOption::Flexible);
 }
 
+/**
+ * Copy of the kernel specification that only differs in how the kernel memory
+ * is handled.
+ **/
+static KernelSpecification
+withKernelMemory(const KernelSpecification &specification,
+                 const settings::KernelMemory kernel_memory) {
+  return KernelSpecification(
+      specification.get<settings::KernelCorrelation>(),
+      specification.get<settings::KernelCount>(),
+      specification.get<settings::KernelPrimitive>(),
+      specification.get<settings::KernelNormalization>(), kernel_memory,
+      specification.get<settings::KernelCenterCalculation>(),
+      specification.get<settings::KernelAlgorithm>(),
+      specification.get<settings::RandomizeDimensions>(),
+      specification.get<settings::RandomizeNumberDimensions>(),
+      specification.getMaxNumberDimensions());
+}
+
+/**
+ * The normalization coefficients are taken from the covariance matrix when it
+ * is updated so they follow its update policy without their own history.
+ **/
+static void setUpdatePolicy(const KernelSpecification &specification,
+                            PrimitiveGroup &prim_grp) {
+  const UpdatePolicy &policy = specification.get<UpdatePolicy>();
+  if (policy.is(settings::UpdateMode::Cumulative)) {
+    return;
+  }
+  prim_grp.kernel_wrapper->set(policy);
+  prim_grp.covariance->set(policy);
+}
+
 /***********************************************************
  * Declaring private methods
  ***********************************************************/
 
 void PrimitiveFactory::check_input_specifications_(
     const KernelSpecification &specification) const {
-  if (create_methods_.count(specification.get<settings::KernelPrimitive>()) ==
-      0) {
+  auto prim_methods =
+      create_methods_.find(specification.get<settings::KernelPrimitive>());
+  if (prim_methods == create_methods_.end()) {
     std::string error_msg = "Kernel Primitive is not supported: ";
     error_msg +=
         settings::toString(specification.get<settings::KernelPrimitive>());
     PANACEA_FAIL(error_msg);
   }
 
+  if (prim_methods->second.count(
+          specification.get<settings::KernelCorrelation>()) == 0) {
+    std::string error_msg = "Kernel Correlation is not supported for the ";
+    error_msg += "primitive: ";
+    error_msg +=
+        settings::toString(specification.get<settings::KernelCorrelation>());
+    PANACEA_FAIL(error_msg);
+  }
+
   if (count_methods_.count(specification.get<settings::KernelCount>()) == 0) {
     std::string error_msg = "Kernel count method is not supported: ";
     error_msg += settings::toString(specification.get<settings::KernelCount>());
@@ -173,7 +217,7 @@ void PrimitiveFactory::check_input_specifications_(
  * Declaring public methods
  ***********************************************************/
 
-PrimitiveFactory::PrimitiveFactory() {
+bool PrimitiveFactory::registerPrimitives_() {
 
   registerPrimitive<GaussUncorrelated, settings::KernelPrimitive::Gaussian,
                     settings::KernelCorrelation::Uncorrelated>();
@@ -183,6 +227,13 @@ PrimitiveFactory::PrimitiveFactory() {
 
   registerPrimitive<GaussLogCorrelated, settings::KernelPrimitive::GaussianLog,
                     settings::KernelCorrelation::Correlated>();
+  return true;
+}
+
+PrimitiveFactory::PrimitiveFactory() {
+  // Registered once, initialization of a local static is thread safe, after
+  // which the maps are only read
+  [[maybe_unused]] static const bool registered = registerPrimitives_();
 }
 
 PrimitiveGroup
@@ -190,17 +241,22 @@ PrimitiveFactory::createGroup(const BaseDescriptorWrapper &dwrapper,
                               const KernelSpecification &specification,
                               const std::string &name) const {
 
+  // The kernel center, covariance and normalization coefficients are all
+  // derived from a single pass over the descriptors
+  const DescriptorStatistics stats(dwrapper);
+
   KernelWrapperFactory kfactory;
   PrimitiveGroup prim_grp(specification);
   prim_grp.name = name;
-  prim_grp.kernel_wrapper = kfactory.create(dwrapper, specification);
+  prim_grp.kernel_wrapper = kfactory.create(dwrapper, specification, &stats);
 
   prim_grp.covariance = Covariance::create(
-      dwrapper, specification.get<settings::KernelCorrelation>(),
+      stats, specification.get<settings::KernelCorrelation>(),
       specification.get<settings::KernelAlgorithm>());
+  setUpdatePolicy(specification, prim_grp);
 
   // Create a normalizer with kwrapper
-  prim_grp.normalizer = createNormalizer(dwrapper, specification);
+  prim_grp.normalizer = createNormalizer(dwrapper, specification, stats);
   prim_grp.normalizer->normalize(*prim_grp.covariance);
 
   Dimensions dimensions(dwrapper.getNumberDimensions());
@@ -218,7 +274,7 @@ PrimitiveFactory::createGroup(const BaseDescriptorWrapper &dwrapper,
 
   Reducer reducer;
   prim_grp.reduced_covariance = std::make_unique<ReducedCovariance>(
-      reducer.reduce(*prim_grp.covariance, dimensions));
+      reducer.reduce(*prim_grp.covariance, dimensions, *prim_grp.workspace));
 
   Inverter inverter;
   prim_grp.reduced_inv_covariance = std::make_unique<ReducedInvCovariance>(
@@ -226,7 +282,7 @@ PrimitiveFactory::createGroup(const BaseDescriptorWrapper &dwrapper,
 
   check_input_specifications_(specification);
 
-  count_methods_[specification.get<settings::KernelCount>()](
+  count_methods_.at(specification.get<settings::KernelCount>())(
       PassKey<PrimitiveFactory>(), prim_grp);
 
   return prim_grp;
@@ -275,10 +331,26 @@ void PrimitiveFactory::update(const PassKey<PrimitiveGroup> &,
     error_msg += std::to_string(dwrapper.getNumberDimensions());
     PANACEA_FAIL(error_msg);
   }
-  prim_grp.kernel_wrapper->update(dwrapper);
+  const DescriptorStatistics stats(dwrapper);
+  if (prim_grp.kernel_wrapper->sharesDescriptors() &&
+      prim_grp.kernel_wrapper->getTypeIndex() !=
+          std::type_index(dwrapper.getPointerToRawData().type())) {
+    // Kernels pointing at the caller's descriptors cannot point at
+    // descriptors of another type, e.g. the chunks of a descriptor file that
+    // is streamed, which are reused from one chunk to the next. The
+    // descriptors are copied into kernels that own their memory instead.
+    KernelWrapperFactory kfactory;
+    prim_grp.kernel_wrapper = kfactory.create(
+        dwrapper,
+        withKernelMemory(prim_grp.getSpecification(),
+                         settings::KernelMemory::Own),
+        &stats);
+  } else {
+    prim_grp.kernel_wrapper->update(dwrapper, stats);
+  }
   // Unnormalize the covariance matrix before updating
   prim_grp.normalizer->unnormalize(*prim_grp.covariance);
-  prim_grp.covariance->update(dwrapper);
+  prim_grp.covariance->update(stats);
   // Now we are free to update the normalization coefficients, note that the
   // covariance matrix must be uptodate before it can be passed into the
   // normalizer, in the case of the variance the diagonal is used to calculate
@@ -306,7 +378,7 @@ void PrimitiveFactory::update(const PassKey<PrimitiveGroup> &,
   // matrices these both need to be recalculated
   Reducer reducer;
   prim_grp.reduced_covariance = std::make_unique<ReducedCovariance>(
-      reducer.reduce(*prim_grp.covariance, dimensions));
+      reducer.reduce(*prim_grp.covariance, dimensions, *prim_grp.workspace));
 
   Inverter inverter;
   prim_grp.reduced_inv_covariance = std::make_unique<ReducedInvCovariance>(
@@ -315,7 +387,7 @@ void PrimitiveFactory::update(const PassKey<PrimitiveGroup> &,
   check_input_specifications_(prim_grp.getSpecification());
 
   // Now we need to update all the primitives after resizing if appropriate
-  count_methods_[prim_grp.getSpecification().get<settings::KernelCount>()](
+  count_methods_.at(prim_grp.getSpecification().get<settings::KernelCount>())(
       PassKey<PrimitiveFactory>(), prim_grp);
 }
 
@@ -340,28 +412,23 @@ void PrimitiveFactory::initialize(const PassKey<PrimitiveGroup> &,
   // would not be calling initialize with an existing descriptor wrapper. By
   // default we should prefer to have shared ownership if the OwnIfRestart
   // setting is specified.
+  const DescriptorStatistics stats(dwrapper);
+
   KernelWrapperFactory kfactory;
   if (specification.is(settings::KernelMemory::OwnIfRestart)) {
-    auto local_spec = KernelSpecification(
-        specification.get<settings::KernelCorrelation>(),
-        specification.get<settings::KernelCount>(),
-        specification.get<settings::KernelPrimitive>(),
-        specification.get<settings::KernelNormalization>(),
-        settings::KernelMemory::Share, // This is the only thing that is changed
-        specification.get<settings::KernelCenterCalculation>(),
-        specification.get<settings::KernelAlgorithm>(),
-        specification.get<settings::RandomizeDimensions>(),
-        specification.get<settings::RandomizeNumberDimensions>(),
-        specification.getMaxNumberDimensions());
-    prim_grp.kernel_wrapper = kfactory.create(dwrapper, local_spec);
+    prim_grp.kernel_wrapper = kfactory.create(
+        dwrapper,
+        withKernelMemory(specification, settings::KernelMemory::Share),
+        &stats);
   } else {
-    prim_grp.kernel_wrapper = kfactory.create(dwrapper, specification);
+    prim_grp.kernel_wrapper = kfactory.create(dwrapper, specification, &stats);
   }
   prim_grp.covariance = Covariance::create(
-      dwrapper, specification.get<settings::KernelCorrelation>(),
+      stats, specification.get<settings::KernelCorrelation>(),
       specification.get<settings::KernelAlgorithm>());
+  setUpdatePolicy(specification, prim_grp);
 
-  prim_grp.normalizer = createNormalizer(dwrapper, specification);
+  prim_grp.normalizer = createNormalizer(dwrapper, specification, stats);
   prim_grp.normalizer->normalize(*prim_grp.covariance);
 
   Dimensions dimensions(dwrapper.getNumberDimensions());
@@ -379,14 +446,14 @@ void PrimitiveFactory::initialize(const PassKey<PrimitiveGroup> &,
 
   Reducer reducer;
   prim_grp.reduced_covariance = std::make_unique<ReducedCovariance>(
-      reducer.reduce(*prim_grp.covariance, dimensions));
+      reducer.reduce(*prim_grp.covariance, dimensions, *prim_grp.workspace));
   Inverter inverter;
   prim_grp.reduced_inv_covariance = std::make_unique<ReducedInvCovariance>(
       inverter.invert(*prim_grp.reduced_covariance));
 
   check_input_specifications_(specification);
 
-  count_methods_[specification.get<settings::KernelCount>()](
+  count_methods_.at(specification.get<settings::KernelCount>())(
       PassKey<PrimitiveFactory>(), prim_grp);
 }
 
@@ -426,7 +493,7 @@ void PrimitiveFactory::reset(const PassKey<PrimitiveGroup> &,
 
     Reducer reducer;
     prim_grp.reduced_covariance = std::make_unique<ReducedCovariance>(
-        reducer.reduce(*prim_grp.covariance, dimensions));
+        reducer.reduce(*prim_grp.covariance, dimensions, *prim_grp.workspace));
   }
 
   if (reset_opt == ResetOption::All ||
@@ -438,7 +505,7 @@ void PrimitiveFactory::reset(const PassKey<PrimitiveGroup> &,
 
   if (reset_opt == ResetOption::All || reset_opt == ResetOption::Primitives) {
     check_input_specifications_(prim_grp.getSpecification());
-    count_methods_[prim_grp.getSpecification().get<settings::KernelCount>()](
+    count_methods_.at(prim_grp.getSpecification().get<settings::KernelCount>())(
         PassKey<PrimitiveFactory>(), prim_grp);
   }
 }
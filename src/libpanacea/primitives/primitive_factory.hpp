@@ -26,7 +26,8 @@ class PrimitiveFactory {
 
 public:
   using PrimitiveCreateMethod = std::unique_ptr<Primitive> (*)(
-      const PassKey<PrimitiveFactory> &, PrimitiveAttributes prim_attr,
+      const PassKey<PrimitiveFactory> &,
+      std::shared_ptr<const PrimitiveAttributes> prim_attr,
       const int &kernel_index);
 
   using PrimitiveCountMethod = void (*)(const PassKey<PrimitiveFactory> &,
@@ -47,6 +48,8 @@ private:
   static std::unordered_map<settings::KernelCount, PrimitiveCountMethod>
       count_methods_;
 
+  static bool registerPrimitives_();
+
   static void OneToOne(const PassKey<PrimitiveFactory> &,
                        PrimitiveGroup &prim_grp);
 
@@ -54,8 +57,16 @@ private:
                      PrimitiveGroup &prim_grp);
 
 public:
+  /**
+   * The built in primitives are registered by the first factory that is
+   * constructed, constructing further factories is free.
+   **/
   PrimitiveFactory();
 
+  /**
+   * Registration is not synchronized, additional primitives must be
+   * registered before factories are used from more than one thread.
+   **/
   template <class T, settings::KernelPrimitive kern_prim,
             settings::KernelCorrelation kern_corr>
   static bool registerPrimitive() {
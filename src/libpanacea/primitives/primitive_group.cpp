@@ -6,7 +6,9 @@
 #include "attribute_manipulators/normalizer.hpp"
 #include "attribute_manipulators/reducer.hpp"
 #include "attributes/covariance.hpp"
+#include "attributes/reduced_inv_covariance.hpp"
 #include "error.hpp"
+#include "io/restart_read_context.hpp"
 #include "kernels/base_kernel_wrapper.hpp"
 #include "kernels/kernel_wrapper_factory.hpp"
 #include "primitive_attributes.hpp"
@@ -21,6 +23,8 @@
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
 namespace panacea {
@@ -42,19 +46,58 @@ createNormalizer(const KernelSpecification &specification) {
 }
 } // namespace
 
-PrimitiveAttributes PrimitiveGroup::createPrimitiveAttributes() noexcept {
+std::shared_ptr<const PrimitiveAttributes>
+PrimitiveGroup::refreshPrimitiveAttributes() noexcept {
 
   assert(this->kernel_wrapper != nullptr);
   assert(this->covariance != nullptr);
   assert(this->reduced_covariance != nullptr);
   assert(this->reduced_inv_covariance != nullptr);
 
-  return PrimitiveAttributes{
-      .normalizer = this->normalizer.get(), // must return address and not copy
-      .kernel_wrapper = this->kernel_wrapper.get(),
-      .covariance = this->covariance.get(),
-      .reduced_covariance = this->reduced_covariance.get(),
-      .reduced_inv_covariance = this->reduced_inv_covariance.get()};
+  // A group that has been moved from no longer has attributes
+  if (attributes_ == nullptr) {
+    attributes_ = std::make_shared<PrimitiveAttributes>();
+  }
+  // must store addresses and not copies
+  attributes_->normalizer = this->normalizer.get();
+  attributes_->kernel_wrapper = this->kernel_wrapper.get();
+  attributes_->covariance = this->covariance.get();
+  attributes_->reduced_covariance = this->reduced_covariance.get();
+  attributes_->reduced_inv_covariance = this->reduced_inv_covariance.get();
+  if (workspace == nullptr) {
+    workspace = std::make_unique<Workspace>();
+  }
+
+  // Kernels that do not match the normalizer yet are left to be evaluated
+  // in full by the primitives
+  attributes_->origin_exponents.clear();
+  if (not specification.is(settings::KernelCorrelation::Uncorrelated) ||
+      normalizer == nullptr) {
+    return attributes_;
+  }
+  const BaseKernelWrapper &kernels = *kernel_wrapper;
+  const auto &inv_coeffs = normalizer->getInverseNormalizationCoeffs();
+  const auto &chosen_dims = reduced_inv_covariance->getChosenDimensionIndices();
+  for (const int dim : chosen_dims) {
+    if (dim >= kernels.getNumberDimensions() ||
+        static_cast<std::size_t>(dim) >= inv_coeffs.size()) {
+      return attributes_;
+    }
+  }
+  const int num_kernels = kernels.rows();
+  attributes_->origin_exponents.assign(num_kernels, 0.0);
+  for (int kernel = 0; kernel < num_kernels; ++kernel) {
+    double exponent = 0.0;
+    int index = 0;
+    for (const int dim : chosen_dims) {
+      const double kernel_val = kernels.at(kernel, dim) * inv_coeffs[dim];
+      exponent += kernel_val * kernel_val *
+                  reduced_inv_covariance->operator()(index, index);
+      ++index;
+    }
+    attributes_->origin_exponents[kernel] = exponent;
+  }
+  return attributes_;
 }
 
 void PrimitiveGroup::update(const BaseDescriptorWrapper &dwrapper) {
@@ -101,6 +144,7 @@ std::vector<std::any> PrimitiveGroup::write(const settings::FileType file_type,
 
   std::vector<std::any> nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     os << "[Primitive Group]\n";
@@ -135,6 +179,7 @@ PrimitiveGroup::read(const settings::FileType file_type, std::istream &is,
 
   io::ReadInstantiateVector nested_values;
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
@@ -149,6 +194,7 @@ PrimitiveGroup::read(const settings::FileType file_type, std::istream &is,
     }
     std::getline(is, line);
     prim_grp.name = line;
+    prim_grp.kernels_deferred_ = io::deferKernels(is);
 
     nested_values.emplace_back(&prim_grp.specification,
                                postReadKernelSpecsInitialization);
@@ -210,8 +256,14 @@ void PrimitiveGroup::postReadKernelSpecsInitialization(
 
   KernelWrapperFactory kfactory;
   // Essentially create a kernel wrapper shell.
-  prim_grp.kernel_wrapper = kfactory.create(prim_grp.specification);
-  assert(prim_grp.kernel_wrapper.get() != nullptr);
+  auto kernel_wrapper = kfactory.create(prim_grp.specification);
+  assert(kernel_wrapper.get() != nullptr);
+  // When the records of a checkpoint log are read one after the other the
+  // later records may only append rows to the kernels read earlier
+  if (prim_grp.kernel_wrapper == nullptr ||
+      typeid(*prim_grp.kernel_wrapper) != typeid(*kernel_wrapper)) {
+    prim_grp.kernel_wrapper = std::move(kernel_wrapper);
+  }
 }
 
 void PrimitiveGroup::postReadInitialization(const settings::FileType file_type,
@@ -238,9 +290,16 @@ void PrimitiveGroup::postReadInitialization(const settings::FileType file_type,
     return std::any_cast<PrimitiveGroup &>(prim_grp_instance);
   }();
 
-  if (file_type == settings::FileType::TXTRestart) {
+  if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart) {
     PrimitiveFactory prim_factory;
-    prim_factory.reset(PassKey<PrimitiveGroup>(), prim_grp);
+    if (prim_grp.kernels_deferred_) {
+      // The reduced dimensions only depend on the covariance matrix
+      prim_factory.reset(PassKey<PrimitiveGroup>(), prim_grp,
+                         PrimitiveFactory::ResetOption::ReducedCovariance);
+    } else {
+      prim_factory.reset(PassKey<PrimitiveGroup>(), prim_grp);
+    }
   }
 }
 } // namespace panacea
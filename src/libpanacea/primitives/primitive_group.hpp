@@ -12,6 +12,7 @@
 #include "kernels/kernel_specifications.hpp"
 #include "primitive.hpp"
 #include "primitive_attributes.hpp"
+#include "workspace.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io_types.hpp"
@@ -40,6 +41,16 @@ class PrimitiveGroup {
 private:
   KernelSpecification specification;
 
+  // Every primitive of the group points at this single set of attributes so
+  // that replacing or refreshing an attribute is seen by all of them without
+  // touching each primitive.
+  std::shared_ptr<PrimitiveAttributes> attributes_ =
+      std::make_shared<PrimitiveAttributes>();
+
+  // Set while reading a restart file whose kernels are deferred, the
+  // primitives are only constructed once the kernels are read
+  bool kernels_deferred_ = false;
+
 public:
   PrimitiveGroup() = default;
   explicit PrimitiveGroup(const KernelSpecification &specific)
@@ -53,8 +64,17 @@ public:
   std::unique_ptr<ReducedCovariance> reduced_covariance = nullptr;
   std::unique_ptr<ReducedInvCovariance> reduced_inv_covariance = nullptr;
   std::vector<std::unique_ptr<Primitive>> primitives;
-
-  PrimitiveAttributes createPrimitiveAttributes() noexcept;
+  std::unique_ptr<Workspace> workspace = std::make_unique<Workspace>();
+
+  /**
+   * Points the attributes shared by the primitives of the group at the
+   * current normalizer, kernels and covariance matrices and returns them.
+   *
+   * Must be called whenever any of these objects are replaced or the kernels
+   * change, the per kernel terms of the attributes are recomputed here.
+   **/
+  std::shared_ptr<const PrimitiveAttributes>
+  refreshPrimitiveAttributes() noexcept;
 
   void update(const BaseDescriptorWrapper &dwrapper);
 
@@ -70,6 +70,8 @@ template <class T> constexpr const char *toString(T setting) {
       return "Center-Calculation=Mean";
     } else if (setting == KernelCenterCalculation::Median) {
       return "Center-Calculation=Median";
+    } else if (setting == KernelCenterCalculation::StreamingMedian) {
+      return "Center-Calculation=StreamingMedian";
     }
   } else if constexpr (std::is_same<KernelMemory, T>::value) {
     if (setting == KernelMemory::Default) {
@@ -139,6 +141,14 @@ template <class T> constexpr const char *toString(T setting) {
     } else if (setting == EntropyOption::NumericalGrad) {
       return "EntropyOption=NumericalGrad";
     }
+  } else if constexpr (std::is_same<UpdateMode, T>::value) {
+    if (setting == UpdateMode::Cumulative) {
+      return "UpdateMode=Cumulative";
+    } else if (setting == UpdateMode::ExponentialDecay) {
+      return "UpdateMode=ExponentialDecay";
+    } else if (setting == UpdateMode::SlidingWindow) {
+      return "UpdateMode=SlidingWindow";
+    }
   }
   return "";
 }
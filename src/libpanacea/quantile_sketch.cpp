@@ -0,0 +1,197 @@
+
+// Local private PANACEA includes
+#include "quantile_sketch.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace panacea {
+
+/************************************************
+ * Private Methods
+ ************************************************/
+
+std::size_t QuantileSketch::bufferCapacity_() const noexcept {
+  return std::max<std::size_t>(
+      1, static_cast<std::size_t>(std::floor(1.0 / (2.0 * rank_error_))));
+}
+
+std::size_t QuantileSketch::maxRankUncertainty_() const noexcept {
+  return static_cast<std::size_t>(
+      std::floor(2.0 * rank_error_ * static_cast<double>(count_)));
+}
+
+void QuantileSketch::compress_() {
+  if (tuples_.size() < 3) {
+    return;
+  }
+  const std::size_t threshold = maxRankUncertainty_();
+
+  // Walk from the back merging each tuple into its successor while the
+  // uncertainty of the successor stays within the threshold, the smallest
+  // and largest values are always kept.
+  std::vector<Tuple> compressed;
+  compressed.reserve(tuples_.size());
+  compressed.push_back(tuples_.back());
+  for (std::size_t index = tuples_.size() - 2; index > 0; --index) {
+    Tuple &successor = compressed.back();
+    if (tuples_[index].g + successor.g + successor.delta <= threshold) {
+      successor.g += tuples_[index].g;
+    } else {
+      compressed.push_back(tuples_[index]);
+    }
+  }
+  compressed.push_back(tuples_.front());
+  std::reverse(compressed.begin(), compressed.end());
+  tuples_ = std::move(compressed);
+}
+
+/************************************************
+ * Public Methods
+ ************************************************/
+
+QuantileSketch::QuantileSketch(const double rank_error)
+    : rank_error_(rank_error) {
+  if (not(rank_error > 0.0 && rank_error < 0.5)) {
+    std::string error_msg = "The rank error of a quantile sketch must be ";
+    error_msg += "greater than 0.0 and less than 0.5, it is ";
+    error_msg += std::to_string(rank_error);
+    PANACEA_FAIL(error_msg);
+  }
+}
+
+void QuantileSketch::insert(std::vector<double> &values) {
+  if (values.size() == 0) {
+    return;
+  }
+  std::sort(values.begin(), values.end());
+
+  std::vector<Tuple> merged;
+  merged.reserve(tuples_.size() + values.size());
+  std::size_t index = 0;
+  for (const double value : values) {
+    while (index < tuples_.size() && tuples_[index].value <= value) {
+      merged.push_back(tuples_[index]);
+      ++index;
+    }
+    // A new smallest or largest value has an exact rank, otherwise its rank
+    // is as uncertain as that of the value that follows it
+    std::size_t delta = 0;
+    if (not merged.empty() && index < tuples_.size()) {
+      delta = tuples_[index].g + tuples_[index].delta - 1;
+    }
+    merged.push_back(Tuple{value, 1, delta});
+  }
+  merged.insert(merged.end(), tuples_.begin() + index, tuples_.end());
+
+  tuples_ = std::move(merged);
+  count_ += values.size();
+  compress_();
+}
+
+void QuantileSketch::insert(const double value) {
+  if (buffer_.capacity() == 0) {
+    buffer_.reserve(bufferCapacity_());
+  }
+  buffer_.push_back(value);
+  if (buffer_.size() >= bufferCapacity_()) {
+    flush();
+  }
+}
+
+void QuantileSketch::flush() {
+  if (buffer_.size() == 0) {
+    return;
+  }
+  // The buffer is swapped out so it is not cleared while being merged
+  std::vector<double> values;
+  values.swap(buffer_);
+  insert(values);
+  values.clear();
+  buffer_.swap(values);
+}
+
+double QuantileSketch::quantile(const double quantile) const {
+  if (count() == 0) {
+    PANACEA_FAIL("Cannot calculate a quantile of an empty quantile sketch.");
+  }
+  assert(quantile >= 0.0 && quantile <= 1.0);
+  if (buffer_.size() > 0) {
+    QuantileSketch flushed = *this;
+    flushed.flush();
+    return flushed.quantile(quantile);
+  }
+
+  const double rank =
+      std::max(1.0, std::ceil(quantile * static_cast<double>(count_)));
+  const double allowed_error = rank_error_ * static_cast<double>(count_);
+
+  double rank_min = 0.0;
+  for (const auto &tuple : tuples_) {
+    rank_min += static_cast<double>(tuple.g);
+    const double rank_max = rank_min + static_cast<double>(tuple.delta);
+    if (rank - rank_min <= allowed_error && rank_max - rank <= allowed_error) {
+      return tuple.value;
+    }
+  }
+  return tuples_.back().value;
+}
+
+std::istream &QuantileSketch::read(QuantileSketch &sketch, std::istream &is) {
+  std::string line = "";
+  std::getline(is, line);
+  std::istringstream ss(line);
+  std::size_t num_tuples = 0;
+  if (not(ss >> sketch.rank_error_ >> sketch.count_ >> num_tuples)) {
+    std::string error_msg = "Unable to read the rank error, count and number ";
+    error_msg += "of tuples of a quantile sketch.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+
+  sketch.buffer_.clear();
+  sketch.tuples_.clear();
+  sketch.tuples_.reserve(num_tuples);
+  for (std::size_t index = 0; index < num_tuples; ++index) {
+    std::getline(is, line);
+    std::istringstream ss_tuple(line);
+    Tuple tuple;
+    if (not(ss_tuple >> tuple.value >> tuple.g >> tuple.delta)) {
+      std::string error_msg = "Unable to read quantile sketch tuple.\n";
+      error_msg += "line is: " + line + "\n";
+      PANACEA_FAIL(error_msg);
+    }
+    sketch.tuples_.push_back(tuple);
+  }
+  return is;
+}
+
+std::ostream &QuantileSketch::write(const QuantileSketch &sketch,
+                                    std::ostream &os) {
+  if (sketch.buffer_.size() > 0) {
+    QuantileSketch flushed = sketch;
+    flushed.flush();
+    return write(flushed, os);
+  }
+  // Values are written with enough digits to be read back exactly
+  const auto precision =
+      os.precision(std::numeric_limits<double>::max_digits10);
+  os << sketch.rank_error_ << " " << sketch.count_ << " "
+     << sketch.tuples_.size() << "\n";
+  for (const auto &tuple : sketch.tuples_) {
+    os << tuple.value << " " << tuple.g << " " << tuple.delta << "\n";
+  }
+  os.precision(precision);
+  return os;
+}
+
+} // namespace panacea
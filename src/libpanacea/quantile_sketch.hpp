@@ -0,0 +1,85 @@
+#ifndef PANACEA_PRIVATE_QUANTILE_SKETCH_H
+#define PANACEA_PRIVATE_QUANTILE_SKETCH_H
+#pragma once
+
+// Standard includes
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace panacea {
+
+/**
+ * Streaming quantile summary of a single stream of values
+ *
+ * Uses the Greenwald-Khanna algorithm, for a stream of n values the value
+ * returned for a quantile has a rank that is within rank_error * n of the
+ * requested rank. Only O(1 / rank_error * log(rank_error * n)) tuples are
+ * kept, no matter how many values have been seen.
+ *
+ * Each tuple stores a value, the number of values it stands for (g) and the
+ * uncertainty in its rank (delta).
+ *
+ * Values inserted one at a time are buffered and merged into the tuples as a
+ * single sorted batch every floor(1 / (2 * rank_error)) values, the summary is
+ * compressed once per batch rather than once per value.
+ **/
+class QuantileSketch {
+public:
+  struct Tuple {
+    double value;
+    std::size_t g;
+    std::size_t delta;
+  };
+
+  static constexpr double default_rank_error = 0.005;
+
+private:
+  double rank_error_ = default_rank_error;
+  std::size_t count_ = 0;
+  std::vector<Tuple> tuples_;
+  std::vector<double> buffer_;
+
+  std::size_t bufferCapacity_() const noexcept;
+  std::size_t maxRankUncertainty_() const noexcept;
+  void compress_();
+
+public:
+  explicit QuantileSketch(const double rank_error = default_rank_error);
+
+  /**
+   * Adds a batch of values, merging them into the summary in a single pass.
+   * The values are sorted in place.
+   **/
+  void insert(std::vector<double> &values);
+  void insert(const double value);
+
+  /**
+   * Merges any buffered values into the tuples.
+   **/
+  void flush();
+
+  /**
+   * Value whose rank is within rank_error * count of quantile * count.
+   *
+   * quantile must be in the range [0, 1], 0.5 returns the median. Buffered
+   * values are included, call flush() first to avoid merging them on every
+   * call.
+   **/
+  double quantile(const double quantile) const;
+
+  double rankError() const noexcept { return rank_error_; }
+  std::size_t count() const noexcept { return count_ + buffer_.size(); }
+
+  /**
+   * The tuples of the summary, values that are still buffered are not
+   * included.
+   **/
+  const std::vector<Tuple> &tuples() const noexcept { return tuples_; }
+
+  static std::istream &read(QuantileSketch &sketch, std::istream &is);
+  static std::ostream &write(const QuantileSketch &sketch, std::ostream &os);
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_QUANTILE_SKETCH_H
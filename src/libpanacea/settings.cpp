@@ -110,6 +110,24 @@ PANACEASettingsBuilder &PANACEASettingsBuilder::set(
   return *this;
 }
 
+PANACEASettingsBuilder &
+PANACEASettingsBuilder::set(const settings::UpdateMode &update_mode) {
+  ent_settings_.update_mode_ = update_mode;
+  return *this;
+}
+
+PANACEASettingsBuilder &
+PANACEASettingsBuilder::setForgettingFactorTo(const double &factor) {
+  ent_settings_.forgetting_factor_ = factor;
+  return *this;
+}
+
+PANACEASettingsBuilder &
+PANACEASettingsBuilder::setUpdateWindowTo(const int &number_updates) {
+  ent_settings_.update_window_ = number_updates;
+  return *this;
+}
+
 /******************************************************
  * Ostream enums
  ******************************************************/
@@ -131,6 +149,10 @@ std::ostream &operator<<(std::ostream &os,
     os << "TXTDescriptors";
   } else if (file_type == settings::FileType::TXTKernelDistribution) {
     os << "TXTKernelDistribution";
+  } else if (file_type == settings::FileType::BinaryDescriptors) {
+    os << "BinaryDescriptors";
+  } else if (file_type == settings::FileType::BinaryRestart) {
+    os << "BinaryRestart";
   }
   return os;
 }
@@ -218,6 +240,8 @@ std::ostream &operator<<(std::ostream &os,
     os << "Mean";
   } else if (cent == settings::KernelCenterCalculation::Median) {
     os << "Median";
+  } else if (cent == settings::KernelCenterCalculation::StreamingMedian) {
+    os << "StreamingMedian";
   }
   return os;
 }
@@ -238,6 +262,8 @@ std::ostream &operator<<(std::ostream &os,
     os << "None";
   } else if (eq_set == settings::EquationSetting::IgnoreExp) {
     os << "IgnoreExp";
+  } else if (eq_set == settings::EquationSetting::IgnoreExpAndPrefactor) {
+    os << "IgnoreExpAndPrefactor";
   }
   return os;
 }
@@ -317,6 +343,48 @@ operator<<(std::ostream &os,
   return os;
 }
 
+std::ostream &operator<<(std::ostream &os,
+                         const settings::LayoutCache &layout_cache) {
+  if (layout_cache == settings::LayoutCache::None) {
+    os << "None";
+  } else if (layout_cache == settings::LayoutCache::PointMajor) {
+    os << "PointMajor";
+  }
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const settings::UpdateMode &update_mode) {
+  if (update_mode == settings::UpdateMode::Cumulative) {
+    os << "Cumulative";
+  } else if (update_mode == settings::UpdateMode::ExponentialDecay) {
+    os << "ExponentialDecay";
+  } else if (update_mode == settings::UpdateMode::SlidingWindow) {
+    os << "SlidingWindow";
+  }
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const settings::RestartLoading &restart_loading) {
+  if (restart_loading == settings::RestartLoading::Eager) {
+    os << "Eager";
+  } else if (restart_loading == settings::RestartLoading::Lazy) {
+    os << "Lazy";
+  }
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os,
+                         const settings::DescriptorSidecar &sidecar) {
+  if (sidecar == settings::DescriptorSidecar::None) {
+    os << "None";
+  } else if (sidecar == settings::DescriptorSidecar::Summary) {
+    os << "Summary";
+  }
+  return os;
+}
+
 /***************************************************
  * Istream enums
  ***************************************************/
@@ -350,10 +418,15 @@ std::istream &operator>>(std::istream &is, settings::FileType &file_type) {
     file_type = settings::FileType::TXTDescriptors;
   } else if (line.find("TXTKernelDistribution", 0) != std::string::npos) {
     file_type = settings::FileType::TXTKernelDistribution;
+  } else if (line.find("BinaryDescriptors", 0) != std::string::npos) {
+    file_type = settings::FileType::BinaryDescriptors;
+  } else if (line.find("BinaryRestart", 0) != std::string::npos) {
+    file_type = settings::FileType::BinaryRestart;
   } else {
     std::string error_msg = "Unrecognized file type while reading istream.\n";
     error_msg += "Accepted file types are:\n";
-    error_msg += "TXTRestart\nTXTDescriptors\n";
+    error_msg += "TXTRestart\nTXTDescriptors\nTXTKernelDistribution\n";
+    error_msg += "BinaryDescriptors\nBinaryRestart\n";
     error_msg += "Line is: " + line + "\n";
     PANACEA_FAIL(error_msg);
   }
@@ -510,6 +583,9 @@ std::istream &operator>>(std::istream &is,
     cent = settings::KernelCenterCalculation::None;
   } else if (line.find("Mean", 0) != std::string::npos) {
     cent = settings::KernelCenterCalculation::Mean;
+  } else if (line.find("StreamingMedian", 0) != std::string::npos) {
+    // Must be checked before Median which it contains
+    cent = settings::KernelCenterCalculation::StreamingMedian;
   } else if (line.find("Median", 0) != std::string::npos) {
     cent = settings::KernelCenterCalculation::Median;
   } else {
@@ -517,7 +593,7 @@ std::istream &operator>>(std::istream &is,
         "Unrecognized kernel center calculation type while ";
     error_msg += "reading istream.\n";
     error_msg += "Accepted kernel center calculation types are:\n";
-    error_msg += "None\nMean\nMedian\n";
+    error_msg += "None\nMean\nMedian\nStreamingMedian\n";
     error_msg += "Line is: " + line + "\n";
     PANACEA_FAIL(error_msg);
   }
@@ -549,13 +625,15 @@ std::istream &operator>>(std::istream &is, settings::EquationSetting &eq_set) {
   std::getline(is, line);
   if (line.find("None", 0) != std::string::npos) {
     eq_set = settings::EquationSetting::None;
+  } else if (line.find("IgnoreExpAndPrefactor", 0) != std::string::npos) {
+    eq_set = settings::EquationSetting::IgnoreExpAndPrefactor;
   } else if (line.find("IgnoreExp", 0) != std::string::npos) {
     eq_set = settings::EquationSetting::IgnoreExp;
   } else {
     std::string error_msg =
         "Unrecognized equation setting while reading istream.\n";
     error_msg += "Accepted equation settings are:\n";
-    error_msg += "None\nIgnoreExp\n";
+    error_msg += "None\nIgnoreExp\nIgnoreExpAndPrefactor\n";
     error_msg += "Line is: " + line + "\n";
     PANACEA_FAIL(error_msg);
   }
@@ -702,4 +780,81 @@ std::istream &operator>>(std::istream &is,
   return is;
 }
 
+std::istream &operator>>(std::istream &is,
+                         settings::LayoutCache &layout_cache) {
+  std::string line;
+  std::getline(is, line);
+  if (line.find("PointMajor", 0) != std::string::npos) {
+    layout_cache = settings::LayoutCache::PointMajor;
+  } else if (line.find("None", 0) != std::string::npos) {
+    layout_cache = settings::LayoutCache::None;
+  } else {
+    std::string error_msg =
+        "Unrecognized layout cache setting while reading istream.\n";
+    error_msg += "Accepted layout cache settings are:\n";
+    error_msg += "None\nPointMajor\n";
+    error_msg += "Line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  return is;
+}
+
+std::istream &operator>>(std::istream &is, settings::UpdateMode &update_mode) {
+  std::string line;
+  std::getline(is, line);
+  if (line.find("Cumulative", 0) != std::string::npos) {
+    update_mode = settings::UpdateMode::Cumulative;
+  } else if (line.find("ExponentialDecay", 0) != std::string::npos) {
+    update_mode = settings::UpdateMode::ExponentialDecay;
+  } else if (line.find("SlidingWindow", 0) != std::string::npos) {
+    update_mode = settings::UpdateMode::SlidingWindow;
+  } else {
+    std::string error_msg =
+        "Unrecognized update mode while reading istream.\n";
+    error_msg += "Accepted update modes are:\n";
+    error_msg += "Cumulative\nExponentialDecay\nSlidingWindow\n";
+    error_msg += "Line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  return is;
+}
+
+std::istream &operator>>(std::istream &is,
+                         settings::RestartLoading &restart_loading) {
+  std::string line;
+  std::getline(is, line);
+  if (line.find("Eager", 0) != std::string::npos) {
+    restart_loading = settings::RestartLoading::Eager;
+  } else if (line.find("Lazy", 0) != std::string::npos) {
+    restart_loading = settings::RestartLoading::Lazy;
+  } else {
+    std::string error_msg =
+        "Unrecognized restart loading while reading istream.\n";
+    error_msg += "Accepted restart loadings are:\n";
+    error_msg += "Eager\nLazy\n";
+    error_msg += "Line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  return is;
+}
+
+std::istream &operator>>(std::istream &is,
+                         settings::DescriptorSidecar &sidecar) {
+  std::string line;
+  std::getline(is, line);
+  if (line.find("None", 0) != std::string::npos) {
+    sidecar = settings::DescriptorSidecar::None;
+  } else if (line.find("Summary", 0) != std::string::npos) {
+    sidecar = settings::DescriptorSidecar::Summary;
+  } else {
+    std::string error_msg =
+        "Unrecognized descriptor sidecar while reading istream.\n";
+    error_msg += "Accepted descriptor sidecars are:\n";
+    error_msg += "None\nSummary\n";
+    error_msg += "Line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  return is;
+}
+
 } // namespace panacea
@@ -6,9 +6,12 @@
 #include "attributes/covariance/covariance_uncorrelated.hpp"
 #include "attributes/reduced_covariance.hpp"
 #include "attributes/reduced_inv_covariance.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
 #include "kernels/base_kernel_wrapper.hpp"
 #include "kernels/kernel_specifications.hpp"
+#include "kernels/kernel_store.hpp"
 #include "matrix/matrix.hpp"
+#include "memory_mapped_array.hpp"
 #include "primitives/primitive.hpp"
 #include "primitives/primitive_group.hpp"
 #include "vector/vector.hpp"
@@ -38,6 +41,11 @@ const std::unordered_map<std::type_index, std::string> type_map{
     {std::type_index(typeid(double *)), "double *"},
     {std::type_index(typeid(double **)), "double **"},
     {std::type_index(typeid(double ***)), "double ***"},
+    {std::type_index(typeid(MemoryMappedArray *)), "MemoryMappedArray *"},
+    {std::type_index(typeid(CompressedSparseRows *)),
+     "CompressedSparseRows *"},
+    {std::type_index(typeid(KernelStore)), "KernelStore"},
+    {std::type_index(typeid(const KernelStore *)), "const KernelStore *"},
     {std::type_index(typeid(std::vector<std::deque<double>>)),
      "std::vector<std::deque<double>>"},
     {std::type_index(typeid(std::vector<std::deque<double>> &)),
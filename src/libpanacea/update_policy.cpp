@@ -0,0 +1,83 @@
+
+// Local private PANACEA includes
+#include "update_policy.hpp"
+
+#include "error.hpp"
+
+// Standard includes
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace panacea {
+
+UpdatePolicy::UpdatePolicy(const settings::UpdateMode mode,
+                           const double forgetting_factor, const int window)
+    : mode_(mode) {
+  if (mode == settings::UpdateMode::ExponentialDecay) {
+    if (not(forgetting_factor > 0.0 && forgetting_factor <= 1.0)) {
+      std::string error_msg = "The forgetting factor of an exponential decay ";
+      error_msg += "update must be greater than 0.0 and no larger than 1.0, ";
+      error_msg += "it is " + std::to_string(forgetting_factor);
+      PANACEA_FAIL(error_msg);
+    }
+    forgetting_factor_ = forgetting_factor;
+  } else if (mode == settings::UpdateMode::SlidingWindow) {
+    if (window < 1) {
+      std::string error_msg = "The window of a sliding window update must ";
+      error_msg += "contain at least one update, it is ";
+      error_msg += std::to_string(window);
+      PANACEA_FAIL(error_msg);
+    }
+    window_ = window;
+  }
+}
+
+bool operator==(const UpdatePolicy &policy1, const UpdatePolicy &policy2) {
+  if (policy1.mode_ != policy2.mode_)
+    return false;
+  if (policy1.forgetting_factor_ != policy2.forgetting_factor_)
+    return false;
+  if (policy1.window_ != policy2.window_)
+    return false;
+  return true;
+}
+
+bool operator!=(const UpdatePolicy &policy1, const UpdatePolicy &policy2) {
+  return !(policy1 == policy2);
+}
+
+std::istream &UpdatePolicy::read(UpdatePolicy &policy, std::istream &is) {
+  std::string line = "";
+  // Skip what remains of a previous line
+  is >> std::ws;
+  if (is.peek() == '[' || is.peek() == EOF) {
+    // Written before update modes were added, the next section follows
+    policy = UpdatePolicy();
+    return is;
+  }
+  std::getline(is, line);
+  std::istringstream ss(line);
+  std::string mode = "";
+  if (not(ss >> mode >> policy.forgetting_factor_ >> policy.window_)) {
+    std::string error_msg = "Unable to read the mode, forgetting factor and ";
+    error_msg += "window of an update policy.\n";
+    error_msg += "line is: " + line + "\n";
+    PANACEA_FAIL(error_msg);
+  }
+  std::istringstream ss_mode(mode);
+  ss_mode >> policy.mode_;
+  return is;
+}
+
+std::ostream &UpdatePolicy::write(const UpdatePolicy &policy,
+                                  std::ostream &os) {
+  const auto precision =
+      os.precision(std::numeric_limits<double>::max_digits10);
+  os << policy.mode_ << " " << policy.forgetting_factor_ << " "
+     << policy.window_ << "\n";
+  os.precision(precision);
+  return os;
+}
+
+} // namespace panacea
@@ -0,0 +1,64 @@
+#ifndef PANACEA_PRIVATE_UPDATE_POLICY_H
+#define PANACEA_PRIVATE_UPDATE_POLICY_H
+#pragma once
+
+// Public PANACEA includes
+#include "panacea/settings.hpp"
+
+// Standard includes
+#include <iostream>
+
+namespace panacea {
+
+/**
+ * How new descriptors are combined with the ones already seen when the
+ * statistics of a kernel distribution are updated.
+ *
+ * With ExponentialDecay the weight of the descriptors already seen is
+ * multiplied by the forgetting factor before each update. With SlidingWindow
+ * only the descriptors of the last window updates are kept.
+ **/
+class UpdatePolicy {
+public:
+  static constexpr double default_forgetting_factor = 0.95;
+  static constexpr int default_window = 10;
+
+private:
+  settings::UpdateMode mode_ = settings::UpdateMode::Cumulative;
+  double forgetting_factor_ = 1.0;
+  int window_ = 0;
+
+public:
+  UpdatePolicy() = default;
+
+  /**
+   * The forgetting factor is only used with ExponentialDecay and the window
+   * only with SlidingWindow.
+   **/
+  explicit UpdatePolicy(const settings::UpdateMode mode,
+                        const double forgetting_factor =
+                            default_forgetting_factor,
+                        const int window = default_window);
+
+  settings::UpdateMode mode() const noexcept { return mode_; }
+  double forgettingFactor() const noexcept { return forgetting_factor_; }
+  int window() const noexcept { return window_; }
+
+  bool is(const settings::UpdateMode mode) const noexcept {
+    return mode_ == mode;
+  }
+
+  friend bool operator==(const UpdatePolicy &policy1,
+                         const UpdatePolicy &policy2);
+  friend bool operator!=(const UpdatePolicy &policy1,
+                         const UpdatePolicy &policy2);
+
+  static std::istream &read(UpdatePolicy &policy, std::istream &is);
+  static std::ostream &write(const UpdatePolicy &policy, std::ostream &os);
+};
+
+bool operator==(const UpdatePolicy &policy1, const UpdatePolicy &policy2);
+bool operator!=(const UpdatePolicy &policy1, const UpdatePolicy &policy2);
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_UPDATE_POLICY_H
@@ -2,12 +2,12 @@
 #include "vector.hpp"
 
 #include "error.hpp"
+#include "io/txt_numbers.hpp"
 #include "private_settings.hpp"
 #include "vector_eigen.hpp"
 
 // Standard includes
 #include <any>
-#include <iomanip>
 #include <iostream>
 #include <typeindex>
 #include <vector>
@@ -56,6 +56,7 @@ std::vector<std::any> Vector::write(const settings::FileType file_type,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     os << "[Vector Type]\n";
@@ -65,14 +66,12 @@ std::vector<std::any> Vector::write(const settings::FileType file_type,
     os << vec.rows() << " " << vec.cols() << "\n";
     if (vec.direction() == Direction::AlongRows) {
       for (int row = 0; row < vec.rows(); ++row) {
-        os << std::setfill(' ') << std::setw(14) << std::setprecision(8)
-           << std::right << vec(row);
+        io::writeDouble(os, vec(row), 14);
         os << "\n";
       }
     } else {
       for (int col = 0; col < vec.cols(); ++col) {
-        os << std::setfill(' ') << std::setw(14) << std::setprecision(15)
-           << std::right << vec(col);
+        io::writeDouble(os, vec(col), 14);
         os << " ";
       }
     }
@@ -100,6 +99,7 @@ io::ReadInstantiateVector Vector::read(const settings::FileType file_type,
   }();
 
   if (file_type == settings::FileType::TXTRestart ||
+      file_type == settings::FileType::BinaryRestart ||
       file_type == settings::FileType::TXTKernelDistribution) {
 
     std::string line = "";
@@ -188,12 +188,11 @@ io::ReadInstantiateVector Vector::read(const settings::FileType file_type,
     }
 
     try {
+      std::vector<double> values;
+      io::readBlock(is, rows, cols, values);
       for (int row = 0; row < rows; ++row) {
-        std::getline(is, line);
-        std::istringstream ss_data(line);
         for (int col = 0; col < cols; ++col) {
-          double value;
-          ss_data >> value;
+          const double value = values[row * cols + col];
           if (vec.direction() == Direction::AlongRows) {
             vec(row) = value;
           } else {
@@ -0,0 +1,35 @@
+
+// Local private PANACEA includes
+#include "workspace.hpp"
+
+#include "matrix/matrix.hpp"
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace panacea {
+
+std::vector<double> &Workspace::vector(const Slot slot,
+                                       const std::size_t size) {
+  auto &buffer = vectors_[static_cast<std::size_t>(slot)];
+  buffer.resize(size);
+  return buffer;
+}
+
+Matrix &Workspace::matrix(const Slot slot, const int rows, const int cols) {
+  auto &mat = matrices_[static_cast<std::size_t>(slot)];
+  if (mat == nullptr) {
+    mat = createMatrix(rows, cols);
+  } else if (mat->rows() != rows || mat->cols() != cols) {
+    mat->resize(rows, cols);
+  }
+  return *mat;
+}
+
+Workspace &Workspace::local() {
+  thread_local Workspace workspace;
+  return workspace;
+}
+
+} // namespace panacea
@@ -0,0 +1,63 @@
+#ifndef PANACEA_PRIVATE_WORKSPACE_H
+#define PANACEA_PRIVATE_WORKSPACE_H
+#pragma once
+
+// Local private PANACEA includes
+#include "matrix/matrix.hpp"
+
+// Standard includes
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace panacea {
+
+/**
+ * Scratch memory that is reused from one call to the next
+ *
+ * The hot paths need temporary vectors and matrices whose size only depends
+ * on the number of dimensions. Rather than allocating them on every call they
+ * are borrowed from a workspace, each slot keeps its memory between calls so
+ * once a slot has been used at its largest size it is never allocated again.
+ *
+ * A workspace is not thread safe. Evaluating a primitive is const and may
+ * happen on several threads at once, so the primitives borrow from the
+ * workspace of the calling thread, local(). Every primitive group also owns a
+ * workspace that the reducer borrows when the group is updated, updates
+ * change the group and are never concurrent with other calls.
+ **/
+class Workspace {
+public:
+  enum class Slot { Difference, Product, Reduction };
+
+private:
+  static constexpr std::size_t number_slots = 3;
+  std::array<std::vector<double>, number_slots> vectors_;
+  std::array<std::unique_ptr<Matrix>, number_slots> matrices_;
+
+public:
+  Workspace() = default;
+  Workspace(const Workspace &) = delete;
+  Workspace &operator=(const Workspace &) = delete;
+
+  /**
+   * Vector of the requested size, the values left from the previous use of
+   * the slot are not cleared.
+   **/
+  std::vector<double> &vector(const Slot slot, const std::size_t size);
+
+  /**
+   * Matrix of the requested size, the values are not cleared. The memory is
+   * only reallocated if the number of elements changes.
+   **/
+  Matrix &matrix(const Slot slot, const int rows, const int cols);
+
+  /**
+   * Workspace of the calling thread.
+   **/
+  static Workspace &local();
+};
+
+} // namespace panacea
+#endif // PANACEA_PRIVATE_WORKSPACE_H
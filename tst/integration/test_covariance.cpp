@@ -2,9 +2,13 @@
 // Local private includes
 #include "attributes/covariance.hpp"
 
+#include "attribute_manipulators/normalizer.hpp"
 #include "descriptors/descriptor_wrapper.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
 #include "helper.hpp"
+#include "io/descriptor_stream_reader_txt.hpp"
 #include "io/file_io_factory.hpp"
+#include "io/section_index.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io.hpp"
@@ -15,6 +19,8 @@
 // Standard includes
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 using namespace std;
@@ -287,3 +293,260 @@ TEST_CASE("Testing:covariance read & write using fileio",
     }
   }
 }
+
+TEST_CASE("Testing:covariance and normalization of sparse descriptors",
+          "[integration,panacea]") {
+
+  // 5 points 4 dimensions, mostly zero
+  std::vector<std::vector<double>> data{{0.0, 1.2, 0.0, 0.0},
+                                        {3.1, 0.0, 0.0, 0.0},
+                                        {0.0, 0.0, 0.0, 2.2},
+                                        {1.4, 0.7, 0.0, 0.0},
+                                        {0.0, 0.0, 0.0, 0.9}};
+  std::vector<std::vector<double>> data2{{0.5, 0.0, 0.0, 0.0},
+                                         {0.0, 0.0, 0.0, 1.7}};
+
+  DescriptorWrapper<std::vector<std::vector<double>> *> dense(&data, 5, 4);
+  DescriptorWrapper<std::vector<std::vector<double>> *> dense2(&data2, 2, 4);
+  SparseDescriptorWrapper sparse(dense);
+  SparseDescriptorWrapper sparse2(dense2);
+
+  auto correlation = GENERATE(settings::KernelCorrelation::Correlated,
+                              settings::KernelCorrelation::Uncorrelated);
+
+  auto cov_dense =
+      Covariance::create(dense, correlation, CovarianceOption::Flexible);
+  auto cov_sparse =
+      Covariance::create(sparse, correlation, CovarianceOption::Flexible);
+
+  auto compare = [&]() {
+    REQUIRE(cov_dense->rows() == cov_sparse->rows());
+    for (int row = 0; row < cov_dense->rows(); ++row) {
+      REQUIRE(cov_dense->getMean(row) == Approx(cov_sparse->getMean(row)));
+      for (int col = 0; col < cov_dense->cols(); ++col) {
+        REQUIRE(cov_dense->operator()(row, col) ==
+                Approx(cov_sparse->operator()(row, col)));
+      }
+    }
+  };
+  compare();
+
+  WHEN("The covariance is updated with more descriptors") {
+    cov_dense->update(dense2);
+    cov_sparse->update(sparse2);
+    compare();
+  }
+
+  WHEN("Variance normalization coefficients are calculated") {
+    Normalizer norm_dense(dense, settings::KernelNormalization::Variance,
+                          NormalizerOption::Flexible);
+    Normalizer norm_sparse(sparse, settings::KernelNormalization::Variance,
+                           NormalizerOption::Flexible);
+    const auto coeffs_dense = norm_dense.getNormalizationCoeffs();
+    const auto coeffs_sparse = norm_sparse.getNormalizationCoeffs();
+    REQUIRE(coeffs_dense.size() == coeffs_sparse.size());
+    for (size_t dim = 0; dim < coeffs_dense.size(); ++dim) {
+      REQUIRE(coeffs_dense.at(dim) == Approx(coeffs_sparse.at(dim)));
+    }
+  }
+}
+
+TEST_CASE("Testing:covariance update history read & write using fileio",
+          "[integration,panacea]") {
+
+  std::vector<std::vector<double>> data{{7.3, 1.9, 4.9}, {0.3, 3.2, 1.8},
+                                        {2.9, 4.3, 9.2}, {2.3, 1.8, 8.9},
+                                        {1.2, 1.3, 4.1}, {0.3, 3.3, 5.9}};
+  std::vector<std::vector<double>> update_data{
+      {1.3, 2.9, 3.9}, {4.3, 0.2, 2.8}, {2.1, 3.3, 7.2}};
+
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(
+      &data, data.size(), data.at(0).size());
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper2(
+      &update_data, update_data.size(), update_data.at(0).size());
+
+  auto cov_ptr =
+      Covariance::create(dwrapper, settings::KernelCorrelation::Correlated,
+                         CovarianceOption::Flexible);
+  auto &cov = *cov_ptr;
+  cov.set(UpdatePolicy(settings::UpdateMode::SlidingWindow, 1.0, 2));
+  cov.update(dwrapper2);
+
+  io::FileIOFactory file_io_factory;
+  auto restart_file = file_io_factory.create(settings::FileType::TXTRestart);
+  restart_file->write(&cov, "test_covariance_update_history.restart");
+
+  auto cov_ptr2 = Covariance::create(settings::KernelCorrelation::Correlated);
+  auto &cov2 = *cov_ptr2;
+  restart_file->read(&cov2, "test_covariance_update_history.restart");
+
+  REQUIRE(cov2.getUpdatePolicy() == cov.getUpdatePolicy());
+
+  // The window holds the first two sets of descriptors, after another update
+  // the first set falls out of it
+  cov.update(dwrapper2);
+  cov2.update(dwrapper2);
+  for (int row = 0; row < 3; ++row) {
+    REQUIRE(cov2.getMean(row) == Approx(cov.getMean(row)));
+    REQUIRE(cov.getMean(row) ==
+            Approx((update_data[0][row] + update_data[1][row] +
+                    update_data[2][row]) /
+                   3.0));
+    for (int col = 0; col < 3; ++col) {
+      REQUIRE(cov2(row, col) == Approx(cov(row, col)));
+    }
+  }
+}
+
+TEST_CASE("Testing:covariance restart file section index",
+          "[integration,panacea]") {
+
+  test::ArrayDataNonTrivial array_data;
+  DescriptorWrapper<double ***> dwrapper(&(array_data.data), array_data.rows,
+                                         array_data.cols);
+  auto cov_ptr =
+      Covariance::create(dwrapper, settings::KernelCorrelation::Correlated,
+                         CovarianceOption::Flexible);
+  auto &cov = *cov_ptr;
+
+  io::FileIOFactory file_io_factory;
+  auto restart_file = file_io_factory.create(settings::FileType::TXTRestart);
+
+  std::stringstream ss;
+  restart_file->write(&cov, ss);
+  const std::string text = ss.str();
+  REQUIRE(text.find("[Section Index]") == 0);
+  // The offsets follow the objects
+  REQUIRE(text.rfind("[End Section Index]\n") ==
+          text.size() - std::string("[End Section Index]\n").size());
+
+  std::istringstream index_stream(text);
+  const auto index = io::SectionIndex::read(index_stream);
+  REQUIRE(index.contains(io::SectionIndex::root));
+  REQUIRE(index.size() > 1);
+
+  auto requireSameCovariance = [&](const Covariance &cov2) {
+    REQUIRE(cov.rows() == cov2.rows());
+    REQUIRE(cov.cols() == cov2.cols());
+    REQUIRE(cov.getCummulativeDescPoints() == cov2.getCummulativeDescPoints());
+    for (int row = 0; row < cov.rows(); ++row) {
+      REQUIRE(cov.getMean(row) == Approx(cov2.getMean(row)));
+      for (int col = 0; col < cov.cols(); ++col) {
+        REQUIRE(cov(row, col) == Approx(cov2(row, col)));
+      }
+    }
+  };
+
+  WHEN("Reading several indexed records from one stream") {
+    std::stringstream ss2;
+    restart_file->write(&cov, ss2);
+    restart_file->write(&cov, ss2);
+
+    auto cov_ptr2 = Covariance::create(settings::KernelCorrelation::Correlated);
+    auto cov_ptr3 = Covariance::create(settings::KernelCorrelation::Correlated);
+    restart_file->read(cov_ptr2.get(), ss2);
+    restart_file->read(cov_ptr3.get(), ss2);
+    requireSameCovariance(*cov_ptr2);
+    requireSameCovariance(*cov_ptr3);
+  }
+
+  WHEN("Reading a file written without an index") {
+    const std::size_t body_begin = text.find("\n") + 1;
+    std::stringstream ss2(
+        text.substr(body_begin, text.find("[Section Offsets]") - body_begin));
+
+    auto cov_ptr2 = Covariance::create(settings::KernelCorrelation::Correlated);
+    restart_file->read(cov_ptr2.get(), ss2);
+    requireSameCovariance(*cov_ptr2);
+  }
+
+  WHEN("Writing to a stream that cannot move back") {
+    // Reports every position as unknown, like a pipe
+    struct ForwardOnlyBuffer : public std::stringbuf {
+      pos_type seekoff(off_type, std::ios_base::seekdir,
+                       std::ios_base::openmode) override {
+        return pos_type(off_type(-1));
+      }
+      pos_type seekpos(pos_type, std::ios_base::openmode) override {
+        return pos_type(off_type(-1));
+      }
+    };
+    ForwardOnlyBuffer buffer;
+    std::ostream forward_only(&buffer);
+    restart_file->write(&cov, forward_only);
+    REQUIRE(buffer.str().find("[Section Index]") == std::string::npos);
+
+    std::stringstream ss2(buffer.str());
+    auto cov_ptr2 = Covariance::create(settings::KernelCorrelation::Correlated);
+    restart_file->read(cov_ptr2.get(), ss2);
+    requireSameCovariance(*cov_ptr2);
+  }
+}
+
+TEST_CASE("Testing:covariance update from descriptor file chunks",
+          "[integration,panacea]") {
+
+  std::vector<std::vector<double>> initial_data{
+      {7.3, 1.9, 4.9}, {0.3, 3.2, 1.8}, {2.9, 4.3, 9.2}};
+  std::vector<std::vector<double>> update_data{
+      {2.3, 1.8, 8.9}, {1.2, 1.3, 4.1}, {0.3, 3.3, 5.9}, {1.3, 2.9, 3.9},
+      {4.3, 0.2, 2.8}, {2.1, 3.3, 7.2}, {5.1, 0.9, 6.6}};
+
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(
+      &initial_data, initial_data.size(), initial_data.at(0).size());
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper_update(
+      &update_data, update_data.size(), update_data.at(0).size());
+
+  io::FileIOFactory file_io_factory;
+  auto descriptor_file =
+      file_io_factory.create(settings::FileType::TXTDescriptors);
+  BaseDescriptorWrapper *dwrapper_update_ptr = &dwrapper_update;
+  descriptor_file->write(dwrapper_update_ptr, "test_covariance.descriptors");
+
+  auto cov_ptr =
+      Covariance::create(dwrapper, settings::KernelCorrelation::Correlated,
+                         CovarianceOption::Flexible);
+  cov_ptr->update(dwrapper_update);
+
+  for (const bool overlap : {false, true}) {
+    auto cov_chunked_ptr =
+        Covariance::create(dwrapper, settings::KernelCorrelation::Correlated,
+                           CovarianceOption::Flexible);
+
+    // 7 points are read as chunks of 3, 3 and 1 points
+    io::DescriptorStreamReaderTXT reader("test_covariance.descriptors", 3);
+    REQUIRE(reader.rows() == 7);
+    REQUIRE(reader.cols() == 3);
+    int chunks = 0;
+    reader.forEachChunk(
+        [&](const BaseDescriptorWrapper &chunk) {
+          REQUIRE(chunk.getNumberPoints() == (chunks < 2 ? 3 : 1));
+          cov_chunked_ptr->update(chunk);
+          ++chunks;
+        },
+        overlap);
+    REQUIRE(chunks == 3);
+    REQUIRE(reader.done());
+
+    REQUIRE(cov_chunked_ptr->getCummulativeDescPoints() ==
+            cov_ptr->getCummulativeDescPoints());
+    for (int row = 0; row < 3; ++row) {
+      REQUIRE(cov_chunked_ptr->getMean(row) == Approx(cov_ptr->getMean(row)));
+      for (int col = 0; col < 3; ++col) {
+        REQUIRE((*cov_chunked_ptr)(row, col) == Approx((*cov_ptr)(row, col)));
+      }
+    }
+  }
+
+  // The update method passes the chunks straight to the covariance
+  auto cov_updated_ptr =
+      Covariance::create(dwrapper, settings::KernelCorrelation::Correlated,
+                         CovarianceOption::Flexible);
+  io::DescriptorStreamReaderTXT reader("test_covariance.descriptors", 2);
+  reader.update(*cov_updated_ptr);
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 3; ++col) {
+      REQUIRE((*cov_updated_ptr)(row, col) == Approx((*cov_ptr)(row, col)));
+    }
+  }
+}
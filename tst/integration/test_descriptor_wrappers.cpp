@@ -1,6 +1,12 @@
 
 // Local private includes
+#include "constants.hpp"
 #include "descriptors/descriptor_wrapper.hpp"
+#include "descriptors/mapped_descriptor_wrapper.hpp"
+#include "distribution/distribution_factory.hpp"
+#include "distribution/distribution_settings/kernel_distribution_settings.hpp"
+#include "kernels/kernel_specifications.hpp"
+#include "private_settings.hpp"
 
 #include "helper.hpp"
 #include "io/file_io_factory.hpp"
@@ -75,3 +81,121 @@ TEST_CASE("Testing:descriptor_wrapper file io with write and read",
   REQUIRE(dwrapper2(0, 2) == 3.0);
   REQUIRE(dwrapper2(1, 2) == 3.0);
 }
+
+TEST_CASE("Testing:descriptor_wrapper binary file io and memory mapping",
+          "[integration,panacea]") {
+
+  std::vector<std::vector<double>> data = {
+      {1.0, 4.0}, {2.0, 9.0}, {6.0, 2.0}, {3.0, 3.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 4, 2);
+  BaseDescriptorWrapper *dwrapper_ptr = &dwrapper;
+
+  panacea::io::FileIOFactory file_factory;
+  auto file_io = file_factory.create(settings::FileType::BinaryDescriptors);
+  file_io->write(dwrapper_ptr, "wrapper.bin_descriptors");
+
+  WHEN("Reading the binary file into owned descriptors") {
+    std::vector<std::vector<double>> empty_data;
+    DescriptorWrapper<std::vector<std::vector<double>>> dwrapper2(empty_data,
+                                                                  0, 0);
+    BaseDescriptorWrapper *dwrapper_ptr2 = &dwrapper2;
+    file_io->read(dwrapper_ptr2, "wrapper.bin_descriptors");
+
+    REQUIRE(dwrapper2.getNumberPoints() == 4);
+    REQUIRE(dwrapper2.getNumberDimensions() == 2);
+    for (int pt = 0; pt < 4; ++pt) {
+      for (int dim = 0; dim < 2; ++dim) {
+        REQUIRE(dwrapper2(pt, dim) == data.at(pt).at(dim));
+      }
+    }
+  }
+
+  WHEN("Memory mapping the binary file") {
+    MappedDescriptorWrapper mapped_dwrapper("wrapper.bin_descriptors");
+    REQUIRE(mapped_dwrapper.rows() == 4);
+    REQUIRE(mapped_dwrapper.cols() == 2);
+    REQUIRE(mapped_dwrapper.getNumberPoints() == 4);
+    REQUIRE(mapped_dwrapper.getNumberDimensions() == 2);
+    REQUIRE(mapped_dwrapper.getTypeIndex() ==
+            std::type_index(typeid(MemoryMappedArray *)));
+    for (int pt = 0; pt < 4; ++pt) {
+      for (int dim = 0; dim < 2; ++dim) {
+        REQUIRE(mapped_dwrapper(pt, dim) == data.at(pt).at(dim));
+      }
+    }
+
+    // Kernels sharing the mapping should give the same density as kernels
+    // built from the in memory descriptors
+    KernelDistributionSettings kernel_settings;
+    kernel_settings.dist_settings = KernelSpecification(
+        settings::KernelCorrelation::Correlated,
+        settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+        settings::KernelNormalization::None, settings::KernelMemory::Share,
+        settings::KernelCenterCalculation::None,
+        settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+        settings::RandomizeNumberDimensions::No, constants::automate);
+
+    DistributionFactory dist_factory;
+    auto dist_mapped = dist_factory.create(mapped_dwrapper, kernel_settings);
+    auto dist_memory = dist_factory.create(dwrapper, kernel_settings);
+
+    for (int pt = 0; pt < 4; ++pt) {
+      REQUIRE(dist_mapped->compute(dwrapper, pt, kernel_settings) ==
+              Approx(dist_memory->compute(dwrapper, pt, kernel_settings)));
+    }
+  }
+}
+
+TEST_CASE("Testing:descriptor_wrapper binary files that are empty or corrupt",
+          "[integration,panacea]") {
+
+  std::vector<std::vector<double>> data;
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 0, 2);
+  BaseDescriptorWrapper *dwrapper_ptr = &dwrapper;
+
+  panacea::io::FileIOFactory file_factory;
+  auto file_io = file_factory.create(settings::FileType::BinaryDescriptors);
+  file_io->write(dwrapper_ptr, "empty.bin_descriptors");
+
+  WHEN("Memory mapping a file without any values") {
+    MappedDescriptorWrapper mapped_dwrapper("empty.bin_descriptors");
+    REQUIRE(mapped_dwrapper.getNumberPoints() == 0);
+    REQUIRE(mapped_dwrapper.getNumberDimensions() == 2);
+  }
+
+  // Overwrites a 32 or 64 bit field of the header
+  auto corrupt = [](const std::string &file_name, const int offset,
+                    const std::int64_t value, const int bytes) {
+    std::fstream fs(file_name,
+                    std::ios::in | std::ios::out | std::ios::binary);
+    char buffer[8];
+    for (int byte = 0; byte < bytes; ++byte) {
+      buffer[byte] = static_cast<char>((value >> (8 * byte)) & 0xFF);
+    }
+    fs.seekp(offset);
+    fs.write(buffer, bytes);
+  };
+
+  WHEN("The header contains an unknown layout") {
+    corrupt("empty.bin_descriptors", 16, 7, 4);
+    REQUIRE_THROWS(MappedDescriptorWrapper("empty.bin_descriptors"));
+  }
+
+  WHEN("The header contains an unknown arrangement") {
+    corrupt("empty.bin_descriptors", 20, 2, 4);
+    REQUIRE_THROWS(MappedDescriptorWrapper("empty.bin_descriptors"));
+  }
+
+  WHEN("The header claims more values than the file holds") {
+    corrupt("empty.bin_descriptors", 24, 1000000000, 8);
+    corrupt("empty.bin_descriptors", 32, 1000000000, 8);
+    REQUIRE_THROWS(MappedDescriptorWrapper("empty.bin_descriptors"));
+
+    std::vector<std::vector<double>> empty_data;
+    DescriptorWrapper<std::vector<std::vector<double>>> dwrapper2(empty_data,
+                                                                  0, 0);
+    BaseDescriptorWrapper *dwrapper_ptr2 = &dwrapper2;
+    REQUIRE_THROWS(file_io->read(dwrapper_ptr2, "empty.bin_descriptors"));
+    REQUIRE(dwrapper2.getNumberPoints() == 0);
+  }
+}
@@ -11,6 +11,7 @@
 
 // Public PANACEA includes
 #include "panacea/file_io.hpp"
+#include "panacea/instrumentation.hpp"
 
 // Third party includes
 #include <catch2/catch.hpp>
@@ -120,3 +121,97 @@ TEST_CASE("Testing:distributions write & read with fileio",
     REQUIRE(grad1.at(i) == grad2.at(i));
   }
 }
+
+TEST_CASE("Testing:distributions with point major layout cache",
+          "[integration,panacea]") {
+
+  // 4 points 2 dimensions
+  std::vector<std::vector<double>> train_data{
+      {1.0, 4.0}, {2.0, 3.5}, {1.5, 5.0}, {3.0, 4.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> train_dwrapper(
+      &train_data, 4, 2);
+
+  // The same points with the dimensions along the rows
+  std::vector<std::vector<double>> data{{1.0, 2.0, 1.5, 3.0},
+                                        {4.0, 3.5, 5.0, 4.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 2, 4);
+  dwrapper.set(Arrangement::DimensionsAlongRowsPointsAlongCols);
+
+  KernelDistributionSettings kernel_settings;
+  kernel_settings.dist_settings = std::move(KernelSpecification(
+      settings::KernelCorrelation::Uncorrelated,
+      settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+      settings::KernelNormalization::None, settings::KernelMemory::Own,
+      settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate));
+
+  DistributionFactory dist_factory;
+  auto dist = dist_factory.create(train_dwrapper, kernel_settings);
+
+  std::vector<double> values;
+  std::vector<std::vector<double>> grads;
+  for (int pt = 0; pt < 4; ++pt) {
+    values.push_back(dist->compute(dwrapper, pt, kernel_settings));
+    grads.push_back(dist->compute_grad(dwrapper, pt, pt, kernel_settings));
+  }
+
+  // Distributions read a single point in place, only entropy terms copy the
+  // descriptors
+  dwrapper.setLayoutCache(settings::LayoutCache::PointMajor);
+  instrumentation::reset();
+  for (int pt = 0; pt < 4; ++pt) {
+    REQUIRE(dist->compute(dwrapper, pt, kernel_settings) ==
+            Approx(values.at(pt)));
+    auto grad = dist->compute_grad(dwrapper, pt, pt, kernel_settings);
+    REQUIRE(grad.size() == grads.at(pt).size());
+    for (size_t dim = 0; dim < grad.size(); ++dim) {
+      REQUIRE(grad.at(dim) == Approx(grads.at(pt).at(dim)));
+    }
+  }
+  REQUIRE(instrumentation::count(
+              instrumentation::Event::LayoutPointMajorBuilt) == 0);
+}
+
+TEST_CASE("Testing:distributions with kernels mapped from a binary restart",
+          "[integration,panacea]") {
+
+  // Enough points that the mapped kernels are streamed in more than a single
+  // block
+  const int dims = 2;
+  const int num_pts =
+      constants::kernel_stream_block_bytes / (dims * sizeof(double)) + 5;
+  std::vector<std::vector<double>> data(num_pts, std::vector<double>(dims));
+  for (int pt = 0; pt < num_pts; ++pt) {
+    data[pt][0] = 0.001 * pt;
+    data[pt][1] = static_cast<double>(pt % 7);
+  }
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(
+      &data, num_pts, dims);
+
+  // Owned kernels are held by the shared kernel wrapper which adopts the
+  // mapped kernel data when the restart file is read
+  KernelDistributionSettings kernel_settings;
+  kernel_settings.dist_settings = std::move(KernelSpecification(
+      settings::KernelCorrelation::Uncorrelated,
+      settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+      settings::KernelNormalization::None, settings::KernelMemory::Own,
+      settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate));
+
+  DistributionFactory dist_factory;
+  auto dist = dist_factory.create(dwrapper, kernel_settings);
+
+  io::FileIOFactory file_io_factory;
+  auto restart_file = file_io_factory.create(settings::FileType::BinaryRestart);
+  restart_file->write(dist.get(), "distribution_mapped.bin_restart");
+
+  auto dist_mapped = dist_factory.create(kernel_settings);
+  restart_file->read(dist_mapped.get(), "distribution_mapped.bin_restart");
+
+  for (const int pt : {0, num_pts / 2, num_pts - 1}) {
+    REQUIRE(dist_mapped->compute(dwrapper, pt, kernel_settings) ==
+            Approx(dist->compute(dwrapper, pt, kernel_settings)));
+  }
+}
@@ -1,12 +1,16 @@
 
 // Local private includes
 #include "descriptors/descriptor_wrapper.hpp"
+#include "io/file_checkpoint_log.hpp"
 #include "io/file_io_factory.hpp"
 #include "kernels/kernel_specifications.hpp"
+#include "kernels/kernel_store.hpp"
 #include "kernels/kernel_wrapper.hpp"
 #include "kernels/kernel_wrapper_factory.hpp"
 #include "kernels/mean_kernel_wrapper.hpp"
 #include "kernels/median_kernel_wrapper.hpp"
+#include "kernels/shared_kernel_wrapper.hpp"
+#include "memory_mapped_array.hpp"
 
 #include "helper.hpp"
 
@@ -17,7 +21,11 @@
 #include <catch2/catch.hpp>
 
 // Standard includes
+#include <any>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string>
 #include <vector>
 
 using namespace std;
@@ -50,3 +58,200 @@ TEST_CASE("Testing:mean kernel_wrapper write & read using fileio",
   auto type_ind_data = std::type_index(typeid(vector<double>));
   REQUIRE(mean_kwrapper2.getTypeIndex() == type_ind_data);
 }
+
+TEST_CASE("Testing:shared kernel_wrapper binary restart using fileio",
+          "[integration,panacea]") {
+
+  // Enough points that the kernels span more than a single chunk
+  const int cols = 2;
+  const int rows = KernelStore(cols).rowsPerChunk() + 3;
+  std::vector<std::vector<double>> data(rows, std::vector<double>(cols));
+  for (int row = 0; row < rows; ++row) {
+    data[row][0] = 0.5 * row;
+    data[row][1] = 1.0 / (row + 1.0);
+  }
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, rows, cols);
+
+  SharedKernelWrapper kwrapper(test::Test::key(), dwrapper);
+  BaseKernelWrapper *kwrapper_ptr = &kwrapper;
+
+  io::FileIOFactory file_io_factory;
+  auto restart_file = file_io_factory.create(settings::FileType::BinaryRestart);
+  REQUIRE(restart_file->type() == settings::FileType::BinaryRestart);
+
+  std::vector<std::vector<double>> empty_data;
+  SharedKernelWrapper kwrapper2(test::Test::key(), empty_data, 0, 0);
+  BaseKernelWrapper *kwrapper_ptr2 = &kwrapper2;
+
+  WHEN("Reading the restart file by name the kernels are memory mapped") {
+    restart_file->write(kwrapper_ptr, "test_kernel_shared.bin_restart");
+    restart_file->read(kwrapper_ptr2, "test_kernel_shared.bin_restart");
+
+    REQUIRE(kwrapper2.rows() == rows);
+    REQUIRE(kwrapper2.cols() == cols);
+    REQUIRE(kwrapper2.getNumberPoints() == rows);
+    auto store = std::any_cast<const KernelStore *>(
+        kwrapper2.getPointerToRawData());
+    REQUIRE(store->mapped());
+    // Kernel distributions stream the rows of the reported array
+    REQUIRE(kwrapper2.mappedRows() == store->mappedArray());
+    REQUIRE(kwrapper2.mappedRows()->rows() == rows);
+    // Primitives read the kernels without detaching them from the mapping
+    const BaseKernelWrapper &kernels = kwrapper2;
+    REQUIRE(kernels.at(rows - 1, 1) == data[rows - 1][1]);
+    REQUIRE(kwrapper2.mappedRows() == store->mappedArray());
+    for (int row = 0; row < rows; ++row) {
+      REQUIRE(kwrapper2.at(row, 0) == data[row][0]);
+      REQUIRE(kwrapper2.at(row, 1) == data[row][1]);
+    }
+
+    // Appending points past the end of the mapping
+    data.push_back({-1.0, -2.0});
+    data.push_back({-3.0, -4.0});
+    DescriptorWrapper<vector<vector<double>> *> dwrapper2(&data, rows + 2,
+                                                          cols);
+    kwrapper2.update(dwrapper2);
+    REQUIRE(kwrapper2.rows() == rows + 2);
+    REQUIRE(kwrapper2.at(0, 1) == data[0][1]);
+    REQUIRE(kwrapper2.at(rows - 1, 0) == data[rows - 1][0]);
+    REQUIRE(kwrapper2.at(rows + 1, 1) == Approx(-4.0));
+    // The adopted storage is not written in place, the update copies it
+    REQUIRE(kwrapper2.mappedRows() == nullptr);
+  }
+
+  WHEN("Writing the kernels back to the file they are mapped from") {
+    restart_file->write(kwrapper_ptr, "test_kernel_shared_back.bin_restart");
+    restart_file->read(kwrapper_ptr2, "test_kernel_shared_back.bin_restart");
+    auto store = std::any_cast<const KernelStore *>(
+        kwrapper2.getPointerToRawData());
+    REQUIRE(store->mapped());
+
+    restart_file->write(kwrapper_ptr2, "test_kernel_shared_back.bin_restart");
+    // The mapping still holds the contents it was read from
+    REQUIRE(kwrapper2.at(rows - 1, 1) == data[rows - 1][1]);
+
+    SharedKernelWrapper kwrapper3(test::Test::key(), empty_data, 0, 0);
+    BaseKernelWrapper *kwrapper_ptr3 = &kwrapper3;
+    restart_file->read(kwrapper_ptr3, "test_kernel_shared_back.bin_restart");
+    REQUIRE(kwrapper3.rows() == rows);
+    for (int row = 0; row < rows; ++row) {
+      REQUIRE(kwrapper3.at(row, 0) == data[row][0]);
+      REQUIRE(kwrapper3.at(row, 1) == data[row][1]);
+    }
+  }
+
+  WHEN("Reading a restart file with a corrupt section table") {
+    restart_file->write(kwrapper_ptr, "test_kernel_shared_bad.bin_restart");
+    std::fstream fs("test_kernel_shared_bad.bin_restart",
+                    std::fstream::in | std::fstream::out |
+                        std::fstream::binary);
+    // Claim far more sections than the record holds
+    const char num_sections[8] = {'\0', '\0', '\0', '\0',
+                                  '\0', '\0', '\0', '\x10'};
+    fs.seekp(16);
+    fs.write(num_sections, sizeof(num_sections));
+    fs.close();
+    REQUIRE_THROWS(restart_file->read(kwrapper_ptr2,
+                                      "test_kernel_shared_bad.bin_restart"));
+  }
+
+  WHEN("Reading several restart records from a stream the kernels are "
+       "copied") {
+    MeanKernelWrapper mean_kwrapper(test::Test::key(), dwrapper);
+    BaseKernelWrapper *mean_kwrapper_ptr = &mean_kwrapper;
+
+    std::fstream fs("test_kernel_shared_stream.bin_restart",
+                    std::fstream::out | std::fstream::binary);
+    restart_file->write(mean_kwrapper_ptr, fs);
+    restart_file->write(kwrapper_ptr, fs);
+    fs.close();
+
+    MeanKernelWrapper mean_kwrapper2(test::Test::key());
+    mean_kwrapper_ptr = &mean_kwrapper2;
+    std::fstream fs2("test_kernel_shared_stream.bin_restart",
+                     std::fstream::in | std::fstream::binary);
+    restart_file->read(mean_kwrapper_ptr, fs2);
+    restart_file->read(kwrapper_ptr2, fs2);
+    fs2.close();
+
+    REQUIRE(mean_kwrapper2.at(0, 0) == Approx(mean_kwrapper.at(0, 0)));
+    REQUIRE(mean_kwrapper2.at(0, 1) == Approx(mean_kwrapper.at(0, 1)));
+    auto store = std::any_cast<const KernelStore *>(
+        kwrapper2.getPointerToRawData());
+    REQUIRE_FALSE(store->mapped());
+    REQUIRE(kwrapper2.mappedRows() == nullptr);
+    REQUIRE(kwrapper2.rows() == rows);
+    for (int row = 0; row < rows; ++row) {
+      REQUIRE(kwrapper2.at(row, 0) == data[row][0]);
+      REQUIRE(kwrapper2.at(row, 1) == data[row][1]);
+    }
+  }
+}
+
+TEST_CASE("Testing:shared kernel_wrapper checkpoint log",
+          "[integration,panacea]") {
+
+  const int cols = 2;
+  std::vector<std::vector<double>> data{{0.5, 1.0}, {1.5, 2.0}, {2.5, 3.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, 3, cols);
+  SharedKernelWrapper kwrapper(test::Test::key(), dwrapper);
+  BaseKernelWrapper *kwrapper_ptr = &kwrapper;
+
+  for (const auto file_type : {settings::FileType::TXTRestart,
+                               settings::FileType::BinaryRestart}) {
+    io::FileCheckpointLog log(file_type, "test_kernel_shared.log");
+    log.append(kwrapper_ptr);
+    const auto full_size = std::ifstream("test_kernel_shared.log",
+                                         std::ios::binary | std::ios::ate)
+                               .tellg();
+
+    // Only the appended points are written by the following records
+    data.push_back({-1.0, -2.0});
+    data.push_back({-3.0, -4.0});
+    DescriptorWrapper<vector<vector<double>> *> dwrapper2(&data, 5, cols);
+    kwrapper.update(dwrapper2);
+    log.append(kwrapper_ptr);
+    log.append(kwrapper_ptr);
+
+    std::ifstream log_file("test_kernel_shared.log", std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(log_file)),
+                         std::istreambuf_iterator<char>());
+    REQUIRE(contents.find("Append 3\n") != std::string::npos);
+    REQUIRE(contents.find("Append 5\n") != std::string::npos);
+
+    std::vector<std::vector<double>> empty_data;
+    SharedKernelWrapper kwrapper2(test::Test::key(), empty_data, 0, 0);
+    BaseKernelWrapper *kwrapper_ptr2 = &kwrapper2;
+    log.read(kwrapper_ptr2);
+    REQUIRE(kwrapper2.rows() == 5);
+    for (int row = 0; row < 5; ++row) {
+      REQUIRE(kwrapper2.at(row, 0) == data[row][0]);
+      REQUIRE(kwrapper2.at(row, 1) == data[row][1]);
+    }
+
+    // Replacing the points forces a full record
+    data = {{7.0, 8.0}, {9.0, 10.0}};
+    DescriptorWrapper<vector<vector<double>> *> dwrapper3(&data, 2, cols);
+    kwrapper.update(dwrapper3);
+    log.append(kwrapper_ptr);
+    SharedKernelWrapper kwrapper3(test::Test::key(), empty_data, 0, 0);
+    BaseKernelWrapper *kwrapper_ptr3 = &kwrapper3;
+    log.read(kwrapper_ptr3);
+    REQUIRE(kwrapper3.rows() == 2);
+    REQUIRE(kwrapper3.at(1, 1) == 10.0);
+
+    // Compacting leaves a single full record
+    log.compact(kwrapper_ptr);
+    REQUIRE(std::ifstream("test_kernel_shared.log",
+                          std::ios::binary | std::ios::ate)
+                .tellg() <= full_size);
+    SharedKernelWrapper kwrapper4(test::Test::key(), empty_data, 0, 0);
+    BaseKernelWrapper *kwrapper_ptr4 = &kwrapper4;
+    log.read(kwrapper_ptr4);
+    REQUIRE(kwrapper4.rows() == 2);
+    REQUIRE(kwrapper4.at(0, 0) == 7.0);
+
+    data = {{0.5, 1.0}, {1.5, 2.0}, {2.5, 3.0}};
+    kwrapper.update(dwrapper);
+  }
+}
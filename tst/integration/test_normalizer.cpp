@@ -3,12 +3,15 @@
 #include "attribute_manipulators/normalizer.hpp"
 
 #include "attributes/covariance.hpp"
+#include "descriptors/descriptor_summary.hpp"
+#include "descriptors/descriptor_wrapper.hpp"
 #include "io/file_io_factory.hpp"
 #include "matrix/matrix.hpp"
 #include "vector/vector.hpp"
 
 // Public PANACEA includes
 #include "panacea/file_io.hpp"
+#include "panacea/settings.hpp"
 
 // Third party includes
 #include <catch2/catch.hpp>
@@ -38,3 +41,77 @@ TEST_CASE("Testing:normalizer write & read using fileio",
   REQUIRE(norm_coeffs.at(1) == norm_coeffs2.at(1));
   REQUIRE(norm_coeffs.at(2) == norm_coeffs2.at(2));
 }
+
+TEST_CASE("Testing:normalizer and covariance from merged descriptor summaries",
+          "[integration,panacea]") {
+  std::vector<std::vector<double>> data1{
+      {0.0, 4.0, 2.0}, {1.0, 3.0, 1.0}, {2.0, 1.0, 5.0}, {3.0, 8.0, 2.0}};
+  std::vector<std::vector<double>> data2{{4.0, 2.0, 3.0}, {8.0, 6.0, 2.5}};
+  std::vector<std::vector<double>> all_data = data1;
+  all_data.insert(all_data.end(), data2.begin(), data2.end());
+
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper1(&data1, 4,
+                                                                   3);
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper2(&data2, 2,
+                                                                   3);
+  DescriptorWrapper<std::vector<std::vector<double>> *> all_dwrapper(
+      &all_data, 6, 3);
+
+  io::FileIOFactory file_io_factory;
+  auto txt_file = file_io_factory.create(settings::FileType::TXTDescriptors,
+                                         settings::DescriptorSidecar::Summary);
+  auto binary_file =
+      file_io_factory.create(settings::FileType::BinaryDescriptors,
+                             settings::DescriptorSidecar::Summary);
+  txt_file->write(static_cast<BaseDescriptorWrapper *>(&dwrapper1),
+                  "test_summary_descriptors1.txt");
+  binary_file->write(static_cast<BaseDescriptorWrapper *>(&dwrapper2),
+                     "test_summary_descriptors2.bin");
+
+  REQUIRE_THROWS(file_io_factory.create(settings::FileType::TXTRestart,
+                                        settings::DescriptorSidecar::Summary));
+
+  const DescriptorSummary merged =
+      mergeSummaries({summaryFileName("test_summary_descriptors1.txt"),
+                      summaryFileName("test_summary_descriptors2.bin")});
+  REQUIRE(merged.statistics().getNumberPoints() == 6);
+
+  WHEN("Creating a covariance matrix from the merged statistics") {
+    auto cov = Covariance::create(merged.statistics(),
+                                  settings::KernelCorrelation::Correlated,
+                                  CovarianceOption::Flexible);
+    auto all_cov = Covariance::create(all_dwrapper,
+                                      settings::KernelCorrelation::Correlated,
+                                      CovarianceOption::Flexible);
+    REQUIRE(cov->getCummulativeDescPoints() == 6);
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 3; ++col) {
+        REQUIRE((*cov)(row, col) == Approx((*all_cov)(row, col)));
+      }
+    }
+  }
+
+  WHEN("Creating and updating a normalizer from the statistics") {
+    Normalizer normalizer(merged.statistics(),
+                          settings::KernelNormalization::Variance);
+    Normalizer all_normalizer(all_dwrapper,
+                              settings::KernelNormalization::Variance);
+    const auto &coeffs = normalizer.getNormalizationCoeffs();
+    const auto &all_coeffs = all_normalizer.getNormalizationCoeffs();
+    REQUIRE(coeffs.size() == 3);
+    for (int dim = 0; dim < 3; ++dim) {
+      REQUIRE(coeffs.at(dim) == Approx(all_coeffs.at(dim)));
+    }
+
+    // With a history the statistics of each file are combined
+    const UpdatePolicy policy(settings::UpdateMode::SlidingWindow, 1.0, 2);
+    Normalizer streamed(DescriptorSummary(dwrapper1).statistics(),
+                        settings::KernelNormalization::Variance,
+                        NormalizerOption::Strict, policy);
+    streamed.update(DescriptorSummary(dwrapper2).statistics());
+    for (int dim = 0; dim < 3; ++dim) {
+      REQUIRE(streamed.getNormalizationCoeffs().at(dim) ==
+              Approx(all_coeffs.at(dim)));
+    }
+  }
+}
@@ -410,3 +410,52 @@ TEST_CASE("Testing:primitive group write & read using fileio",
             Approx(prim_grp2.primitives.at(0)->compute(dwrapper_init, 2)));
   }
 }
+
+TEST_CASE("Testing:primitive group update appends primitives",
+          "[integration,panacea]") {
+
+  std::vector<std::vector<double>> data{{1.0, 4.0}, {2.0, 5.0}, {3.0, 7.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper_init(&data, 3,
+                                                                      2);
+
+  auto correlation = GENERATE(settings::KernelCorrelation::Uncorrelated,
+                              settings::KernelCorrelation::Correlated);
+
+  KernelSpecification kernel_settings(
+      correlation, settings::KernelCount::OneToOne,
+      settings::KernelPrimitive::Gaussian, settings::KernelNormalization::None,
+      settings::KernelMemory::Own, settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate);
+
+  PrimitiveFactory prim_factory;
+  auto prim_grp = prim_factory.createGroup(dwrapper_init, kernel_settings,
+                                           "test_prim_group_append");
+  REQUIRE(prim_grp.primitives.size() == 3);
+  const auto *first_primitive = prim_grp.primitives.at(0).get();
+
+  // The same descriptors with two more points
+  data.push_back({4.0, 4.5});
+  data.push_back({2.5, 6.0});
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper_grown(&data, 5,
+                                                                       2);
+  prim_grp.update(dwrapper_grown);
+
+  REQUIRE(prim_grp.kernel_wrapper->getNumberPoints() == 5);
+  REQUIRE(prim_grp.primitives.size() == 5);
+  // Existing primitives are kept
+  REQUIRE(prim_grp.primitives.at(0).get() == first_primitive);
+
+  const double pre_factor = prim_grp.reduced_covariance->getGaussianPreFactor();
+  REQUIRE(pre_factor > 0.0);
+  for (int index = 0; index < 5; ++index) {
+    const auto &primitive = prim_grp.primitives.at(index);
+    REQUIRE(primitive->getId() == index);
+    // Old and new primitives see the updated covariance
+    REQUIRE(primitive->getPreFactor() == Approx(pre_factor));
+    // Every primitive is centered on its own point
+    REQUIRE(primitive->compute(dwrapper_grown, index) == Approx(pre_factor));
+  }
+  REQUIRE(prim_grp.primitives.at(0)->compute(dwrapper_grown, 4) <
+          pre_factor);
+}
@@ -4,6 +4,7 @@
 
 #include "attributes/covariance.hpp"
 #include "attributes/dimensions.hpp"
+#include "constants.hpp"
 #include "descriptors/descriptor_wrapper.hpp"
 #include "matrix/matrix.hpp"
 #include "vector/vector.hpp"
@@ -11,6 +12,10 @@
 // Third party includes
 #include <catch2/catch.hpp>
 
+// Standard includes
+#include <cmath>
+#include <vector>
+
 using namespace std;
 using namespace panacea;
 
@@ -164,3 +169,53 @@ TEST_CASE("Testing:reducer1", "[integration,panacea]") {
     }
   }
 }
+
+TEST_CASE("Testing:reducer cached determinant", "[integration,panacea]") {
+
+  // Log determinant and Gaussian prefactors computed directly from the
+  // entries of the reduced covariance matrix
+  auto check = [](const ReducedCovariance &reduced_covar) {
+    const int ndim = reduced_covar.getNumberDimensions();
+    auto mat = createMatrix(ndim, ndim);
+    for (int row = 0; row < ndim; ++row) {
+      for (int col = 0; col < ndim; ++col) {
+        mat->operator()(row, col) = reduced_covar(row, col);
+      }
+    }
+    const double det = mat->getDeterminant();
+    REQUIRE(det > 0.0);
+    const double log_pre_factor =
+        -0.5 * (std::log(det) + ndim * std::log(2.0 * constants::PI));
+    REQUIRE(reduced_covar.getDeterminant() == Approx(det));
+    REQUIRE(reduced_covar.getLogDeterminant() == Approx(std::log(det)));
+    REQUIRE(reduced_covar.getGaussianLogPreFactor() == Approx(log_pre_factor));
+    REQUIRE(reduced_covar.getGaussianPreFactor() ==
+            Approx(std::exp(log_pre_factor)));
+  };
+
+  std::vector<std::vector<double>> data{
+      {1.0, 4.0, 0.5}, {2.0, 3.0, 1.5}, {3.0, 7.0, -2.0}, {5.0, 1.0, 0.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 4, 3);
+  auto cov_ptr =
+      Covariance::create(dwrapper, settings::KernelCorrelation::Correlated,
+                         settings::KernelAlgorithm::Flexible);
+
+  Reducer reducer;
+  const ReducedCovariance reduced_covar =
+      reducer.reduce(*cov_ptr, Dimensions(std::vector<int>{0, 1, 2}));
+  REQUIRE(reduced_covar.getNumberDimensions() == 3);
+  check(reduced_covar);
+
+  // An updated covariance matrix is reduced into a new factorization
+  std::vector<std::vector<double>> more_data{{-4.0, 2.0, 6.0},
+                                             {8.0, -3.0, 2.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> more_dwrapper(
+      &more_data, 2, 3);
+  cov_ptr->update(more_dwrapper);
+  const ReducedCovariance updated_covar =
+      reducer.reduce(*cov_ptr, Dimensions(std::vector<int>{0, 1, 2}));
+  REQUIRE(updated_covar.getNumberDimensions() == 3);
+  check(updated_covar);
+  REQUIRE(updated_covar.getLogDeterminant() !=
+          Approx(reduced_covar.getLogDeterminant()));
+}
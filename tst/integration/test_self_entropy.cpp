@@ -9,18 +9,25 @@
 #include "distribution/distributions/kernel_distribution.hpp"
 #include "entropy/entropy_factory.hpp"
 #include "entropy/entropy_settings/entropy_settings.hpp"
+#include "entropy/entropy_terms/entropy_decorators/lazy_restart.hpp"
 #include "entropy/entropy_terms/entropy_decorators/numerical_grad.hpp"
 #include "entropy/entropy_terms/entropy_decorators/weight.hpp"
+#include "io/file_io_factory.hpp"
+#include "io/restart_delta.hpp"
 #include "kernels/kernel_specifications.hpp"
 #include "private_settings.hpp"
 
 #include "helper.hpp"
 
+// Public PANACEA includes
+#include "panacea/instrumentation.hpp"
+
 // Third party includes
 #include <catch2/catch.hpp>
 
 // Standard includes
 #include <cmath>
+#include <fstream>
 #include <memory>
 #include <vector>
 
@@ -108,6 +115,33 @@ TEST_CASE("Testing:self entropy", "[integration,panacea]") {
     // Check that opposite in direction
     REQUIRE(grad1.at(0) == Approx(grad2.at(0) * -1.0));
   }
+  WHEN("Writing the gradiant into a buffer that is reused") {
+    const auto grad = entropy_term->compute_grad(dwrapper_init, 0, settings);
+    const auto grad2 = entropy_term->compute_grad(dwrapper_init, 1, settings);
+
+    // The buffer is filled in place by the term and its decorators
+    std::vector<double> buffer(grad.size(), 0.0);
+    const double *buffer_data = buffer.data();
+    entropy_term->compute_grad(dwrapper_init, 0, buffer);
+    REQUIRE(buffer.data() == buffer_data);
+    REQUIRE(buffer.size() == grad.size());
+
+    entropy_term = std::make_unique<Weight>(std::move(entropy_term), 2.0);
+    entropy_term->compute_grad(dwrapper_init, 1, buffer);
+    REQUIRE(buffer.data() == buffer_data);
+    for (std::size_t dim = 0; dim < grad2.size(); ++dim) {
+      REQUIRE(buffer.at(dim) == Approx(2.0 * grad2.at(dim)));
+    }
+
+    entropy_term = std::make_unique<NumericalGrad>(std::move(entropy_term));
+    entropy_term->compute_grad(dwrapper_init, 0, buffer);
+    REQUIRE(buffer.data() == buffer_data);
+    REQUIRE(buffer.size() == grad.size());
+    for (std::size_t dim = 0; dim < grad.size(); ++dim) {
+      REQUIRE(buffer.at(dim) == Approx(2.0 * grad.at(dim)));
+    }
+    REQUIRE(entropy_term->compute_grad(dwrapper_init, 0) == buffer);
+  }
 }
 
 TEST_CASE("Testing:self entropy with Array Data2", "[integration,panacea]") {
@@ -316,3 +350,168 @@ TEST_CASE("Testing:self entropy shell + initialize", "[integration,panacea]") {
 
   REQUIRE(shell_term_entropy_value == Approx(initialized_term_entropy_value));
 }
+
+TEST_CASE("Testing:self entropy lazy restart", "[integration,panacea]") {
+
+  KernelDistributionSettings kernel_settings;
+  kernel_settings.dist_settings = std::move(KernelSpecification(
+      settings::KernelCorrelation::Uncorrelated,
+      settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+      settings::KernelNormalization::None, settings::KernelMemory::Own,
+      settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Strict, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate));
+
+  EntropySettings settings;
+  settings.type = settings::EntropyType::Self;
+  settings.setDistributionSettings(
+      std::move(std::make_unique<KernelDistributionSettings>(kernel_settings)));
+
+  // 3 points 2 dimensions
+  std::vector<std::vector<double>> data{{1.0, 4.0}, {2.0, 3.0}, {3.0, 6.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 3, 2);
+
+  EntropyFactory entropy_factory;
+  auto entropy_term = entropy_factory.create(dwrapper, settings);
+  const double entropy_value = entropy_term->compute(dwrapper);
+
+  io::FileIOFactory file_io_factory;
+  for (const auto file_type :
+       {settings::FileType::TXTRestart, settings::FileType::BinaryRestart}) {
+    auto restart_file = file_io_factory.create(file_type);
+    restart_file->write(entropy_term.get(), "self_entropy_lazy.restart");
+
+    auto lazy_term = entropy_factory.create("self_entropy_lazy.restart",
+                                            settings::RestartLoading::Lazy);
+    auto &lazy_restart = dynamic_cast<LazyRestart &>(*lazy_term);
+
+    // Only the statistics are read until the entropy term is evaluated
+    REQUIRE(lazy_term->getDimensions() == entropy_term->getDimensions());
+    REQUIRE(lazy_term->getMaximumNumberOfDimensions() == 2);
+    REQUIRE_FALSE(lazy_restart.loaded());
+
+    REQUIRE(lazy_term->compute(dwrapper) == Approx(entropy_value));
+    REQUIRE(lazy_restart.loaded());
+
+    // The kernels are not read from a restart file that was replaced
+    auto stale_term = entropy_factory.create("self_entropy_lazy.restart",
+                                             settings::RestartLoading::Lazy);
+    restart_file->write(entropy_term.get(), "self_entropy_lazy.restart");
+    REQUIRE_THROWS(stale_term->compute(dwrapper));
+  }
+}
+
+TEST_CASE("Testing:self entropy checkpoint snapshot holds the kernels",
+          "[integration,panacea]") {
+
+  KernelDistributionSettings kernel_settings;
+  kernel_settings.dist_settings = std::move(KernelSpecification(
+      settings::KernelCorrelation::Uncorrelated,
+      settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+      settings::KernelNormalization::None, settings::KernelMemory::Own,
+      settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate));
+
+  EntropySettings settings;
+  settings.type = settings::EntropyType::Self;
+  settings.setDistributionSettings(
+      std::move(std::make_unique<KernelDistributionSettings>(kernel_settings)));
+
+  std::vector<std::vector<double>> data{{1.0, 4.0}, {2.0, 3.0}, {3.0, 6.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 3, 2);
+  // The same points followed by another one, they are appended to the kernels
+  std::vector<std::vector<double>> more_data{
+      {1.0, 4.0}, {2.0, 3.0}, {3.0, 6.0}, {9.0, 0.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> more_dwrapper(
+      &more_data, 4, 2);
+
+  EntropyFactory entropy_factory;
+  io::FileIOFactory file_io_factory;
+  for (const auto file_type :
+       {settings::FileType::TXTRestart, settings::FileType::BinaryRestart}) {
+    auto entropy_term = entropy_factory.create(dwrapper, settings);
+    const double entropy_value = entropy_term->compute(dwrapper);
+
+    auto restart_file = file_io_factory.create(file_type);
+    io::RestartOStream snapshot;
+    snapshot.setSnapshot(true);
+    restart_file->write(entropy_term.get(), snapshot);
+    // The kernels are only serialized when the snapshot is rendered
+    REQUIRE(snapshot.deferred());
+
+    entropy_term->update(more_dwrapper);
+    REQUIRE(entropy_term->compute(dwrapper) != Approx(entropy_value));
+
+    {
+      std::ofstream file("self_entropy_snapshot.restart", std::ios::binary);
+      file << snapshot.render();
+    }
+    auto restarted_term =
+        entropy_factory.create("self_entropy_snapshot.restart",
+                               settings::RestartLoading::Eager);
+    REQUIRE(restarted_term->compute(dwrapper) == Approx(entropy_value));
+  }
+}
+
+TEST_CASE("Testing:self entropy resolves the layout once per evaluation",
+          "[integration,panacea]") {
+  // 4 points 2 dimensions
+  std::vector<std::vector<double>> train_data{
+      {1.0, 4.0}, {2.0, 3.5}, {1.5, 5.0}, {3.0, 4.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> train_dwrapper(
+      &train_data, 4, 2);
+
+  // The same points with the dimensions along the rows
+  std::vector<std::vector<double>> data{{1.0, 2.0, 1.5, 3.0},
+                                        {4.0, 3.5, 5.0, 4.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 2, 4);
+  dwrapper.set(Arrangement::DimensionsAlongRowsPointsAlongCols);
+
+  KernelDistributionSettings kernel_settings;
+  kernel_settings.dist_settings = std::move(KernelSpecification(
+      settings::KernelCorrelation::Uncorrelated,
+      settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+      settings::KernelNormalization::None, settings::KernelMemory::Own,
+      settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate));
+
+  EntropySettings settings;
+  settings.type = settings::EntropyType::Self;
+  settings.setDistributionSettings(
+      std::move(std::make_unique<KernelDistributionSettings>(kernel_settings)));
+
+  EntropyFactory entropy_factory;
+  auto entropy_term = entropy_factory.create(train_dwrapper, settings);
+
+  const double entropy = entropy_term->compute(dwrapper);
+  const auto grad = entropy_term->compute_grad(dwrapper, 1);
+
+  dwrapper.setLayoutCache(settings::LayoutCache::PointMajor);
+  instrumentation::reset();
+  REQUIRE(entropy_term->compute(dwrapper) == Approx(entropy));
+  REQUIRE(instrumentation::count(
+              instrumentation::Event::LayoutPointMajorBuilt) == 1);
+
+  // The copy does not outlive the call it was made for
+  const auto cached_grad = entropy_term->compute_grad(dwrapper, 1);
+  REQUIRE(instrumentation::count(
+              instrumentation::Event::LayoutPointMajorBuilt) == 2);
+  REQUIRE(cached_grad.size() == grad.size());
+  for (size_t dim = 0; dim < grad.size(); ++dim) {
+    REQUIRE(cached_grad.at(dim) == Approx(grad.at(dim)));
+  }
+  REQUIRE(instrumentation::count(instrumentation::Event::LayoutInPlace) == 0);
+
+  // Values written between calls are seen without notifying the wrapper
+  data[0][2] = 2.5;
+  data[1][2] = 3.0;
+  std::vector<std::vector<double>> moved_data{
+      {1.0, 4.0}, {2.0, 3.5}, {2.5, 3.0}, {3.0, 4.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> moved_dwrapper(
+      &moved_data, 4, 2);
+  REQUIRE(entropy_term->compute(dwrapper) ==
+          Approx(entropy_term->compute(moved_dwrapper)));
+  REQUIRE(entropy_term->compute(dwrapper) != Approx(entropy));
+}
@@ -12,6 +12,7 @@
 
 // Standard includes
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -781,3 +782,243 @@ TEST_CASE("Testing:panacea cross entropy read & write with fileio",
     }
   }
 }
+
+TEST_CASE("Testing:panacea cross entropy with sparse descriptors",
+          "[end-to-end,panacea]") {
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Cross)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Uncorrelated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::Variance);
+
+  PANACEA panacea_pi;
+
+  // 4 points 5 dimensions, mostly zero
+  std::vector<std::vector<double>> data = {{0.0, 1.0, 0.0, 0.0, 0.5},
+                                           {2.0, 0.0, 0.0, 0.0, 0.0},
+                                           {0.0, 0.0, 1.5, 0.0, 1.0},
+                                           {1.0, 0.5, 0.0, 0.0, 0.0}};
+  auto dense = panacea_pi.wrap(&data, 4, 5);
+  auto sparse = panacea_pi.wrapSparse(4, 5, {0, 2, 3, 5, 7},
+                                      {1, 4, 0, 2, 4, 0, 1},
+                                      {1.0, 0.5, 2.0, 1.5, 1.0, 1.0, 0.5});
+
+  auto cross_ent_dense = panacea_pi.create(*dense, panacea_settings);
+  auto cross_ent_sparse = panacea_pi.create(*sparse, panacea_settings);
+
+  REQUIRE(cross_ent_dense->compute(*dense, panacea_settings) ==
+          Approx(cross_ent_sparse->compute(*sparse, panacea_settings)));
+
+  for (int pt = 0; pt < 4; ++pt) {
+    auto grad_dense = cross_ent_dense->compute_grad(*dense, pt);
+    auto grad_sparse = cross_ent_sparse->compute_grad(*sparse, pt);
+    REQUIRE(grad_dense.size() == grad_sparse.size());
+    for (size_t dim = 0; dim < grad_dense.size(); ++dim) {
+      REQUIRE(grad_dense.at(dim) == Approx(grad_sparse.at(dim)));
+    }
+  }
+
+  // The terms of the kernels used by the sparse evaluation follow updates
+  cross_ent_dense->update(*dense);
+  cross_ent_sparse->update(*sparse);
+  REQUIRE(cross_ent_dense->compute(*dense, panacea_settings) ==
+          Approx(cross_ent_sparse->compute(*sparse, panacea_settings)));
+}
+
+TEST_CASE("Testing:panacea cross entropy restart written before update modes",
+          "[end-to-end,panacea]") {
+
+  // Restart file written before the update history sections were added
+  const std::string legacy_restart = R"RESTART([Entropy]
+Cross
+[Entropy Settings]
+Self
+SelfOwnIfRestartCrossOwn
+N/A
+N/A
+N/A
+None
+None
+[Distribution]
+Kernel
+[Prefactor]
+1
+[Primitive Group]
+
+[Kernel Specifications]
+Uncorrelated
+Single
+Gaussian
+Variance
+Own
+Mean
+Flexible
+No
+No
+-1
+
+[Normalization]
+Flexible
+2
+[Normalization Coefficients]
+1.25830573921179
+1.04083299973307
+[Kernel]
+Mean
+Single
+[Meta Data]
+[Total Number Points]
+3
+[Data]
+Points along rows dimensions along columns
+1 2
+     2.1666667      5.1666667 
+[Covariance]
+Uncorrelated
+3
+
+[Normalization State]
+Normalized
+
+[Matrix Type]
+Eigen
+
+[Matrix]
+2 2
+             1 0.922612906314877 
+             0 0.999999999999995 
+
+[Vector Type]
+Eigen
+Along Rows
+
+[Vector]
+2 1
+     2.1666667
+     5.1666667
+
+)RESTART";
+  {
+    std::ofstream restart_out("legacy_cross_entropy.restart");
+    restart_out << legacy_restart;
+  }
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Cross)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::Single)
+                                         .set(KernelCorrelation::Uncorrelated)
+                                         .set(KernelCenterCalculation::Mean)
+                                         .set(KernelNormalization::Variance);
+
+  PANACEA panacea_pi;
+  std::vector<std::vector<double>> data{{1.0, 4.0}, {2.0, 5.5}, {3.5, 6.0}};
+  auto dwrapper = panacea_pi.wrap(&data, 3, 2);
+  auto expected = panacea_pi.create(*dwrapper, panacea_settings);
+
+  auto restart_file = panacea_pi.create(settings::FileType::TXTRestart);
+  auto restarted = panacea_pi.create(panacea_settings);
+  restart_file->read(restarted.get(), "legacy_cross_entropy.restart");
+
+  // The updates of the older files were cumulative
+  REQUIRE(restarted->compute(*dwrapper) ==
+          Approx(expected->compute(*dwrapper)));
+  restarted->update(*dwrapper);
+  expected->update(*dwrapper);
+  REQUIRE(restarted->compute(*dwrapper) ==
+          Approx(expected->compute(*dwrapper)));
+}
+
+TEST_CASE("Testing:panacea cross entropy sliding window update",
+          "[end-to-end,panacea]") {
+
+  PANACEASettings cumulative_settings =
+      PANACEASettings::make()
+          .set(EntropyType::Cross)
+          .set(PANACEAAlgorithm::Flexible)
+          .distributionType(kernel)
+          .set(KernelPrimitive::Gaussian)
+          .set(KernelCount::Single)
+          .set(KernelCorrelation::Correlated)
+          .set(KernelCenterCalculation::Mean)
+          .set(KernelNormalization::None);
+
+  // Only the descriptors of the two most recent updates are kept, the
+  // descriptors the term is created from count as the first update
+  PANACEASettings window_settings = PANACEASettings::make()
+                                        .set(EntropyType::Cross)
+                                        .set(PANACEAAlgorithm::Flexible)
+                                        .distributionType(kernel)
+                                        .set(KernelPrimitive::Gaussian)
+                                        .set(KernelCount::Single)
+                                        .set(KernelCorrelation::Correlated)
+                                        .set(KernelCenterCalculation::Mean)
+                                        .set(KernelNormalization::None)
+                                        .set(UpdateMode::SlidingWindow)
+                                        .setUpdateWindowTo(2);
+
+  PANACEA panacea_pi;
+
+  // The distribution drifts away from the origin
+  std::vector<std::vector<double>> data1 = {
+      {0.0, 1.0}, {1.0, 0.0}, {-1.0, 0.5}, {0.5, -1.0}};
+  std::vector<std::vector<double>> data2 = {
+      {10.0, 11.5}, {11.0, 10.0}, {9.0, 10.5}, {10.5, 9.5}};
+  std::vector<std::vector<double>> data3 = {
+      {20.0, 21.0}, {21.5, 20.0}, {19.0, 20.5}, {20.5, 18.5}};
+  auto dwrapper1 = panacea_pi.wrap(&(data1), 4, 2);
+  auto dwrapper2 = panacea_pi.wrap(&(data2), 4, 2);
+  auto dwrapper3 = panacea_pi.wrap(&(data3), 4, 2);
+
+  std::unique_ptr<EntropyTerm> window_ent =
+      panacea_pi.create(*dwrapper1, window_settings);
+
+  WHEN("The window is not yet full") {
+    window_ent->update(*dwrapper2);
+
+    // Nothing has dropped out, so every point is kept as with cumulative
+    // updates
+    std::unique_ptr<EntropyTerm> expected_ent =
+        panacea_pi.create(*dwrapper1, cumulative_settings);
+    expected_ent->update(*dwrapper2);
+
+    for (auto *dwrapper : {dwrapper1.get(), dwrapper2.get(), dwrapper3.get()}) {
+      REQUIRE(window_ent->compute(*dwrapper) ==
+              Approx(expected_ent->compute(*dwrapper)));
+    }
+  }
+
+  WHEN("The window is full") {
+    window_ent->update(*dwrapper2);
+    window_ent->update(*dwrapper3);
+
+    // The points the term was created from have dropped out, so the term
+    // matches one that has only ever seen the last two updates
+    std::unique_ptr<EntropyTerm> expected_ent =
+        panacea_pi.create(*dwrapper2, cumulative_settings);
+    expected_ent->update(*dwrapper3);
+
+    std::unique_ptr<EntropyTerm> cumulative_ent =
+        panacea_pi.create(*dwrapper1, cumulative_settings);
+    cumulative_ent->update(*dwrapper2);
+    cumulative_ent->update(*dwrapper3);
+
+    for (auto *dwrapper : {dwrapper1.get(), dwrapper2.get(), dwrapper3.get()}) {
+      REQUIRE(window_ent->compute(*dwrapper) ==
+              Approx(expected_ent->compute(*dwrapper)));
+      REQUIRE(window_ent->compute(*dwrapper) !=
+              Approx(cumulative_ent->compute(*dwrapper)));
+    }
+
+    // Forgetting the points at the origin makes them far less likely
+    REQUIRE(window_ent->compute(*dwrapper1) >
+            cumulative_ent->compute(*dwrapper1));
+  }
+}
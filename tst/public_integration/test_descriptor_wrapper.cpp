@@ -11,6 +11,8 @@
 #include <catch2/catch.hpp>
 
 // Standard includes
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <vector>
 
@@ -68,3 +70,56 @@ TEST_CASE("Testing:panacea-descriptor_wrapper", "[end-to-end,panacea]") {
     REQUIRE(dwrapper->operator()(0, 0) == 12.0);
   }
 }
+
+TEST_CASE("Testing:panacea merge descriptor summaries",
+          "[end-to-end,panacea]") {
+
+  // pi - public interface
+  PANACEA panacea_pi;
+
+  std::vector<std::vector<double>> data1{{0.0, 4.0}, {1.0, 3.0}, {2.0, 1.0}};
+  std::vector<std::vector<double>> data2{{4.0, 2.0}, {8.0, 6.0}};
+  auto dwrapper1 = panacea_pi.wrap(&data1, 3, 2);
+  auto dwrapper2 = panacea_pi.wrap(&data2, 2, 2);
+
+  auto txt_file = panacea_pi.create(settings::FileType::TXTDescriptors,
+                                    settings::DescriptorSidecar::Summary);
+  auto binary_file = panacea_pi.create(settings::FileType::BinaryDescriptors,
+                                       settings::DescriptorSidecar::Summary);
+  txt_file->write(dwrapper1.get(), "panacea_summary_descriptors1.txt");
+  binary_file->write(dwrapper2.get(), "panacea_summary_descriptors2.bin");
+
+  auto summary =
+      panacea_pi.mergeSummaries({"panacea_summary_descriptors1.txt.summary",
+                                 "panacea_summary_descriptors2.bin.summary"});
+  REQUIRE(summary->getNumberPoints() == 5);
+  REQUIRE(summary->getNumberDimensions() == 2);
+  REQUIRE(summary->getMin(0) == Approx(0.0));
+  REQUIRE(summary->getMax(0) == Approx(8.0));
+  REQUIRE(summary->getMin(1) == Approx(1.0));
+  REQUIRE(summary->getMax(1) == Approx(6.0));
+
+  // Sample variances of all five points, the descriptors are divided by
+  // their standard deviations
+  const std::vector<double> variances = {10.0, 3.7};
+  const auto coeffs =
+      summary->getNormalizationCoeffs(KernelNormalization::Variance);
+  REQUIRE(coeffs.size() == 2);
+  for (int dim = 0; dim < 2; ++dim) {
+    REQUIRE(summary->getVariance(dim) == Approx(variances.at(dim)));
+    REQUIRE(coeffs.at(dim) == Approx(std::sqrt(variances.at(dim))));
+  }
+
+  double total = 0.0;
+  for (int bin = 0; bin < summary->getNumberBins(); ++bin) {
+    total += summary->getBinCount(0, bin);
+  }
+  REQUIRE(total == Approx(5.0));
+
+  for (const auto *file_name : {"panacea_summary_descriptors1.txt",
+                                "panacea_summary_descriptors1.txt.summary",
+                                "panacea_summary_descriptors2.bin",
+                                "panacea_summary_descriptors2.bin.summary"}) {
+    std::remove(file_name);
+  }
+}
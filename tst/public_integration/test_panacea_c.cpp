@@ -0,0 +1,206 @@
+// Public PANACEA includes
+#include "panacea/panacea_c.h"
+
+#include "panacea/base_descriptor_wrapper.hpp"
+#include "panacea/entropy_term.hpp"
+#include "panacea/panacea.hpp"
+
+// Third party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace panacea;
+using namespace panacea::settings;
+
+TEST_CASE("Testing:panacea c interface self entropy", "[end-to-end,panacea]") {
+
+  // Three points with two dimensions
+  std::vector<std::vector<double>> data = {{0.0, 0.0}, {1.0, 0.5}, {2.0, 2.0}};
+  std::vector<double> point_major = {0.0, 0.0, 1.0, 0.5, 2.0, 2.0};
+  std::vector<double> dimension_major = {0.0, 1.0, 2.0, 0.0, 0.5, 2.0};
+  const int points = 3;
+  const int dims = 2;
+
+  PANACEASettings cpp_settings = PANACEASettings::make()
+                                     .set(EntropyType::Self)
+                                     .set(PANACEAAlgorithm::Flexible)
+                                     .distributionType(kernel)
+                                     .set(KernelPrimitive::Gaussian)
+                                     .set(KernelCount::OneToOne)
+                                     .set(KernelCorrelation::Uncorrelated)
+                                     .set(KernelCenterCalculation::None)
+                                     .set(KernelNormalization::None);
+  PANACEA panacea_pi;
+  auto dwrapper = panacea_pi.wrap(&data, points, dims);
+  auto self_ent = panacea_pi.create(*dwrapper, cpp_settings);
+  const double expected = self_ent->compute(*dwrapper);
+  const std::vector<double> expected_grad =
+      self_ent->compute_grad(*dwrapper, 1);
+
+  panacea_settings *c_settings = nullptr;
+  REQUIRE(panacea_settings_create(PANACEA_SELF, &c_settings) ==
+          PANACEA_SUCCESS);
+
+  for (const auto layout : {PANACEA_POINT_MAJOR, PANACEA_DIMENSION_MAJOR}) {
+    WHEN("Wrapping a caller array, layout " + std::to_string(layout)) {
+      double *values = layout == PANACEA_POINT_MAJOR ? point_major.data()
+                                                     : dimension_major.data();
+      panacea_descriptors *descriptors = nullptr;
+      REQUIRE(panacea_descriptors_wrap(values, points, dims, layout,
+                                       &descriptors) == PANACEA_SUCCESS);
+
+      panacea_entropy_term *term = nullptr;
+      REQUIRE(panacea_entropy_term_create(descriptors, c_settings, &term) ==
+              PANACEA_SUCCESS);
+
+      int term_dims = 0;
+      REQUIRE(panacea_entropy_term_dimensions(term, &term_dims) ==
+              PANACEA_SUCCESS);
+      REQUIRE(term_dims == dims);
+
+      double entropy = 0.0;
+      REQUIRE(panacea_entropy_term_compute(term, descriptors, &entropy) ==
+              PANACEA_SUCCESS);
+      REQUIRE(entropy == Approx(expected));
+
+      std::vector<double> grad(dims, 0.0);
+      REQUIRE(panacea_entropy_term_compute_grad(term, descriptors, 1,
+                                                grad.data(), dims) ==
+              PANACEA_SUCCESS);
+      REQUIRE(grad[0] == Approx(expected_grad[0]));
+      REQUIRE(grad[1] == Approx(expected_grad[1]));
+
+      THEN("Errors are reported instead of thrown") {
+        REQUIRE(panacea_entropy_term_compute_grad(term, descriptors, 1,
+                                                  grad.data(), 1) ==
+                PANACEA_FAILURE);
+        REQUIRE(std::string(panacea_last_error()).find("Gradient buffer") !=
+                std::string::npos);
+        REQUIRE(panacea_entropy_term_compute_point(term, descriptors, points,
+                                                   &entropy) ==
+                PANACEA_FAILURE);
+      }
+
+      THEN("The kernels share the caller array") {
+        // Moving every point by the same amount does not change the entropy
+        for (auto &value : point_major) {
+          value += 1.0;
+        }
+        for (auto &value : dimension_major) {
+          value += 1.0;
+        }
+        double moved = 0.0;
+        REQUIRE(panacea_entropy_term_compute(term, descriptors, &moved) ==
+                PANACEA_SUCCESS);
+        REQUIRE(moved == Approx(expected));
+      }
+
+      THEN("A restart file can be written and read back") {
+        const std::string file_name =
+            "c_interface_restart" + std::to_string(layout) + ".bin";
+        REQUIRE(panacea_entropy_term_write_restart(
+                    term, PANACEA_BINARY_RESTART, file_name.c_str()) ==
+                PANACEA_SUCCESS);
+
+        panacea_entropy_term *restarted = nullptr;
+        REQUIRE(panacea_entropy_term_create_from_restart(
+                    file_name.c_str(), PANACEA_LAZY, &restarted) ==
+                PANACEA_SUCCESS);
+        double restarted_entropy = 0.0;
+        REQUIRE(panacea_entropy_term_compute(restarted, descriptors,
+                                             &restarted_entropy) ==
+                PANACEA_SUCCESS);
+        REQUIRE(restarted_entropy == Approx(expected));
+
+        // The kernels of the restarted term are mapped from the file they
+        // are written back to
+        REQUIRE(panacea_entropy_term_write_restart(
+                    restarted, PANACEA_BINARY_RESTART, file_name.c_str()) ==
+                PANACEA_SUCCESS);
+        REQUIRE(panacea_entropy_term_compute(restarted, descriptors,
+                                             &restarted_entropy) ==
+                PANACEA_SUCCESS);
+        REQUIRE(restarted_entropy == Approx(expected));
+
+        panacea_entropy_term *rewritten = nullptr;
+        REQUIRE(panacea_entropy_term_create_from_restart(
+                    file_name.c_str(), PANACEA_EAGER, &rewritten) ==
+                PANACEA_SUCCESS);
+        double rewritten_entropy = 0.0;
+        REQUIRE(panacea_entropy_term_compute(rewritten, descriptors,
+                                             &rewritten_entropy) ==
+                PANACEA_SUCCESS);
+        REQUIRE(rewritten_entropy == Approx(expected));
+        panacea_entropy_term_destroy(rewritten);
+        panacea_entropy_term_destroy(restarted);
+        std::remove(file_name.c_str());
+      }
+
+      THEN("The descriptors can be written to a binary descriptor file") {
+        const std::string file_name =
+            "c_interface_descriptors" + std::to_string(layout) + ".bin";
+        REQUIRE(panacea_descriptors_write(descriptors, file_name.c_str()) ==
+                PANACEA_SUCCESS);
+        auto mapped = panacea_pi.wrap(file_name);
+        REQUIRE(mapped->getNumberPoints() == points);
+        REQUIRE(mapped->getNumberDimensions() == dims);
+        for (int point = 0; point < points; ++point) {
+          for (int dim = 0; dim < dims; ++dim) {
+            REQUIRE((*mapped)(point, dim) == data[point][dim]);
+          }
+        }
+        mapped.reset();
+        std::remove(file_name.c_str());
+      }
+
+      panacea_entropy_term_destroy(term);
+      panacea_descriptors_destroy(descriptors);
+    }
+  }
+  panacea_settings_destroy(c_settings);
+}
+
+TEST_CASE("Testing:panacea c interface unknown enumerators",
+          "[end-to-end,panacea]") {
+
+  // Values outside of the C enumerations are reported, not cast
+  auto requireUnknown = [](const int status) {
+    REQUIRE(status == PANACEA_FAILURE);
+    REQUIRE(std::string(panacea_last_error()).find("Unknown") !=
+            std::string::npos);
+  };
+
+  panacea_settings *c_settings = nullptr;
+  requireUnknown(panacea_settings_create(static_cast<panacea_entropy_type>(2),
+                                         &c_settings));
+  REQUIRE(c_settings == nullptr);
+
+  REQUIRE(panacea_settings_create(PANACEA_SELF, &c_settings) ==
+          PANACEA_SUCCESS);
+  requireUnknown(panacea_settings_set_algorithm(
+      c_settings, static_cast<panacea_algorithm>(-1)));
+  requireUnknown(panacea_settings_set_kernel_primitive(
+      c_settings, static_cast<panacea_kernel_primitive>(3)));
+  requireUnknown(panacea_settings_set_kernel_count(
+      c_settings, static_cast<panacea_kernel_count>(3)));
+  requireUnknown(panacea_settings_set_kernel_correlation(
+      c_settings, static_cast<panacea_kernel_correlation>(2)));
+  requireUnknown(panacea_settings_set_kernel_center(
+      c_settings, static_cast<panacea_kernel_center>(4)));
+  requireUnknown(panacea_settings_set_kernel_normalization(
+      c_settings, static_cast<panacea_kernel_normalization>(2)));
+  panacea_settings_destroy(c_settings);
+
+  panacea_entropy_term *term = nullptr;
+  requireUnknown(panacea_entropy_term_create_from_restart(
+      "c_interface_missing.restart", static_cast<panacea_restart_loading>(2),
+      &term));
+  REQUIRE(term == nullptr);
+  REQUIRE(std::string(panacea_last_error()).find("restart loading") !=
+          std::string::npos);
+}
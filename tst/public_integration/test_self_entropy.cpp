@@ -12,7 +12,12 @@
 
 // Standard includes
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -348,6 +353,53 @@ TEST_CASE("Testing:panacea self entropy read & write with fileio",
     }
   }
 
+  GIVEN("A self entropy term written to a binary restart file") {
+    PANACEASettings panacea_settings = PANACEASettings::make()
+                                           .set(EntropyType::Self)
+                                           .set(PANACEAAlgorithm::Flexible)
+                                           .distributionType(kernel)
+                                           .set(KernelPrimitive::Gaussian)
+                                           .set(KernelCount::OneToOne)
+                                           .set(KernelCorrelation::Uncorrelated)
+                                           .set(KernelCenterCalculation::None)
+                                           .set(KernelNormalization::None);
+
+    std::unique_ptr<EntropyTerm> self_ent =
+        panacea_pi.create(*dwrapper, panacea_settings);
+
+    double self_ent_val = self_ent->compute(*dwrapper, panacea_settings);
+    auto restart_file = panacea_pi.create(settings::FileType::BinaryRestart);
+
+    WHEN("provided with file_name") {
+      restart_file->write(self_ent.get(), "self_entropy_restart.bin");
+
+      std::unique_ptr<EntropyTerm> self_ent2 =
+          panacea_pi.create(panacea_settings);
+
+      restart_file->read(self_ent2.get(), "self_entropy_restart.bin");
+      double self_ent_val2 = self_ent2->compute(*dwrapper, panacea_settings);
+
+      REQUIRE(self_ent_val == Approx(self_ent_val2));
+    }
+    WHEN("provided with file stream") {
+
+      ofstream restart_out;
+      restart_out.open("self_entropy_restart2.bin", std::ios::binary);
+      restart_file->write(self_ent.get(), restart_out);
+      restart_out.close();
+      std::unique_ptr<EntropyTerm> self_ent2 =
+          panacea_pi.create(panacea_settings);
+
+      ifstream restart_in;
+      restart_in.open("self_entropy_restart2.bin", std::ios::binary);
+      restart_file->read(self_ent2.get(), restart_in);
+      restart_in.close();
+      double self_ent_val2 = self_ent2->compute(*dwrapper, panacea_settings);
+
+      REQUIRE(self_ent_val == Approx(self_ent_val2));
+    }
+  }
+
   GIVEN("A weighted self entropy term") {
     // Creating settings for generating a self entropy term where the
     // underlying distribution is using a kernel estimator
@@ -462,3 +514,453 @@ TEST_CASE("Testing:panacea self entropy update", "[end-to-end,panacea]") {
             << self_ent_three_pts << std::endl;
   REQUIRE(self_ent_two_pts < self_ent_three_pts);
 }
+
+TEST_CASE("Testing:panacea self entropy update from descriptor file chunks",
+          "[end-to-end,panacea]") {
+
+  // The kernels of a default self entropy term share the memory of the
+  // descriptors it was created from
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Self)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Correlated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::None);
+
+  PANACEA panacea_pi;
+
+  std::vector<std::vector<double>> initial_data{
+      {7.3, 1.9, 4.9}, {0.3, 3.2, 1.8}, {2.9, 4.3, 9.2}};
+  std::vector<std::vector<double>> update_data{
+      {2.3, 1.8, 8.9}, {1.2, 1.3, 4.1}, {0.3, 3.3, 5.9}, {1.3, 2.9, 3.9},
+      {4.3, 0.2, 2.8}, {2.1, 3.3, 7.2}, {5.1, 0.9, 6.6}};
+
+  auto dwrapper = panacea_pi.wrap(&initial_data, 3, 3);
+  auto dwrapper_update = panacea_pi.wrap(&update_data, 7, 3);
+  auto descriptor_file = panacea_pi.create(FileType::TXTDescriptors);
+  BaseDescriptorWrapper *dwrapper_update_ptr = dwrapper_update.get();
+  descriptor_file->write(dwrapper_update_ptr, "self_ent_chunks.txt");
+
+  // Updating with the same chunks of 3, 3 and 1 points in memory
+  std::vector<std::vector<std::vector<double>>> chunks{
+      {update_data.begin(), update_data.begin() + 3},
+      {update_data.begin() + 3, update_data.begin() + 6},
+      {update_data.begin() + 6, update_data.end()}};
+  auto self_ent = panacea_pi.create(*dwrapper, panacea_settings);
+  for (auto &chunk : chunks) {
+    auto chunk_wrapper = panacea_pi.wrap(&chunk, chunk.size(), 3);
+    self_ent->update(*chunk_wrapper);
+  }
+
+  for (const bool overlap : {false, true}) {
+    auto self_ent_streamed = panacea_pi.create(*dwrapper, panacea_settings);
+    {
+      auto reader = panacea_pi.createDescriptorStreamReader(
+          FileType::TXTDescriptors, "self_ent_chunks.txt", 3);
+      REQUIRE(reader->rows() == 7);
+      REQUIRE(reader->cols() == 3);
+      reader->update(*self_ent_streamed, overlap);
+      REQUIRE(reader->done());
+    }
+    // The chunks of the reader are gone, the kernels hold a copy of the last
+    for (int pt = 0; pt < 7; ++pt) {
+      REQUIRE(self_ent_streamed->compute(*dwrapper_update, pt) ==
+              Approx(self_ent->compute(*dwrapper_update, pt)));
+    }
+  }
+
+  REQUIRE_THROWS(panacea_pi.createDescriptorStreamReader(
+      FileType::TXTRestart, "self_ent_chunks.txt", 3));
+}
+
+TEST_CASE("Testing:panacea self entropy is identical after a restart",
+          "[end-to-end,panacea]") {
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Self)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Correlated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::Variance);
+
+  PANACEA panacea_pi;
+
+  // Values that need every digit of a double to be represented
+  std::vector<std::vector<double>> data;
+  for (int pt = 0; pt < 6; ++pt) {
+    data.push_back({std::sqrt(2.0 + pt), 1.0 / (3.0 + pt * pt),
+                    std::exp(-0.7 * pt) / 7.0});
+  }
+  auto dwrapper = panacea_pi.wrap(&data, 6, 3);
+  std::unique_ptr<EntropyTerm> self_ent =
+      panacea_pi.create(*dwrapper, panacea_settings);
+
+  for (const auto file_type : {FileType::TXTRestart, FileType::BinaryRestart}) {
+    auto restart_file = panacea_pi.create(file_type);
+    restart_file->write(self_ent.get(), "self_ent_identical.restart");
+    std::unique_ptr<EntropyTerm> self_ent2 =
+        panacea_pi.create(panacea_settings);
+    restart_file->read(self_ent2.get(), "self_ent_identical.restart");
+
+    REQUIRE(self_ent2->compute(*dwrapper) == self_ent->compute(*dwrapper));
+    for (int pt = 0; pt < 6; ++pt) {
+      REQUIRE(self_ent2->compute(*dwrapper, pt) ==
+              self_ent->compute(*dwrapper, pt));
+      REQUIRE(self_ent2->compute_grad(*dwrapper, pt) ==
+              self_ent->compute_grad(*dwrapper, pt));
+    }
+  }
+}
+
+TEST_CASE("Testing:panacea self entropy checkpoint", "[end-to-end,panacea]") {
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Self)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Uncorrelated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::None);
+
+  // pi - public interface
+  PANACEA panacea_pi;
+
+  std::vector<std::vector<double>> data = {{0.0, 0.0}, {10.0, 10.0}};
+  const std::vector<std::vector<double>> checkpointed_data = data;
+  auto dwrapper = panacea_pi.wrap(&(data), 2, 2);
+  std::unique_ptr<EntropyTerm> self_ent =
+      panacea_pi.create(*dwrapper, panacea_settings);
+  const double self_ent_val = self_ent->compute(*dwrapper, panacea_settings);
+
+  for (const auto file_type : {FileType::TXTRestart, FileType::BinaryRestart}) {
+    auto checkpoint = panacea_pi.createCheckpointWriter(file_type);
+    auto written = checkpoint->write(self_ent.get(), "self_ent.checkpoint");
+
+    // Changing the entropy term does not change the checkpoint
+    std::vector<std::vector<double>> update_data = {
+        {1.0, 3.0}, {5.0, 2.0}, {20.0, 20.0}};
+    auto dwrapper_update = panacea_pi.wrap(&(update_data), 3, 2);
+    std::unique_ptr<EntropyTerm> self_ent_updated =
+        panacea_pi.create(*dwrapper, panacea_settings);
+    checkpoint->write(self_ent_updated.get(), "self_ent_updated.checkpoint");
+    self_ent_updated->update(*dwrapper_update);
+
+    written.get();
+    checkpoint->wait();
+
+    std::ifstream partial("self_ent.checkpoint.partial");
+    REQUIRE_FALSE(partial.good());
+
+    auto restart_file = panacea_pi.create(file_type);
+    std::vector<std::vector<double>> data_copy = checkpointed_data;
+    auto dwrapper_copy = panacea_pi.wrap(&(data_copy), 2, 2);
+    for (const auto *file_name :
+         {"self_ent.checkpoint", "self_ent_updated.checkpoint"}) {
+      std::unique_ptr<EntropyTerm> self_ent2 =
+          panacea_pi.create(panacea_settings);
+      restart_file->read(self_ent2.get(), file_name);
+      REQUIRE(self_ent2->compute(*dwrapper_copy, panacea_settings) ==
+              Approx(self_ent_val));
+    }
+  }
+}
+
+TEST_CASE("Testing:panacea self entropy checkpoint log",
+          "[end-to-end,panacea]") {
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Self)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Uncorrelated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::None);
+
+  // pi - public interface
+  PANACEA panacea_pi;
+
+  for (const auto file_type : {FileType::TXTRestart, FileType::BinaryRestart}) {
+    std::vector<std::vector<double>> data = {{0.0, 0.0}, {10.0, 10.0}};
+    auto dwrapper = panacea_pi.wrap(&(data), 2, 2);
+    std::unique_ptr<EntropyTerm> self_ent =
+        panacea_pi.create(*dwrapper, panacea_settings);
+
+    auto log = panacea_pi.createCheckpointLog(file_type, "self_ent.log");
+    log->append(self_ent.get());
+
+    // The distribution grows by a point between checkpoints
+    for (const double value : {5.0, 20.0}) {
+      data.push_back({value, 2.0 * value});
+      dwrapper = panacea_pi.wrap(&(data), data.size(), 2);
+      self_ent->update(*dwrapper);
+      log->append(self_ent.get());
+    }
+    const double self_ent_val = self_ent->compute(*dwrapper, panacea_settings);
+
+    std::unique_ptr<EntropyTerm> self_ent2 =
+        panacea_pi.create(panacea_settings);
+    log->read(self_ent2.get());
+    REQUIRE(self_ent2->compute(*dwrapper, panacea_settings) ==
+            Approx(self_ent_val));
+
+    log->compact(self_ent.get());
+    std::unique_ptr<EntropyTerm> self_ent3 =
+        panacea_pi.create(panacea_settings);
+    log->read(self_ent3.get());
+    REQUIRE(self_ent3->compute(*dwrapper, panacea_settings) ==
+            Approx(self_ent_val));
+
+    // Kernels read from a restart are owned by the entropy term, as they
+    // grow only the new points are appended to the log
+    auto log2 = panacea_pi.createCheckpointLog(file_type, "self_ent2.log");
+    log2->append(self_ent3.get());
+    std::unique_ptr<EntropyTerm> self_ent_first =
+        panacea_pi.create(panacea_settings);
+    log2->read(self_ent_first.get());
+    data.push_back({1.0, -1.0});
+    dwrapper = panacea_pi.wrap(&(data), data.size(), 2);
+    self_ent3->update(*dwrapper);
+    log2->append(self_ent3.get());
+    const double self_ent_val3 =
+        self_ent3->compute(*dwrapper, panacea_settings);
+
+    std::ifstream log_file("self_ent2.log", std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(log_file)),
+                         std::istreambuf_iterator<char>());
+    REQUIRE(contents.find("Append 4\n") != std::string::npos);
+
+    std::unique_ptr<EntropyTerm> self_ent4 =
+        panacea_pi.create(panacea_settings);
+    log2->read(self_ent4.get());
+    REQUIRE(self_ent4->compute(*dwrapper, panacea_settings) ==
+            Approx(self_ent_val3));
+
+    // Records cut short while being appended are skipped, damage to a
+    // record that is followed by others is not
+    const auto second_record = contents.find("[Checkpoint Record]", 1);
+    REQUIRE(contents.rfind("[Checkpoint Record]", 0) == 0);
+    REQUIRE(second_record != std::string::npos);
+    const std::size_t second_size = contents.size() - second_record;
+    const double self_ent_val2 =
+        self_ent_first->compute(*dwrapper, panacea_settings);
+    const std::vector<std::pair<std::string, double>> torn_logs = {
+        {contents + contents.substr(second_record, second_size / 2),
+         self_ent_val3},
+        {contents.substr(0, second_record + second_size / 2), self_ent_val2},
+        {contents.substr(0, second_record + 10), self_ent_val2}};
+    for (const auto &torn_log : torn_logs) {
+      {
+        std::ofstream torn_file("self_ent2.log", std::ios::binary);
+        torn_file << torn_log.first;
+      }
+      std::unique_ptr<EntropyTerm> self_ent5 =
+          panacea_pi.create(panacea_settings);
+      log2->read(self_ent5.get());
+      REQUIRE(self_ent5->compute(*dwrapper, panacea_settings) ==
+              Approx(torn_log.second));
+    }
+
+    std::string damaged = contents;
+    damaged[second_record / 2] ^= 0x20;
+    {
+      std::ofstream damaged_file("self_ent2.log", std::ios::binary);
+      damaged_file << damaged;
+    }
+    std::unique_ptr<EntropyTerm> self_ent6 =
+        panacea_pi.create(panacea_settings);
+    REQUIRE_THROWS(log2->read(self_ent6.get()));
+
+    std::remove("self_ent.log");
+    std::remove("self_ent2.log");
+  }
+}
+
+TEST_CASE("Testing:panacea self entropy create from restart file",
+          "[end-to-end,panacea]") {
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Self)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Uncorrelated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::None)
+                                         .weightEntropyTermBy(2.0);
+
+  // pi - public interface
+  PANACEA panacea_pi;
+
+  std::vector<std::vector<double>> data = {
+      {0.0, 0.0}, {10.0, 5.0}, {4.0, 2.0}, {-3.0, 7.0}};
+  auto dwrapper = panacea_pi.wrap(&(data), 4, 2);
+  std::unique_ptr<EntropyTerm> self_ent =
+      panacea_pi.create(*dwrapper, panacea_settings);
+  const double self_ent_val = self_ent->compute(*dwrapper, panacea_settings);
+  const std::vector<double> self_ent_grad =
+      self_ent->compute_grad(*dwrapper, 1, panacea_settings);
+
+  for (const auto file_type : {FileType::TXTRestart, FileType::BinaryRestart}) {
+    auto restart_file = panacea_pi.create(file_type);
+    restart_file->write(self_ent.get(), "self_ent_create.restart");
+
+    for (const auto loading :
+         {settings::RestartLoading::Eager, settings::RestartLoading::Lazy}) {
+      std::unique_ptr<EntropyTerm> self_ent2 =
+          panacea_pi.create("self_ent_create.restart", loading);
+
+      // The dimensions are known before the kernels are read
+      REQUIRE(self_ent2->type() == EntropyType::Self);
+      REQUIRE(self_ent2->state() == EntropyTerm::State::Initialized);
+      REQUIRE(self_ent2->getMaximumNumberOfDimensions() ==
+              self_ent->getMaximumNumberOfDimensions());
+      REQUIRE(self_ent2->getDimensions() == self_ent->getDimensions());
+      REQUIRE(std::any_cast<double>(self_ent2->get(EntropyOption::Weight)) ==
+              Approx(2.0));
+
+      REQUIRE(self_ent2->compute(*dwrapper, panacea_settings) ==
+              Approx(self_ent_val));
+      const auto grad =
+          self_ent2->compute_grad(*dwrapper, 1, panacea_settings);
+      REQUIRE(grad.size() == self_ent_grad.size());
+      for (std::size_t dim = 0; dim < grad.size(); ++dim) {
+        REQUIRE(grad[dim] == Approx(self_ent_grad[dim]));
+      }
+    }
+
+    // Every record of a checkpoint log is read
+    auto log = panacea_pi.createCheckpointLog(file_type, "self_ent_create.log");
+    std::unique_ptr<EntropyTerm> self_ent3 =
+        panacea_pi.create("self_ent_create.restart");
+    log->append(self_ent3.get());
+    std::vector<std::vector<double>> update_data = {{1.0, -1.0}};
+    auto dwrapper_update = panacea_pi.wrap(&(update_data), 1, 2);
+    self_ent3->update(*dwrapper_update);
+    log->append(self_ent3.get());
+    const double self_ent_val3 =
+        self_ent3->compute(*dwrapper, panacea_settings);
+
+    std::unique_ptr<EntropyTerm> self_ent4 = panacea_pi.create(
+        "self_ent_create.log", settings::RestartLoading::Lazy);
+    REQUIRE(self_ent4->compute(*dwrapper, panacea_settings) ==
+            Approx(self_ent_val3));
+    std::remove("self_ent_create.log");
+  }
+}
+
+TEST_CASE("Testing:panacea self entropy restart written before update modes",
+          "[end-to-end,panacea]") {
+
+  // Restart file written before the update history sections were added
+  const std::string legacy_restart = R"RESTART([Entropy]
+Self
+[Entropy Settings]
+Self
+SelfOwnIfRestartCrossOwn
+N/A
+N/A
+N/A
+None
+None
+[Distribution]
+Kernel
+[Prefactor]
+0.333333
+[Primitive Group]
+
+[Kernel Specifications]
+Correlated
+OneToOne
+Gaussian
+Variance
+OwnIfRestart
+None
+Flexible
+No
+No
+-1
+
+[Normalization]
+Flexible
+2
+[Normalization Coefficients]
+1.25830573921179
+1.04083299973307
+[Kernel]
+None
+OneToOne
+[Meta Data]
+[Data]
+Points along rows dimensions along columns
+3 2
+             1              4 
+             2            5.5 
+           3.5              6 
+[Covariance]
+Correlated
+3
+
+[Normalization State]
+Normalized
+
+[Matrix Type]
+Eigen
+
+[Matrix]
+2 2
+             1 0.922612906314877 
+0.922612906314877 0.999999999999995 
+
+[Vector Type]
+Eigen
+Along Rows
+
+[Vector]
+2 1
+     2.1666667
+     5.1666667
+
+)RESTART";
+  {
+    std::ofstream restart_out("legacy_self_entropy.restart");
+    restart_out << legacy_restart;
+  }
+
+  PANACEASettings panacea_settings = PANACEASettings::make()
+                                         .set(EntropyType::Self)
+                                         .set(PANACEAAlgorithm::Flexible)
+                                         .distributionType(kernel)
+                                         .set(KernelPrimitive::Gaussian)
+                                         .set(KernelCount::OneToOne)
+                                         .set(KernelCorrelation::Correlated)
+                                         .set(KernelCenterCalculation::None)
+                                         .set(KernelNormalization::Variance);
+
+  PANACEA panacea_pi;
+  std::vector<std::vector<double>> data{{1.0, 4.0}, {2.0, 5.5}, {3.5, 6.0}};
+  auto dwrapper = panacea_pi.wrap(&data, 3, 2);
+  auto expected = panacea_pi.create(*dwrapper, panacea_settings);
+
+  auto restart_file = panacea_pi.create(settings::FileType::TXTRestart);
+  auto restarted = panacea_pi.create(panacea_settings);
+  restart_file->read(restarted.get(), "legacy_self_entropy.restart");
+
+  // The updates of the older files were cumulative
+  REQUIRE(restarted->compute(*dwrapper) ==
+          Approx(expected->compute(*dwrapper)));
+  restarted->update(*dwrapper);
+  expected->update(*dwrapper);
+  REQUIRE(restarted->compute(*dwrapper) ==
+          Approx(expected->compute(*dwrapper)));
+}
@@ -203,3 +203,89 @@ TEST_CASE("Testing:covariance read & write", "[unit,panacea]") {
   REQUIRE(cov2.getCummulativeDescPoints() == 6);
   REQUIRE(cov2.getNormalizationState() == NormalizationState::Unnormalized);
 }
+
+TEST_CASE("Testing:covariance update policies", "[unit,panacea]") {
+  std::vector<std::vector<double>> data{
+      {0.6787, 0.6948, 0.7094}, {0.7577, 0.3171, 0.7547},
+      {0.7431, 0.9502, 0.2760}, {0.3922, 0.0344, 0.6797},
+      {0.6555, 0.4387, 0.6551}, {0.1712, 0.3816, 0.1626}};
+  std::vector<std::vector<double>> update_data{{0.0318, 0.7952, 0.4984},
+                                               {0.2769, 0.1869, 0.9597},
+                                               {0.0462, 0.4898, 0.3404},
+                                               {0.0971, 0.4456, 0.5853},
+                                               {0.8235, 0.6463, 0.2238}};
+
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(
+      &data, data.size(), data.at(0).size());
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper2(
+      &update_data, update_data.size(), update_data.at(0).size());
+
+  auto cov_ptr =
+      Covariance::create(dwrapper, settings::KernelCorrelation::Correlated);
+  auto &cov = *cov_ptr;
+
+  WHEN("Only the most recent update is kept") {
+    cov.set(UpdatePolicy(settings::UpdateMode::SlidingWindow, 1.0, 1));
+    REQUIRE(cov.getUpdatePolicy().is(settings::UpdateMode::SlidingWindow));
+    cov.update(dwrapper2);
+
+    auto expected_ptr =
+        Covariance::create(dwrapper2, settings::KernelCorrelation::Correlated);
+    REQUIRE(cov.getCummulativeDescPoints() ==
+            (data.size() + update_data.size()));
+    for (int row = 0; row < 3; ++row) {
+      REQUIRE(cov.getMean(row) == Approx(expected_ptr->getMean(row)));
+      for (int col = 0; col < 3; ++col) {
+        REQUIRE(cov(row, col) == Approx((*expected_ptr)(row, col)));
+      }
+    }
+  }
+
+  WHEN("A forgetting factor of 1.0 is used") {
+    auto cumulative_ptr =
+        Covariance::create(dwrapper, settings::KernelCorrelation::Correlated);
+    cumulative_ptr->update(dwrapper2);
+
+    cov.set(UpdatePolicy(settings::UpdateMode::ExponentialDecay, 1.0));
+    cov.update(dwrapper2);
+    for (int row = 0; row < 3; ++row) {
+      REQUIRE(cov.getMean(row) == Approx(cumulative_ptr->getMean(row)));
+      for (int col = 0; col < 3; ++col) {
+        REQUIRE(cov(row, col) == Approx((*cumulative_ptr)(row, col)));
+      }
+    }
+  }
+
+  WHEN("The earlier descriptors are decayed") {
+    cov.set(UpdatePolicy(settings::UpdateMode::ExponentialDecay, 0.5));
+    cov.update(dwrapper2);
+
+    // Six points with half their weight are merged with five new points
+    const double weight = 6.0 * 0.5 + 5.0;
+    std::vector<double> mean1(3, 0.0);
+    std::vector<double> mean2(3, 0.0);
+    for (int dim = 0; dim < 3; ++dim) {
+      for (const auto &row : data) {
+        mean1[dim] += row[dim] / 6.0;
+      }
+      for (const auto &row : update_data) {
+        mean2[dim] += row[dim] / 5.0;
+      }
+      REQUIRE(cov.getMean(dim) ==
+              Approx((3.0 * mean1[dim] + 5.0 * mean2[dim]) / weight));
+    }
+    double co_moment = 0.0;
+    for (const auto &row : data) {
+      co_moment += 0.5 * (row[0] - mean1[0]) * (row[1] - mean1[1]);
+    }
+    for (const auto &row : update_data) {
+      co_moment += (row[0] - mean2[0]) * (row[1] - mean2[1]);
+    }
+    co_moment += (mean2[0] - mean1[0]) * (mean2[1] - mean1[1]) * 3.0 * 5.0 /
+                 weight;
+    REQUIRE(cov(0, 1) == Approx(co_moment / (weight - 1.0)));
+  }
+
+  REQUIRE_THROWS(UpdatePolicy(settings::UpdateMode::ExponentialDecay, 0.0));
+  REQUIRE_THROWS(UpdatePolicy(settings::UpdateMode::SlidingWindow, 1.0, 0));
+}
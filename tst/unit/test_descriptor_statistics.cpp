@@ -0,0 +1,135 @@
+
+// Local private PANACEA includes
+#include "descriptors/descriptor_statistics.hpp"
+#include "descriptors/descriptor_wrapper.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
+
+// Third party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+using namespace panacea;
+
+namespace {
+// Co-moment computed directly from the definition
+double coMoment(const std::vector<std::vector<double>> &data, const int dim1,
+                const int dim2) {
+  double mean1 = 0.0;
+  double mean2 = 0.0;
+  for (const auto &row : data) {
+    mean1 += row.at(dim1);
+    mean2 += row.at(dim2);
+  }
+  mean1 /= static_cast<double>(data.size());
+  mean2 /= static_cast<double>(data.size());
+  double co_moment = 0.0;
+  for (const auto &row : data) {
+    co_moment += (row.at(dim1) - mean1) * (row.at(dim2) - mean2);
+  }
+  return co_moment;
+}
+} // namespace
+
+TEST_CASE("Testing:descriptor statistics", "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data{
+      {1.0, 4.0, 2.0}, {2.0, 3.0, 2.0}, {6.0, 1.0, 2.0}, {-1.0, 8.0, 2.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 4, 3);
+
+  WHEN("Gathering the full moments") {
+    DescriptorStatistics stats(dwrapper);
+    REQUIRE(stats.getNumberPoints() == 4);
+    REQUIRE(stats.getNumberDimensions() == 3);
+    REQUIRE(stats.getMean(0) == Approx(2.0));
+    REQUIRE(stats.getMean(1) == Approx(4.0));
+    REQUIRE(stats.getMean(2) == Approx(2.0));
+    REQUIRE(stats.getMin(0) == Approx(-1.0));
+    REQUIRE(stats.getMax(1) == Approx(8.0));
+    for (int dim1 = 0; dim1 < 3; ++dim1) {
+      for (int dim2 = 0; dim2 < 3; ++dim2) {
+        REQUIRE(stats.getCoMoment(dim1, dim2) ==
+                Approx(coMoment(data, dim1, dim2)).margin(1E-12));
+      }
+    }
+    REQUIRE(stats.getVariance(0) == Approx(coMoment(data, 0, 0) / 3.0));
+    REQUIRE(stats.getStackedDimensions() == std::vector<int>{2});
+  }
+
+  WHEN("Gathering only the diagonal moments") {
+    DescriptorStatistics stats(dwrapper, Moments::Diagonal);
+    REQUIRE(stats.getCoMoment(1, 1) == Approx(coMoment(data, 1, 1)));
+    REQUIRE_THROWS(stats.getCoMoment(0, 1));
+    DescriptorStatistics full_stats(dwrapper);
+    REQUIRE_THROWS(stats.merge(full_stats));
+  }
+
+  WHEN("Merging the statistics of two sets of points") {
+    std::vector<std::vector<double>> first(data.begin(), data.begin() + 1);
+    std::vector<std::vector<double>> second(data.begin() + 1, data.end());
+    DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper1(&first, 1,
+                                                                    3);
+    DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper2(&second,
+                                                                    3, 3);
+    DescriptorStatistics stats(dwrapper1);
+    stats.merge(DescriptorStatistics(dwrapper2));
+    DescriptorStatistics whole(dwrapper);
+    REQUIRE(stats.getNumberPoints() == 4);
+    for (int dim1 = 0; dim1 < 3; ++dim1) {
+      REQUIRE(stats.getMean(dim1) == Approx(whole.getMean(dim1)));
+      REQUIRE(stats.getMin(dim1) == Approx(whole.getMin(dim1)));
+      REQUIRE(stats.getMax(dim1) == Approx(whole.getMax(dim1)));
+      for (int dim2 = 0; dim2 < 3; ++dim2) {
+        REQUIRE(stats.getCoMoment(dim1, dim2) ==
+                Approx(whole.getCoMoment(dim1, dim2)).margin(1E-12));
+      }
+    }
+  }
+
+  WHEN("Gathering the statistics of sparse descriptors") {
+    SparseDescriptorWrapper sparse(dwrapper);
+    DescriptorStatistics sparse_stats(sparse);
+    DescriptorStatistics dense_stats(dwrapper);
+    for (int dim1 = 0; dim1 < 3; ++dim1) {
+      REQUIRE(sparse_stats.getMean(dim1) == Approx(dense_stats.getMean(dim1)));
+      REQUIRE(sparse_stats.getMin(dim1) == Approx(dense_stats.getMin(dim1)));
+      REQUIRE(sparse_stats.getMax(dim1) == Approx(dense_stats.getMax(dim1)));
+      for (int dim2 = 0; dim2 < 3; ++dim2) {
+        REQUIRE(sparse_stats.getCoMoment(dim1, dim2) ==
+                Approx(dense_stats.getCoMoment(dim1, dim2)).margin(1E-12));
+      }
+    }
+  }
+}
+
+TEST_CASE("Testing:descriptor statistics threads", "[unit,panacea]") {
+
+  // Enough points that the statistics are gathered on several threads
+  const int rows = 20000;
+  const int cols = 4;
+  std::vector<std::vector<double>> data(rows, std::vector<double>(cols));
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      data[row][col] = static_cast<double>((row * (col + 7)) % 101) - 50.0;
+    }
+  }
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, rows,
+                                                                 cols);
+  DescriptorStatistics stats(dwrapper);
+  REQUIRE(stats.getNumberPoints() == rows);
+  for (int dim1 = 0; dim1 < cols; ++dim1) {
+    double mean = 0.0;
+    for (const auto &row : data) {
+      mean += row[dim1];
+    }
+    mean /= static_cast<double>(rows);
+    REQUIRE(stats.getMean(dim1) == Approx(mean).margin(1E-9));
+    for (int dim2 = dim1; dim2 < cols; ++dim2) {
+      REQUIRE(stats.getCoMoment(dim1, dim2) ==
+              Approx(coMoment(data, dim1, dim2)));
+    }
+  }
+}
@@ -0,0 +1,101 @@
+
+// Local private PANACEA includes
+#include "descriptors/descriptor_summary.hpp"
+#include "descriptors/descriptor_wrapper.hpp"
+
+// Third party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace panacea;
+
+namespace {
+double totalCount(const DescriptorSummary &summary, const int dim) {
+  double total = 0.0;
+  for (int bin = 0; bin < summary.getNumberBins(); ++bin) {
+    total += summary.getBinCount(dim, bin);
+  }
+  return total;
+}
+} // namespace
+
+TEST_CASE("Testing:descriptor summary", "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data1{
+      {0.0, 4.0, 2.0}, {1.0, 3.0, 2.0}, {2.0, 1.0, 2.0}, {3.0, 8.0, 2.0}};
+  std::vector<std::vector<double>> data2{{4.0, 2.0, 2.0}, {8.0, 6.0, 2.0}};
+  std::vector<std::vector<double>> all_data = data1;
+  all_data.insert(all_data.end(), data2.begin(), data2.end());
+
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper1(&data1, 4,
+                                                                   3);
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper2(&data2, 2,
+                                                                   3);
+  DescriptorWrapper<std::vector<std::vector<double>> *> all_dwrapper(
+      &all_data, 6, 3);
+
+  WHEN("Summarizing a set of descriptors") {
+    DescriptorSummary summary(dwrapper1, 4);
+    REQUIRE(summary.statistics().getNumberPoints() == 4);
+    REQUIRE(summary.getNumberBins() == 4);
+    REQUIRE(summary.getBinWidth(0) == Approx(0.75));
+    // One point per bin, the maximum lands in the last bin
+    for (int bin = 0; bin < 4; ++bin) {
+      REQUIRE(summary.getBinCount(0, bin) == Approx(1.0));
+    }
+    // Stacked points all land in the first bin
+    REQUIRE(summary.getBinCount(2, 0) == Approx(4.0));
+    REQUIRE_THROWS(DescriptorSummary(dwrapper1, 0));
+  }
+
+  WHEN("Merging the summaries of two sets of descriptors") {
+    DescriptorSummary merged;
+    merged.merge(DescriptorSummary(dwrapper1, 4));
+    merged.merge(DescriptorSummary(dwrapper2, 4));
+    DescriptorStatistics all_stats(all_dwrapper);
+    const auto &stats = merged.statistics();
+    REQUIRE(stats.getNumberPoints() == 6);
+    for (int dim1 = 0; dim1 < 3; ++dim1) {
+      REQUIRE(stats.getMean(dim1) == Approx(all_stats.getMean(dim1)));
+      REQUIRE(stats.getMin(dim1) == Approx(all_stats.getMin(dim1)));
+      REQUIRE(stats.getMax(dim1) == Approx(all_stats.getMax(dim1)));
+      for (int dim2 = 0; dim2 < 3; ++dim2) {
+        REQUIRE(stats.getCoMoment(dim1, dim2) ==
+                Approx(all_stats.getCoMoment(dim1, dim2)).margin(1E-12));
+      }
+      REQUIRE(totalCount(merged, dim1) == Approx(6.0));
+    }
+    REQUIRE(merged.getBinWidth(0) == Approx(2.0));
+    // [0, 2) holds 0.0 and 1.0, the 2.0 of the first summary straddles the
+    // boundary so only part of it is moved to the second bin
+    REQUIRE(merged.getBinCount(0, 0) > 2.0);
+    REQUIRE(merged.getBinCount(0, 3) >= 1.0);
+    REQUIRE(merged.getBinCount(2, 0) == Approx(6.0));
+
+    REQUIRE_THROWS(merged.merge(DescriptorSummary(dwrapper2, 8)));
+  }
+
+  WHEN("Writing and reading a summary") {
+    DescriptorSummary summary(dwrapper1);
+    std::stringstream ss;
+    DescriptorSummary::write(summary, ss);
+    DescriptorSummary summary_read;
+    DescriptorSummary::read(summary_read, ss);
+    REQUIRE(summary_read.getNumberBins() ==
+            DescriptorSummary::default_number_bins);
+    REQUIRE(summary_read.statistics().getNumberPoints() == 4);
+    for (int dim = 0; dim < 3; ++dim) {
+      REQUIRE(summary_read.statistics().getMean(dim) ==
+              summary.statistics().getMean(dim));
+      for (int bin = 0; bin < summary.getNumberBins(); ++bin) {
+        REQUIRE(summary_read.getBinCount(dim, bin) ==
+                summary.getBinCount(dim, bin));
+      }
+    }
+    REQUIRE(summaryFileName("desc.txt") == "desc.txt.summary");
+  }
+}
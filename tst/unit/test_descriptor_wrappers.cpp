@@ -1,8 +1,13 @@
 
 // Local private includes
 #include "descriptors/descriptor_wrapper.hpp"
+#include "descriptors/point_major_descriptors.hpp"
+#include "descriptors/sparse_descriptor_wrapper.hpp"
 #include "helper.hpp"
 
+// Public PANACEA includes
+#include "panacea/instrumentation.hpp"
+
 // Third party includes
 #include <catch2/catch.hpp>
 
@@ -158,3 +163,135 @@ TEST_CASE("Testing:descriptor_wrapper write and read", "[unit,panacea]") {
   REQUIRE(dwrapper2(0, 2) == 3.0);
   REQUIRE(dwrapper2(1, 2) == 3.0);
 }
+
+TEST_CASE("Testing:descriptor_wrapper point major layout cache",
+          "[unit,panacea]") {
+
+  // Two dimensions with three points, dimensions are along the rows
+  std::vector<std::vector<double>> data{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 2, 3);
+  dwrapper.set(Arrangement::DimensionsAlongRowsPointsAlongCols);
+
+  instrumentation::reset();
+  WHEN("The layout cache is disabled the wrapper is used in place") {
+    const PointMajorDescriptors point_major(dwrapper);
+    REQUIRE(&point_major.get() == &dwrapper);
+    REQUIRE(instrumentation::count(instrumentation::Event::LayoutInPlace) ==
+            1);
+    REQUIRE(instrumentation::count(
+                instrumentation::Event::LayoutPointMajorBuilt) == 0);
+  }
+
+  WHEN("The layout cache is enabled") {
+    dwrapper.setLayoutCache(settings::LayoutCache::PointMajor);
+    {
+      const PointMajorDescriptors point_major(dwrapper);
+      const BaseDescriptorWrapper &copy = point_major.get();
+      REQUIRE(&copy != &dwrapper);
+      REQUIRE(copy.arrangement() ==
+              Arrangement::PointsAlongRowsDimensionsAlongCols);
+      REQUIRE(copy.getNumberPoints() == 3);
+      REQUIRE(copy.getNumberDimensions() == 2);
+      for (int pt = 0; pt < 3; ++pt) {
+        for (int dim = 0; dim < 2; ++dim) {
+          REQUIRE(copy(pt, dim) == Approx(dwrapper(pt, dim)));
+        }
+      }
+      REQUIRE(instrumentation::count(
+                  instrumentation::Event::LayoutPointMajorBuilt) == 1);
+    }
+
+    THEN("Writing through the wrapper is seen by the next copy") {
+      dwrapper(1, 0) = 10.0;
+      const PointMajorDescriptors point_major(dwrapper);
+      REQUIRE(point_major.get()(1, 0) == Approx(10.0));
+      REQUIRE(instrumentation::count(
+                  instrumentation::Event::LayoutPointMajorBuilt) == 2);
+    }
+
+    THEN("Modifying the data directly is seen by the next copy") {
+      data[1][2] = 20.0;
+      const PointMajorDescriptors point_major(dwrapper);
+      REQUIRE(point_major.get()(2, 1) == Approx(20.0));
+    }
+
+    THEN("Descriptors with the points along the rows are used in place") {
+      dwrapper.set(Arrangement::PointsAlongRowsDimensionsAlongCols);
+      const PointMajorDescriptors point_major(dwrapper);
+      REQUIRE(&point_major.get() == &dwrapper);
+      REQUIRE(instrumentation::count(
+                  instrumentation::Event::LayoutPointMajorBuilt) == 1);
+    }
+  }
+}
+
+TEST_CASE("Testing:sparse_descriptor_wrapper access", "[unit,panacea]") {
+
+  // 3 points 4 dimensions
+  //
+  // 0.0 1.5 0.0 0.0
+  // 0.0 0.0 0.0 0.0
+  // 2.0 0.0 0.0 3.0
+  SparseDescriptorWrapper dwrapper(3, 4, {0, 1, 1, 3}, {1, 0, 3},
+                                   {1.5, 2.0, 3.0});
+  const BaseDescriptorWrapper &const_dwrapper = dwrapper;
+
+  REQUIRE(dwrapper.getNumberPoints() == 3);
+  REQUIRE(dwrapper.getNumberDimensions() == 4);
+  REQUIRE(dwrapper.getNumberNonZeros() == 3);
+  REQUIRE(dwrapper.getTypeIndex() ==
+          std::type_index(typeid(CompressedSparseRows *)));
+  REQUIRE(sparseData(dwrapper) != nullptr);
+
+  REQUIRE(const_dwrapper(0, 1) == 1.5);
+  REQUIRE(const_dwrapper(2, 0) == 2.0);
+  REQUIRE(const_dwrapper(2, 3) == 3.0);
+  REQUIRE(const_dwrapper(1, 2) == 0.0);
+  REQUIRE(dwrapper.value(1, 2) == 0.0);
+  REQUIRE(dwrapper.value(2, 3) == 3.0);
+  REQUIRE(dwrapper.getNumberNonZeros() == 3);
+
+  WHEN("A value that is not stored is written") {
+    dwrapper(1, 2) = 4.0;
+    REQUIRE(dwrapper.getNumberNonZeros() == 4);
+    REQUIRE(const_dwrapper(1, 2) == 4.0);
+    REQUIRE(const_dwrapper(2, 0) == 2.0);
+    REQUIRE(const_dwrapper(2, 3) == 3.0);
+  }
+
+  WHEN("The wrapper is resized") {
+    dwrapper.resize(2, 2);
+    REQUIRE(dwrapper.getNumberPoints() == 2);
+    REQUIRE(dwrapper.getNumberDimensions() == 2);
+    REQUIRE(dwrapper.getNumberNonZeros() == 1);
+    REQUIRE(const_dwrapper(0, 1) == 1.5);
+  }
+
+  WHEN("Created from a dense wrapper") {
+    std::vector<std::vector<double>> data{{0.0, 1.5, 0.0, 0.0},
+                                          {0.0, 0.0, 0.0, 0.0},
+                                          {2.0, 0.0, 0.0, 3.0}};
+    DescriptorWrapper<std::vector<std::vector<double>> *> dense(&data, 3, 4);
+    SparseDescriptorWrapper converted(dense);
+    REQUIRE(converted.getNumberNonZeros() == 3);
+    for (int pt = 0; pt < 3; ++pt) {
+      for (int dim = 0; dim < 4; ++dim) {
+        REQUIRE(static_cast<const BaseDescriptorWrapper &>(converted)(
+                    pt, dim) == data[pt][dim]);
+      }
+    }
+  }
+
+  WHEN("The structure is inconsistent") {
+    // Column indices not increasing
+    REQUIRE_THROWS(SparseDescriptorWrapper(1, 4, {0, 2}, {3, 1}, {1.0, 2.0}));
+    // Column index out of range
+    REQUIRE_THROWS(SparseDescriptorWrapper(1, 4, {0, 1}, {4}, {1.0}));
+    // Wrong number of offsets
+    REQUIRE_THROWS(SparseDescriptorWrapper(2, 4, {0, 1}, {0}, {1.0}));
+  }
+
+  WHEN("The arrangement is changed") {
+    REQUIRE_THROWS(dwrapper.set(Arrangement::DimensionsAlongRowsPointsAlongCols));
+  }
+}
@@ -4,6 +4,7 @@
 #include "distribution/distribution_factory.hpp"
 #include "distribution/distribution_settings/kernel_distribution_settings.hpp"
 #include "distribution/distributions/kernel_distribution.hpp"
+#include "distribution/distributions/kernel_distribution/kernel_evaluation_plan.hpp"
 #include "io/file_io_factory.hpp"
 #include "private_settings.hpp"
 
@@ -161,3 +162,55 @@ TEST_CASE("Testing:distributions pre_factor", "[unit,panacea]") {
   REQUIRE(dist1->compute(dwrapper1, 0, kernel_settings) ==
           Approx(dist2->compute(dwrapper2, 0, kernel_settings)));
 }
+
+TEST_CASE("Testing:distributions evaluation plan", "[unit,panacea]") {
+
+  // Registers the gradient methods
+  KernelDistributionGradiant kern_dist_grad;
+
+  KernelEvaluationPlan unbound_plan;
+  REQUIRE_FALSE(unbound_plan.bound());
+
+  WHEN("The kernels are one to one") {
+    KernelSpecification specification(
+        settings::KernelCorrelation::Uncorrelated,
+        settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+        settings::KernelNormalization::None, settings::KernelMemory::Share,
+        settings::KernelCenterCalculation::None,
+        settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+        settings::RandomizeNumberDimensions::No, -1);
+
+    KernelEvaluationPlan plan(specification);
+    REQUIRE(plan.bound());
+    REQUIRE(plan.count() == settings::KernelCount::OneToOne);
+    REQUIRE(plan.gradiant(settings::GradSetting::WRTBoth,
+                          settings::EquationSetting::None) != nullptr);
+    REQUIRE(plan.gradiant(settings::GradSetting::WRTKernel,
+                          settings::EquationSetting::None) != nullptr);
+    REQUIRE(plan.gradiant(settings::GradSetting::WRTDescriptor,
+                          settings::EquationSetting::None) != nullptr);
+    REQUIRE(plan.gradiant(settings::GradSetting::WRTDescriptor,
+                          settings::EquationSetting::IgnoreExpAndPrefactor) ==
+            nullptr);
+  }
+
+  WHEN("There is a single kernel") {
+    KernelSpecification specification(
+        settings::KernelCorrelation::Uncorrelated,
+        settings::KernelCount::Single, settings::KernelPrimitive::Gaussian,
+        settings::KernelNormalization::None, settings::KernelMemory::Own,
+        settings::KernelCenterCalculation::Mean,
+        settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+        settings::RandomizeNumberDimensions::No, -1);
+
+    KernelEvaluationPlan plan(specification);
+    REQUIRE(plan.gradiant(settings::GradSetting::WRTDescriptor,
+                          settings::EquationSetting::IgnoreExpAndPrefactor) ==
+            KernelDistributionGradiant::grad_method
+                [settings::GradSetting::WRTDescriptor]
+                [settings::EquationSetting::IgnoreExpAndPrefactor]
+                [settings::KernelCount::Single]);
+    REQUIRE(plan.gradiant(settings::GradSetting::WRTBoth,
+                          settings::EquationSetting::None) == nullptr);
+  }
+}
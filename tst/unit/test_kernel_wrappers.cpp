@@ -3,10 +3,14 @@
 #include "descriptors/descriptor_wrapper.hpp"
 #include "io/file_io_factory.hpp"
 #include "kernels/kernel_specifications.hpp"
+#include "kernels/kernel_store.hpp"
 #include "kernels/kernel_wrapper.hpp"
 #include "kernels/kernel_wrapper_factory.hpp"
 #include "kernels/mean_kernel_wrapper.hpp"
 #include "kernels/median_kernel_wrapper.hpp"
+#include "kernels/shared_kernel_wrapper.hpp"
+#include "kernels/streaming_median_kernel_wrapper.hpp"
+#include "update_policy.hpp"
 
 #include "helper.hpp"
 
@@ -168,6 +172,50 @@ TEST_CASE("Testing:median kernel_wrapper write & read", "[unit,panacea]") {
   REQUIRE(median_kwrapper2.getTypeIndex() == type_ind_data);
 }
 
+TEST_CASE("Testing:streaming median kernel_wrapper write & read",
+          "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data = {{1.0, 4.0}, {2.0, 9.0}, {6.0, 2.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, 3, 2);
+
+  StreamingMedianKernelWrapper median_kwrapper(test::Test::key(), dwrapper,
+                                               0.01);
+  BaseKernelWrapper *kwrapper_ptr = &median_kwrapper;
+
+  std::fstream fs;
+  fs.open("streaming_median_kernel_wrapper_restart.txt", std::fstream::out);
+  BaseKernelWrapper::write(settings::FileType::TXTRestart, fs, kwrapper_ptr);
+  fs.close();
+
+  StreamingMedianKernelWrapper median_kwrapper2(test::Test::key());
+  kwrapper_ptr = &median_kwrapper2;
+  std::fstream fs2;
+  fs2.open("streaming_median_kernel_wrapper_restart.txt", std::fstream::in);
+  BaseKernelWrapper::read(settings::FileType::TXTRestart, fs2, kwrapper_ptr);
+  fs2.close();
+
+  REQUIRE(median_kwrapper2.getNumberDimensions() == 2);
+  REQUIRE(median_kwrapper2.getNumberPoints() == 3);
+  REQUIRE(median_kwrapper2.rows() == 1);
+  REQUIRE(median_kwrapper2.cols() == 2);
+  REQUIRE(median_kwrapper2.at(0, 0) == Approx(2.0));
+  REQUIRE(median_kwrapper2.at(0, 1) == Approx(4.0));
+  REQUIRE(median_kwrapper2.rankError() == Approx(0.01));
+  REQUIRE(median_kwrapper2.sketches().size() == 2);
+  REQUIRE(median_kwrapper2.sketches().at(1).count() == 3);
+
+  // The sketches are restored, so updates continue from the saved state
+  std::vector<std::vector<double>> data2 = {{0.5, 8.0}, {0.0, 7.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper2(&data2, 2, 2);
+  median_kwrapper.update(dwrapper2);
+  median_kwrapper2.update(dwrapper2);
+  REQUIRE(median_kwrapper2.getNumberPoints() == 5);
+  REQUIRE(median_kwrapper2.at(0, 0) == Approx(median_kwrapper.at(0, 0)));
+  REQUIRE(median_kwrapper2.at(0, 1) == Approx(median_kwrapper.at(0, 1)));
+  auto type_ind_data = std::type_index(typeid(vector<double>));
+  REQUIRE(median_kwrapper2.getTypeIndex() == type_ind_data);
+}
+
 TEST_CASE("Testing:template kernel_wrapper write & read", "[unit,panacea]") {
 
   std::vector<std::vector<double>> data = {{1.0, 4.0}, {2.0, 9.0}, {6.0, 2.0}};
@@ -221,6 +269,21 @@ TEST_CASE("Testing:kernel_wrapper creation with factory", "[unit,panacea]") {
 
     auto kwrapper = kern_factory.create(dwrapper, specs);
   }
+  WHEN("Testing kernel wrapper creation single streaming median") {
+    KernelSpecification specs(
+        settings::KernelCorrelation::Uncorrelated, settings::KernelCount::Single,
+        settings::KernelPrimitive::Gaussian,
+        settings::KernelNormalization::None, settings::KernelMemory::Own,
+        settings::KernelCenterCalculation::StreamingMedian,
+        settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+        settings::RandomizeNumberDimensions::No, -1);
+
+    auto kwrapper = kern_factory.create(dwrapper, specs);
+    REQUIRE(kwrapper->center() ==
+            settings::KernelCenterCalculation::StreamingMedian);
+    REQUIRE(kwrapper->getNumberPoints() == 3);
+    REQUIRE(kwrapper->at(0, 0) == Approx(2.0));
+  }
 }
 
 TEST_CASE("Testing:kernel_wrappers with update", "[unit,panacea]") {
@@ -260,6 +323,19 @@ TEST_CASE("Testing:kernel_wrappers with update", "[unit,panacea]") {
     REQUIRE(median_kwrapper.at(0, 0) == Approx(5.5));
   }
 
+  WHEN("Testing streaming median kernel wrapper") {
+    StreamingMedianKernelWrapper median_kwrapper(test::Test::key(), dwrapper);
+    median_kwrapper.update(dwrapper2);
+    REQUIRE(median_kwrapper.getNumberDimensions() == 1);
+    REQUIRE(median_kwrapper.getNumberPoints() == 8);
+    //
+    // 1.0, 2.0, 3.0, 5.0, 6.0, 6.0, 8.0, 9.0
+    //
+    // With this few points the sketch is exact, the median is taken as the
+    // point with rank ceil(8 / 2) = 4
+    REQUIRE(median_kwrapper.at(0, 0) == Approx(5.0));
+  }
+
   WHEN("Testing one to one kernel wrapper") {
 
     KernelWrapper<vector<vector<double>> *> kwrapper(
@@ -359,3 +435,278 @@ TEST_CASE("Testing:kernel_arrangements", "[unit,panacea]") {
   REQUIRE(kwrapper.at(0, 2) == 3.0);
   REQUIRE(kwrapper.at(1, 2) == 3.0);
 }
+
+TEST_CASE("Testing:shared kernel_wrapper copy on write", "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data = {{1.0, 4.0}, {2.0, 9.0}, {6.0, 2.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, 3, 2);
+
+  SharedKernelWrapper kwrapper(test::Test::key(), dwrapper);
+  SharedKernelWrapper kwrapper2(test::Test::key(), dwrapper);
+
+  // Kernels built from the same descriptors share storage
+  REQUIRE(kwrapper.sharesStorageWith(kwrapper2));
+  REQUIRE(kwrapper.storageUseCount() == 2);
+  REQUIRE(kwrapper.rows() == 3);
+  REQUIRE(kwrapper.cols() == 2);
+  REQUIRE(kwrapper.getNumberPoints() == 3);
+  REQUIRE(kwrapper.getNumberDimensions() == 2);
+  REQUIRE(kwrapper2.at(2, 1) == Approx(2.0));
+
+  // Storage is owned, changing the descriptors does not change the kernels
+  data.at(0).at(0) = 10.0;
+  REQUIRE(kwrapper.at(0, 0) == Approx(1.0));
+
+  WHEN("Updating one of the kernels") {
+    std::vector<std::vector<double>> data2 = {{5.0, 1.0}};
+    DescriptorWrapper<vector<vector<double>> *> dwrapper2(&data2, 1, 2);
+    kwrapper2.update(dwrapper2);
+
+    REQUIRE_FALSE(kwrapper.sharesStorageWith(kwrapper2));
+    REQUIRE(kwrapper.storageUseCount() == 1);
+    REQUIRE(kwrapper2.getNumberPoints() == 1);
+    REQUIRE(kwrapper2.at(0, 0) == Approx(5.0));
+
+    // The kernel that was not updated keeps its values
+    REQUIRE(kwrapper.getNumberPoints() == 3);
+    REQUIRE(kwrapper.at(0, 0) == Approx(1.0));
+    REQUIRE(kwrapper.at(1, 1) == Approx(9.0));
+  }
+
+  WHEN("Creating owned kernels with the factory") {
+    KernelSpecification specs(
+        settings::KernelCorrelation::Uncorrelated,
+        settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+        settings::KernelNormalization::None, settings::KernelMemory::Own,
+        settings::KernelCenterCalculation::None,
+        settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+        settings::RandomizeNumberDimensions::No, -1);
+
+    KernelWrapperFactory kern_factory;
+    auto kwrapper3 = kern_factory.create(dwrapper, specs);
+    auto kwrapper4 = kern_factory.create(dwrapper, specs);
+    auto shared3 = dynamic_cast<SharedKernelWrapper *>(kwrapper3.get());
+    auto shared4 = dynamic_cast<SharedKernelWrapper *>(kwrapper4.get());
+    REQUIRE(shared3 != nullptr);
+    REQUIRE(shared4 != nullptr);
+    REQUIRE(shared3->sharesStorageWith(*shared4));
+    REQUIRE(kwrapper3->at(0, 0) == Approx(10.0));
+  }
+}
+
+TEST_CASE("Testing:kernel_store append", "[unit,panacea]") {
+
+  const int cols = 3;
+  KernelStore store(cols);
+  REQUIRE(store.rows() == 0);
+  REQUIRE(store.cols() == cols);
+  REQUIRE(store.capacity() == 0);
+
+  // Fill more than a single chunk
+  const int rows = 2 * store.rowsPerChunk() + 1;
+  const double *first_row = nullptr;
+  for (int row = 0; row < rows; ++row) {
+    double *values = store.appendRow();
+    for (int col = 0; col < cols; ++col) {
+      values[col] = row * cols + col;
+    }
+    if (row == 0) {
+      first_row = values;
+    }
+  }
+  REQUIRE(store.rows() == rows);
+  REQUIRE(store.capacity() == 3 * store.rowsPerChunk());
+
+  // Appending never moves the rows that are already stored
+  REQUIRE(store.row(0) == first_row);
+  REQUIRE(store.at(0, 2) == Approx(2.0));
+  REQUIRE(store.at(rows - 1, 1) == Approx((rows - 1) * cols + 1));
+  REQUIRE(store.row(rows - 1)[0] == Approx((rows - 1) * cols));
+
+  WHEN("Copying the store") {
+    KernelStore copy(store);
+    copy.at(0, 0) = -1.0;
+    REQUIRE(copy.rows() == rows);
+    REQUIRE(copy.at(rows - 1, 2) == Approx(store.at(rows - 1, 2)));
+    REQUIRE(store.at(0, 0) == Approx(0.0));
+  }
+
+  WHEN("Shrinking and growing the store") {
+    store.resize(2, cols);
+    REQUIRE(store.rows() == 2);
+    REQUIRE(store.capacity() == store.rowsPerChunk());
+    store.resize(4, cols);
+    REQUIRE(store.at(1, 1) == Approx(4.0));
+    REQUIRE(store.at(2, 1) == Approx(0.0));
+    REQUIRE(store.at(3, 2) == Approx(0.0));
+  }
+
+  WHEN("Changing the number of columns") {
+    store.resize(2, 2);
+    REQUIRE(store.cols() == 2);
+    REQUIRE(store.at(1, 0) == Approx(3.0));
+    REQUIRE(store.at(1, 1) == Approx(4.0));
+  }
+}
+
+TEST_CASE("Testing:shared kernel_wrapper appends points", "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data = {{1.0, 4.0}, {2.0, 9.0}, {6.0, 2.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, 3, 2);
+
+  SharedKernelWrapper kwrapper(test::Test::key(), dwrapper);
+  SharedKernelWrapper kwrapper2(test::Test::key(), dwrapper);
+  REQUIRE(kwrapper.sharesStorageWith(kwrapper2));
+
+  // The same descriptors with two more points
+  data.push_back({3.0, 3.0});
+  data.push_back({7.0, 5.0});
+  DescriptorWrapper<vector<vector<double>> *> dwrapper_grown(&data, 5, 2);
+
+  // Reading through a const wrapper does not detach from the storage
+  const SharedKernelWrapper &const_kwrapper = kwrapper;
+  kwrapper.update(dwrapper_grown);
+  REQUIRE(kwrapper.getNumberPoints() == 5);
+  REQUIRE(const_kwrapper.at(3, 0) == Approx(3.0));
+  REQUIRE(const_kwrapper.at(4, 1) == Approx(5.0));
+
+  // The other wrapper may be reading the storage, the wrapper that appended
+  // detached from it
+  REQUIRE_FALSE(kwrapper.sharesStorageWith(kwrapper2));
+  REQUIRE(kwrapper2.storageUseCount() == 1);
+  REQUIRE(kwrapper2.getNumberPoints() == 3);
+  const SharedKernelWrapper &const_kwrapper2 = kwrapper2;
+  REQUIRE(const_kwrapper2.at(2, 0) == Approx(6.0));
+
+  // Growing with the same points shares the storage again
+  kwrapper2.update(dwrapper_grown);
+  REQUIRE(kwrapper.sharesStorageWith(kwrapper2));
+  REQUIRE(kwrapper2.getNumberPoints() == 5);
+  REQUIRE(const_kwrapper2.at(4, 0) == Approx(7.0));
+
+  WHEN("Updating with descriptors whose existing points changed") {
+    std::vector<std::vector<double>> data2 = {
+        {5.0, 1.0}, {2.0, 9.0}, {6.0, 2.0}, {3.0, 3.0}, {7.0, 5.0}, {1.0, 1.0}};
+    DescriptorWrapper<vector<vector<double>> *> dwrapper2(&data2, 6, 2);
+    kwrapper2.update(dwrapper2);
+
+    // The kernels are replaced
+    REQUIRE_FALSE(kwrapper.sharesStorageWith(kwrapper2));
+    REQUIRE(kwrapper2.getNumberPoints() == 6);
+    REQUIRE(const_kwrapper2.at(0, 0) == Approx(5.0));
+    REQUIRE(const_kwrapper2.at(5, 1) == Approx(1.0));
+    REQUIRE(const_kwrapper.at(0, 0) == Approx(1.0));
+  }
+
+  WHEN("One wrapper grows with different points than the other") {
+    std::vector<std::vector<double>> data3 = data;
+    data3.push_back({8.0, 8.0});
+    data.push_back({0.0, 0.0});
+    DescriptorWrapper<vector<vector<double>> *> dwrapper3(&data3, 6, 2);
+    DescriptorWrapper<vector<vector<double>> *> dwrapper4(&data, 6, 2);
+    kwrapper.update(dwrapper3);
+    kwrapper2.update(dwrapper4);
+
+    REQUIRE_FALSE(kwrapper.sharesStorageWith(kwrapper2));
+    REQUIRE(const_kwrapper.at(5, 0) == Approx(8.0));
+    REQUIRE(const_kwrapper2.at(5, 0) == Approx(0.0));
+    REQUIRE(const_kwrapper2.at(4, 1) == Approx(5.0));
+  }
+}
+
+TEST_CASE("Testing:shared kernel_wrapper detaches before changing storage",
+          "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data = {{1.0, 4.0}, {2.0, 9.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, 2, 2);
+
+  SharedKernelWrapper kwrapper(test::Test::key(), dwrapper);
+  SharedKernelWrapper kwrapper2(test::Test::key(), dwrapper);
+  const SharedKernelWrapper &reader = kwrapper2;
+  const double *first_row =
+      std::any_cast<const KernelStore *>(reader.getPointerToRawData())
+          ->row(0);
+
+  WHEN("One of the wrappers appends points") {
+    data.push_back({3.0, 3.0});
+    DescriptorWrapper<vector<vector<double>> *> dwrapper_grown(&data, 3, 2);
+    kwrapper.update(dwrapper_grown);
+
+    const SharedKernelWrapper &appender = kwrapper;
+    REQUIRE_FALSE(kwrapper.sharesStorageWith(kwrapper2));
+    REQUIRE(appender.at(2, 1) == Approx(3.0));
+    // The storage of the other wrapper was neither grown nor moved
+    const auto *store =
+        std::any_cast<const KernelStore *>(reader.getPointerToRawData());
+    REQUIRE(store->rows() == 2);
+    REQUIRE(store->row(0) == first_row);
+    REQUIRE(reader.at(1, 1) == Approx(9.0));
+
+    // Once it is the only owner a wrapper appends in place
+    data.push_back({5.0, 5.0});
+    DescriptorWrapper<vector<vector<double>> *> dwrapper_grown2(&data, 4, 2);
+    const void *storage = kwrapper.appendOnlyStorage().get();
+    kwrapper.update(dwrapper_grown2);
+    REQUIRE(kwrapper.appendOnlyStorage().get() == storage);
+    REQUIRE(appender.at(3, 0) == Approx(5.0));
+  }
+
+  WHEN("Writing through one of the wrappers") {
+    kwrapper.at(0, 0) = -1.0;
+    REQUIRE_FALSE(kwrapper.sharesStorageWith(kwrapper2));
+    REQUIRE(reader.at(0, 0) == Approx(1.0));
+    // The private copy is written in place until it is handed out as append
+    // only storage
+    const auto storage = kwrapper.appendOnlyStorage();
+    REQUIRE(storage != kwrapper2.appendOnlyStorage());
+    kwrapper.at(1, 0) = -2.0;
+    REQUIRE(kwrapper.appendOnlyStorage() != storage);
+  }
+}
+
+TEST_CASE("Testing:mean kernel_wrapper update policies", "[unit,panacea]") {
+
+  std::vector<std::vector<double>> data = {{1.0}, {2.0}, {6.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper(&data, 3, 1);
+
+  std::vector<std::vector<double>> data2 = {{5.0}, {8.0}, {3.0}, {9.0}, {6.0}};
+  DescriptorWrapper<vector<vector<double>> *> dwrapper2(&data2, 5, 1);
+
+  WHEN("Keeping a window of a single update") {
+    MeanKernelWrapper mean_kwrapper(test::Test::key(), dwrapper);
+    mean_kwrapper.set(
+        UpdatePolicy(settings::UpdateMode::SlidingWindow, 1.0, 1));
+    mean_kwrapper.update(dwrapper2);
+    // Only the points of data2 are in the window, 31.0 / 5.0 = 6.2
+    REQUIRE(mean_kwrapper.at(0, 0) == Approx(6.2));
+    REQUIRE(mean_kwrapper.getUpdatePolicy().window() == 1);
+
+    BaseKernelWrapper *kwrapper_ptr = &mean_kwrapper;
+    std::fstream fs;
+    fs.open("mean_kernel_wrapper_policy_restart.txt", std::fstream::out);
+    BaseKernelWrapper::write(settings::FileType::TXTRestart, fs, kwrapper_ptr);
+    fs.close();
+
+    MeanKernelWrapper mean_kwrapper2(test::Test::key());
+    kwrapper_ptr = &mean_kwrapper2;
+    std::fstream fs2;
+    fs2.open("mean_kernel_wrapper_policy_restart.txt", std::fstream::in);
+    BaseKernelWrapper::read(settings::FileType::TXTRestart, fs2, kwrapper_ptr);
+    fs2.close();
+    REQUIRE(mean_kwrapper2.getUpdatePolicy() ==
+            mean_kwrapper.getUpdatePolicy());
+
+    // The window now only holds the points of data
+    mean_kwrapper2.update(dwrapper);
+    REQUIRE(mean_kwrapper2.at(0, 0) == Approx(3.0));
+  }
+
+  WHEN("Decaying the earlier points") {
+    MeanKernelWrapper mean_kwrapper(test::Test::key(), dwrapper);
+    mean_kwrapper.set(
+        UpdatePolicy(settings::UpdateMode::ExponentialDecay, 0.5, 1));
+    mean_kwrapper.update(dwrapper2);
+    // (0.5 * 9.0 + 31.0) / (0.5 * 3.0 + 5.0) = 35.5 / 6.5
+    REQUIRE(mean_kwrapper.at(0, 0) == Approx(35.5 / 6.5));
+  }
+}
@@ -5,6 +5,9 @@
 // Third party includes
 #include <catch2/catch.hpp>
 
+// Standard includes
+#include <cmath>
+
 using namespace std;
 using namespace panacea;
 
@@ -140,3 +143,38 @@ TEST_CASE("Testing:matrix test make Identity", "[unit,panacea]") {
     }
   }
 }
+
+TEST_CASE("Testing:matrix cholesky factor and inverse", "[unit,panacea]") {
+
+  //  4  2
+  //  2  3
+  auto matrix = createMatrix(2, 2);
+  matrix->operator()(0, 0) = 4.0;
+  matrix->operator()(0, 1) = 2.0;
+  matrix->operator()(1, 0) = 2.0;
+  matrix->operator()(1, 1) = 3.0;
+
+  WHEN("The matrix is positive definite") {
+    auto lower = choleskyFactor(*matrix);
+    REQUIRE(lower != nullptr);
+    // L = | 2        0 |
+    //     | 1  sqrt(2) |
+    REQUIRE(lower->operator()(0, 0) == Approx(2.0));
+    REQUIRE(lower->operator()(0, 1) == Approx(0.0));
+    REQUIRE(lower->operator()(1, 0) == Approx(1.0));
+    REQUIRE(lower->operator()(1, 1) == Approx(std::sqrt(2.0)));
+
+    // inverse = 1/8 |  3 -2 |
+    //               | -2  4 |
+    auto inverse = choleskyInverse(*lower);
+    REQUIRE(inverse->operator()(0, 0) == Approx(3.0 / 8.0));
+    REQUIRE(inverse->operator()(0, 1) == Approx(-2.0 / 8.0));
+    REQUIRE(inverse->operator()(1, 0) == Approx(-2.0 / 8.0));
+    REQUIRE(inverse->operator()(1, 1) == Approx(4.0 / 8.0));
+  }
+
+  WHEN("The matrix is not positive definite") {
+    matrix->operator()(1, 1) = -3.0;
+    REQUIRE(choleskyFactor(*matrix) == nullptr);
+  }
+}
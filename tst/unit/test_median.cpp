@@ -1,5 +1,6 @@
 
 // Local private PANACEA includes
+#include "descriptors/descriptor_wrapper.hpp"
 #include "median.hpp"
 
 // Third party includes
@@ -48,3 +49,83 @@ TEST_CASE("Testing:median", "[unit,panacea]") {
     REQUIRE(median_vec.at(1) == Approx(6.0));
   }
 }
+
+TEST_CASE("Testing:median selection", "[unit,panacea]") {
+
+  // Large enough that the columns are split across threads
+  const int rows = 40001;
+  const int cols = 5;
+  std::vector<std::vector<double>> data(rows, std::vector<double>(cols));
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      // Each column is a permutation of 0 to rows - 1 scaled by col + 1
+      data[row][col] = static_cast<double>((row * 7919 + col) % rows) *
+                       static_cast<double>(col + 1);
+    }
+  }
+
+  class Data {
+    const std::vector<std::vector<double>> &data_;
+    int rows_;
+
+  public:
+    Data(const std::vector<std::vector<double>> &data, const int rows)
+        : data_(data), rows_(rows) {}
+    int rows() const { return rows_; }
+    int cols() const { return data_.at(0).size(); }
+
+    double operator()(const int row, const int col) const {
+      return data_.at(row).at(col);
+    }
+  };
+
+  Median median;
+
+  WHEN("Odd number of rows") {
+    Data data2d(data, rows);
+    auto median_vec = median.calculate<Data, Direction::AlongColumns>(data2d);
+    REQUIRE(median_vec.size() == cols);
+    for (int col = 0; col < cols; ++col) {
+      REQUIRE(median_vec.at(col) == Approx(20000.0 * (col + 1)));
+    }
+  }
+
+  WHEN("Reading contiguous rows of a descriptor wrapper") {
+    DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, rows,
+                                                                   cols);
+    auto median_vec = median.calculate<const BaseDescriptorWrapper &,
+                                       Direction::AlongColumns>(dwrapper);
+    REQUIRE(median_vec.size() == cols);
+    for (int col = 0; col < cols; ++col) {
+      REQUIRE(median_vec.at(col) == Approx(20000.0 * (col + 1)));
+    }
+  }
+
+  WHEN("Even number of rows") {
+    // Dropping the last row leaves an even count, the two central values
+    // are averaged
+    Data data2d(data, rows - 1);
+    auto median_vec = median.calculate<Data, Direction::AlongColumns>(data2d);
+    std::vector<double> column(rows - 1);
+    for (int col = 0; col < cols; ++col) {
+      for (int row = 0; row < rows - 1; ++row) {
+        column[row] = data[row][col];
+      }
+      std::sort(column.begin(), column.end());
+      const double expected =
+          (column[(rows - 1) / 2] + column[(rows - 1) / 2 - 1]) * 0.5;
+      REQUIRE(median_vec.at(col) == Approx(expected));
+    }
+  }
+
+  WHEN("Calculating median along rows") {
+    Data data2d(data, rows);
+    auto median_vec = median.calculate(data2d);
+    REQUIRE(median_vec.size() == rows);
+    for (int row = 0; row < rows; row += 997) {
+      std::vector<double> values = data[row];
+      std::sort(values.begin(), values.end());
+      REQUIRE(median_vec.at(row) == Approx(values[cols / 2]));
+    }
+  }
+}
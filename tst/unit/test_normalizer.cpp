@@ -3,8 +3,10 @@
 #include "attribute_manipulators/normalizer.hpp"
 
 #include "attributes/covariance.hpp"
+#include "descriptors/descriptor_wrapper.hpp"
 #include "io/file_io_factory.hpp"
 #include "matrix/matrix.hpp"
+#include "update_policy.hpp"
 #include "vector/vector.hpp"
 
 // Public PANACEA includes
@@ -103,4 +105,48 @@ TEST_CASE("Testing:normalizer write & read", "[unit,panacea]") {
   REQUIRE(norm_coeffs.at(0) == norm_coeffs2.at(0));
   REQUIRE(norm_coeffs.at(1) == norm_coeffs2.at(1));
   REQUIRE(norm_coeffs.at(2) == norm_coeffs2.at(2));
+
+  // The reciprocals are recalculated when the coefficients are read
+  const auto &inv_coeffs2 = normalizer2.getInverseNormalizationCoeffs();
+  REQUIRE(inv_coeffs2.size() == 3);
+  REQUIRE(inv_coeffs2.at(0) == Approx(1.0));
+  REQUIRE(inv_coeffs2.at(1) == Approx(1.0 / 3.0));
+  REQUIRE(inv_coeffs2.at(2) == Approx(0.5));
+}
+
+TEST_CASE("Testing:normalizer update policy", "[unit,panacea]") {
+  std::vector<std::vector<double>> data = {{1.0, 4.0}, {2.0, 9.0}, {6.0, 2.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(&data, 3, 2);
+
+  std::vector<std::vector<double>> data2 = {
+      {5.0, 1.0}, {8.0, 1.5}, {3.0, 2.0}, {9.0, 0.5}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper2(&data2, 4,
+                                                                  2);
+
+  Normalizer normalizer(dwrapper, settings::KernelNormalization::Variance,
+                        NormalizerOption::Strict, settings::None::None,
+                        UpdatePolicy(settings::UpdateMode::SlidingWindow, 1.0,
+                                     1));
+  REQUIRE(normalizer.getUpdatePolicy().is(settings::UpdateMode::SlidingWindow));
+  normalizer.update(dwrapper2);
+
+  // With a window of a single update only data2 is used
+  Normalizer normalizer2(dwrapper2, settings::KernelNormalization::Variance);
+  const auto coeffs = normalizer.getNormalizationCoeffs();
+  const auto coeffs2 = normalizer2.getNormalizationCoeffs();
+  REQUIRE(coeffs.size() == 2);
+  REQUIRE(coeffs.at(0) == Approx(coeffs2.at(0)));
+  REQUIRE(coeffs.at(1) == Approx(coeffs2.at(1)));
+
+  std::fstream fs;
+  fs.open("test_normalizer_policy.restart", std::fstream::out);
+  Normalizer::write(settings::FileType::TXTRestart, fs, &normalizer);
+  fs.close();
+
+  Normalizer normalizer3;
+  std::fstream fs2;
+  fs2.open("test_normalizer_policy.restart", std::fstream::in);
+  Normalizer::read(settings::FileType::TXTRestart, fs2, &normalizer3);
+  fs2.close();
+  REQUIRE(normalizer3.getUpdatePolicy() == normalizer.getUpdatePolicy());
 }
@@ -2,15 +2,56 @@
 // Local private PANACEA includes
 #include "primitives/primitive_factory.hpp"
 
+#include "constants.hpp"
+
 // Public PANACEA includes
 #include "descriptors/descriptor_wrapper.hpp"
 
 // Third party includes
 #include <catch2/catch.hpp>
 
+// Standard includes
+#include <thread>
+#include <vector>
+
 using namespace std;
 using namespace panacea;
 
 TEST_CASE("Testing:primitive_factory trivial constructor", "[unit,panacea]") {
   PrimitiveFactory prim_factory;
 }
+
+TEST_CASE("Testing:primitive_factory concurrent construction",
+          "[unit,panacea]") {
+  std::vector<std::vector<double>> raw_desc_data{{0.0, 3.0}, {2.0, 4.0},
+                                                 {1.0, 7.0}};
+  DescriptorWrapper<std::vector<std::vector<double>> *> dwrapper(
+      &raw_desc_data, 3, 2);
+
+  KernelSpecification specification(
+      settings::KernelCorrelation::Uncorrelated,
+      settings::KernelCount::OneToOne, settings::KernelPrimitive::Gaussian,
+      settings::KernelNormalization::None, settings::KernelMemory::Share,
+      settings::KernelCenterCalculation::None,
+      settings::KernelAlgorithm::Flexible, settings::RandomizeDimensions::No,
+      settings::RandomizeNumberDimensions::No, constants::automate);
+
+  // Each thread constructs its own factory, the registration tables are
+  // shared between them
+  const int num_threads = 4;
+  std::vector<std::size_t> num_primitives(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (int index = 0; index < num_threads; ++index) {
+    threads.emplace_back([&, index]() {
+      PrimitiveFactory prim_factory;
+      auto prim_grp = prim_factory.createGroup(dwrapper, specification);
+      num_primitives[index] = prim_grp.primitives.size();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (const auto count : num_primitives) {
+    REQUIRE(count == 3);
+  }
+}
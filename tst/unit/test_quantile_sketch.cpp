@@ -0,0 +1,126 @@
+// Local private PANACEA includes
+#include "quantile_sketch.hpp"
+
+// Third party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace panacea;
+
+TEST_CASE("Testing:quantile sketch", "[unit,panacea]") {
+
+  const double rank_error = 0.01;
+  const int num_values = 10000;
+
+  // Values 0 to 9999 in a random order, a value v has rank v + 1
+  std::vector<double> values(num_values);
+  std::iota(values.begin(), values.end(), 0.0);
+  std::mt19937 gen(42);
+  std::shuffle(values.begin(), values.end(), gen);
+
+  QuantileSketch sketch(rank_error);
+
+  WHEN("Inserting values in batches") {
+    for (int start = 0; start < num_values; start += 100) {
+      std::vector<double> batch(values.begin() + start,
+                                values.begin() + start + 100);
+      sketch.insert(batch);
+    }
+  }
+  WHEN("Inserting values one at a time") {
+    for (const double value : values) {
+      sketch.insert(value);
+    }
+  }
+
+  REQUIRE(sketch.count() == num_values);
+  sketch.flush();
+  // Far fewer tuples than values are kept
+  REQUIRE(sketch.tuples().size() < num_values / 10);
+
+  const double allowed_error = rank_error * num_values;
+  for (const double quantile : {0.0, 0.1, 0.25, 0.5, 0.75, 0.9, 1.0}) {
+    const double rank = std::max(1.0, std::ceil(quantile * num_values));
+    REQUIRE(std::abs(sketch.quantile(quantile) + 1.0 - rank) <=
+            allowed_error);
+  }
+  // The smallest and largest values are always kept exactly
+  REQUIRE(sketch.tuples().front().value == Approx(0.0));
+  REQUIRE(sketch.tuples().back().value == Approx(num_values - 1.0));
+}
+
+TEST_CASE("Testing:quantile sketch small", "[unit,panacea]") {
+
+  QuantileSketch sketch;
+  REQUIRE_THROWS(sketch.quantile(0.5));
+
+  std::vector<double> values = {6.0, 1.0, 2.0};
+  sketch.insert(values);
+  REQUIRE(sketch.count() == 3);
+  REQUIRE(sketch.quantile(0.5) == Approx(2.0));
+  REQUIRE(sketch.quantile(0.0) == Approx(1.0));
+  REQUIRE(sketch.quantile(1.0) == Approx(6.0));
+
+  REQUIRE_THROWS(QuantileSketch(0.0));
+  REQUIRE_THROWS(QuantileSketch(0.5));
+}
+
+TEST_CASE("Testing:quantile sketch write & read", "[unit,panacea]") {
+
+  QuantileSketch sketch(0.05);
+  std::mt19937 gen(7);
+  std::normal_distribution<double> distribution(3.0, 2.0);
+  std::vector<double> values(1000);
+  for (auto &value : values) {
+    value = distribution(gen);
+  }
+  sketch.insert(values);
+
+  std::stringstream ss;
+  QuantileSketch::write(sketch, ss);
+
+  QuantileSketch sketch2;
+  QuantileSketch::read(sketch2, ss);
+
+  REQUIRE(sketch2.rankError() == Approx(0.05));
+  REQUIRE(sketch2.count() == sketch.count());
+  REQUIRE(sketch2.tuples().size() == sketch.tuples().size());
+  for (const double quantile : {0.1, 0.5, 0.9}) {
+    REQUIRE(sketch2.quantile(quantile) == sketch.quantile(quantile));
+  }
+}
+
+TEST_CASE("Testing:quantile sketch buffers single values", "[unit,panacea]") {
+
+  // Values are merged every floor(1 / (2 * 0.05)) = 10 values
+  QuantileSketch sketch(0.05);
+  for (int value = 1; value <= 15; ++value) {
+    sketch.insert(static_cast<double>(value));
+  }
+  REQUIRE(sketch.count() == 15);
+  std::size_t merged = 0;
+  for (const auto &tuple : sketch.tuples()) {
+    merged += tuple.g;
+  }
+  REQUIRE(merged == 10);
+
+  // Buffered values are seen by queries and when written
+  REQUIRE(sketch.quantile(1.0) == Approx(15.0));
+  std::stringstream ss;
+  QuantileSketch::write(sketch, ss);
+  QuantileSketch sketch2;
+  QuantileSketch::read(sketch2, ss);
+  REQUIRE(sketch2.count() == 15);
+  REQUIRE(sketch2.quantile(1.0) == Approx(15.0));
+
+  sketch.flush();
+  REQUIRE(sketch.tuples().back().value == Approx(15.0));
+}
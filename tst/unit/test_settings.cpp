@@ -37,4 +37,10 @@ TEST_CASE("Testing:settings printing with << ", "[unit,panacea]") {
   std::cout << settings::KernelCenterCalculation::None << std::endl;
   std::cout << settings::KernelCenterCalculation::Mean << std::endl;
   std::cout << settings::KernelCenterCalculation::Median << std::endl;
+  std::cout << settings::KernelCenterCalculation::StreamingMedian << std::endl;
+  std::cout << settings::UpdateMode::Cumulative << std::endl;
+  std::cout << settings::UpdateMode::ExponentialDecay << std::endl;
+  std::cout << settings::UpdateMode::SlidingWindow << std::endl;
+  std::cout << settings::DescriptorSidecar::None << std::endl;
+  std::cout << settings::DescriptorSidecar::Summary << std::endl;
 }
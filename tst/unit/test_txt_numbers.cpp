@@ -0,0 +1,96 @@
+
+// Local private PANACEA includes
+#include "io/txt_numbers.hpp"
+
+// Third party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace panacea;
+
+TEST_CASE("Testing:txt numbers", "[unit,panacea]") {
+
+  const std::vector<double> values{0.0,     -0.0,    0.1,     1.0 / 3.0,
+                                   -2.5e-7, 1.0e300, 4.9e-324, 123456789.0};
+
+  WHEN("Writing values") {
+    for (const double value : values) {
+      std::ostringstream os;
+      io::writeDouble(os, value);
+      double read_value = 1.0;
+      const std::string text = os.str();
+      REQUIRE(io::parseDouble(text.data(), text.data() + text.size(),
+                              read_value) == text.data() + text.size());
+      // Values read back exactly
+      REQUIRE(read_value == value);
+      REQUIRE(std::signbit(read_value) == std::signbit(value));
+    }
+    std::ostringstream os;
+    io::writeDouble(os, 0.5, 14);
+    REQUIRE(os.str() == "           0.5");
+  }
+
+  WHEN("Reading values written by the stream operators") {
+    std::ostringstream os;
+    for (const double value : values) {
+      os << std::setw(14) << std::setprecision(8) << value << " ";
+    }
+    os << "+7.25";
+    const std::string text = os.str();
+    std::vector<double> read_values(values.size() + 1);
+    REQUIRE(io::parseValues(text.data(), text.data() + text.size(),
+                            read_values.data(),
+                            read_values.size()) ==
+            static_cast<int>(read_values.size()));
+    for (std::size_t index = 0; index < values.size(); ++index) {
+      std::istringstream is(text);
+      double expected = 0.0;
+      for (std::size_t skip = 0; skip <= index; ++skip) {
+        is >> expected;
+      }
+      REQUIRE(read_values[index] == expected);
+    }
+    REQUIRE(read_values.back() == 7.25);
+  }
+
+  WHEN("Reading a block large enough to be split between threads") {
+    const int rows = 30000;
+    const int cols = 4;
+    std::ostringstream os;
+    for (int row = 0; row < rows; ++row) {
+      for (int col = 0; col < cols; ++col) {
+        io::writeDouble(os, row * 0.1 + col, 14);
+        os << " ";
+      }
+      os << "\n";
+    }
+    os << "next line\n";
+    std::istringstream is(os.str());
+    std::vector<double> block;
+    io::readBlock(is, rows, cols, block);
+    REQUIRE(block.size() == rows * cols);
+    for (int row = 0; row < rows; ++row) {
+      for (int col = 0; col < cols; ++col) {
+        REQUIRE(block[row * cols + col] == row * 0.1 + col);
+      }
+    }
+    // The stream is left at the line following the block
+    std::string line;
+    std::getline(is, line);
+    REQUIRE(line == "next line");
+  }
+
+  WHEN("Reading a block with a missing value") {
+    std::istringstream is("1.0 2.0\n3.0\n");
+    std::vector<double> block;
+    REQUIRE_THROWS(io::readBlock(is, 2, 2, block));
+  }
+}
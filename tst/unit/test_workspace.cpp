@@ -0,0 +1,66 @@
+
+// Local private PANACEA includes
+#include "workspace.hpp"
+
+#include "matrix/matrix.hpp"
+
+// Third party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace panacea;
+
+TEST_CASE("Testing:workspace", "[unit,panacea]") {
+  Workspace workspace;
+
+  WHEN("Borrowing vectors") {
+    std::vector<double> &diff =
+        workspace.vector(Workspace::Slot::Difference, 4);
+    REQUIRE(diff.size() == 4);
+    diff[3] = 2.0;
+    const double *diff_data = diff.data();
+
+    // A smaller request reuses the memory of the slot
+    std::vector<double> &diff2 =
+        workspace.vector(Workspace::Slot::Difference, 3);
+    REQUIRE(&diff2 == &diff);
+    REQUIRE(diff2.size() == 3);
+    REQUIRE(diff2.data() == diff_data);
+    REQUIRE(workspace.vector(Workspace::Slot::Difference, 4).data() ==
+            diff_data);
+
+    // Slots are independent of each other
+    std::vector<double> &product =
+        workspace.vector(Workspace::Slot::Product, 4);
+    REQUIRE(&product != &diff);
+  }
+
+  WHEN("Borrowing matrices") {
+    Matrix &mat = workspace.matrix(Workspace::Slot::Reduction, 3, 3);
+    REQUIRE(mat.rows() == 3);
+    REQUIRE(mat.cols() == 3);
+    mat(2, 2) = 5.0;
+    Matrix &mat2 = workspace.matrix(Workspace::Slot::Reduction, 3, 3);
+    REQUIRE(&mat2 == &mat);
+    REQUIRE(mat2(2, 2) == Approx(5.0));
+
+    Matrix &mat3 = workspace.matrix(Workspace::Slot::Reduction, 2, 4);
+    REQUIRE(&mat3 == &mat);
+    REQUIRE(mat3.rows() == 2);
+    REQUIRE(mat3.cols() == 4);
+  }
+}
+
+TEST_CASE("Testing:workspace of each thread", "[unit,panacea]") {
+  Workspace &local = Workspace::local();
+  REQUIRE(&Workspace::local() == &local);
+
+  const Workspace *other = nullptr;
+  std::thread thread([&other]() { other = &Workspace::local(); });
+  thread.join();
+  REQUIRE(other != &local);
+}